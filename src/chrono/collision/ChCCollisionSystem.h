@@ -152,6 +152,21 @@ class ChApi ChCollisionSystem {
     /// Perform a ray-hit test with the collision models.
     virtual bool RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult) = 0;
 
+    /// Perform a ray-hit test with the specified collision model only.
+    /// Unlike the test against all models, this does not use the broadphase; implementations
+    /// must be safe to call concurrently from multiple threads.
+    /// The default implementation reports no hit (not supported, see SupportsModelRayHit()).
+    virtual bool RayHit(const ChVector<>& from,
+                        const ChVector<>& to,
+                        ChCollisionModel* model,
+                        ChRayhitResult& mresult) {
+        mresult.hit = false;
+        return false;
+    }
+
+    /// Return true if the collision system implements the ray-hit test with a single model.
+    virtual bool SupportsModelRayHit() const { return false; }
+
     // SERIALIZATION
 
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
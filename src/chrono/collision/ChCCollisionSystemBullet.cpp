@@ -1392,6 +1392,48 @@ bool ChCollisionSystemBullet::RayHit(const ChVector<>& from, const ChVector<>& t
     return false;
 }
 
+bool ChCollisionSystemBullet::RayHit(const ChVector<>& from,
+                                     const ChVector<>& to,
+                                     ChCollisionModel* model,
+                                     ChRayhitResult& mresult) {
+    mresult.hit = false;
+
+    ChModelBullet* bmodel = dynamic_cast<ChModelBullet*>(model);
+    if (!bmodel)
+        return false;
+    btCollisionObject* bobject = bmodel->GetBulletModel();
+    if (!bobject || !bobject->getCollisionShape())
+        return false;
+
+    btVector3 btfrom((btScalar)from.x(), (btScalar)from.y(), (btScalar)from.z());
+    btVector3 btto((btScalar)to.x(), (btScalar)to.y(), (btScalar)to.z());
+    btTransform rayFromTrans;
+    rayFromTrans.setIdentity();
+    rayFromTrans.setOrigin(btfrom);
+    btTransform rayToTrans;
+    rayToTrans.setIdentity();
+    rayToTrans.setOrigin(btto);
+
+    btCollisionWorld::ClosestRayResultCallback rayCallback(btfrom, btto);
+
+    // No broadphase and no shared state: only the shape of this model is tested.
+    btCollisionWorld::rayTestSingle(rayFromTrans, rayToTrans, bobject, bobject->getCollisionShape(),
+                                    bobject->getWorldTransform(), rayCallback);
+
+    if (rayCallback.hasHit()) {
+        mresult.hitModel = model;
+        mresult.abs_hitPoint.Set(rayCallback.m_hitPointWorld.x(), rayCallback.m_hitPointWorld.y(),
+                                 rayCallback.m_hitPointWorld.z());
+        mresult.abs_hitNormal.Set(rayCallback.m_hitNormalWorld.x(), rayCallback.m_hitNormalWorld.y(),
+                                  rayCallback.m_hitNormalWorld.z());
+        mresult.abs_hitNormal.Normalize();
+        mresult.hit = true;
+        mresult.dist_factor = rayCallback.m_closestHitFraction;
+        return true;
+    }
+    return false;
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (btScalar)threshold;
 }
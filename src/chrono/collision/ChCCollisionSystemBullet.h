@@ -75,6 +75,14 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// Perform a raycast (ray-hit test with the collision models).
     virtual bool RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult);
 
+    /// Perform a ray-hit test with the specified collision model only.
+    /// The ray is tested directly against the Bullet shape of the model; this is thread safe.
+    virtual bool RayHit(const ChVector<>& from,
+                        const ChVector<>& to,
+                        ChCollisionModel* model,
+                        ChRayhitResult& mresult) override;
+    virtual bool SupportsModelRayHit() const override { return true; }
+
     // For Bullet related stuff
     btCollisionWorld* GetBulletCollisionWorld() { return bt_collision_world; }
 
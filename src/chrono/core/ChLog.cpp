@@ -11,6 +11,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 #include <cstdarg>
 
@@ -54,7 +55,7 @@ void SetLogDefault() {
 // Logger class
 //
 
-ChLog::ChLog() {
+ChLog::ChLog() : enabled_levels((1 << CHERROR) | (1 << CHWARNING) | (1 << CHMESSAGE)) {
     default_level = CHMESSAGE;
     current_level = CHMESSAGE;
 }
@@ -64,6 +65,37 @@ ChLog& ChLog::operator-(eChLogLevel mnewlev) {
     return *this;
 }
 
+void ChLog::SetLevelEnabled(eChLogLevel mlev, bool enabled) {
+    if (enabled)
+        enabled_levels.fetch_or(1u << mlev, std::memory_order_relaxed);
+    else
+        enabled_levels.fetch_and(~(1u << mlev), std::memory_order_relaxed);
+}
+
+void ChLog::OutputMessage(eChLogLevel mlev, const char* data, size_t n) {
+    eChLogLevel old_level = current_level;
+    current_level = mlev;
+    Output(data, n);
+    current_level = old_level;
+}
+
+//
+// Log message class
+//
+
+ChLogMessage::~ChLogMessage() {
+    if (length == 0 || buffer[length - 1] != '\n')
+        buffer[length++] = '\n';
+    log.OutputMessage(level, buffer, length);
+}
+
+void ChLogMessage::Output(const char* data, size_t n) {
+    // keep one char for the final newline
+    size_t ncopy = std::min(n, sizeof(buffer) - 1 - length);
+    memcpy(buffer + length, data, ncopy);
+    length += ncopy;
+}
+
 /*
 void ChLog::PrintCurTime()
 {
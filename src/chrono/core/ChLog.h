@@ -12,6 +12,7 @@
 #ifndef CHLOG_H
 #define CHLOG_H
 
+#include <atomic>
 #include <cassert>
 
 #include "chrono/core/ChStream.h"
@@ -31,11 +32,12 @@ class ChApi ChLog : public ChStreamOutAscii {
     /// specializations of the ChLog class may handle message output
     /// in different ways (for example a ChLogForGUIapplication may
     /// print logs in STATUS level only to the bottom of the window, etc.)
-    enum eChLogLevel { CHERROR = 0, CHWARNING, CHMESSAGE, CHSTATUS, CHQUIET };
+    enum eChLogLevel { CHERROR = 0, CHWARNING, CHMESSAGE, CHSTATUS, CHTRACE, CHQUIET };
 
   protected:
     eChLogLevel current_level;
     eChLogLevel default_level;
+    std::atomic<unsigned int> enabled_levels;
 
     /// Creates the ChLog, and sets the level at MESSAGE
     ChLog();
@@ -51,19 +53,34 @@ class ChApi ChLog : public ChStreamOutAscii {
     void SetDefaultLevel(eChLogLevel mlev) { default_level = mlev; };
 
     /// Sets the current level, to be used until new flushing.
-    void SetCurrentLevel(eChLogLevel mlev) { current_level = mlev; };
+    /// Inherited classes used by several threads may keep a current level per thread.
+    virtual void SetCurrentLevel(eChLogLevel mlev) { current_level = mlev; };
 
     /// Gets the current level
-    eChLogLevel GetCurrentLevel() { return current_level; };
+    virtual eChLogLevel GetCurrentLevel() { return current_level; };
 
     /// Restore the default level.
-    void RestoreDefaultLevel() { current_level = default_level; };
+    void RestoreDefaultLevel() { SetCurrentLevel(default_level); };
 
     /// Using the - operator is easy to set the status of the
     /// log, so in you code you can write, for example:
     ///   GetLog() - ChLog::CHERROR << "a big error in " << mynumber << " items \n" ;
     ChLog& operator-(eChLogLevel mnewlev);
 
+    /// Enable or disable the messages of the given level sent with the CH_LOG macro.
+    /// By default, CHERROR, CHWARNING and CHMESSAGE are enabled.
+    void SetLevelEnabled(eChLogLevel mlev, bool enabled);
+
+    /// Tell if the messages of the given level sent with the CH_LOG macro are enabled.
+    bool IsLevelEnabled(eChLogLevel mlev) const {
+        return (enabled_levels.load(std::memory_order_relaxed) >> mlev) & 1;
+    }
+
+    /// Output a complete message (one or more lines) of the given level, as done by the CH_LOG macro.
+    /// This base class outputs it as with the << operator, using 'mlev' as current level; inherited
+    /// classes may override it, for example to avoid the contention of threads on a shared stream.
+    virtual void OutputMessage(eChLogLevel mlev, const char* data, size_t n);
+
     /// Prints current time to the log
     // void PrintCurTime();
 
@@ -92,6 +109,48 @@ class ChApi ChLogConsole : public ChLog, public ChStreamOstreamWrapper {
   private:
 };
 
+////////////////////////////////////////////////////////
+//  LOG MESSAGES
+//
+/// Temporary stream used by the CH_LOG macro: it collects the text of one message,
+/// then sends it as a whole to ChLog::OutputMessage() when destroyed.
+/// A newline is appended, if missing. Messages longer than the internal buffer are truncated.
+
+class ChApi ChLogMessage : public ChStreamOutAscii {
+  public:
+    ChLogMessage(ChLog& mlog, ChLog::eChLogLevel mlev) : log(mlog), level(mlev), length(0) {}
+    ~ChLogMessage();
+
+    /// Return this stream as an lvalue, so that all << operators can be used.
+    ChStreamOutAscii& Stream() { return *this; }
+
+  protected:
+    virtual void Output(const char* data, size_t n) override;
+
+  private:
+    ChLog& log;
+    ChLog::eChLogLevel level;
+    size_t length;
+    char buffer[1024];
+};
+
+/// Maximum level of the messages sent with CH_LOG that are compiled in.
+/// Define it (ex. to ChLog::CHWARNING) before including this header, or in the compiler
+/// definitions, to remove the verbose messages from the code at compile time.
+#ifndef CH_LOG_MAX_LEVEL
+#define CH_LOG_MAX_LEVEL chrono::ChLog::CHTRACE
+#endif
+
+/// Send a message of the given level to the current ChLog, as a whole. For example:
+///   CH_LOG(ChLog::CHSTATUS) << "iteration " << iter << " residual " << res;
+/// If the level is above CH_LOG_MAX_LEVEL, the message is discarded at compile time.
+/// If the level is not enabled in the current ChLog, the message is not even formatted.
+#define CH_LOG(mlev)                                                         \
+    if ((mlev) > CH_LOG_MAX_LEVEL || !chrono::GetLog().IsLevelEnabled(mlev)) \
+        ;                                                                    \
+    else                                                                     \
+        chrono::ChLogMessage(chrono::GetLog(), mlev).Stream()
+
 ////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////
 
@@ -0,0 +1,250 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "chrono/core/ChLogAsync.h"
+
+namespace chrono {
+
+// Ring buffer of the messages sent by one thread.
+// The head is advanced only by the thread, the tail only by the writer thread of the log.
+struct ChLogAsync::Ring {
+    static const size_t text_size = 240;
+
+    struct Slot {
+        std::chrono::steady_clock::rep time;
+        int level;
+        unsigned int length;
+        char text[text_size];
+    };
+
+    Ring(unsigned int capacity, std::thread::id thread_id, eChLogLevel level)
+        : slots(capacity), mask(capacity - 1), thread(thread_id), level(level), head(0), tail(0), dropped(0) {}
+
+    std::vector<Slot> slots;
+    size_t mask;
+    std::thread::id thread;
+    eChLogLevel level;    ///< current level of the thread
+    std::string pending;  ///< text of an incomplete line, sent with the << operator
+
+    char pad0[64];
+    std::atomic<size_t> head;
+    char pad1[64];
+    std::atomic<size_t> tail;
+    char pad2[64];
+    std::atomic<unsigned long long> dropped;
+};
+
+namespace {
+
+std::atomic<unsigned long long> next_log_id(1);
+
+// Ring of the calling thread in the last ChLogAsync used by this thread
+struct ThreadRing {
+    unsigned long long log_id;
+    void* ring;
+};
+thread_local ThreadRing thread_ring = {0, NULL};
+
+}  // end anonymous namespace
+
+ChLogAsync::ChLogAsync(ChStreamOutAscii* destination, unsigned int capacity, unsigned int flush_interval_ms)
+    : destination(destination),
+      id(next_log_id++),
+      flush_interval(flush_interval_ms),
+      flush_requested(0),
+      flush_done(0),
+      stop(false) {
+    if (!this->destination) {
+        console.reset(new ChLogConsole);
+        this->destination = console.get();
+    }
+    this->capacity = 1;
+    while (this->capacity < capacity)
+        this->capacity *= 2;
+
+    writer = std::thread(&ChLogAsync::Run, this);
+}
+
+ChLogAsync::~ChLogAsync() {
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        stop = true;
+    }
+    flush_cv.notify_all();
+    writer.join();
+
+    // Messages sent after the last pass of the writer thread
+    Drain();
+}
+
+ChLogAsync::Ring* ChLogAsync::GetThreadRing() {
+    if (thread_ring.log_id == id)
+        return static_cast<Ring*>(thread_ring.ring);
+
+    // First message of this thread (or first after using another ChLogAsync)
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    std::thread::id thread_id = std::this_thread::get_id();
+    Ring* ring = NULL;
+    for (auto& r : rings) {
+        if (r->thread == thread_id)
+            ring = r.get();
+    }
+    if (!ring) {
+        rings.emplace_back(new Ring(capacity, thread_id, default_level));
+        ring = rings.back().get();
+    }
+    thread_ring.log_id = id;
+    thread_ring.ring = ring;
+    return ring;
+}
+
+void ChLogAsync::Push(Ring* ring, eChLogLevel mlev, const char* data, size_t n) {
+    std::chrono::steady_clock::rep time = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    // Messages longer than a slot take consecutive slots
+    size_t offset = 0;
+    do {
+        size_t head = ring->head.load(std::memory_order_relaxed);
+        if (head - ring->tail.load(std::memory_order_acquire) > ring->mask) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Ring::Slot& slot = ring->slots[head & ring->mask];
+        size_t length = std::min(n - offset, Ring::text_size);
+        slot.time = time;
+        slot.level = mlev;
+        slot.length = (unsigned int)length;
+        memcpy(slot.text, data + offset, length);
+        ring->head.store(head + 1, std::memory_order_release);
+        offset += length;
+    } while (offset < n);
+}
+
+void ChLogAsync::OutputMessage(eChLogLevel mlev, const char* data, size_t n) {
+    Push(GetThreadRing(), mlev, data, n);
+}
+
+void ChLogAsync::SetCurrentLevel(eChLogLevel mlev) {
+    GetThreadRing()->level = mlev;
+}
+
+ChLog::eChLogLevel ChLogAsync::GetCurrentLevel() {
+    return GetThreadRing()->level;
+}
+
+void ChLogAsync::Output(const char* data, size_t n) {
+    Ring* ring = GetThreadRing();
+    const char* end = data + n;
+    const char* newline;
+    while ((newline = static_cast<const char*>(memchr(data, '\n', end - data))) != NULL) {
+        size_t length = newline + 1 - data;
+        if (ring->pending.empty()) {
+            Push(ring, ring->level, data, length);
+        } else {
+            ring->pending.append(data, length);
+            Push(ring, ring->level, ring->pending.data(), ring->pending.size());
+            ring->pending.clear();
+        }
+        data = newline + 1;
+    }
+    ring->pending.append(data, end - data);
+}
+
+void ChLogAsync::Flush() {
+    Ring* ring = GetThreadRing();
+    if (!ring->pending.empty()) {
+        Push(ring, ring->level, ring->pending.data(), ring->pending.size());
+        ring->pending.clear();
+    }
+
+    std::unique_lock<std::mutex> lock(flush_mutex);
+    unsigned long long request = ++flush_requested;
+    flush_cv.notify_all();
+    flush_cv.wait(lock, [&]() { return flush_done >= request; });
+
+    ring->level = default_level;
+}
+
+unsigned long long ChLogAsync::GetNumDropped() const {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    unsigned long long dropped = 0;
+    for (auto& r : rings)
+        dropped += r->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+void ChLogAsync::Drain() {
+    struct Entry {
+        std::chrono::steady_clock::rep time;
+        Ring* ring;
+        size_t index;
+    };
+    std::vector<Entry> entries;
+    std::vector<std::pair<Ring*, size_t> > heads;
+
+    // Collect the queued messages of all threads. The slots cannot be overwritten until
+    // the tails are advanced, so they are written directly from the ring buffers.
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        for (auto& r : rings) {
+            Ring* ring = r.get();
+            size_t tail = ring->tail.load(std::memory_order_relaxed);
+            size_t head = ring->head.load(std::memory_order_acquire);
+            for (size_t i = tail; i != head; ++i)
+                entries.push_back({ring->slots[i & ring->mask].time, ring, i & ring->mask});
+            heads.push_back(std::make_pair(ring, head));
+        }
+    }
+
+    // Sort by time; the messages of each thread are already in order.
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+    ChLog* destination_log = dynamic_cast<ChLog*>(destination);
+    std::string text;
+    for (auto& e : entries) {
+        const Ring::Slot& slot = e.ring->slots[e.index];
+        if (destination_log) {
+            destination_log->OutputMessage((eChLogLevel)slot.level, slot.text, slot.length);
+        } else {
+            text.assign(slot.text, slot.length);
+            *destination << text.c_str();
+        }
+    }
+
+    for (auto& h : heads)
+        h.first->tail.store(h.second, std::memory_order_release);
+}
+
+void ChLogAsync::Run() {
+    std::unique_lock<std::mutex> lock(flush_mutex);
+    while (true) {
+        flush_cv.wait_for(lock, flush_interval, [&]() { return stop || flush_requested != flush_done; });
+        unsigned long long request = flush_requested;
+        bool stopping = stop;
+
+        lock.unlock();
+        Drain();
+        lock.lock();
+
+        flush_done = request;
+        flush_cv.notify_all();
+        if (stopping)
+            break;
+    }
+}
+
+}  // end namespace chrono
@@ -0,0 +1,102 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHLOGASYNC_H
+#define CHLOGASYNC_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChLog.h"
+
+namespace chrono {
+
+/// Logger that does not make threads wait for each other, nor for the output.
+/// Each thread writing to this log has its own ring buffer of messages, with a single
+/// writer (the thread) and a single reader (a background thread of this log): messages
+/// are queued without locks, and written to the destination stream (by default, std::cout)
+/// by the background thread, at regular intervals or when Flush() is called.
+/// Messages of different threads are written in the order they were sent.
+/// If the ring buffer of a thread is full, its new messages are dropped (see GetNumDropped()).
+///
+/// Text sent with the << operator is queued one line at a time (i.e. when a newline is found),
+/// while messages sent with the CH_LOG macro are queued as a whole. The current level (set with
+/// the - operator) is kept per thread, and restored to the default level by Flush().
+/// Usage:
+///   ChLogAsync async_log;
+///   SetLog(async_log);
+///   ...
+///   SetLogDefault();  // before the ChLogAsync object is destroyed
+class ChApi ChLogAsync : public ChLog {
+  public:
+    /// Create the log, writing to the given stream (if NULL, a ChLogConsole).
+    /// The ring buffer of each thread can hold 'capacity' messages (rounded up to a power of two);
+    /// messages are written by the background thread every 'flush_interval_ms' milliseconds.
+    ChLogAsync(ChStreamOutAscii* destination = NULL, unsigned int capacity = 1024, unsigned int flush_interval_ms = 20);
+
+    /// Write all pending messages and stop the background thread.
+    virtual ~ChLogAsync();
+
+    /// Queue the pending text of the calling thread, even if not terminated by a newline,
+    /// then wait until all queued messages are written to the destination stream.
+    virtual void Flush() override;
+
+    /// Queue a complete message of the given level, without waiting.
+    virtual void OutputMessage(eChLogLevel mlev, const char* data, size_t n) override;
+
+    /// Set the current level of the calling thread.
+    virtual void SetCurrentLevel(eChLogLevel mlev) override;
+
+    /// Get the current level of the calling thread.
+    virtual eChLogLevel GetCurrentLevel() override;
+
+    /// Get the number of messages dropped because a ring buffer was full.
+    unsigned long long GetNumDropped() const;
+
+  protected:
+    /// Collect text sent with the << operator, and queue it one line at a time.
+    virtual void Output(const char* data, size_t n) override;
+
+  private:
+    struct Ring;
+
+    Ring* GetThreadRing();
+    void Push(Ring* ring, eChLogLevel mlev, const char* data, size_t n);
+    void Drain();
+    void Run();
+
+    ChStreamOutAscii* destination;
+    std::unique_ptr<ChLogConsole> console;
+
+    unsigned long long id;
+    unsigned int capacity;
+    std::chrono::milliseconds flush_interval;
+
+    mutable std::mutex rings_mutex;  ///< protects the list of rings (locked only to add a thread)
+    std::vector<std::unique_ptr<Ring> > rings;
+
+    std::mutex flush_mutex;
+    std::condition_variable flush_cv;
+    unsigned long long flush_requested;
+    unsigned long long flush_done;
+    bool stop;
+    std::thread writer;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,228 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "chrono/core/ChFileutils.h"
+#include "chrono/core/ChModelCache.h"
+
+namespace chrono {
+
+// -----------------------------------------------------------------------------
+// ChMappedFile
+// -----------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+bool ChMappedFile::Open(const std::string& filename) {
+    Close();
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+        CloseHandle(m_file);
+        return false;
+    }
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!m_mapping) {
+        CloseHandle(m_file);
+        return false;
+    }
+    m_data = (const char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_data) {
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        return false;
+    }
+    m_size = (size_t)size.QuadPart;
+    return true;
+}
+
+void ChMappedFile::Close() {
+    if (!m_data)
+        return;
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    CloseHandle(m_file);
+    m_data = NULL;
+    m_size = 0;
+}
+
+#else
+
+bool ChMappedFile::Open(const std::string& filename) {
+    Close();
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    m_data = (const char*)data;
+    m_size = (size_t)st.st_size;
+    return true;
+}
+
+void ChMappedFile::Close() {
+    if (!m_data)
+        return;
+    munmap((void*)m_data, m_size);
+    m_data = NULL;
+    m_size = 0;
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// ChModelCache
+// -----------------------------------------------------------------------------
+
+namespace {
+
+std::mutex& DirectoryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::string& Directory() {
+    static std::string dir;
+    return dir;
+}
+
+std::atomic<bool> enabled(false);
+
+}  // end anonymous namespace
+
+void ChModelCache::SetDirectory(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(DirectoryMutex());
+    if (!dir.empty())
+        ChFileutils::MakeDirectory(dir.c_str());
+    Directory() = dir;
+    enabled = !dir.empty();
+}
+
+std::string ChModelCache::GetDirectory() {
+    std::lock_guard<std::mutex> lock(DirectoryMutex());
+    return Directory();
+}
+
+bool ChModelCache::IsEnabled() {
+    return enabled;
+}
+
+unsigned long long ChModelCache::Hash(const void* data, size_t n, unsigned long long seed) {
+    // FNV-1a on 64-bit words, with a final avalanche
+    const unsigned long long prime = 0x100000001b3ULL;
+    unsigned long long h = 0xcbf29ce484222325ULL ^ (seed * prime) ^ n;
+    const char* bytes = static_cast<const char*>(data);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long word;
+        memcpy(&word, bytes + i, 8);
+        h = (h ^ word) * prime;
+        h ^= h >> 32;
+    }
+    for (; i < n; i++)
+        h = (h ^ (unsigned char)bytes[i]) * prime;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+bool ChModelCache::GetKey(const std::string& filename,
+                          const std::string& kind,
+                          const std::string& options,
+                          std::string& key) {
+    ChMappedFile source;
+    if (!source.Open(filename))
+        return false;
+
+    std::string tag = kind + '\n' + options;
+    unsigned long long h = Hash(source.GetData(), source.GetSize(), Hash(tag.data(), tag.size()));
+
+    char text[32];
+    sprintf(text, "_%016llx.bin", h);
+    key = kind + text;
+    return true;
+}
+
+std::shared_ptr<ChMappedFile> ChModelCache::Load(const std::string& key) {
+    std::string dir = GetDirectory();
+    if (dir.empty())
+        return std::shared_ptr<ChMappedFile>();
+
+    auto image = std::make_shared<ChMappedFile>();
+    if (!image->Open(dir + "/" + key))
+        return std::shared_ptr<ChMappedFile>();
+    return image;
+}
+
+bool ChModelCache::Store(const std::string& key, const ChModelImageOut& image) {
+    std::string dir = GetDirectory();
+    if (dir.empty())
+        return false;
+
+    // Temporary file name unique to this thread (and, most likely, to this process)
+    unsigned long long id = std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+                            (unsigned long long)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    char suffix[32];
+    sprintf(suffix, ".%016llx.tmp", id);
+    std::string filename = dir + "/" + key;
+    std::string tmp_filename = filename + suffix;
+
+    FILE* fp = fopen(tmp_filename.c_str(), "wb");
+    if (!fp)
+        return false;
+    const std::vector<char>& data = image.GetData();
+    bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    ok = (fclose(fp) == 0) && ok;
+
+    if (ok) {
+        ok = std::rename(tmp_filename.c_str(), filename.c_str()) == 0;
+#ifdef _WIN32
+        // Windows does not replace existing files. If another process stored the image
+        // in the meantime, keep that one.
+        if (!ok) {
+            ChMappedFile existing;
+            ok = existing.Open(filename);
+        }
+#endif
+    }
+    if (!ok)
+        std::remove(tmp_filename.c_str());
+    return ok;
+}
+
+}  // end namespace chrono
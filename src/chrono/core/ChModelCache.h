@@ -0,0 +1,169 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHMODELCACHE_H
+#define CHMODELCACHE_H
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+
+/// Read-only memory mapping of a whole file.
+class ChApi ChMappedFile {
+  public:
+    ChMappedFile() : m_data(NULL), m_size(0) {}
+    ~ChMappedFile() { Close(); }
+
+    /// Map the given file. Returns false if the file cannot be opened or is empty.
+    bool Open(const std::string& filename);
+
+    /// Unmap the file.
+    void Close();
+
+    /// Get the content of the file (NULL if not mapped).
+    const char* GetData() const { return m_data; }
+
+    /// Get the size of the file, in bytes.
+    size_t GetSize() const { return m_size; }
+
+  private:
+    ChMappedFile(const ChMappedFile&) = delete;
+    ChMappedFile& operator=(const ChMappedFile&) = delete;
+
+    const char* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#endif
+};
+
+/// Binary image under construction, as a sequence of plain values and arrays.
+class ChModelImageOut {
+  public:
+    template <class T>
+    void Write(const T& value) {
+        WriteBytes(&value, sizeof(T));
+    }
+
+    /// Write the number of elements, then the elements of the array.
+    template <class T>
+    void WriteArray(const std::vector<T>& values) {
+        Write((unsigned long long)values.size());
+        if (!values.empty())
+            WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t n) {
+        const char* bytes = static_cast<const char*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + n);
+    }
+
+    const std::vector<char>& GetData() const { return m_data; }
+
+  private:
+    std::vector<char> m_data;
+};
+
+/// Reader of a binary image written with ChModelImageOut.
+/// All functions return false (or NULL) when reading past the end of the image.
+class ChModelImageIn {
+  public:
+    ChModelImageIn(const char* data, size_t size) : m_data(data), m_end(data + size) {}
+
+    template <class T>
+    bool Read(T& value) {
+        const char* bytes = ReadBytes(sizeof(T));
+        if (!bytes)
+            return false;
+        memcpy(reinterpret_cast<char*>(&value), bytes, sizeof(T));
+        return true;
+    }
+
+    template <class T>
+    bool ReadArray(std::vector<T>& values) {
+        unsigned long long n;
+        if (!Read(n) || n > (unsigned long long)(m_end - m_data) / sizeof(T))
+            return false;
+        values.resize((size_t)n);
+        if (n)
+            memcpy(reinterpret_cast<char*>(values.data()), ReadBytes((size_t)n * sizeof(T)), (size_t)n * sizeof(T));
+        return true;
+    }
+
+    /// Get a pointer to the next n bytes of the image, and skip them.
+    const char* ReadBytes(size_t n) {
+        if (n > (size_t)(m_end - m_data))
+            return NULL;
+        const char* bytes = m_data;
+        m_data += n;
+        return bytes;
+    }
+
+    /// Check if the whole image was read.
+    bool IsAtEnd() const { return m_data == m_end; }
+
+  private:
+    const char* m_data;
+    const char* m_end;
+};
+
+/// On-disk cache of binary images of models loaded from files (parsed meshes, convex
+/// decompositions, parsed specification files), to speed up the startup of repeated runs.
+/// Images are identified by a key built from a hash of the content of the source file,
+/// so they are invalidated automatically when the source file changes. Images are
+/// memory-mapped when loaded; stale images are simply left in the cache directory.
+///
+/// The cache is disabled by default. Usage:
+///   ChModelCache::SetDirectory("model_cache");
+///   mesh.LoadWavefrontMesh(filename);  // parsed the first time, then loaded from the cache
+class ChApi ChModelCache {
+  public:
+    /// Enable the cache, storing images in the given directory (created if it does not exist).
+    /// An empty string disables the cache.
+    static void SetDirectory(const std::string& dir);
+
+    /// Get the cache directory (empty if the cache is disabled).
+    static std::string GetDirectory();
+
+    /// Check if the cache is enabled.
+    static bool IsEnabled();
+
+    /// Get the key of the image of the given kind (e.g. "mesh"), built from the given source file
+    /// with the given options (any text affecting the result, e.g. parameters of an algorithm).
+    /// Returns false if the source file cannot be read.
+    static bool GetKey(const std::string& filename,
+                       const std::string& kind,
+                       const std::string& options,
+                       std::string& key);
+
+    /// Load the image with the given key.
+    /// Returns an empty pointer if the image is not in the cache (or it is not valid).
+    static std::shared_ptr<ChMappedFile> Load(const std::string& key);
+
+    /// Store the image with the given key. The image is written to a temporary file, then renamed,
+    /// so that processes sharing the cache never load incomplete images.
+    /// Returns false if the image cannot be written.
+    static bool Store(const std::string& key, const ChModelImageOut& image);
+
+    /// Hash of a block of bytes (64-bit, non cryptographic).
+    static unsigned long long Hash(const void* data, size_t n, unsigned long long seed = 0);
+};
+
+}  // end namespace chrono
+
+#endif
@@ -331,6 +331,9 @@ class ChApi ChStreamOutBinary : public ChStreamOut, public ChBinaryArchive {
     ChStreamOutBinary& operator<<(const char* str);
     ChStreamOutBinary& operator<<(char* str);
 
+    /// Output a raw block of 'n' bytes, as is (no byte-order conversion).
+    void BlockBinaryOutput(const char* data, size_t n) { this->Output(data, n); }
+
     /// Generic operator for binary streaming of generic objects.
     /// WARNING!!! raw byte streaming! If class 'T' contains double,
     /// int, long, etc, these may give problems when loading on another
@@ -447,6 +450,9 @@ class ChApi ChStreamInBinary : public ChStreamIn, public ChBinaryArchive {
     /// Specialized operator for C strings
     ChStreamInBinary& operator>>(char* str);
 
+    /// Input a raw block of 'n' bytes, as is (no byte-order conversion).
+    void BlockBinaryInput(char* data, size_t n) { this->Input(data, n); }
+
     /// Generic operator for raw binary streaming of generic objects
     /// WARNING!!! raw byte streaming! If class 'T' contains double,
     /// int, long, etc, these may give problems when loading on another
@@ -38,12 +38,17 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
+#include <cstring>
 #include <map>
 #include <unordered_map>
 
 #include "chrono/core/ChLinearAlgebra.h"
+#include "chrono/core/ChModelCache.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/parallel/ChOpenMP.h"
 
 namespace chrono {
 namespace geometry {
@@ -887,9 +892,382 @@ void ChTriangleMeshConnected::ComputeMassProperties(bool bodyCoords,
     }
 }
 
+// Binary image of a parsed Wavefront file, for the ChModelCache.
+// All normals and UV coordinates are stored; the ones not requested are discarded after loading.
+static void StoreMeshImage(const std::string& key, ChTriangleMeshConnected& mesh) {
+    ChModelImageOut image;
+    image.WriteArray(mesh.getCoordsVertices());
+    image.WriteArray(mesh.getCoordsNormals());
+    image.WriteArray(mesh.getCoordsUV());
+    image.WriteArray(mesh.getIndicesVertexes());
+    image.WriteArray(mesh.getIndicesNormals());
+    image.WriteArray(mesh.getIndicesUV());
+    ChModelCache::Store(key, image);
+}
+
+static bool LoadMeshImage(const std::string& key, ChTriangleMeshConnected& mesh) {
+    static_assert(sizeof(ChVector<double>) == 3 * sizeof(double), "Unexpected ChVector layout");
+    static_assert(sizeof(ChVector<int>) == 3 * sizeof(int), "Unexpected ChVector layout");
+
+    auto file = ChModelCache::Load(key);
+    if (!file)
+        return false;
+    ChModelImageIn image(file->GetData(), file->GetSize());
+    bool ok = image.ReadArray(mesh.getCoordsVertices()) && image.ReadArray(mesh.getCoordsNormals()) &&
+              image.ReadArray(mesh.getCoordsUV()) && image.ReadArray(mesh.getIndicesVertexes()) &&
+              image.ReadArray(mesh.getIndicesNormals()) && image.ReadArray(mesh.getIndicesUV()) && image.IsAtEnd();
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+// Parallel Wavefront parser.
+// The file is memory-mapped and split into line-aligned chunks, processed in two
+// passes over all chunks in parallel: the first pass counts the elements of each
+// chunk, the second pass parses them and writes them directly in the mesh arrays,
+// at the offsets of the chunk. Faces are triangulated as fans, as in OBJ::ParseLine.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct ObjCounts {
+    size_t v;     // vertexes
+    size_t vn;    // normals
+    size_t vt;    // texture coordinates
+    size_t f_v;   // vertex indexes (3 per triangle)
+    size_t f_vn;  // normal indexes
+    size_t f_vt;  // texture coordinate indexes
+};
+
+// Output arrays, and offsets of the elements of the chunk in them
+struct ObjOutput {
+    ChVector<double>* v;
+    ChVector<double>* vn;
+    ChVector<double>* vt;
+    int* f_v;
+    int* f_vn;
+    int* f_vt;
+    size_t n_f_vn;  // number of normal indexes that fit in the output array
+    size_t n_f_vt;  // number of texture coordinate indexes that fit in the output array
+};
+
+inline bool IsBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline const char* SkipBlanks(const char* p, const char* end) {
+    while (p < end && IsBlank(*p))
+        p++;
+    return p;
+}
+
+inline const char* TokenEnd(const char* p, const char* end) {
+    while (p < end && !IsBlank(*p))
+        p++;
+    return p;
+}
+
+// Parse a floating point number in [p, end), with the result of strtod.
+// Numbers with up to 19 significant digits and exponents within +/-22 take the exact fast path.
+double ParseDouble(const char* p, const char* end) {
+    static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    while (p < end && *p == '0')
+        p++;
+    for (; p < end && IsDigit(*p); p++, digits++)
+        mantissa = mantissa * 10 + (*p - '0');
+    if (p < end && *p == '.') {
+        p++;
+        if (digits == 0) {
+            for (; p < end && *p == '0'; p++)
+                exponent--;
+        }
+        for (; p < end && IsDigit(*p); p++, digits++, exponent--)
+            mantissa = mantissa * 10 + (*p - '0');
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negative_exp = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negative_exp = (*p++ == '-');
+        int e = 0;
+        for (; p < end && IsDigit(*p); p++)
+            e = std::min(e * 10 + (*p - '0'), 100000);
+        exponent += negative_exp ? -e : e;
+    }
+
+    if (p == end && digits <= 19 && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double value = (double)mantissa;
+        value = exponent < 0 ? value / pow10[-exponent] : value * pow10[exponent];
+        return negative ? -value : value;
+    }
+
+    // Slow path (long mantissas, large exponents, inf, nan, invalid numbers)
+    char buffer[128];
+    size_t n = std::min((size_t)(end - start), sizeof(buffer) - 1);
+    memcpy(buffer, start, n);
+    buffer[n] = 0;
+    return atof(buffer);
+}
+
+// Parse an integer in [p, end), stopping at the first character that is not a digit.
+inline int ParseInt(const char*& p, const char* end) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+    int value = 0;
+    for (; p < end && IsDigit(*p); p++)
+        value = value * 10 + (*p - '0');
+    return negative ? -value : value;
+}
+
+// Indexes of a face vertex "v", "v/vt", "v/vt/vn" or "v//vn".
+// The texture coordinate index is used only if not empty; the normal index is used if there are two slashes.
+struct ObjFaceVertex {
+    int v, vt, vn;
+    bool has_vt, has_vn;
+};
+
+inline ObjFaceVertex ParseFaceVertex(const char* p, const char* end) {
+    ObjFaceVertex fv;
+    fv.v = ParseInt(p, end);
+    fv.vt = 0;
+    fv.vn = 0;
+    fv.has_vt = false;
+    fv.has_vn = false;
+    if (p < end && *p == '/') {
+        p++;
+        fv.vt = ParseInt(p, end);
+        fv.has_vt = (fv.vt != 0);
+        if (p < end && *p == '/') {
+            p++;
+            fv.vn = ParseInt(p, end);
+            fv.has_vn = true;
+        }
+    }
+    return fv;
+}
+
+// Convert a 1-based (or negative, relative) index to 0-based, given the number of elements read so far.
+inline int ResolveIndex(int index, size_t count) {
+    return index < 0 ? (int)count + index : index - 1;
+}
+
+enum ObjKeyword { OBJ_OTHER, OBJ_V, OBJ_VT, OBJ_VN, OBJ_F };
+
+inline ObjKeyword GetKeyword(const char* p, const char* end) {
+    size_t n = end - p;
+    char c0 = (char)tolower(p[0]);
+    if (n == 1)
+        return c0 == 'v' ? OBJ_V : (c0 == 'f' ? OBJ_F : OBJ_OTHER);
+    if (n == 2 && c0 == 'v') {
+        char c1 = (char)tolower(p[1]);
+        return c1 == 't' ? OBJ_VT : (c1 == 'n' ? OBJ_VN : OBJ_OTHER);
+    }
+    return OBJ_OTHER;
+}
+
+// Process the lines in [begin, end). If 'out' is NULL, only count the elements.
+// 'offsets' are the numbers of elements before the chunk (used to resolve relative indexes and to write the output).
+void ProcessObjChunk(const char* begin, const char* end, const ObjCounts& offsets, ObjOutput* out, ObjCounts& counts) {
+    counts = ObjCounts{0, 0, 0, 0, 0, 0};
+    std::vector<const char*> tokens;  // begin and end of the tokens of a line
+
+    const char* line = begin;
+    while (line < end) {
+        // Find the end of the line (comments are skipped)
+        const char* line_end = line;
+        while (line_end < end && *line_end != '\n' && *line_end != '\r' && *line_end != '#')
+            line_end++;
+        const char* next = line_end;
+        while (next < end && *next != '\n' && *next != '\r')
+            next++;
+        if (next < end)
+            next++;
+
+        tokens.clear();
+        for (const char* p = SkipBlanks(line, line_end); p < line_end; p = SkipBlanks(p, line_end)) {
+            tokens.push_back(p);
+            p = TokenEnd(p, line_end);
+            tokens.push_back(p);
+        }
+        int n_args = (int)tokens.size() / 2 - 1;
+        line = next;
+        if (n_args < 1)
+            continue;
+
+        switch (GetKeyword(tokens[0], tokens[1])) {
+            case OBJ_V:
+                if (n_args >= 3) {
+                    if (out)
+                        out->v[counts.v] = ChVector<double>(ParseDouble(tokens[2], tokens[3]),
+                                                            ParseDouble(tokens[4], tokens[5]),
+                                                            ParseDouble(tokens[6], tokens[7]));
+                    counts.v++;
+                }
+                break;
+            case OBJ_VT:
+                if (n_args >= 2) {
+                    if (out)
+                        out->vt[counts.vt] =
+                            ChVector<double>(ParseDouble(tokens[2], tokens[3]), ParseDouble(tokens[4], tokens[5]), 0);
+                    counts.vt++;
+                }
+                break;
+            case OBJ_VN:
+                if (n_args >= 3) {
+                    if (out)
+                        out->vn[counts.vn] = ChVector<double>(ParseDouble(tokens[2], tokens[3]),
+                                                              ParseDouble(tokens[4], tokens[5]),
+                                                              ParseDouble(tokens[6], tokens[7]));
+                    counts.vn++;
+                }
+                break;
+            case OBJ_F:
+                if (n_args >= 3) {
+                    ObjFaceVertex fan[3];
+                    fan[0] = ParseFaceVertex(tokens[2], tokens[3]);
+                    fan[2] = ParseFaceVertex(tokens[4], tokens[5]);
+                    for (int i = 2; i < n_args; i++) {
+                        fan[1] = fan[2];
+                        fan[2] = ParseFaceVertex(tokens[2 * i + 2], tokens[2 * i + 3]);
+                        for (int k = 0; k < 3; k++) {
+                            const ObjFaceVertex& fv = fan[k];
+                            if (out)
+                                out->f_v[counts.f_v] = ResolveIndex(fv.v, offsets.v + counts.v);
+                            counts.f_v++;
+                            if (fv.has_vt) {
+                                if (out && offsets.f_vt + counts.f_vt < out->n_f_vt)
+                                    out->f_vt[counts.f_vt] = ResolveIndex(fv.vt, offsets.vt + counts.vt);
+                                counts.f_vt++;
+                            }
+                            if (fv.has_vn) {
+                                if (out && offsets.f_vn + counts.f_vn < out->n_f_vn)
+                                    out->f_vn[counts.f_vn] = ResolveIndex(fv.vn, offsets.vn + counts.vn);
+                                counts.f_vn++;
+                            }
+                        }
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+}  // end anonymous namespace
+
+void ChTriangleMeshConnected::ParseWavefrontMesh(const std::string& filename) {
+    this->m_vertices.clear();
+    this->m_normals.clear();
+    this->m_UV.clear();
+    this->m_face_v_indices.clear();
+    this->m_face_n_indices.clear();
+    this->m_face_uv_indices.clear();
+
+    ChMappedFile file;
+    if (!file.Open(filename))
+        return;
+    const char* data = file.GetData();
+    size_t size = file.GetSize();
+
+    // Split the file in chunks of whole lines
+    const size_t min_chunk_size = 1 << 18;
+    const size_t max_chunks = 8 * CHOMPfunctions::GetMaxThreads();
+    int num_chunks = (int)std::max((size_t)1, std::min(size / min_chunk_size, max_chunks));
+    std::vector<const char*> bounds(num_chunks + 1);
+    bounds[0] = data;
+    bounds[num_chunks] = data + size;
+    for (int i = 1; i < num_chunks; i++) {
+        const char* p = std::max(bounds[i - 1], data + size * i / num_chunks - 1);
+        const char* newline = static_cast<const char*>(memchr(p, '\n', data + size - p));
+        bounds[i] = newline ? newline + 1 : data + size;
+    }
+
+    // First pass: count the elements of each chunk
+    std::vector<ObjCounts> counts(num_chunks);
+    std::vector<ObjCounts> offsets(num_chunks);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < num_chunks; i++) {
+        ProcessObjChunk(bounds[i], bounds[i + 1], ObjCounts{0, 0, 0, 0, 0, 0}, NULL, counts[i]);
+    }
+
+    ObjCounts total = {0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < num_chunks; i++) {
+        offsets[i] = total;
+        total.v += counts[i].v;
+        total.vn += counts[i].vn;
+        total.vt += counts[i].vt;
+        total.f_v += counts[i].f_v;
+        total.f_vn += counts[i].f_vn;
+        total.f_vt += counts[i].f_vt;
+    }
+
+    // Indexes are grouped by three; with faces lacking some normal or texture coordinate indexes,
+    // the last ones may not fill a triangle, and are discarded.
+    m_vertices.resize(total.v);
+    m_normals.resize(total.vn);
+    m_UV.resize(total.vt);
+    m_face_v_indices.resize(total.f_v / 3);
+    m_face_n_indices.resize(total.f_vn / 3);
+    m_face_uv_indices.resize(total.f_vt / 3);
+
+    // Second pass: parse the elements of each chunk, in place in the mesh arrays
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < num_chunks; i++) {
+        const ObjCounts& offset = offsets[i];
+        ObjOutput out;
+        out.v = m_vertices.data() + offset.v;
+        out.vn = m_normals.data() + offset.vn;
+        out.vt = m_UV.data() + offset.vt;
+        out.f_v = reinterpret_cast<int*>(m_face_v_indices.data()) + offset.f_v;
+        out.f_vn = reinterpret_cast<int*>(m_face_n_indices.data()) + offset.f_vn;
+        out.f_vt = reinterpret_cast<int*>(m_face_uv_indices.data()) + offset.f_vt;
+        out.n_f_vn = 3 * m_face_n_indices.size();
+        out.n_f_vt = 3 * m_face_uv_indices.size();
+        ObjCounts chunk_counts;
+        ProcessObjChunk(bounds[i], bounds[i + 1], offset, &out, chunk_counts);
+    }
+}
+
 using namespace WAVEFRONT;
 
 void ChTriangleMeshConnected::LoadWavefrontMesh(std::string filename, bool load_normals, bool load_uv) {
+    m_filename = filename;
+
+    // Load the image of the parsed file, if in the model cache
+    // (the options identify the version of the parser, images of older versions are not used)
+    std::string key;
+    bool cached = ChModelCache::IsEnabled() && ChModelCache::GetKey(filename, "obj", "2", key);
+    if (!cached || !LoadMeshImage(key, *this)) {
+        ParseWavefrontMesh(filename);
+        if (cached)
+            StoreMeshImage(key, *this);
+    }
+
+    if (!load_normals) {
+        this->m_normals.clear();
+        this->m_face_n_indices.clear();
+    }
+    if (!load_uv) {
+        this->m_UV.clear();
+        this->m_face_uv_indices.clear();
+    }
+}
+
+void ChTriangleMeshConnected::LoadWavefrontMeshSequential(std::string filename, bool load_normals, bool load_uv) {
     this->m_vertices.clear();
     this->m_normals.clear();
     this->m_UV.clear();
@@ -1346,7 +1724,8 @@ bool ChTriangleMeshConnected::SplitEdge (
         std::vector<std::vector<double>*>& aux_data_double, ///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<int>*>& aux_data_int,       ///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<bool>*>& aux_data_bool,      ///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
-        std::vector<std::vector<ChVector<>>*>& aux_data_vect///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::vector<ChVector<>>*>& aux_data_vect,///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::pair<int, int>>* split_edges ///< if not null, the two vertexes of the split edge are appended to it
         ) {
     
     std::array<std::vector<ChVector<int>>*, 4> face_indexes;
@@ -1478,6 +1857,9 @@ bool ChTriangleMeshConnected::SplitEdge (
 
     } // end loop on buffers
 
+    if (split_edges)
+        split_edges->push_back(std::make_pair(iea, ieb));
+
     // just in case the user populated the vector of external auxiliary data buffers,
     // interpolate and store the created value. Assume those have same size of m_vertices
     for (auto data_buffer : aux_data_double) {
@@ -1513,7 +1895,8 @@ void ChTriangleMeshConnected::RefineMeshEdges(
         std::vector<std::vector<double>*>& aux_data_double, ///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<int>*>& aux_data_int,       ///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<bool>*>& aux_data_bool,      ///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
-        std::vector<std::vector<ChVector<>>*>& aux_data_vect///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::vector<ChVector<>>*>& aux_data_vect,///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::pair<int, int>>* split_edges ///< if not null, the two vertexes of the edge split by each new vertex are appended to it, in order of creation
         ) {
 
     // initialize the list of triangles to refine, copying from marked triangles:
@@ -1587,7 +1970,7 @@ void ChTriangleMeshConnected::RefineMeshEdges(
                     SplitEdge(t_N, -1, edge_N, 0, 
                         itA_1, itA_2, itB_1, itB_2,
                         tri_map,
-                        aux_data_double, aux_data_int, aux_data_bool, aux_data_vect);
+                        aux_data_double, aux_data_int, aux_data_bool, aux_data_vect, split_edges);
 
                     // prepare list of original triangles after split, for the next iteration of bisection
                     if (t_N  < marked_tris_flagged.size() && marked_tris_flagged[t_N] == true) {
@@ -1628,7 +2011,7 @@ void ChTriangleMeshConnected::RefineMeshEdges(
                         SplitEdge(t_N, t_N1, edge_N, edge_N1, 
                             itA_1, itA_2, itB_1, itB_2,
                             tri_map,
-                            aux_data_double, aux_data_int, aux_data_bool, aux_data_vect);
+                            aux_data_double, aux_data_int, aux_data_bool, aux_data_vect, split_edges);
 
                         // prepare list of original triangles after split, for the next iteration of bisection
                         if (t_N  < marked_tris_flagged.size() && marked_tris_flagged[t_N] == true) {
@@ -63,9 +63,15 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
     std::vector<ChVector<int>>& getIndicesUV() { return m_face_uv_indices; }
     std::vector<ChVector<int>>& getIndicesColors() { return m_face_col_indices; }
 
-    // Load a triangle mesh saved as a Wavefront .obj file
+    // Load a triangle mesh saved as a Wavefront .obj file.
+    // The file is parsed in parallel (with OpenMP), with coordinates in double precision.
+    // If the ChModelCache is enabled, the parsed file is cached (and loaded from the cache, if the file did not change).
     void LoadWavefrontMesh(std::string filename, bool load_normals = true, bool load_uv = false);
 
+    // Load a triangle mesh saved as a Wavefront .obj file, with the original sequential parser
+    // (coordinates are read in single precision). Slower than LoadWavefrontMesh, and never cached.
+    void LoadWavefrontMeshSequential(std::string filename, bool load_normals = true, bool load_uv = false);
+
     /// Add a triangle to this triangle mesh, by specifying the three coordinates.
     /// This is disconnected - no vertex sharing is used even if it could be..
     virtual void addTriangle(const ChVector<>& vertex0, const ChVector<>& vertex1, const ChVector<>& vertex2) override {
@@ -173,7 +179,8 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
         std::vector<std::vector<double>*>& aux_data_double, ///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<int>*>& aux_data_int,       ///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<bool>*>& aux_data_bool,      ///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
-        std::vector<std::vector<ChVector<>>*>& aux_data_vect///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::vector<ChVector<>>*>& aux_data_vect,///< auxiliary buffers to interpolate (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::pair<int, int>>* split_edges = 0 ///< if not null, the two vertexes of the split edge are appended to it
         );
 
     /// Class to be used optionally in RefineMeshEdges()
@@ -202,7 +209,8 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
         std::vector<std::vector<double>*>& aux_data_double, ///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<int>*>& aux_data_int,       ///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
         std::vector<std::vector<bool>*>& aux_data_bool,      ///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
-        std::vector<std::vector<ChVector<>>*>& aux_data_vect///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::vector<ChVector<>>*>& aux_data_vect,///< auxiliary buffers to refine (assuming indexed as vertexes: each with same size as vertex buffer)
+        std::vector<std::pair<int, int>>* split_edges = 0 ///< if not null, the two vertexes of the edge split by each new vertex are appended to it, in order of creation
         );
 
 
@@ -242,6 +250,9 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
         marchive >> CHNVP(m_face_col_indices);
         marchive >> CHNVP(m_filename);
     }
+
+  private:
+    void ParseWavefrontMesh(const std::string& filename);
 };
 
 }  // end namespace geometry
@@ -19,6 +19,19 @@ namespace chrono {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 //CH_FACTORY_REGISTER(ChContactContainerBase) // NO, abstract class!
 
+void ChContactArrays::Resize(size_t num_contacts) {
+    objA.resize(num_contacts);
+    objB.resize(num_contacts);
+    idA.resize(num_contacts);
+    idB.resize(num_contacts);
+    pointA.resize(num_contacts);
+    pointB.resize(num_contacts);
+    normal.resize(num_contacts);
+    distance.resize(num_contacts);
+    force.resize(num_contacts);
+    torque.resize(num_contacts);
+}
+
 ChContactContainerBase::ChContactContainerBase(const ChContactContainerBase& other) : ChPhysicsItem(other) {
     add_contact_callback = other.add_contact_callback;
     report_contact_callback = other.report_contact_callback;
@@ -40,6 +53,48 @@ ChVector<> ChContactContainerBase::GetContactableTorque(ChContactable* contactab
     return ChVector<>(0);
 }
 
+// Callback collecting the contacts reported by ReportAllContacts() into a ChContactArrays.
+class _ContactArraysCollector : public ChReportContactCallback {
+  public:
+    _ContactArraysCollector(ChContactArrays& data) : m_data(data), m_num(0) {}
+
+    virtual bool ReportContactCallback(const ChVector<>& pA,
+                                       const ChVector<>& pB,
+                                       const ChMatrix33<>& plane_coord,
+                                       const double& distance,
+                                       const ChVector<>& react_forces,
+                                       const ChVector<>& react_torques,
+                                       ChContactable* contactobjA,
+                                       ChContactable* contactobjB) override {
+        if (m_num == m_data.GetNumContacts())
+            m_data.Resize(2 * m_num + 16);
+        ChPhysicsItem* itemA = contactobjA ? contactobjA->GetPhysicsItem() : NULL;
+        ChPhysicsItem* itemB = contactobjB ? contactobjB->GetPhysicsItem() : NULL;
+        m_data.objA[m_num] = contactobjA;
+        m_data.objB[m_num] = contactobjB;
+        m_data.idA[m_num] = itemA ? itemA->GetIdentifier() : -1;
+        m_data.idB[m_num] = itemB ? itemB->GetIdentifier() : -1;
+        m_data.pointA[m_num] = pA;
+        m_data.pointB[m_num] = pB;
+        m_data.normal[m_num] = plane_coord.Get_A_Xaxis();
+        m_data.distance[m_num] = distance;
+        m_data.force[m_num] = plane_coord * react_forces;
+        m_data.torque[m_num] = plane_coord * react_torques;
+        m_num++;
+        return true;
+    }
+
+    ChContactArrays& m_data;
+    size_t m_num;
+};
+
+void ChContactContainerBase::GetContactData(ChContactArrays& data) {
+    data.Resize(GetNcontacts());
+    _ContactArraysCollector collector(data);
+    ReportAllContacts(&collector);
+    data.Resize(collector.m_num);
+}
+
 void ChContactContainerBase::ArchiveOUT(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChContactContainerBase>();
@@ -17,6 +17,7 @@
 
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "chrono/collision/ChCCollisionInfo.h"
 #include "chrono/physics/ChBody.h"
@@ -67,6 +68,29 @@ class ChApi ChReportContactCallback {
         ) = 0;
 };
 
+/// Data of all contacts in a container, stored as a structure of arrays (one entry per contact).
+/// Filled by ChContactContainerBase::GetContactData(). All vectors are expressed in the absolute frame.
+/// The same object can be reused at each query: the arrays are resized, and their memory reused.
+class ChApi ChContactArrays {
+  public:
+    /// Resize all arrays to the given number of contacts.
+    void Resize(size_t num_contacts);
+
+    /// Get the number of contacts stored in the arrays.
+    size_t GetNumContacts() const { return distance.size(); }
+
+    std::vector<ChContactable*> objA;  ///< model A (note: some containers may not support it and could be zero!)
+    std::vector<ChContactable*> objB;  ///< model B (note: some containers may not support it and could be zero!)
+    std::vector<int> idA;              ///< identifier of the physics item of model A (-1 if not available)
+    std::vector<int> idB;              ///< identifier of the physics item of model B (-1 if not available)
+    std::vector<ChVector<> > pointA;   ///< contact point on model A
+    std::vector<ChVector<> > pointB;   ///< contact point on model B
+    std::vector<ChVector<> > normal;   ///< contact normal, from A to B
+    std::vector<double> distance;      ///< contact distance (negative if penetrating)
+    std::vector<ChVector<> > force;    ///< contact force applied to B (-force is applied to A), if computed
+    std::vector<ChVector<> > torque;   ///< rolling/spinning torque applied to B, if computed
+};
+
 /// Class representing a container of many contacts.
 /// There might be implementations of this interface in form of plain CPU linked lists of contact objects,
 /// or highly optimized GPU buffers, etc. This is only the basic interface with the features that are in common.
@@ -121,6 +145,12 @@ class ChApi ChContactContainerBase : public ChPhysicsItem {
     /// Child classes of ChContactContainerBase should try to implement this.
     virtual void ReportAllContacts(ChReportContactCallback* mcallback) {}
 
+    /// Fill the given arrays with the data of all contacts, in a single call.
+    /// This is a faster alternative to ReportAllContacts() for output of large numbers of contacts:
+    /// no virtual call is made per contact and, in child classes, the arrays are filled in parallel.
+    /// The default implementation collects the contacts through ReportAllContacts().
+    virtual void GetContactData(ChContactArrays& data);
+
     /// Compute contact forces on all contactable objects in this container.
     /// If implemented by a derived class, these forces must be stored in the hash table
     /// contact_forces (with key a pointer to ChContactable and value a ForceTorque structure).
@@ -139,6 +169,33 @@ class ChApi ChContactContainerBase : public ChPhysicsItem {
     virtual void ArchiveIN(ChArchiveIn& marchive);
 
   protected:
+    /// Copy the data of the contacts in the given list into the arrays, starting at the given position
+    /// (advanced past the copied contacts). The arrays must be already resized.
+    template <class Tcont>
+    void FillContactData(std::list<Tcont*>& contactlist, ChContactArrays& data, size_t& start) {
+        std::vector<Tcont*> contacts(contactlist.begin(), contactlist.end());
+        int num_contacts = (int)contacts.size();
+#pragma omp parallel for
+        for (int i = 0; i < num_contacts; i++) {
+            Tcont* contact = contacts[i];
+            size_t k = start + i;
+            const ChMatrix33<>& plane = contact->GetContactPlane();
+            data.objA[k] = contact->GetObjA();
+            data.objB[k] = contact->GetObjB();
+            ChPhysicsItem* itemA = data.objA[k]->GetPhysicsItem();
+            ChPhysicsItem* itemB = data.objB[k]->GetPhysicsItem();
+            data.idA[k] = itemA ? itemA->GetIdentifier() : -1;
+            data.idB[k] = itemB ? itemB->GetIdentifier() : -1;
+            data.pointA[k] = contact->GetContactP1();
+            data.pointB[k] = contact->GetContactP2();
+            data.normal[k] = plane.Get_A_Xaxis();
+            data.distance[k] = contact->GetContactDistance();
+            data.force[k] = plane * contact->GetContactForce();
+            data.torque[k] = VNULL;
+        }
+        start += num_contacts;
+    }
+
     struct ForceTorque {
         ChVector<> force;
         ChVector<> torque;
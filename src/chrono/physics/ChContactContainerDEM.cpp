@@ -347,6 +347,23 @@ void ChContactContainerDEM::ReportAllContacts(ChReportContactCallback* mcallback
     //***TODO*** rolling cont.
 }
 
+void ChContactContainerDEM::GetContactData(ChContactArrays& data) {
+    data.Resize(contactlist_3_3.size() + contactlist_6_3.size() + contactlist_6_6.size() + contactlist_333_3.size() +
+                contactlist_333_6.size() + contactlist_333_333.size() + contactlist_666_3.size() +
+                contactlist_666_6.size() + contactlist_666_333.size() + contactlist_666_666.size());
+    size_t start = 0;
+    FillContactData(contactlist_3_3, data, start);
+    FillContactData(contactlist_6_3, data, start);
+    FillContactData(contactlist_6_6, data, start);
+    FillContactData(contactlist_333_3, data, start);
+    FillContactData(contactlist_333_6, data, start);
+    FillContactData(contactlist_333_333, data, start);
+    FillContactData(contactlist_666_3, data, start);
+    FillContactData(contactlist_666_6, data, start);
+    FillContactData(contactlist_666_333, data, start);
+    FillContactData(contactlist_666_666, data, start);
+}
+
 ////////// STATE INTERFACE ////
 
 template <class Tcont>
@@ -115,6 +115,9 @@ class ChApi ChContactContainerDEM : public ChContactContainerBase {
     /// function of the user object inherited from ChReportContactCallback.
     virtual void ReportAllContacts(ChReportContactCallback* mcallback) override;
 
+    /// Fill the given arrays with the data of all contacts, in parallel.
+    virtual void GetContactData(ChContactArrays& data) override;
+
     /// In detail, it computes jacobians, violations, etc. and stores
     /// results in inner structures of contacts.
     virtual void Update(double mtime, bool update_assets = true) override;
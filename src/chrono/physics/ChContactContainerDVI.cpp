@@ -229,6 +229,21 @@ void ChContactContainerDVI::ReportAllContacts(ChReportContactCallback* mcallback
     _ReportAllContactsRolling(contactlist_6_6_rolling, mcallback);
 }
 
+void ChContactContainerDVI::GetContactData(ChContactArrays& data) {
+    data.Resize(contactlist_6_6.size() + contactlist_6_3.size() + contactlist_3_3.size() +
+                contactlist_6_6_rolling.size());
+    size_t start = 0;
+    FillContactData(contactlist_6_6, data, start);
+    FillContactData(contactlist_6_3, data, start);
+    FillContactData(contactlist_3_3, data, start);
+
+    size_t start_rolling = start;
+    FillContactData(contactlist_6_6_rolling, data, start);
+    for (auto contact : contactlist_6_6_rolling) {
+        data.torque[start_rolling++] = contact->GetContactPlane() * contact->GetContactTorque();
+    }
+}
+
 ////////// STATE INTERFACE ////
 
 template <class Tcont>
@@ -91,6 +91,9 @@ class ChApi ChContactContainerDVI : public ChContactContainerBase {
     /// function of the user object inherited from ChReportContactCallback.
     virtual void ReportAllContacts(ChReportContactCallback* mcallback) override;
 
+    /// Fill the given arrays with the data of all contacts, in parallel.
+    virtual void GetContactData(ChContactArrays& data) override;
+
     /// Tell the number of scalar bilateral constraints (actually, friction
     /// constraints aren't exactly as unilaterals, but count them too)
     virtual int GetDOC_d() override {
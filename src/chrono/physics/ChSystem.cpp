@@ -1585,6 +1585,12 @@ bool ChSystem::Integrate_Y() {
     // Compute contacts and create contact constraints
     ComputeCollisions();
 
+    // Smooth (DEM) contact forces are evaluated when the contacts are created, so
+    // gather them now; physics items that load forces during the step then see the
+    // contact forces at the current configuration.
+    if (GetContactMethod() == ChMaterialSurfaceBase::DEM)
+        contact_container->ComputeContactForces();
+
     // Counts dofs, statistics, etc. (not needed because already in Advance()...? )
     Setup();
 
@@ -1617,8 +1623,10 @@ bool ChSystem::Integrate_Y() {
     // tell them to record their variables (ususally x-y couples)
     RecordAllProbes();
 
-    // Call method to gather contact forces/torques in rigid bodies
-    contact_container->ComputeContactForces();
+    // Call method to gather contact forces/torques in rigid bodies (the DEM contact
+    // forces were already gathered after collision detection and have not changed)
+    if (GetContactMethod() != ChMaterialSurfaceBase::DEM)
+        contact_container->ComputeContactForces();
 
     // Time elapsed for step..
     timer_step.stop();
@@ -15,6 +15,7 @@
 #ifndef CHSYSTEM_H
 #define CHSYSTEM_H
 
+#include <algorithm>
 #include <cfloat>
 #include <memory.h>
 #include <cstdlib>
@@ -591,6 +592,14 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
         collision_callbacks.push_back(mcallb);
     }
 
+    /// Remove a callback previously set with SetCustomComputeCollisionCallback().
+    /// The callback object is not deleted; this must be called before deleting it
+    /// while this system is still in use.
+    void UnregisterCustomCollisionCallback(ChCustomComputeCollisionCallback* mcallb) {
+        collision_callbacks.erase(std::remove(collision_callbacks.begin(), collision_callbacks.end(), mcallb),
+                                  collision_callbacks.end());
+    }
+
     /// Class to be inherited by user and to use in SetCustomCollisionPointCallback()
     class ChApi ChCustomCollisionPointCallback {
       public:
@@ -717,6 +717,13 @@ class  ChArchiveOut : public ChArchive {
       virtual void out_array_between (size_t msize, const char* classname) = 0;
       virtual void out_array_end (size_t msize,const char* classname) = 0;
 
+        // for bulk output of the elements of an array of doubles, between out_array_pre()
+        // and out_array_end(); return false if not supported, in which case the elements
+        // are serialized one by one
+      virtual bool out_array_data (const double* data, size_t msize) { return false; }
+      template<class T>
+      bool out_array_data (const T* data, size_t msize) { return false; }
+
 
       //---------------------------------------------------
 
@@ -756,6 +763,21 @@ class  ChArchiveOut : public ChArchive {
               this->out_array_between(bVal.value().size(), typeid(bVal.value()).name());
           }
           this->out_array_end(bVal.value().size(), typeid(bVal.value()).name());
+      }
+        // trick to wrap stl::vector container of doubles, with bulk output if supported
+      void out     (ChNameValue< std::vector<double> > bVal) {
+          this->out_array_pre(bVal.name(), bVal.value().size(), typeid(double).name());
+          if (!this->out_array_data(bVal.value().data(), bVal.value().size())) {
+              for (size_t i = 0; i<bVal.value().size(); ++i)
+              {
+                  char buffer[20];
+                  sprintf(buffer, "el_%lu", (unsigned long)i);
+                  ChNameValue< double > array_val(buffer, bVal.value()[i]);
+                  this->out (array_val);
+                  this->out_array_between(bVal.value().size(), typeid(bVal.value()).name());
+              }
+          }
+          this->out_array_end(bVal.value().size(), typeid(bVal.value()).name());
       }
         // trick to wrap stl::list container
       template<class T>
@@ -1035,6 +1057,13 @@ class  ChArchiveIn : public ChArchive {
       virtual void in_array_between (const char* name) = 0;
       virtual void in_array_end (const char* name) = 0;
 
+        // for bulk input of the elements of an array of doubles, between in_array_pre()
+        // and in_array_end(); return false if not supported, in which case the elements
+        // are deserialized one by one
+      virtual bool in_array_data (double* data, size_t msize) { return false; }
+      template<class T>
+      bool in_array_data (T* data, size_t msize) { return false; }
+
       //---------------------------------------------------
 
            // trick to wrap enum mappers:
@@ -1081,6 +1110,26 @@ class  ChArchiveIn : public ChArchive {
               this->in_array_between(bVal.name());
           }
           this->in_array_end(bVal.name());
+      }
+             // trick to wrap stl::vector container of doubles, with bulk input if supported
+      void in     (ChNameValue< std::vector<double> > bVal) {
+          bVal.value().clear();
+          size_t arraysize;
+          this->in_array_pre(bVal.name(), arraysize);
+          bVal.value().resize(arraysize);
+          if (!this->in_array_data(bVal.value().data(), arraysize)) {
+              for (size_t i = 0; i<arraysize; ++i)
+              {
+                  char idname[20];
+                  sprintf(idname, "el_%lu", (unsigned long)i);
+                  double element;
+                  ChNameValue< double > array_val(idname, element);
+                  this->in (array_val);
+                  bVal.value()[i]=element;
+                  this->in_array_between(bVal.name());
+              }
+          }
+          this->in_array_end(bVal.name());
       }
              // trick to wrap stl::list container
       template<class T>
@@ -0,0 +1,431 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2013 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#ifndef CHARCHIVEBINARYCOMPACT_H
+#define CHARCHIVEBINARYCOMPACT_H
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chrono/serialization/ChArchive.h"
+#include "chrono/core/ChLog.h"
+
+namespace chrono {
+
+///
+/// This is a class for serializing to compact binary archives.
+/// Compared to ChArchiveOutBinary:
+///  - integers, sizes, enums and object IDs are written as variable-length integers;
+///  - class names of polymorphic objects are written only once, then referenced by index;
+///  - arrays of doubles (std::vector<double>, ChMatrix data) are written in bulk;
+///  - all output is buffered and passed to the stream in blocks, each preceded by its
+///    length (variable-length integer), so that the reader can also load whole blocks.
+/// Multi-byte values are stored in little-endian order. Archives written with this
+/// class can only be read with ChArchiveInBinaryCompact.
+///
+
+class  ChArchiveOutBinaryCompact : public ChArchiveOut {
+  public:
+
+      /// Create the archive on the given stream. Optionally, give an estimate of the
+      /// number of tracked objects, to size the pointer tables in advance.
+      ChArchiveOutBinaryCompact( ChStreamOutBinary& mostream, size_t expected_objects = 0) {
+          ostream = &mostream;
+          big_endian = mostream.IsBigEndianMachine();
+          if (expected_objects)
+              internal_ptr_id.reserve(expected_objects);
+          buffer.reserve(buffer_size);
+      };
+
+      virtual ~ChArchiveOutBinaryCompact() {
+          Flush();
+      };
+
+      /// Pass all buffered data to the stream, as one block. This is done automatically
+      /// when the archive is destroyed.
+      void Flush() {
+          if (!buffer.empty())
+              put_block(buffer.data(), buffer.size());
+          buffer.clear();
+      }
+
+      virtual void out     (ChNameValue<bool> bVal) {
+            put_byte(bVal.value() ? 1 : 0);
+      }
+      virtual void out     (ChNameValue<int> bVal) {
+            put_varint(zigzag(bVal.value()));
+      }
+      virtual void out     (ChNameValue<double> bVal) {
+            put_raw(bVal.value());
+      }
+      virtual void out     (ChNameValue<float> bVal){
+            put_raw(bVal.value());
+      }
+      virtual void out     (ChNameValue<char> bVal){
+            put_byte(bVal.value());
+      }
+      virtual void out     (ChNameValue<unsigned int> bVal){
+            put_varint(bVal.value());
+      }
+      virtual void out     (ChNameValue<const char*> bVal){
+            put_string(bVal.value(), strlen(bVal.value()));
+      }
+      virtual void out     (ChNameValue<std::string> bVal){
+            put_string(bVal.value().c_str(), bVal.value().size());
+      }
+      virtual void out     (ChNameValue<unsigned long> bVal){
+            put_varint(bVal.value());
+      }
+      virtual void out     (ChNameValue<unsigned long long> bVal){
+            put_varint(bVal.value());
+      }
+      virtual void out     (ChNameValue<ChEnumMapperBase> bVal) {
+            put_varint(zigzag(bVal.value().GetValueAsInt()));
+      }
+
+      virtual void out_array_pre (const char* name, size_t msize, const char* classname) {
+            put_varint(msize);
+      }
+      virtual void out_array_between (size_t msize, const char* classname) {}
+      virtual void out_array_end (size_t msize,const char* classname) {}
+
+      virtual bool out_array_data (const double* data, size_t msize) {
+            if (big_endian) {
+                for (size_t i = 0; i < msize; ++i)
+                    put_raw(data[i]);
+            } else {
+                put_bytes(reinterpret_cast<const char*>(data), msize * sizeof(double));
+            }
+            return true;
+      }
+
+        // for custom c++ objects:
+      virtual void out     (ChNameValue<ChFunctorArchiveOut> bVal, const char* classname, bool tracked, size_t obj_ID) {
+          bVal.value().CallArchiveOut(*this);
+      }
+
+        // References are written as a tag followed by the reference data:
+        //   tag 0: object already stored (or null pointer), followed by its object ID
+        //   tag 1: external object, followed by its external ID
+        //   tag 2: new object of a class not seen before, followed by the class name
+        //   tag 3+k: new object of the k-th class name seen in this archive
+      virtual void out_ref          (ChNameValue<ChFunctorArchiveOut> bVal, bool already_inserted, size_t obj_ID, size_t ext_ID, const char* classname)
+      {
+          if (!already_inserted) {
+            // New object, we have to fully serialize it
+            auto cls = class_ids.find(classname);
+            if (cls == class_ids.end()) {
+                put_varint(2);
+                put_string(classname, strlen(classname));
+                size_t index = class_ids.size();
+                class_ids[classname] = index;
+            } else {
+                put_varint(3 + cls->second);
+            }
+            bVal.value().CallArchiveOutConstructor(*this);
+            bVal.value().CallArchiveOut(*this);
+          } else {
+              if (obj_ID || bVal.value().IsNull() ) {
+                // Object already in list. Only store obj_ID as ID
+                put_varint(0);
+                put_varint(obj_ID);
+              }
+              if (ext_ID) {
+                // Object is external. Only store ref_ID as ID
+                put_varint(1);
+                put_varint(ext_ID);
+              }
+          }
+      }
+
+  protected:
+      static const size_t buffer_size = 1 << 16;
+
+      static unsigned long long zigzag(long long val) {
+          return ((unsigned long long)val << 1) ^ (unsigned long long)(val >> 63);
+      }
+
+      // Write a block (length, then data) to the stream
+      void put_block(const char* data, size_t n) {
+          char tmp[10];
+          size_t len = 0;
+          unsigned long long val = n;
+          while (val >= 0x80) {
+              tmp[len++] = (char)(val | 0x80);
+              val >>= 7;
+          }
+          tmp[len++] = (char)val;
+          ostream->BlockBinaryOutput(tmp, len);
+          ostream->BlockBinaryOutput(data, n);
+      }
+      void put_bytes(const char* data, size_t n) {
+          if (buffer.size() + n > buffer_size) {
+              Flush();
+              if (n > buffer_size) {
+                  // large arrays are written as their own block, without copying
+                  put_block(data, n);
+                  return;
+              }
+          }
+          buffer.insert(buffer.end(), data, data + n);
+      }
+      void put_byte(char c) {
+          if (buffer.size() >= buffer_size)
+              Flush();
+          buffer.push_back(c);
+      }
+      void put_varint(unsigned long long val) {
+          char tmp[10];
+          size_t n = 0;
+          while (val >= 0x80) {
+              tmp[n++] = (char)(val | 0x80);
+              val >>= 7;
+          }
+          tmp[n++] = (char)val;
+          put_bytes(tmp, n);
+      }
+      template <class T>
+      void put_raw(T val) {
+          if (big_endian)
+              StreamSwapBytes<T>(&val);
+          put_bytes(reinterpret_cast<const char*>(&val), sizeof(T));
+      }
+      void put_string(const char* str, size_t n) {
+          put_varint(n);
+          put_bytes(str, n);
+      }
+
+      ChStreamOutBinary* ostream;
+      bool big_endian;
+      std::vector<char> buffer;
+      std::unordered_map<std::string, size_t> class_ids;
+};
+
+
+
+
+
+///
+/// This is a class for for deserializing from compact binary archives,
+/// written with ChArchiveOutBinaryCompact.
+///
+
+class  ChArchiveInBinaryCompact : public ChArchiveIn {
+  public:
+
+      ChArchiveInBinaryCompact( ChStreamInBinary& mistream) {
+          istream = &mistream;
+          big_endian = mistream.IsBigEndianMachine();
+          pos = 0;
+      };
+
+      virtual ~ChArchiveInBinaryCompact() {};
+
+      virtual void in     (ChNameValue<bool> bVal) {
+            bVal.value() = (get_byte() != 0);
+      }
+      virtual void in     (ChNameValue<int> bVal) {
+            bVal.value() = (int)unzigzag(get_varint());
+      }
+      virtual void in     (ChNameValue<double> bVal) {
+            get_raw(bVal.value());
+      }
+      virtual void in     (ChNameValue<float> bVal){
+            get_raw(bVal.value());
+      }
+      virtual void in     (ChNameValue<char> bVal){
+            bVal.value() = get_byte();
+      }
+      virtual void in     (ChNameValue<unsigned int> bVal){
+            bVal.value() = (unsigned int)get_varint();
+      }
+      virtual void in     (ChNameValue<std::string> bVal){
+            get_string(bVal.value());
+      }
+      virtual void in     (ChNameValue<unsigned long> bVal){
+            bVal.value() = (unsigned long)get_varint();
+      }
+      virtual void in     (ChNameValue<unsigned long long> bVal){
+            bVal.value() = get_varint();
+      }
+      virtual void in     (ChNameValue<ChEnumMapperBase> bVal) {
+            bVal.value().SetValueAsInt((int)unzigzag(get_varint()));
+      }
+         // for wrapping arrays and lists
+      virtual void in_array_pre (const char* name, size_t& msize) {
+            msize = (size_t)get_varint();
+      }
+      virtual void in_array_between (const char* name) {}
+      virtual void in_array_end (const char* name) {}
+
+      virtual bool in_array_data (double* data, size_t msize) {
+            get_bytes(reinterpret_cast<char*>(data), msize * sizeof(double));
+            if (big_endian) {
+                for (size_t i = 0; i < msize; ++i)
+                    StreamSwapBytes<double>(&data[i]);
+            }
+            return true;
+      }
+
+        //  for custom c++ objects:
+      virtual void in     (ChNameValue<ChFunctorArchiveIn> bVal) {
+          if (bVal.flags() & NVP_TRACK_OBJECT){
+              bool already_stored; size_t obj_ID;
+              PutPointer(bVal.value().GetRawPtr(), already_stored, obj_ID);
+          }
+          bVal.value().CallArchiveIn(*this);
+      }
+
+      virtual void* in_ref          (ChNameValue<ChFunctorArchiveIn> bVal)
+      {
+          void* new_ptr = nullptr;
+
+          unsigned long long tag = get_varint();
+
+          if (tag == 0) {
+            //  Was a shared object: just get the pointer to already-retrieved
+            size_t obj_ID = (size_t)get_varint();
+
+            if (this->internal_id_ptr.find(obj_ID) == this->internal_id_ptr.end())
+                    throw (ChExceptionArchive( "In object '" + std::string(bVal.name()) +"' the reference ID " + std::to_string((int)obj_ID) +" is not a valid number." ));
+
+            bVal.value().SetRawPtr(internal_id_ptr[obj_ID]);
+          }
+          else if (tag == 1) {
+            // Was an external object: just get the pointer to external
+            size_t ext_ID = (size_t)get_varint();
+
+            if (this->external_id_ptr.find(ext_ID) == this->external_id_ptr.end())
+                    throw (ChExceptionArchive( "In object '" + std::string(bVal.name()) +"' the external reference ID " + std::to_string((int)ext_ID) +" cannot be rebuilt." ));
+
+            bVal.value().SetRawPtr(external_id_ptr[ext_ID]);
+          }
+          else {
+            if (tag == 2) {
+                class_names.push_back(std::string());
+                get_string(class_names.back());
+            } else if (tag - 3 >= class_names.size()) {
+                throw (ChExceptionArchive( "In object '" + std::string(bVal.name()) +"' the class index " + std::to_string((int)(tag - 3)) +" is not valid." ));
+            }
+            const std::string& cls_name = (tag == 2) ? class_names.back() : class_names[(size_t)(tag - 3)];
+
+            // Dynamically create (no class factory will be invoked for non-polimorphic obj):
+            // call new(), or deserialize constructor params+call new():
+            bVal.value().CallArchiveInConstructor(*this, cls_name.c_str());
+
+            if (bVal.value().GetRawPtr()) {
+                bool already_stored; size_t obj_ID;
+                PutPointer(bVal.value().GetRawPtr(), already_stored, obj_ID);
+                // 3) Deserialize
+                bVal.value().CallArchiveIn(*this);
+            } else {
+                throw(ChExceptionArchive("Archive cannot create object" + cls_name + "\n"));
+            }
+            new_ptr = bVal.value().GetRawPtr();
+          }
+
+          return new_ptr;
+      }
+
+  protected:
+      static long long unzigzag(unsigned long long val) {
+          return (long long)(val >> 1) ^ -(long long)(val & 1);
+      }
+
+      // Read the length of the next block from the stream (only the block data is buffered)
+      size_t get_block_length() {
+          unsigned long long val = 0;
+          int shift = 0;
+          char c;
+          do {
+              istream->BlockBinaryInput(&c, 1);
+              val |= (unsigned long long)(c & 0x7f) << shift;
+              shift += 7;
+          } while ((c & 0x80) && shift < 64);
+          return (size_t)val;
+      }
+      void get_bytes(char* data, size_t n) {
+          while (n) {
+              if (pos == buffer.size()) {
+                  size_t len = get_block_length();
+                  if (len <= n) {
+                      // the whole block is requested: read it in place
+                      istream->BlockBinaryInput(data, len);
+                      data += len;
+                      n -= len;
+                      continue;
+                  }
+                  buffer.resize(len);
+                  istream->BlockBinaryInput(buffer.data(), len);
+                  pos = 0;
+              }
+              size_t k = std::min(n, buffer.size() - pos);
+              std::memcpy(data, buffer.data() + pos, k);
+              pos += k;
+              data += k;
+              n -= k;
+          }
+      }
+      char get_byte() {
+          if (pos < buffer.size())
+              return buffer[pos++];
+          char c;
+          get_bytes(&c, 1);
+          return c;
+      }
+      unsigned long long get_varint() {
+          unsigned long long val = 0;
+          int shift = 0;
+          char c;
+          if (buffer.size() - pos >= 10) {
+              // fast path: the longest varint is in the buffer
+              const char* p = buffer.data() + pos;
+              do {
+                  c = *p++;
+                  val |= (unsigned long long)(c & 0x7f) << shift;
+                  shift += 7;
+              } while ((c & 0x80) && shift < 64);
+              pos = p - buffer.data();
+              return val;
+          }
+          do {
+              c = get_byte();
+              val |= (unsigned long long)(c & 0x7f) << shift;
+              shift += 7;
+          } while ((c & 0x80) && shift < 64);
+          return val;
+      }
+      template <class T>
+      void get_raw(T& val) {
+          get_bytes(reinterpret_cast<char*>(&val), sizeof(T));
+          if (big_endian)
+              StreamSwapBytes<T>(&val);
+      }
+      void get_string(std::string& str) {
+          size_t n = (size_t)get_varint();
+          str.resize(n);
+          if (n)
+              get_bytes(&str[0], n);
+      }
+
+      ChStreamInBinary* istream;
+      bool big_endian;
+      std::vector<char> buffer;  ///< current block
+      size_t pos;                ///< read position in the current block
+      std::vector<std::string> class_names;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,446 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Asynchronous binary output of body states.
+//
+// File layout (native byte order):
+//   - file header (magic, version, field flags)
+//   - one chunk per frame:
+//       chunk header (magic, number of columns, frame index, time, number of bodies)
+//       identifier column (int32), then one column (double) per field component,
+//       in the order of the Field enum; each column is preceded by a column header
+//       (codec, element size, raw size, stored size)
+//
+// =============================================================================
+
+#include <cstring>
+
+#include "chrono/core/ChException.h"
+#include "chrono/utils/ChUtilsBinaryOutput.h"
+
+namespace chrono {
+namespace utils {
+
+// -----------------------------------------------------------------------------
+// File format definitions and column codecs
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const char kFileMagic[8] = {'C', 'H', 'B', 'O', 'U', 'T', '\0', '\0'};
+const uint32_t kVersion = 1;
+const uint32_t kChunkMagic = 0x4B4E4843;  // "CHNK"
+
+const int kNumFields = 6;
+const int kFieldSize[kNumFields] = {3, 4, 3, 3, 3, 3};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t fields;
+};
+
+struct ChunkHeader {
+    uint32_t magic;
+    uint32_t num_columns;
+    uint64_t frame;
+    double time;
+    uint64_t num_bodies;
+};
+
+enum Codec : uint32_t { CODEC_RAW = 0, CODEC_SHUFFLE_RLE = 1 };
+
+struct ColumnHeader {
+    uint32_t codec;
+    uint32_t elem_size;
+    uint64_t raw_size;
+    uint64_t stored_size;
+};
+
+// Group the k-th bytes of all elements together: floating point values of similar
+// magnitude then share long runs of identical sign/exponent bytes.
+void Shuffle(const char* in, size_t num_elem, size_t elem_size, char* out) {
+    for (size_t i = 0; i < num_elem; i++)
+        for (size_t k = 0; k < elem_size; k++)
+            out[k * num_elem + i] = in[i * elem_size + k];
+}
+
+void Unshuffle(const char* in, size_t num_elem, size_t elem_size, char* out) {
+    for (size_t i = 0; i < num_elem; i++)
+        for (size_t k = 0; k < elem_size; k++)
+            out[i * elem_size + k] = in[k * num_elem + i];
+}
+
+// Run-length encoding: a control byte c < 128 is followed by c+1 literal bytes;
+// a control byte c >= 128 is followed by one byte, repeated c-128+3 times.
+void EncodeRLE(const char* in, size_t size, std::vector<char>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < size) {
+        size_t run = 1;
+        while (i + run < size && run < 130 && in[i + run] == in[i])
+            run++;
+        if (run >= 3) {
+            out.push_back((char)(128 + run - 3));
+            out.push_back(in[i]);
+            i += run;
+            continue;
+        }
+        size_t start = i;
+        while (i < size && i - start < 128) {
+            if (i + 2 < size && in[i] == in[i + 1] && in[i] == in[i + 2])
+                break;
+            i++;
+        }
+        out.push_back((char)(i - start - 1));
+        out.insert(out.end(), in + start, in + i);
+    }
+}
+
+bool DecodeRLE(const char* in, size_t size, char* out, size_t out_size) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < size) {
+        unsigned int c = (unsigned char)in[i++];
+        if (c < 128) {
+            size_t len = c + 1;
+            if (i + len > size || j + len > out_size)
+                return false;
+            std::memcpy(out + j, in + i, len);
+            i += len;
+            j += len;
+        } else {
+            size_t len = c - 128 + 3;
+            if (i >= size || j + len > out_size)
+                return false;
+            std::memset(out + j, in[i++], len);
+            j += len;
+        }
+    }
+    return j == out_size;
+}
+
+bool ReadColumn(std::ifstream& file, void* data, size_t num_elem, size_t elem_size, std::vector<char>& work) {
+    ColumnHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+    size_t raw_size = num_elem * elem_size;
+    if (header.elem_size != elem_size || header.raw_size != raw_size)
+        return false;
+
+    if (header.codec == CODEC_RAW) {
+        return header.stored_size == raw_size && file.read(static_cast<char*>(data), raw_size);
+    }
+    if (header.codec == CODEC_SHUFFLE_RLE) {
+        work.resize(header.stored_size + raw_size);
+        if (!file.read(work.data(), header.stored_size))
+            return false;
+        char* shuffled = work.data() + header.stored_size;
+        if (!DecodeRLE(work.data(), header.stored_size, shuffled, raw_size))
+            return false;
+        Unshuffle(shuffled, num_elem, elem_size, static_cast<char*>(data));
+        return true;
+    }
+    return false;
+}
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+// ChBinaryOutputWriter
+// -----------------------------------------------------------------------------
+
+ChBinaryOutputWriter::ChBinaryOutputWriter(const std::string& filename,
+                                           int fields,
+                                           Compression compression,
+                                           Backpressure backpressure)
+    : m_fields(fields & ALL_FIELDS),
+      m_compression(compression),
+      m_backpressure(backpressure),
+      m_busy(false),
+      m_stop(false),
+      m_num_frames(0),
+      m_num_written(0),
+      m_num_dropped(0) {
+    m_num_columns = GetNumColumns(m_fields);
+
+    m_file.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!m_file.good())
+        throw ChException("Cannot open output file " + filename);
+
+    FileHeader header;
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kVersion;
+    header.fields = m_fields;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    m_free.push_back(&m_buffers[0]);
+    m_free.push_back(&m_buffers[1]);
+
+    m_thread = std::thread(&ChBinaryOutputWriter::Worker, this);
+}
+
+ChBinaryOutputWriter::~ChBinaryOutputWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    m_file.close();
+}
+
+int ChBinaryOutputWriter::GetNumColumns(int fields) {
+    int num_columns = 0;
+    for (int f = 0; f < kNumFields; f++) {
+        if (fields & (1 << f))
+            num_columns += kFieldSize[f];
+    }
+    return num_columns;
+}
+
+unsigned int ChBinaryOutputWriter::GetNumWritten() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_written;
+}
+
+unsigned int ChBinaryOutputWriter::GetNumDropped() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_dropped;
+}
+
+bool ChBinaryOutputWriter::WriteFrame(ChSystem* system) {
+    Buffer* buffer;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_free.empty()) {
+            if (m_backpressure == Backpressure::DROP) {
+                m_num_frames++;
+                m_num_dropped++;
+                return false;
+            }
+            m_cv.wait(lock, [this]() { return !m_free.empty(); });
+        }
+        buffer = m_free.back();
+        m_free.pop_back();
+        buffer->frame = m_num_frames++;
+    }
+
+    Capture(system, *buffer);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(buffer);
+    }
+    m_cv.notify_all();
+
+    return true;
+}
+
+void ChBinaryOutputWriter::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_pending.empty() && !m_busy; });
+    m_file.flush();
+}
+
+// Copy the selected fields of all bodies in the staging buffer, one column per field
+// component. This is the only part of the output done on the simulation thread.
+void ChBinaryOutputWriter::Capture(ChSystem* system, Buffer& buffer) {
+    auto& bodylist = *system->Get_bodylist();
+    int n = (int)bodylist.size();
+
+    buffer.time = system->GetChTime();
+    buffer.num_bodies = n;
+    buffer.identifiers.resize(n);
+    buffer.columns.resize(m_num_columns * (size_t)n);
+
+    auto container = system->GetContactContainer();
+    if (m_fields & (CONTACT_FORCE | CONTACT_TORQUE))
+        container->ComputeContactForces();
+
+#pragma omp parallel for
+    for (int i = 0; i < n; i++) {
+        ChBody* body = bodylist[i].get();
+        double* col = buffer.columns.data() + i;
+        auto put = [&col, n](const ChVector<>& v) {
+            col[0] = v.x();
+            col[n] = v.y();
+            col[2 * n] = v.z();
+            col += 3 * n;
+        };
+
+        buffer.identifiers[i] = body->GetIdentifier();
+        if (m_fields & POSITION)
+            put(body->GetPos());
+        if (m_fields & ROTATION) {
+            const ChQuaternion<>& q = body->GetRot();
+            col[0] = q.e0();
+            col[n] = q.e1();
+            col[2 * n] = q.e2();
+            col[3 * n] = q.e3();
+            col += 4 * n;
+        }
+        if (m_fields & LIN_VEL)
+            put(body->GetPos_dt());
+        if (m_fields & ANG_VEL)
+            put(body->GetWvel_par());
+        if (m_fields & CONTACT_FORCE)
+            put(container->GetContactableForce(body));
+        if (m_fields & CONTACT_TORQUE)
+            put(container->GetContactableTorque(body));
+    }
+}
+
+void ChBinaryOutputWriter::WriteBuffer(const Buffer& buffer) {
+    ChunkHeader header;
+    header.magic = kChunkMagic;
+    header.num_columns = 1 + m_num_columns;
+    header.frame = buffer.frame;
+    header.time = buffer.time;
+    header.num_bodies = buffer.num_bodies;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    auto write_column = [this](const void* data, size_t num_elem, size_t elem_size) {
+        ColumnHeader col;
+        col.codec = CODEC_RAW;
+        col.elem_size = (uint32_t)elem_size;
+        col.raw_size = num_elem * elem_size;
+        col.stored_size = col.raw_size;
+
+        if (m_compression == Compression::SHUFFLE_RLE && num_elem > 0) {
+            m_shuffled.resize(col.raw_size);
+            Shuffle(static_cast<const char*>(data), num_elem, elem_size, m_shuffled.data());
+            EncodeRLE(m_shuffled.data(), m_shuffled.size(), m_work);
+            if (m_work.size() < col.raw_size) {
+                col.codec = CODEC_SHUFFLE_RLE;
+                col.stored_size = m_work.size();
+                m_file.write(reinterpret_cast<const char*>(&col), sizeof(col));
+                m_file.write(m_work.data(), m_work.size());
+                return;
+            }
+        }
+
+        m_file.write(reinterpret_cast<const char*>(&col), sizeof(col));
+        m_file.write(static_cast<const char*>(data), col.raw_size);
+    };
+
+    size_t n = buffer.num_bodies;
+    write_column(buffer.identifiers.data(), n, sizeof(int32_t));
+    for (int c = 0; c < m_num_columns; c++)
+        write_column(buffer.columns.data() + c * n, n, sizeof(double));
+}
+
+void ChBinaryOutputWriter::Worker() {
+    while (true) {
+        Buffer* buffer;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_pending.empty(); });
+            // Pending frames are always written before stopping.
+            if (m_pending.empty())
+                return;
+            buffer = m_pending.front();
+            m_pending.erase(m_pending.begin());
+            m_busy = true;
+        }
+
+        WriteBuffer(*buffer);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(buffer);
+            m_busy = false;
+            m_num_written++;
+        }
+        m_cv.notify_all();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// ChBinaryOutputReader
+// -----------------------------------------------------------------------------
+
+ChBinaryOutputReader::ChBinaryOutputReader(const std::string& filename)
+    : m_valid(false), m_fields(0), m_frame(0), m_time(0), m_num_bodies(0) {
+    m_file.open(filename.c_str(), std::ios::binary);
+    FileHeader header;
+    if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return;
+    if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 || header.version != kVersion)
+        return;
+    m_fields = header.fields;
+    m_valid = true;
+}
+
+bool ChBinaryOutputReader::ReadFrame() {
+    if (!m_valid)
+        return false;
+
+    ChunkHeader header;
+    if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+    int num_columns = ChBinaryOutputWriter::GetNumColumns(m_fields);
+    if (header.magic != kChunkMagic || header.num_columns != 1 + num_columns)
+        return false;
+
+    size_t n = header.num_bodies;
+    m_frame = header.frame;
+    m_time = header.time;
+    m_num_bodies = n;
+    m_identifiers.resize(n);
+    m_columns.resize(num_columns * n);
+
+    if (!ReadColumn(m_file, m_identifiers.data(), n, sizeof(int32_t), m_work))
+        return false;
+    for (int c = 0; c < num_columns; c++) {
+        if (!ReadColumn(m_file, m_columns.data() + c * n, n, sizeof(double), m_work))
+            return false;
+    }
+
+    return true;
+}
+
+const double* ChBinaryOutputReader::Column(ChBinaryOutputWriter::Field field, int component) const {
+    if (!(m_fields & field))
+        return nullptr;
+    size_t c = component;
+    for (int f = 0; f < kNumFields && (1 << f) != field; f++) {
+        if (m_fields & (1 << f))
+            c += kFieldSize[f];
+    }
+    return m_columns.data() + c * m_num_bodies;
+}
+
+std::vector<double> ChBinaryOutputReader::GetColumn(ChBinaryOutputWriter::Field field, int component) const {
+    const double* col = Column(field, component);
+    if (!col)
+        return std::vector<double>();
+    return std::vector<double>(col, col + m_num_bodies);
+}
+
+ChVector<> ChBinaryOutputReader::GetVector(ChBinaryOutputWriter::Field field, size_t i) const {
+    const double* col = Column(field, 0);
+    if (!col)
+        return VNULL;
+    return ChVector<>(col[i], col[m_num_bodies + i], col[2 * m_num_bodies + i]);
+}
+
+ChQuaternion<> ChBinaryOutputReader::GetRotation(size_t i) const {
+    const double* col = Column(ChBinaryOutputWriter::ROTATION, 0);
+    if (!col)
+        return QUNIT;
+    size_t n = m_num_bodies;
+    return ChQuaternion<>(col[i], col[n + i], col[2 * n + i], col[3 * n + i]);
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,195 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Asynchronous binary output of body states.
+//
+// ChBinaryOutputWriter
+//  snapshots selected body fields into one of two staging buffers on the
+//  simulation thread and lets a background thread encode and write them to a
+//  single file, one chunk per frame. Within a chunk, each field component is
+//  stored as a separate column (e.g. all body x positions, then all y
+//  positions), optionally compressed.
+//
+// ChBinaryOutputReader
+//  reads back, frame by frame, the files created by ChBinaryOutputWriter.
+//
+// =============================================================================
+
+#ifndef CH_UTILS_BINARY_OUTPUT_H
+#define CH_UTILS_BINARY_OUTPUT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+/// Asynchronous writer of body states to a binary, column-oriented file.
+/// Each call to WriteFrame() copies the selected fields of all bodies in the system
+/// into a staging buffer and returns; the buffer is encoded and written to disk by a
+/// background thread. Two staging buffers are used, so that one frame can be captured
+/// while the previous one is being written. If a new frame is requested while both
+/// buffers are in use, the writer either waits for the background thread (BLOCK) or
+/// discards the new frame (DROP).
+class ChApi ChBinaryOutputWriter {
+  public:
+    /// Body fields that can be included in the output (bit flags).
+    enum Field {
+        POSITION = 1 << 0,        ///< body reference frame position (3 columns)
+        ROTATION = 1 << 1,        ///< body reference frame orientation, as a quaternion (4 columns)
+        LIN_VEL = 1 << 2,         ///< linear velocity, in the absolute frame (3 columns)
+        ANG_VEL = 1 << 3,         ///< angular velocity, in the absolute frame (3 columns)
+        CONTACT_FORCE = 1 << 4,   ///< resultant contact force, in the absolute frame (3 columns)
+        CONTACT_TORQUE = 1 << 5,  ///< resultant contact torque, in the absolute frame (3 columns)
+        ALL_FIELDS = (1 << 6) - 1
+    };
+
+    /// Column encoding.
+    enum class Compression {
+        NONE,        ///< raw values
+        SHUFFLE_RLE  ///< byte shuffling followed by run-length encoding (lossless)
+    };
+
+    /// Behavior when a frame is requested while both staging buffers are in use.
+    enum class Backpressure {
+        BLOCK,  ///< wait until the background thread releases a buffer
+        DROP    ///< discard the new frame
+    };
+
+    /// Create a writer to the specified file, for the given combination of fields.
+    /// Throws a ChException if the file cannot be opened.
+    ChBinaryOutputWriter(const std::string& filename,
+                         int fields = POSITION | ROTATION,
+                         Compression compression = Compression::SHUFFLE_RLE,
+                         Backpressure backpressure = Backpressure::BLOCK);
+
+    /// Write all pending frames, then close the file.
+    ~ChBinaryOutputWriter();
+
+    /// Capture the current state of the bodies in the specified system and queue it for
+    /// output. Return false if the frame was discarded (DROP policy only).
+    bool WriteFrame(ChSystem* system);
+
+    /// Wait until all queued frames have been written to the file.
+    void Flush();
+
+    /// Get the number of frames written so far.
+    unsigned int GetNumWritten() const;
+
+    /// Get the number of frames discarded so far.
+    unsigned int GetNumDropped() const;
+
+    /// Get the number of columns for the specified combination of fields.
+    static int GetNumColumns(int fields);
+
+  private:
+    struct Buffer {
+        uint64_t frame;
+        double time;
+        size_t num_bodies;
+        std::vector<int32_t> identifiers;
+        std::vector<double> columns;
+    };
+
+    void Capture(ChSystem* system, Buffer& buffer);
+    void WriteBuffer(const Buffer& buffer);
+    void Worker();
+
+    std::ofstream m_file;
+    int m_fields;
+    int m_num_columns;
+    Compression m_compression;
+    Backpressure m_backpressure;
+
+    Buffer m_buffers[2];
+    std::vector<Buffer*> m_free;     ///< buffers available for capture
+    std::vector<Buffer*> m_pending;  ///< captured buffers, in frame order, waiting to be written
+    bool m_busy;                     ///< is the background thread writing a buffer?
+    bool m_stop;
+
+    uint64_t m_num_frames;
+    unsigned int m_num_written;
+    unsigned int m_num_dropped;
+    std::vector<char> m_shuffled;  ///< encoding work space (background thread)
+    std::vector<char> m_work;      ///< encoding work space (background thread)
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+};
+
+/// Reader for files created by ChBinaryOutputWriter.
+/// Frames are read sequentially; the data of the current frame is available through
+/// the various accessors until the next call to ReadFrame().
+class ChApi ChBinaryOutputReader {
+  public:
+    /// Open the specified file and read its header.
+    ChBinaryOutputReader(const std::string& filename);
+
+    /// Return true if the file was successfully opened and has a valid header.
+    bool IsOpen() const { return m_valid; }
+
+    /// Get the combination of fields stored in the file.
+    int GetFields() const { return m_fields; }
+
+    /// Read the next frame. Return false at the end of the file or on error.
+    bool ReadFrame();
+
+    /// Get the index of the current frame (counting all frames passed to the writer,
+    /// including the discarded ones).
+    uint64_t GetFrame() const { return m_frame; }
+
+    /// Get the simulation time of the current frame.
+    double GetTime() const { return m_time; }
+
+    /// Get the number of bodies in the current frame.
+    size_t GetNumBodies() const { return m_num_bodies; }
+
+    /// Get the identifiers of the bodies in the current frame.
+    const std::vector<int32_t>& GetIdentifiers() const { return m_identifiers; }
+
+    /// Get the values of one component of the specified field, for all bodies.
+    /// Return an empty array if the field is not stored in the file.
+    std::vector<double> GetColumn(ChBinaryOutputWriter::Field field, int component) const;
+
+    /// Get the specified 3-component field for the i-th body of the current frame.
+    ChVector<> GetVector(ChBinaryOutputWriter::Field field, size_t i) const;
+
+    /// Get the orientation of the i-th body of the current frame.
+    ChQuaternion<> GetRotation(size_t i) const;
+
+  private:
+    const double* Column(ChBinaryOutputWriter::Field field, int component) const;
+
+    std::ifstream m_file;
+    bool m_valid;
+    int m_fields;
+    uint64_t m_frame;
+    double m_time;
+    size_t m_num_bodies;
+    std::vector<int32_t> m_identifiers;
+    std::vector<double> m_columns;
+    std::vector<char> m_work;
+};
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
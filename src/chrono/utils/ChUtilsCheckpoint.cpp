@@ -0,0 +1,380 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Binary full-state checkpoint and restart of a ChSystem.
+//
+// File layout (native byte order, all sections aligned at 64 bytes):
+//   - header (magic, version, byte order mark, time, step count, number of
+//     contact constraints, number of sections)
+//   - section table (one entry per section: id, element size, count, offset)
+//   - ITEMS section: one ItemRecord per body, other physics item and link,
+//     in the order of the system lists
+//   - BODIES section: coordinates and their derivatives for all bodies
+//   - X, V, A, L sections: the state vectors of the system
+//
+// =============================================================================
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32) || defined(__WIN32__) || defined(__CYGWIN__)
+#define CH_CHECKPOINT_NO_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "chrono/utils/ChUtilsCheckpoint.h"
+
+namespace chrono {
+namespace utils {
+
+// -----------------------------------------------------------------------------
+// File format definitions
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const char kMagic[8] = {'C', 'H', 'C', 'K', 'P', 'T', '\0', '\0'};
+const uint32_t kVersion = 1;
+const uint32_t kByteOrder = 0x01020304;
+const uint64_t kAlignment = 64;
+
+enum SectionID : uint32_t { ITEMS = 1, BODIES = 2, STATE_X = 3, STATE_V = 4, STATE_A = 5, STATE_L = 6 };
+const uint32_t kNumSections = 6;
+
+enum ItemKind : uint32_t { ITEM_BODY = 0, ITEM_OTHER = 1, ITEM_LINK = 2 };
+
+enum ItemFlags : uint32_t { FLAG_FIXED = 1 << 0, FLAG_SLEEPING = 1 << 1, FLAG_ACTIVE = 1 << 2 };
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    double time;
+    uint64_t stepcount;
+    uint64_t num_contact_doc;
+    uint32_t num_sections;
+    uint32_t reserved;
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t elem_size;
+    uint64_t count;
+    uint64_t offset;
+};
+
+struct ItemRecord {
+    uint32_t kind;
+    uint32_t flags;
+    uint32_t dof;
+    uint32_t dof_w;
+    uint32_t doc;
+    int32_t identifier;
+};
+
+// Body coordinates: position and rotation, and their first and second time derivatives.
+const int kBodyCoords = 21;
+
+uint64_t AlignOffset(uint64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+ItemRecord MakeRecord(ChPhysicsItem* item, ItemKind kind, uint32_t flags) {
+    ItemRecord rec;
+    rec.kind = kind;
+    rec.flags = flags;
+    rec.dof = item->GetDOF();
+    rec.dof_w = item->GetDOF_w();
+    rec.doc = item->GetDOC();
+    rec.identifier = item->GetIdentifier();
+    return rec;
+}
+
+void CollectItems(ChSystem* system, std::vector<ItemRecord>& items) {
+    items.clear();
+    for (auto& body : *system->Get_bodylist()) {
+        uint32_t flags = (body->GetBodyFixed() ? FLAG_FIXED : 0) | (body->GetSleeping() ? FLAG_SLEEPING : 0);
+        items.push_back(MakeRecord(body.get(), ITEM_BODY, flags));
+    }
+    for (auto& item : *system->Get_otherphysicslist())
+        items.push_back(MakeRecord(item.get(), ITEM_OTHER, 0));
+    for (auto& link : *system->Get_linklist())
+        items.push_back(MakeRecord(link.get(), ITEM_LINK, link->IsActive() ? FLAG_ACTIVE : 0));
+}
+
+void StoreCoordsys(const ChCoordsys<>& csys, double* data) {
+    data[0] = csys.pos.x();
+    data[1] = csys.pos.y();
+    data[2] = csys.pos.z();
+    data[3] = csys.rot.e0();
+    data[4] = csys.rot.e1();
+    data[5] = csys.rot.e2();
+    data[6] = csys.rot.e3();
+}
+
+ChCoordsys<> LoadCoordsys(const double* data) {
+    return ChCoordsys<>(ChVector<>(data[0], data[1], data[2]), ChQuaternion<>(data[3], data[4], data[5], data[6]));
+}
+
+// Read-only view of a checkpoint file, memory-mapped where available.
+class CheckpointFile {
+  public:
+    CheckpointFile() : m_data(nullptr), m_size(0) {}
+    ~CheckpointFile() { Close(); }
+
+    bool Open(const std::string& filename) {
+#ifdef CH_CHECKPOINT_NO_MMAP
+        std::ifstream ifile(filename.c_str(), std::ios::binary | std::ios::ate);
+        if (!ifile.good())
+            return false;
+        m_buffer.resize((size_t)ifile.tellg());
+        ifile.seekg(0);
+        if (!ifile.read(m_buffer.data(), m_buffer.size()))
+            return false;
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+            return false;
+        madvise(addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(addr);
+        m_size = (size_t)st.st_size;
+        return true;
+#endif
+    }
+
+    void Close() {
+#ifndef CH_CHECKPOINT_NO_MMAP
+        if (m_data)
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const char* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+  private:
+    const char* m_data;
+    size_t m_size;
+#ifdef CH_CHECKPOINT_NO_MMAP
+    std::vector<char> m_buffer;
+#endif
+};
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+// WriteBinaryCheckpoint
+//
+// Gather the system state and write each section with a single write.
+// -----------------------------------------------------------------------------
+bool WriteBinaryCheckpoint(ChSystem* system, const std::string& filename) {
+    system->Setup();
+
+    // Gather item descriptions and body coordinates
+    std::vector<ItemRecord> items;
+    CollectItems(system, items);
+
+    auto& bodylist = *system->Get_bodylist();
+    std::vector<double> bodies(kBodyCoords * bodylist.size());
+    for (size_t i = 0; i < bodylist.size(); i++) {
+        double* data = &bodies[kBodyCoords * i];
+        StoreCoordsys(bodylist[i]->GetCoord(), data);
+        StoreCoordsys(bodylist[i]->GetCoord_dt(), data + 7);
+        StoreCoordsys(bodylist[i]->GetCoord_dtdt(), data + 14);
+    }
+
+    // Gather the system state vectors
+    ChState x(system->GetNcoords_x(), system);
+    ChStateDelta v(system->GetNcoords_w(), system);
+    ChStateDelta a(system->GetNcoords_w(), system);
+    ChVectorDynamic<> L(system->GetNconstr());
+    double T;
+    system->StateGather(x, v, T);
+    system->StateGatherAcceleration(a);
+    system->StateGatherReactions(L);
+
+    // Section table
+    struct SectionData {
+        SectionEntry entry;
+        const void* data;
+    };
+    SectionData sections[kNumSections] = {
+        {{ITEMS, sizeof(ItemRecord), items.size(), 0}, items.data()},
+        {{BODIES, sizeof(double), bodies.size(), 0}, bodies.data()},
+        {{STATE_X, sizeof(double), (uint64_t)x.GetRows(), 0}, x.GetAddress()},
+        {{STATE_V, sizeof(double), (uint64_t)v.GetRows(), 0}, v.GetAddress()},
+        {{STATE_A, sizeof(double), (uint64_t)a.GetRows(), 0}, a.GetAddress()},
+        {{STATE_L, sizeof(double), (uint64_t)L.GetRows(), 0}, L.GetAddress()}};
+
+    uint64_t offset = AlignOffset(sizeof(FileHeader) + kNumSections * sizeof(SectionEntry));
+    for (auto& s : sections) {
+        s.entry.offset = offset;
+        offset = AlignOffset(offset + s.entry.elem_size * s.entry.count);
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrder;
+    header.time = T;
+    header.stepcount = system->GetStepcount();
+    header.num_contact_doc = system->GetContactContainer()->GetDOC();
+    header.num_sections = kNumSections;
+
+    std::ofstream ofile(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!ofile.good())
+        return false;
+
+    const char padding[kAlignment] = {0};
+    ofile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (auto& s : sections)
+        ofile.write(reinterpret_cast<const char*>(&s.entry), sizeof(SectionEntry));
+
+    uint64_t pos = sizeof(FileHeader) + kNumSections * sizeof(SectionEntry);
+    for (auto& s : sections) {
+        ofile.write(padding, s.entry.offset - pos);
+        ofile.write(static_cast<const char*>(s.data), s.entry.elem_size * s.entry.count);
+        pos = s.entry.offset + s.entry.elem_size * s.entry.count;
+    }
+
+    return ofile.good();
+}
+
+// -----------------------------------------------------------------------------
+// ReadBinaryCheckpoint
+//
+// Validate the checkpoint against the system, then scatter the stored state.
+// -----------------------------------------------------------------------------
+bool ReadBinaryCheckpoint(ChSystem* system, const std::string& filename) {
+    CheckpointFile file;
+    if (!file.Open(filename))
+        return false;
+
+    // Check the header and locate the sections
+    if (file.Size() < sizeof(FileHeader))
+        return false;
+    FileHeader header;
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.byte_order != kByteOrder || header.num_sections != kNumSections)
+        return false;
+    if (file.Size() < sizeof(FileHeader) + kNumSections * sizeof(SectionEntry))
+        return false;
+
+    const char* sections[kNumSections + 1] = {nullptr};
+    uint64_t counts[kNumSections + 1] = {0};
+    for (uint32_t i = 0; i < kNumSections; i++) {
+        SectionEntry entry;
+        std::memcpy(&entry, file.Data() + sizeof(FileHeader) + i * sizeof(SectionEntry), sizeof(entry));
+        if (entry.id < 1 || entry.id > kNumSections || entry.offset + entry.elem_size * entry.count > file.Size())
+            return false;
+        if (entry.elem_size != (entry.id == ITEMS ? sizeof(ItemRecord) : sizeof(double)))
+            return false;
+        sections[entry.id] = file.Data() + entry.offset;
+        counts[entry.id] = entry.count;
+    }
+
+    // Check the item descriptions against the system
+    auto& bodylist = *system->Get_bodylist();
+    std::vector<ItemRecord> items(counts[ITEMS]);
+    std::memcpy(items.data(), sections[ITEMS], items.size() * sizeof(ItemRecord));
+    if (items.size() !=
+        bodylist.size() + system->Get_otherphysicslist()->size() + system->Get_linklist()->size())
+        return false;
+    if (counts[BODIES] != kBodyCoords * bodylist.size())
+        return false;
+
+    for (size_t i = 0; i < bodylist.size(); i++) {
+        if (items[i].kind != ITEM_BODY || ((items[i].flags & FLAG_FIXED) != 0) != bodylist[i]->GetBodyFixed())
+            return false;
+    }
+
+    // The set of bodies in the state vectors depends on the sleeping flags
+    for (size_t i = 0; i < bodylist.size(); i++)
+        bodylist[i]->SetSleeping((items[i].flags & FLAG_SLEEPING) != 0);
+
+    system->Setup();
+
+    std::vector<ItemRecord> current;
+    CollectItems(system, current);
+    for (size_t i = 0; i < items.size(); i++) {
+        if (current[i].kind != items[i].kind || current[i].flags != items[i].flags ||
+            current[i].dof != items[i].dof || current[i].dof_w != items[i].dof_w || current[i].doc != items[i].doc)
+            return false;
+    }
+
+    // Contact constraints are regenerated at the next step: only the multipliers of
+    // the other constraints must match.
+    int num_contact_doc = system->GetContactContainer()->GetDOC();
+    if (counts[STATE_X] != (uint64_t)system->GetNcoords_x() || counts[STATE_V] != (uint64_t)system->GetNcoords_w() ||
+        counts[STATE_A] != (uint64_t)system->GetNcoords_w() ||
+        counts[STATE_L] < header.num_contact_doc ||
+        counts[STATE_L] - header.num_contact_doc != (uint64_t)(system->GetNconstr() - num_contact_doc))
+        return false;
+
+    // Restore the system state
+    ChState x(system->GetNcoords_x(), system);
+    ChStateDelta v(system->GetNcoords_w(), system);
+    ChStateDelta a(system->GetNcoords_w(), system);
+    ChVectorDynamic<> L(system->GetNconstr());
+    std::memcpy(x.GetAddress(), sections[STATE_X], counts[STATE_X] * sizeof(double));
+    std::memcpy(v.GetAddress(), sections[STATE_V], counts[STATE_V] * sizeof(double));
+    std::memcpy(a.GetAddress(), sections[STATE_A], counts[STATE_A] * sizeof(double));
+    if ((uint64_t)num_contact_doc == header.num_contact_doc)
+        std::memcpy(L.GetAddress(), sections[STATE_L], counts[STATE_L] * sizeof(double));
+    else
+        std::memcpy(L.GetAddress(), sections[STATE_L], (counts[STATE_L] - header.num_contact_doc) * sizeof(double));
+
+    system->StateScatter(x, v, header.time);
+    system->StateScatterAcceleration(a);
+    system->StateScatterReactions(L);
+
+    // Restore the body coordinates of fixed and sleeping bodies, which are not part of
+    // the state vectors, and the exact rotation derivatives of all bodies (the state
+    // vectors carry angular velocities and accelerations instead).
+    const double* body_data = reinterpret_cast<const double*>(sections[BODIES]);
+    for (size_t i = 0; i < bodylist.size(); i++) {
+        const double* data = body_data + kBodyCoords * i;
+        if (bodylist[i]->GetBodyFixed() || bodylist[i]->GetSleeping())
+            bodylist[i]->SetCoord(LoadCoordsys(data));
+        bodylist[i]->SetCoord_dt(LoadCoordsys(data + 7));
+        bodylist[i]->SetCoord_dtdt(LoadCoordsys(data + 14));
+    }
+
+    system->Update();
+
+    return true;
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,60 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Binary full-state checkpoint and restart of a ChSystem.
+//
+// WriteBinaryCheckpoint and ReadBinaryCheckpoint
+//  these functions write and read, respectively, a versioned binary snapshot
+//  of the state of a system: the vectors obtained with ChSystem::StateGather,
+//  StateGatherAcceleration and StateGatherReactions, the coordinates of all
+//  bodies (including fixed and sleeping ones) and a description of each
+//  physics item. Each of these is stored as one contiguous, 64-byte aligned
+//  section, written with a single sequential write; on POSIX systems the file
+//  is memory-mapped when restoring.
+//  Limitations:
+//    - the checkpoint stores state, not the model: the system must be rebuilt
+//      (same items, added in the same order) before restoring into it.
+//    - contacts are regenerated by the collision detection at the next step;
+//      the contact reactions are stored but are only restored if the target
+//      system currently has the same number of contact constraints.
+//    - sleeping timers and the internal state of the timestepper (if any) are
+//      not stored.
+//
+// =============================================================================
+
+#ifndef CH_UTILS_CHECKPOINT_H
+#define CH_UTILS_CHECKPOINT_H
+
+#include <string>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+/// Write a binary checkpoint file with the current state of the specified system.
+/// Return false if the file could not be written.
+ChApi bool WriteBinaryCheckpoint(ChSystem* system, const std::string& filename);
+
+/// Restore the state of the specified system from a binary checkpoint file.
+/// The system must contain the same physics items, in the same order, as the one
+/// used to create the checkpoint. Advancing the restored system reproduces the
+/// step that followed the checkpoint in the original simulation. Return false if
+/// the file cannot be read or does not match the system (in which case the system
+/// state is left unchanged, except possibly for the sleeping flags of its bodies).
+ChApi bool ReadBinaryCheckpoint(ChSystem* system, const std::string& filename);
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
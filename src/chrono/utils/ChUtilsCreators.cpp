@@ -14,8 +14,11 @@
 //
 // =============================================================================
 
+#include <cstdio>
+
 #include "chrono_thirdparty/tinyobjloader/tiny_obj_loader.h"
 #include "chrono/collision/ChCConvexDecomposition.h"
+#include "chrono/core/ChModelCache.h"
 #include "chrono/utils/ChUtilsCreators.h"
 
 namespace chrono {
@@ -727,6 +730,70 @@ void LoadConvexMesh(const std::string& file_name,
     convex_shape.ComputeConvexDecomposition();
 }
 
+// -----------------------------------------------------------------------------
+
+void LoadConvexMesh(const std::string& file_name,
+                    ChTriangleMeshConnected& convex_mesh,
+                    std::vector<std::vector<ChVector<double> > >& convex_hulls,
+                    const ChVector<>& pos,
+                    const ChQuaternion<>& rot,
+                    int hacd_maxhullcount,
+                    int hacd_maxhullmerge,
+                    int hacd_maxhullvertexes,
+                    float hacd_concavity,
+                    float hacd_smallclusterthreshold,
+                    float hacd_fusetolerance) {
+    convex_mesh.LoadWavefrontMesh(file_name, true, false);
+
+    for (int i = 0; i < convex_mesh.m_vertices.size(); i++) {
+        convex_mesh.m_vertices[i] = pos + rot.Rotate(convex_mesh.m_vertices[i]);
+    }
+
+    // The decomposition depends on the mesh file, on the transform and on the parameters
+    std::string key;
+    if (ChModelCache::IsEnabled()) {
+        char options[512];
+        sprintf(options, "%.17g %.17g %.17g %.17g %.17g %.17g %.17g %d %d %d %.9g %.9g %.9g", pos.x(), pos.y(),
+                pos.z(), rot.e0(), rot.e1(), rot.e2(), rot.e3(), hacd_maxhullcount, hacd_maxhullmerge,
+                hacd_maxhullvertexes, hacd_concavity, hacd_smallclusterthreshold, hacd_fusetolerance);
+        ChModelCache::GetKey(file_name, "hacd", options, key);
+    }
+
+    if (!key.empty()) {
+        if (auto file = ChModelCache::Load(key)) {
+            ChModelImageIn image(file->GetData(), file->GetSize());
+            unsigned int hull_count;
+            bool ok = image.Read(hull_count) && hull_count <= file->GetSize();
+            if (ok) {
+                convex_hulls.resize(hull_count);
+                for (unsigned int c = 0; ok && c < hull_count; c++)
+                    ok = image.ReadArray(convex_hulls[c]);
+            }
+            if (ok && image.IsAtEnd())
+                return;
+        }
+    }
+
+    ChConvexDecompositionHACDv2 convex_shape;
+    convex_shape.AddTriangleMesh(convex_mesh);
+    convex_shape.SetParameters(hacd_maxhullcount, hacd_maxhullmerge, hacd_maxhullvertexes, hacd_concavity,
+                               hacd_smallclusterthreshold, hacd_fusetolerance);
+    convex_shape.ComputeConvexDecomposition();
+
+    unsigned int hull_count = convex_shape.GetHullCount();
+    convex_hulls.assign(hull_count, std::vector<ChVector<double> >());
+    for (unsigned int c = 0; c < hull_count; c++)
+        convex_shape.GetConvexHullResult(c, convex_hulls[c]);
+
+    if (!key.empty()) {
+        ChModelImageOut image;
+        image.Write(hull_count);
+        for (unsigned int c = 0; c < hull_count; c++)
+            image.WriteArray(convex_hulls[c]);
+        ChModelCache::Store(key, image);
+    }
+}
+
 // -----------------------------------------------------------------------------
 void LoadConvexHulls(const std::string& file_name,
 	geometry::ChTriangleMeshConnected& convex_mesh,
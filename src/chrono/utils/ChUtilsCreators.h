@@ -258,6 +258,23 @@ ChApi void LoadConvexMesh(const std::string& file_name,
                           float hacd_smallclusterthreshold = 0.0f,
                           float hacd_fusetolerance = 1e-6f);
 
+// Given a file containing an obj, this function will load the obj file into a
+// mesh and generate the vertexes of the convex hulls of its decomposition.
+// If the ChModelCache is enabled, the hulls are cached (and loaded from the
+// cache, if the file and the parameters did not change).
+// The output of this function is used with AddConvexCollisionModel
+ChApi void LoadConvexMesh(const std::string& file_name,
+                          geometry::ChTriangleMeshConnected& convex_mesh,
+                          std::vector<std::vector<ChVector<double> > >& convex_hulls,
+                          const ChVector<>& pos = ChVector<>(0, 0, 0),
+                          const ChQuaternion<>& rot = ChQuaternion<>(1, 0, 0, 0),
+                          int hacd_maxhullcount = 1024,
+                          int hacd_maxhullmerge = 256,
+                          int hacd_maxhullvertexes = 64,
+                          float hacd_concavity = 0.01f,
+                          float hacd_smallclusterthreshold = 0.0f,
+                          float hacd_fusetolerance = 1e-6f);
+
 // Given a path to an obj file, loads the obj assuming that the individual
 // objects in the obj are convex hulls, usefull when loading a precomputed
 // set of convex hulls.
@@ -12,14 +12,111 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <cstring>
+#include <string>
 #include <vector>
 
 #include "chrono_cosimulation/ChCosimulation.h"
 #include "chrono_cosimulation/ChExceptionSocket.h"
 
+#ifdef UNIX
+#include <sys/select.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
 namespace chrono {
 namespace cosimul {
 
+namespace {
+
+// Handshake messages for the shared memory transport (see ChCosimulation::WaitConnection)
+const char shm_request[] = "CHSHM001";
+const char shm_accept[] = "CHSHMACK";
+const char shm_reject[] = "CHSHMNAK";
+const int shm_msg_len = 8;
+
+// Time given to a client to request the shared memory transport, in milliseconds
+const int shm_request_timeout = 100;
+
+#ifdef UNIX
+typedef socklen_t SockLen;
+#else
+typedef int SockLen;
+#endif
+
+// Wait up to 'timeout' milliseconds for data on the socket.
+bool WaitReadable(int socket_id, int timeout) {
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(socket_id, &set);
+    timeval tv;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+    return select(socket_id + 1, &set, NULL, NULL, &tv) > 0;
+}
+
+bool SendAll(int socket_id, const char* data, int n) {
+    while (n > 0) {
+        int sent = (int)send(socket_id, data, n, 0);
+        if (sent <= 0)
+            return false;
+        data += sent;
+        n -= sent;
+    }
+    return true;
+}
+
+bool ReceiveAll(int socket_id, char* data, int n) {
+    while (n > 0) {
+        int received = (int)recv(socket_id, data, n, 0);
+        if (received <= 0)
+            return false;
+        data += received;
+        n -= received;
+    }
+    return true;
+}
+
+// Check whether the peer of a connected socket runs on this host.
+bool IsLocalPeer(int socket_id) {
+    struct sockaddr_in local, peer;
+    SockLen len_local = sizeof(local);
+    SockLen len_peer = sizeof(peer);
+    if (getsockname(socket_id, (struct sockaddr*)&local, &len_local) != 0 ||
+        getpeername(socket_id, (struct sockaddr*)&peer, &len_peer) != 0)
+        return false;
+    return local.sin_addr.s_addr == peer.sin_addr.s_addr;
+}
+
+// Check, without consuming it, whether the client sent a shared memory request.
+// Clients that do not send anything within the timeout use the TCP transport.
+// Only called if shared memory is enabled, so that other clients are not delayed.
+bool PeekRequest(int socket_id) {
+    char msg[shm_msg_len];
+    for (int wait = 0; wait < shm_request_timeout; wait += 10) {
+        if (!WaitReadable(socket_id, 10))
+            continue;
+        int n = (int)recv(socket_id, msg, shm_msg_len, MSG_PEEK);
+        if (n <= 0 || std::memcmp(msg, shm_request, n) != 0)
+            return false;
+        if (n == shm_msg_len)
+            return true;
+    }
+    return false;
+}
+
+int ProcessId() {
+#ifdef UNIX
+    return (int)getpid();
+#else
+    return (int)_getpid();
+#endif
+}
+
+}  // end anonymous namespace
+
 ChCosimulation::ChCosimulation(ChSocketFramework& mframework,
                                int n_in_values,  /// number of scalar variables to receive each timestep
                                int n_out_values  /// number of scalar variables to send each timestep
@@ -29,9 +126,15 @@ ChCosimulation::ChCosimulation(ChSocketFramework& mframework,
     this->in_n = n_in_values;
     this->out_n = n_out_values;
     this->nport = 0;
+    this->use_shm = false;
+    this->shm = 0;
+    this->send_buffer.reserve(sizeof(double) * (n_out_values + 1));
 }
 
 ChCosimulation::~ChCosimulation() {
+    if (this->shm)
+        delete this->shm;
+    this->shm = 0;
     if (this->myServer)
         delete this->myServer;
     this->myServer = 0;
@@ -59,6 +162,64 @@ bool ChCosimulation::WaitConnection(int aport) {
     if (!this->myClient)
         throw(ChExceptionSocket(0, "Server failed in getting the client socket"));
 
+    // without shared memory, the client is served over TCP right away
+    if (!this->use_shm)
+        return true;
+
+    // switch to shared memory, if requested by a client on this host
+    int socket_id = this->myClient->getSocketId();
+    if (PeekRequest(socket_id)) {
+        char msg[shm_msg_len];
+        ReceiveAll(socket_id, msg, shm_msg_len);
+
+        if (IsLocalPeer(socket_id)) {
+            std::string name = "chrono_cosim_" + std::to_string(ProcessId()) + "_" + std::to_string(aport);
+            this->shm = new ChSharedMemoryChannel(name, this->out_n, this->in_n);
+
+            unsigned char len[4];
+            for (int i = 0; i < 4; i++)
+                len[i] = (unsigned char)(name.size() >> (8 * i));
+            if (!SendAll(socket_id, shm_accept, shm_msg_len) || !SendAll(socket_id, (char*)len, 4) ||
+                !SendAll(socket_id, name.c_str(), (int)name.size()))
+                throw(ChExceptionSocket(0, "Server failed in setting up shared memory"));
+        } else {
+            SendAll(socket_id, shm_reject, shm_msg_len);
+        }
+    }
+
+    return true;
+}
+
+bool ChCosimulation::ConnectToServer(const std::string& hostname, int aport) {
+    this->nport = aport;
+
+    this->myClient = new ChSocketTCP(aport);
+    std::string host(hostname);  // a name, or a numeric address
+    this->myClient->connectToServer(host, NAME);
+
+    if (!this->use_shm)
+        return true;
+
+    // request the shared memory transport
+    int socket_id = this->myClient->getSocketId();
+    char msg[shm_msg_len];
+    if (!SendAll(socket_id, shm_request, shm_msg_len) || !ReceiveAll(socket_id, msg, shm_msg_len))
+        throw(ChExceptionSocket(0, "Client failed in requesting shared memory"));
+
+    if (std::memcmp(msg, shm_accept, shm_msg_len) == 0) {
+        unsigned char len[4];
+        if (!ReceiveAll(socket_id, (char*)len, 4))
+            throw(ChExceptionSocket(0, "Client failed in requesting shared memory"));
+        size_t name_len = len[0] | (len[1] << 8) | (len[2] << 16) | ((size_t)len[3] << 24);
+        std::string name(name_len, ' ');
+        if (!ReceiveAll(socket_id, &name[0], (int)name_len))
+            throw(ChExceptionSocket(0, "Client failed in requesting shared memory"));
+
+        this->shm = new ChSharedMemoryChannel(name);
+        if (this->shm->GetNumOutValues() != this->out_n || this->shm->GetNumInValues() != this->in_n)
+            throw(ChExceptionSocket(0, "Error. Number of values does not match the server."));
+    }
+
     return true;
 }
 
@@ -70,8 +231,14 @@ bool ChCosimulation::SendData(double mtime, ChMatrix<double>* out_data) {
     if (!myClient)
         throw ChExceptionSocket(0, "Error. Attempted 'SendData' with no connected client.");
 
-    std::vector<char> mbuffer;                     // now zero length
-    ChStreamOutBinaryVector stream_out(&mbuffer);  // wrap the buffer, for easy formatting
+    // -----> SEND through shared memory, directly from the matrix storage
+    if (this->shm) {
+        this->shm->Send(mtime, out_data->GetAddress());
+        return true;
+    }
+
+    this->send_buffer.clear();                          // now zero length, capacity is kept
+    ChStreamOutBinaryVector stream_out(&send_buffer);  // wrap the buffer, for easy formatting
 
     // Serialize datas (little endian)...
 
@@ -95,11 +262,16 @@ bool ChCosimulation::ReceiveData(double& mtime, ChMatrix<double>* in_data) {
     if (!myClient)
         throw ChExceptionSocket(0, "Error. Attempted 'ReceiveData' with no connected client.");
 
+    // <----- RECEIVE through shared memory, directly into the matrix storage
+    if (this->shm) {
+        this->shm->Receive(mtime, in_data->GetAddress());
+        return true;
+    }
+
     // Receive from the client
     int nbytes = sizeof(double) * (this->in_n + 1);
-    std::vector<char> rbuffer;
-    rbuffer.resize(nbytes);                      // reserve to number of expected bytes
-    ChStreamInBinaryVector stream_in(&rbuffer);  // wrap the buffer, for easy formatting
+    receive_buffer.resize(nbytes);                      // reserve to number of expected bytes
+    ChStreamInBinaryVector stream_in(&receive_buffer);  // wrap the buffer, for easy formatting
 
     // -----> RECEIVE!!!
     int numBytes = this->myClient->ReceiveBuffer(*stream_in.GetVector(), nbytes);
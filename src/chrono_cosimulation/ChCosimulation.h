@@ -15,8 +15,11 @@
 #ifndef CHCOSIMULATION_H
 #define CHCOSIMULATION_H
 
+#include <vector>
+
 #include "chrono_cosimulation/ChSocketFramework.h"
 #include "chrono_cosimulation/ChSocket.h"
+#include "chrono_cosimulation/ChSharedMemoryChannel.h"
 
 #include "chrono/core/ChMatrix.h"
 
@@ -34,6 +37,10 @@ namespace cosimul {
 /// back and forth.
 /// In this case, C::E will work as a server, waiting for
 /// a client to talk with.
+/// If shared memory is enabled on both sides (SetSharedMemory())
+/// and the client runs on the same host, data is exchanged
+/// through shared memory instead of the TCP connection
+/// (see WaitConnection()).
 
 class ChApiCosimulation ChCosimulation {
   public:
@@ -48,8 +55,31 @@ class ChApiCosimulation ChCosimulation {
     /// Wait for a client to connect to the interface,
     /// on a given port, and wait until not connected.
     /// aport is a free port number, for example 50009.
+    /// If shared memory is enabled, a client on the same host can
+    /// request a shared memory transport by sending the 8 bytes
+    /// "CHSHM001" right after connecting (within 100 ms). If accepted, the server replies "CHSHMACK",
+    /// followed by the segment name length (uint32, little endian)
+    /// and the segment name, to be opened with ChSharedMemoryChannel;
+    /// otherwise it replies "CHSHMNAK" and the TCP connection is used.
+    /// Clients that do not send the request are served over TCP as usual.
+    /// If shared memory is disabled (default), nothing is expected
+    /// from the client and the TCP connection is used right away.
     bool WaitConnection(int aport);
 
+    /// Connect, as a client, to a co-simulation interface waiting on the
+    /// given host and port. Shared memory is requested if enabled.
+    /// The number of values received/sent by the client must match the
+    /// number of values sent/received by the server.
+    bool ConnectToServer(const std::string& hostname, int aport);
+
+    /// Enable or disable the use of shared memory for peers on the
+    /// same host (default: disabled). Must be called before the connection,
+    /// on both the server and the client side.
+    void SetSharedMemory(bool val) { use_shm = val; }
+
+    /// Return true if data is exchanged through shared memory.
+    bool IsSharedMemory() const { return shm != 0; }
+
     /// Exchange data with the client, by sending a
     /// vector of floating point values over TCP socket
     /// connection (values are double precision, little endian, 4 bytes each)
@@ -69,6 +99,12 @@ class ChApiCosimulation ChCosimulation {
 
     int in_n;
     int out_n;
+
+    bool use_shm;
+    ChSharedMemoryChannel* shm;
+
+    std::vector<char> send_buffer;
+    std::vector<char> receive_buffer;
 };
 
 /// @} cosimulation_module
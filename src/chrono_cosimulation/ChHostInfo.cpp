@@ -76,8 +76,9 @@ ChHostInfo::ChHostInfo(const string& hostName, hostType type) {
             }
         } else if (type == ADDRESS) {
             // Retrieve host by address
-            unsigned long netAddr = inet_addr(hostName.c_str());
-            if (netAddr == -1) {
+            struct in_addr netAddr;
+            netAddr.s_addr = inet_addr(hostName.c_str());
+            if (netAddr.s_addr == INADDR_NONE) {
                 ChExceptionSocket* inet_addrException = new ChExceptionSocket(0, "Error calling inet_addr()");
                 throw inet_addrException;
             }
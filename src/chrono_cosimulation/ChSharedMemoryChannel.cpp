@@ -0,0 +1,317 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "chrono_cosimulation/ChSharedMemoryChannel.h"
+#include "chrono_cosimulation/ChExceptionSocket.h"
+
+namespace chrono {
+namespace cosimul {
+
+namespace {
+
+typedef std::atomic<unsigned long long> Counter;
+typedef std::atomic<int32_t> ProcessID;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory channel requires lock-free 64-bit atomics");
+
+const uint32_t shm_magic = 0x4348534D;
+const uint32_t shm_version = 2;
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    int32_t n_values[2];  // creator->opener, opener->creator
+    int32_t n_slots;
+    ProcessID pid[2];  // creator, opener (0: not opened yet, -1: closed)
+};
+
+static_assert(sizeof(Header) <= 64, "Shared memory channel header too large");
+
+const size_t header_size = 64;
+const size_t counter_stride = 64;  // head and tail on separate cache lines
+const size_t slots_offset = 2 * counter_stride;
+
+size_t RingSize(int n_values, int n_slots) {
+    size_t size = slots_offset + (size_t)n_slots * (n_values + 1) * sizeof(double);
+    return (size + 63) & ~(size_t)63;
+}
+
+Counter& Head(char* ring) {
+    return *reinterpret_cast<Counter*>(ring);
+}
+
+Counter& Tail(char* ring) {
+    return *reinterpret_cast<Counter*>(ring + counter_stride);
+}
+
+double* Slot(char* ring, int n_values, unsigned long long index) {
+    return reinterpret_cast<double*>(ring + slots_offset) + index * (n_values + 1);
+}
+
+// Spin for a while, then start yielding the processor to other threads.
+// On a single processor, spinning only delays the peer: yield right away.
+const int max_spins = std::thread::hardware_concurrency() > 1 ? 1000 : 0;
+
+inline void Backoff(int& spins) {
+    if (spins < max_spins)
+        spins++;
+    else
+        std::this_thread::yield();
+}
+
+// Number of waiting iterations between checks of the peer process.
+const unsigned int check_interval = 1024;
+
+double Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef _WIN32
+
+int32_t CurrentProcess() {
+    return (int32_t)GetCurrentProcessId();
+}
+
+bool ProcessRunning(int32_t pid) {
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)pid);
+    if (!process)
+        return false;
+    bool running = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return running;
+}
+
+#else
+
+int32_t CurrentProcess() {
+    return (int32_t)getpid();
+}
+
+bool ProcessRunning(int32_t pid) {
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+}
+
+#endif
+
+}  // end anonymous namespace
+
+ChSharedMemoryChannel::ChSharedMemoryChannel(const std::string& name, int n_out_values, int n_in_values, int n_slots)
+    : m_name(name), m_creator(true), m_size(0), m_base(nullptr), m_n_out(n_out_values), m_n_in(n_in_values),
+      m_n_slots(n_slots), m_timeout(0) {
+    if (n_out_values < 0 || n_in_values < 0 || n_slots < 1)
+        throw ChExceptionSocket(0, "Error. Invalid shared memory channel sizes.");
+
+    Map(header_size + RingSize(n_out_values, n_slots) + RingSize(n_in_values, n_slots), true);
+
+    Header* header = reinterpret_cast<Header*>(m_base);
+    header->version = shm_version;
+    header->n_values[0] = n_out_values;
+    header->n_values[1] = n_in_values;
+    header->n_slots = n_slots;
+    new (&header->pid[0]) ProcessID(CurrentProcess());
+    new (&header->pid[1]) ProcessID(0);
+
+    SetupRings(true);
+    new (&Head(m_out_ring)) Counter(0);
+    new (&Tail(m_out_ring)) Counter(0);
+    new (&Head(m_in_ring)) Counter(0);
+    new (&Tail(m_in_ring)) Counter(0);
+
+    // Mark the segment as initialized
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = shm_magic;
+}
+
+ChSharedMemoryChannel::ChSharedMemoryChannel(const std::string& name)
+    : m_name(name), m_creator(false), m_size(0), m_base(nullptr), m_timeout(0) {
+    Map(0, false);
+
+    Header* header = reinterpret_cast<Header*>(m_base);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_size < header_size || header->magic != shm_magic || header->version != shm_version)
+        throw ChExceptionSocket(0, "Error. Invalid shared memory segment " + name);
+
+    m_n_out = header->n_values[1];
+    m_n_in = header->n_values[0];
+    m_n_slots = header->n_slots;
+    if (m_size < header_size + RingSize(m_n_out, m_n_slots) + RingSize(m_n_in, m_n_slots))
+        throw ChExceptionSocket(0, "Error. Invalid shared memory segment " + name);
+
+    SetupRings(false);
+    header->pid[1].store(CurrentProcess(), std::memory_order_release);
+}
+
+void ChSharedMemoryChannel::SetupRings(bool creator) {
+    Header* header = reinterpret_cast<Header*>(m_base);
+    char* ring0 = m_base + header_size;
+    char* ring1 = ring0 + RingSize(header->n_values[0], header->n_slots);
+    m_out_ring = creator ? ring0 : ring1;
+    m_in_ring = creator ? ring1 : ring0;
+}
+
+#ifdef _WIN32
+
+void ChSharedMemoryChannel::Map(size_t size, bool create) {
+    if (create) {
+        m_handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32),
+                                      (DWORD)(size & 0xFFFFFFFF), m_name.c_str());
+        if (m_handle && GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(m_handle);
+            m_handle = NULL;
+        }
+    } else {
+        m_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, m_name.c_str());
+    }
+    if (!m_handle)
+        throw ChExceptionSocket(0, "Error. Cannot open shared memory segment " + m_name);
+
+    m_base = (char*)MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!m_base) {
+        CloseHandle(m_handle);
+        throw ChExceptionSocket(0, "Error. Cannot map shared memory segment " + m_name);
+    }
+
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(m_base, &info, sizeof(info));
+    m_size = create ? size : info.RegionSize;
+}
+
+ChSharedMemoryChannel::~ChSharedMemoryChannel() {
+    reinterpret_cast<Header*>(m_base)->pid[m_creator ? 0 : 1].store(-1, std::memory_order_release);
+    UnmapViewOfFile(m_base);
+    CloseHandle(m_handle);
+}
+
+#else
+
+void ChSharedMemoryChannel::Map(size_t size, bool create) {
+    std::string shm_name = "/" + m_name;
+    int fd = create ? shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600)
+                    : shm_open(shm_name.c_str(), O_RDWR, 0);
+    if (fd == -1)
+        throw ChExceptionSocket(0, "Error. Cannot open shared memory segment " + m_name);
+
+    if (create) {
+        if (ftruncate(fd, (off_t)size) == -1) {
+            close(fd);
+            shm_unlink(shm_name.c_str());
+            throw ChExceptionSocket(0, "Error. Cannot size shared memory segment " + m_name);
+        }
+    } else {
+        struct stat st;
+        fstat(fd, &st);
+        size = (size_t)st.st_size;
+    }
+
+    void* base = size ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (base == MAP_FAILED) {
+        if (create)
+            shm_unlink(shm_name.c_str());
+        throw ChExceptionSocket(0, "Error. Cannot map shared memory segment " + m_name);
+    }
+
+    m_base = (char*)base;
+    m_size = size;
+}
+
+ChSharedMemoryChannel::~ChSharedMemoryChannel() {
+    reinterpret_cast<Header*>(m_base)->pid[m_creator ? 0 : 1].store(-1, std::memory_order_release);
+    munmap(m_base, m_size);
+    if (m_creator)
+        shm_unlink(("/" + m_name).c_str());
+}
+
+#endif
+
+// Called periodically while waiting for the peer: throw if the peer process closed the
+// channel or terminated, or if the wait exceeded the timeout.
+void ChSharedMemoryChannel::CheckPeer(double wait_start) const {
+    const Header* header = reinterpret_cast<const Header*>(m_base);
+    int32_t pid = header->pid[m_creator ? 1 : 0].load(std::memory_order_acquire);
+    if (pid == -1)
+        throw ChExceptionSocket(0, "Error. Peer closed shared memory channel " + m_name);
+    if (pid != 0 && !ProcessRunning(pid))
+        throw ChExceptionSocket(0, "Error. Peer of shared memory channel " + m_name + " terminated");
+    if (m_timeout > 0 && Now() - wait_start > 1e-3 * m_timeout)
+        throw ChExceptionSocket(0, "Error. Timeout on shared memory channel " + m_name);
+}
+
+void ChSharedMemoryChannel::Send(double time, const double* values) {
+    Counter& head = Head(m_out_ring);
+    Counter& tail = Tail(m_out_ring);
+    unsigned long long h = head.load(std::memory_order_relaxed);
+
+    // Wait for a free slot
+    int spins = 0;
+    unsigned int waits = 0;
+    double wait_start = 0;
+    while (h - tail.load(std::memory_order_acquire) >= (unsigned long long)m_n_slots) {
+        if (waits++ == 0)
+            wait_start = Now();
+        Backoff(spins);
+        if (waits % check_interval == 0)
+            CheckPeer(wait_start);
+    }
+
+    double* slot = Slot(m_out_ring, m_n_out, h % m_n_slots);
+    slot[0] = time;
+    std::memcpy(slot + 1, values, m_n_out * sizeof(double));
+
+    head.store(h + 1, std::memory_order_release);
+}
+
+void ChSharedMemoryChannel::Receive(double& time, double* values) {
+    Counter& head = Head(m_in_ring);
+    Counter& tail = Tail(m_in_ring);
+    unsigned long long t = tail.load(std::memory_order_relaxed);
+
+    // Wait for a filled slot
+    int spins = 0;
+    unsigned int waits = 0;
+    double wait_start = 0;
+    while (head.load(std::memory_order_acquire) == t) {
+        if (waits++ == 0)
+            wait_start = Now();
+        Backoff(spins);
+        if (waits % check_interval == 0)
+            CheckPeer(wait_start);
+    }
+
+    const double* slot = Slot(m_in_ring, m_n_in, t % m_n_slots);
+    time = slot[0];
+    std::memcpy(values, slot + 1, m_n_in * sizeof(double));
+
+    tail.store(t + 1, std::memory_order_release);
+}
+
+}  // end namespace cosimul
+}  // end namespace chrono
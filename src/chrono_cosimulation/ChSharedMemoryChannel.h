@@ -0,0 +1,110 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSHAREDMEMORYCHANNEL_H
+#define CHSHAREDMEMORYCHANNEL_H
+
+#include <string>
+
+#include "chrono_cosimulation/ChApiCosimulation.h"
+
+namespace chrono {
+namespace cosimul {
+
+/// @addtogroup cosimulation_module
+/// @{
+
+/// Channel for exchanging fixed-size vectors of doubles with a process running on
+/// the same host, through a named shared memory segment.
+/// The segment contains two single-producer/single-consumer ring buffers, one per
+/// direction. Each ring buffer slot holds a time value followed by the vector values,
+/// as native doubles. Senders and receivers busy-wait (then yield) on the ring
+/// buffer counters, so no system call is involved in a data exchange.
+/// Each side stores its process ID in the segment header; a waiting side periodically
+/// checks that the peer process is still running (and, optionally, a timeout) and
+/// throws a ChExceptionSocket otherwise.
+///
+/// Segment layout (all offsets in bytes, native byte order):
+///  - 0:   header: uint32 magic (0x4348534D), uint32 version (2),
+///         int32 number of values creator->opener, int32 number of values opener->creator,
+///         int32 number of slots per ring buffer, int32 creator and opener process IDs
+///         (0: not opened yet, -1: closed)
+///  - 64:  ring buffer creator->opener: uint64 head (written by the sender) at +0,
+///         uint64 tail (written by the receiver) at +64, slots at +128
+///  - followed by the ring buffer opener->creator, with the same layout.
+/// Slots are (1 + number of values) doubles; the ring buffer sizes are rounded up
+/// to a multiple of 64 bytes.
+class ChApiCosimulation ChSharedMemoryChannel {
+  public:
+    /// Create a new shared memory segment with the given name.
+    /// The creator sends 'n_out_values' and receives 'n_in_values' values per exchange.
+    /// Throws a ChExceptionSocket on failure.
+    ChSharedMemoryChannel(const std::string& name, int n_out_values, int n_in_values, int n_slots = 4);
+
+    /// Open an existing shared memory segment, created by the peer process.
+    /// The directions are swapped with respect to the creator.
+    /// Throws a ChExceptionSocket on failure.
+    ChSharedMemoryChannel(const std::string& name);
+
+    /// Unmap the segment (and remove it, if this is the creator).
+    ~ChSharedMemoryChannel();
+
+    /// Get the name of the shared memory segment.
+    const std::string& GetName() const { return m_name; }
+
+    /// Get the number of values sent at each exchange.
+    int GetNumOutValues() const { return m_n_out; }
+
+    /// Get the number of values received at each exchange.
+    int GetNumInValues() const { return m_n_in; }
+
+    /// Set the maximum time, in milliseconds, that Send() and Receive() wait for the
+    /// peer (default: 0, i.e. wait as long as the peer process is running).
+    void SetTimeout(int milliseconds) { m_timeout = milliseconds; }
+
+    /// Send the time and GetNumOutValues() values.
+    /// Waits only if the peer lags more than the number of slots behind.
+    /// Throws a ChExceptionSocket if the peer terminated or on timeout.
+    void Send(double time, const double* values);
+
+    /// Receive the time and GetNumInValues() values.
+    /// Waits until the peer has sent them.
+    /// Throws a ChExceptionSocket if the peer terminated or on timeout.
+    void Receive(double& time, double* values);
+
+  private:
+    void Map(size_t size, bool create);
+    void SetupRings(bool creator);
+    void CheckPeer(double wait_start) const;
+
+    std::string m_name;
+    bool m_creator;
+    size_t m_size;
+    char* m_base;
+#ifdef _WIN32
+    void* m_handle;
+#endif
+
+    int m_n_out;
+    int m_n_in;
+    int m_n_slots;
+    int m_timeout;
+    char* m_out_ring;  ///< ring buffer written by this process
+    char* m_in_ring;   ///< ring buffer read by this process
+};
+
+/// @} cosimulation_module
+
+}  // end namespace cosimul
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,886 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Host implementation of the SPH fluid dynamics, parallelized with OpenMP.
+// =============================================================================
+
+#include "chrono_fsi/ChFluidDynamicsCpu.h"
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include <cmath>
+#include <stdexcept>
+
+namespace chrono {
+namespace fsi {
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// Host versions of the SPH functions of ChSphGeneral.cuh. The parameters are
+// passed explicitly since the device versions read them from constant memory.
+// -----------------------------------------------------------------------------
+
+// 3D cubic spline kernel
+inline Real W3(Real d, const SimParams &p) {
+  Real h = p.HSML;
+  Real q = std::abs(d) / h;
+  if (q >= 2) {
+    return 0;
+  }
+  Real a = 2 - q;
+  Real w = a * a * a;
+  if (q < 1) {
+    Real b = 1 - q;
+    w -= 4 * b * b * b;
+  }
+  return Real(0.25) / (Real(PI) * h * h * h) * w;
+}
+
+// gradient of the cubic spline kernel; d = pos_a - pos_b
+inline Real3 GradW(Real3 d, const SimParams &p) {
+  Real h = p.HSML;
+  Real q = length(d) / h;
+  Real f = 0;
+  if (q < 1) {
+    f = 3 * q - 4;
+  } else if (q < 2) {
+    f = -q + 4 - 4 / q;
+  }
+  return f * Real(0.75) * Real(INVPI) / (h * h * h * h * h) * d;
+}
+
+// coefficient B of the (Tait) equation of state, with gamma = 7
+inline Real EosB(const SimParams &p) {
+  return 100 * p.rho0 * p.v_Max * p.v_Max / 7;
+}
+
+// fluid equation of state
+inline Real Eos(Real rho, const SimParams &p) {
+  return EosB(p) * (std::pow(rho / p.rho0, Real(7)) - 1) + p.BASEPRES;
+}
+
+// inverse of the equation of state
+inline Real InvEos(Real pw, const SimParams &p) {
+  Real powerComp = (pw - p.BASEPRES) / EosB(p) + 1;
+  return (powerComp > 0)
+             ? p.rho0 * std::pow(powerComp, Real(1) / 7)
+             : -p.rho0 * std::pow(std::abs(powerComp), Real(1) / 7);
+}
+
+// speed of sound used in the Ferrari density diffusion
+inline Real FerrariCi(Real rho, const SimParams &p) {
+  return std::sqrt(7 * EosB(p) / p.rho0) * std::pow(rho / p.rho0, Real(3));
+}
+
+// move b to the periodic image closest to a and return a - b
+inline Real3 Modify_Local_PosB(Real3 &b, Real3 a, const SimParams &p) {
+  Real3 dist3 = a - b;
+  b.x += ((dist3.x > Real(0.5) * p.boxDims.x) ? p.boxDims.x : 0);
+  b.x -= ((dist3.x < Real(-0.5) * p.boxDims.x) ? p.boxDims.x : 0);
+
+  b.y += ((dist3.y > Real(0.5) * p.boxDims.y) ? p.boxDims.y : 0);
+  b.y -= ((dist3.y < Real(-0.5) * p.boxDims.y) ? p.boxDims.y : 0);
+
+  b.z += ((dist3.z > Real(0.5) * p.boxDims.z) ? p.boxDims.z : 0);
+  b.z -= ((dist3.z < Real(-0.5) * p.boxDims.z) ? p.boxDims.z : 0);
+
+  dist3 = a - b;
+  // modifying the markers perfect overlap
+  if (length(dist3) < p.epsMinMarkersDis * p.HSML) {
+    dist3 = mR3(p.epsMinMarkersDis * p.HSML, 0, 0);
+  }
+  b = a - dist3;
+  return dist3;
+}
+
+// distance vector a - b, considering the periodic boundary condition
+inline Real3 Distance(Real3 a, Real3 b, const SimParams &p) {
+  return Modify_Local_PosB(b, a, p);
+}
+
+// modify pressure for body force
+inline void modifyPressure(Real4 &rhoPresMuB, const Real3 &dist3Alpha,
+                           const SimParams &p) {
+  if (dist3Alpha.x > Real(0.5) * p.boxDims.x) {
+    rhoPresMuB.y -= p.deltaPress.x;
+  } else if (dist3Alpha.x < Real(-0.5) * p.boxDims.x) {
+    rhoPresMuB.y += p.deltaPress.x;
+  }
+  if (dist3Alpha.y > Real(0.5) * p.boxDims.y) {
+    rhoPresMuB.y -= p.deltaPress.y;
+  } else if (dist3Alpha.y < Real(-0.5) * p.boxDims.y) {
+    rhoPresMuB.y += p.deltaPress.y;
+  }
+  if (dist3Alpha.z > Real(0.5) * p.boxDims.z) {
+    rhoPresMuB.y -= p.deltaPress.z;
+  } else if (dist3Alpha.z < Real(-0.5) * p.boxDims.z) {
+    rhoPresMuB.y += p.deltaPress.z;
+  }
+}
+
+// derivatives of velocity and density of marker A due to marker B
+// (artificial viscosity type 2, Ferrari density diffusion)
+inline Real4 DifVelocityRho(const Real3 &dist3, Real d, const Real3 &velMasA,
+                            const Real3 &vel_XSPH_A, const Real3 &velMasB,
+                            const Real3 &vel_XSPH_B, const Real4 &rhoPresMuA,
+                            const Real4 &rhoPresMuB, Real multViscosity,
+                            const SimParams &p) {
+  Real3 gradW = GradW(dist3, p);
+  Real rAB_Dot_GradW = dot(dist3, gradW);
+  Real rAB_Dot_GradW_OverDist =
+      rAB_Dot_GradW / (d * d + p.epsMinMarkersDis * p.HSML * p.HSML);
+  Real rhoSum = rhoPresMuA.x + rhoPresMuB.x;
+  Real3 derivV = -p.markerMass *
+                     (rhoPresMuA.y / (rhoPresMuA.x * rhoPresMuA.x) +
+                      rhoPresMuB.y / (rhoPresMuB.x * rhoPresMuB.x)) *
+                     gradW +
+                 p.markerMass * (8 * multViscosity) * p.mu0 /
+                     (rhoSum * rhoSum) * rAB_Dot_GradW_OverDist *
+                     (velMasA - velMasB);
+
+  Real derivRho = p.markerMass * dot(vel_XSPH_A - vel_XSPH_B, gradW);
+  Real cA = FerrariCi(rhoPresMuA.x, p);
+  Real cB = FerrariCi(rhoPresMuB.x, p);
+  derivRho -= rAB_Dot_GradW / (d + p.epsMinMarkersDis * p.HSML) *
+              ((cA > cB) ? cA : cB) / rhoPresMuB.x *
+              (rhoPresMuB.x - rhoPresMuA.x);
+
+  return mR4(derivV, derivRho);
+}
+
+// rotation matrix (rows) from a quaternion (e0, e1, e2, e3)
+inline void RotationMatrixFromQuaternion(Real3 &AD1, Real3 &AD2, Real3 &AD3,
+                                         const Real4 &q) {
+  AD1 = 2 * mR3(Real(0.5) - q.z * q.z - q.w * q.w, q.y * q.z - q.x * q.w,
+                q.y * q.w + q.x * q.z);
+  AD2 = 2 * mR3(q.y * q.z + q.x * q.w, Real(0.5) - q.y * q.y - q.w * q.w,
+                q.z * q.w - q.x * q.y);
+  AD3 = 2 * mR3(q.y * q.w - q.x * q.z, q.z * q.w + q.x * q.y,
+                Real(0.5) - q.y * q.y - q.z * q.z);
+}
+
+// rotate a vector from the local to the global frame
+inline Real3 Rotate_By_RotationMatrix(const Real3 &A1, const Real3 &A2,
+                                      const Real3 &A3, const Real3 &r3) {
+  return mR3(dot(A1, r3), dot(A2, r3), dot(A3, r3));
+}
+
+// rotate a vector from the global to the local frame
+inline Real3 InverseRotate_By_RotationMatrix(const Real3 &A1, const Real3 &A2,
+                                             const Real3 &A3, const Real3 &r3) {
+  return mR3(A1.x * r3.x + A2.x * r3.y + A3.x * r3.z,
+             A1.y * r3.x + A2.y * r3.y + A3.y * r3.z,
+             A1.z * r3.x + A2.z * r3.y + A3.z * r3.z);
+}
+
+inline int3 calcGridPos(Real3 pos, const SimParams &p) {
+  int3 gridPos;
+  gridPos.x = (int)std::floor((pos.x - p.worldOrigin.x) / p.cellSize.x);
+  gridPos.y = (int)std::floor((pos.y - p.worldOrigin.y) / p.cellSize.y);
+  gridPos.z = (int)std::floor((pos.z - p.worldOrigin.z) / p.cellSize.z);
+  return gridPos;
+}
+
+inline uint calcGridHash(int3 gridPos, const SimParams &p) {
+  gridPos.x -= ((gridPos.x >= p.gridSize.x) ? p.gridSize.x : 0);
+  gridPos.y -= ((gridPos.y >= p.gridSize.y) ? p.gridSize.y : 0);
+  gridPos.z -= ((gridPos.z >= p.gridSize.z) ? p.gridSize.z : 0);
+
+  gridPos.x += ((gridPos.x < 0) ? p.gridSize.x : 0);
+  gridPos.y += ((gridPos.y < 0) ? p.gridSize.y : 0);
+  gridPos.z += ((gridPos.z < 0) ? p.gridSize.z : 0);
+
+  return gridPos.z * p.gridSize.y * p.gridSize.x + gridPos.y * p.gridSize.x +
+         gridPos.x;
+}
+
+// call visit(j) for every (sorted) marker j in the 27 cells around posA
+template <typename Visitor>
+inline void ForEachNeighbor(const Real3 &posA, const SimParams &p,
+                            const uint *cellStart, const uint *cellEnd,
+                            Visitor visit) {
+  int3 gridPos = calcGridPos(posA, p);
+  for (int z = -1; z <= 1; z++) {
+    for (int y = -1; y <= 1; y++) {
+      for (int x = -1; x <= 1; x++) {
+        uint gridHash = calcGridHash(gridPos + mI3(x, y, z), p);
+        uint endIndex = cellEnd[gridHash];
+        for (uint j = cellStart[gridHash]; j < endIndex; j++) {
+          visit(j);
+        }
+      }
+    }
+  }
+}
+
+inline bool isFinite3(const Real3 &v) {
+  return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+inline bool isFinite4(const Real4 &v) {
+  return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z) &&
+         std::isfinite(v.w);
+}
+
+} // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+
+ChFluidDynamicsCpu::ChFluidDynamicsCpu(ChFsiDataManager *otherFsiData,
+                                       SimParams *otherParamsH,
+                                       NumberOfObjects *otherNumObjects)
+    : fsiData(otherFsiData), paramsH(otherParamsH),
+      numObjectsH(otherNumObjects) {}
+
+// -----------------------------------------------------------------------------
+
+ChFluidDynamicsCpu::~ChFluidDynamicsCpu() {}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::Finalize(SphMarkerDataH *sphMarkersH,
+                                  FsiBodiesDataH *fsiBodiesH) {
+  int numAllMarkers = numObjectsH->numAllMarkers;
+  sortedSphMarkersH.resize(numAllMarkers);
+  gridMarkerHashH.resize(numAllMarkers);
+  gridMarkerIndexH.resize(numAllMarkers);
+  mapOriginalToSorted.resize(numAllMarkers);
+  vel_XSPH_SortedH.resize(numAllMarkers);
+  vel_XSPH_H.resize(numAllMarkers);
+  derivVelRhoH.resize(numAllMarkers);
+
+  // Resizing the arrays used to modify the BCE velocity and pressure according
+  // to ADAMI
+  const thrust::host_vector<::int4> &referenceArray =
+      fsiData->fsiGeneralData.referenceArray;
+  int numRigidAndBoundaryMarkers =
+      referenceArray[2 + numObjectsH->numRigidBodies - 1].y -
+      referenceArray[0].y;
+  if ((numObjectsH->numBoundaryMarkers + numObjectsH->numRigid_SphMarkers) !=
+      numRigidAndBoundaryMarkers) {
+    throw std::runtime_error(
+        "Error! number of rigid and boundary markers are saved incorrectly!\n");
+  }
+  velMas_ModifiedBCE.resize(numRigidAndBoundaryMarkers);
+  rhoPreMu_ModifiedBCE.resize(numRigidAndBoundaryMarkers);
+  bceAcc.resize(numObjectsH->numRigid_SphMarkers);
+
+  rigid_FSI_ForcesH.resize(numObjectsH->numRigidBodies);
+  rigid_FSI_TorquesH.resize(numObjectsH->numRigidBodies);
+  rigidIdentifierH.resize(numObjectsH->numRigid_SphMarkers);
+  rigidSPH_MeshPos_LRF_H.resize(numObjectsH->numRigid_SphMarkers);
+
+  if (numObjectsH->numRigidBodies == 0) {
+    return;
+  }
+
+  // Make the rigid identifier: the markers of each rigid body are contiguous
+  for (int rigidSphereA = 0; rigidSphereA < numObjectsH->numRigidBodies;
+       rigidSphereA++) {
+    ::int4 referencePart = referenceArray[2 + rigidSphereA];
+    if (referencePart.z != 1) {
+      throw std::runtime_error("Error! in accessing rigid bodies. Reference "
+                               "array indexing is wrong\n");
+    }
+    for (int i = referencePart.x; i < referencePart.y; i++) {
+      rigidIdentifierH[i - numObjectsH->startRigidMarkers] = rigidSphereA;
+    }
+  }
+
+  // Populate local position of BCE markers
+#pragma omp parallel for
+  for (int index = 0; index < numObjectsH->numRigid_SphMarkers; index++) {
+    int rigidIndex = rigidIdentifierH[index];
+    int rigidMarkerIndex = index + numObjectsH->startRigidMarkers;
+    Real3 a1, a2, a3;
+    RotationMatrixFromQuaternion(a1, a2, a3,
+                                 fsiBodiesH->q_fsiBodies_H[rigidIndex]);
+    Real3 dist3 = sphMarkersH->posRadH[rigidMarkerIndex] -
+                  fsiBodiesH->posRigid_fsiBodies_H[rigidIndex];
+    rigidSPH_MeshPos_LRF_H[index] =
+        InverseRotate_By_RotationMatrix(a1, a2, a3, dist3);
+  }
+
+  UpdateRigidMarkersPositionVelocity(sphMarkersH, fsiBodiesH);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::IntegrateSPH(SphMarkerDataH *sphMarkersH2,
+                                      SphMarkerDataH *sphMarkersH1,
+                                      FsiBodiesDataH *fsiBodiesH1, Real dT) {
+  ArrangeData(sphMarkersH1);
+  ModifyBceVelocity(sphMarkersH1, fsiBodiesH1);
+  CalculateXSPH_velocity();
+  Collide();
+  AddGravityToFluid();
+  UpdateFluid(sphMarkersH2, dT);
+  ApplyBoundarySPH_Markers(sphMarkersH2);
+}
+
+// -----------------------------------------------------------------------------
+// Counting sort of the markers by grid cell. Within a cell the markers keep
+// their original order, so the result is identical to a stable sort by hash.
+
+void ChFluidDynamicsCpu::ArrangeData(SphMarkerDataH *sphMarkersH) {
+  const SimParams &p = *paramsH;
+  int numAllMarkers = numObjectsH->numAllMarkers;
+  if (sphMarkersH->posRadH.size() != numAllMarkers ||
+      gridMarkerHashH.size() != numAllMarkers) {
+    throw std::runtime_error("Error! size error, ArrangeData!\n");
+  }
+  int numCells = p.gridSize.x * p.gridSize.y * p.gridSize.z;
+
+  const Real3 *posRad = sphMarkersH->posRadH.data();
+  uint *gridMarkerHash = gridMarkerHashH.data();
+  Real3 boxMin = p.worldOrigin;
+  Real3 boxMax = p.worldOrigin + p.boxDims;
+
+  bool isError = false;
+#pragma omp parallel for reduction(|| : isError)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real3 pos = posRad[index];
+    if (!isFinite3(pos) || pos.x < boxMin.x || pos.y < boxMin.y ||
+        pos.z < boxMin.z || pos.x > boxMax.x || pos.y > boxMax.y ||
+        pos.z > boxMax.z) {
+      isError = true;
+      continue;
+    }
+    gridMarkerHash[index] = calcGridHash(calcGridPos(pos, p), p);
+  }
+  if (isError) {
+    throw std::runtime_error("Error! particle position is NAN or out of the "
+                             "domain: thrown from ArrangeData!\n");
+  }
+
+  // Count the markers of each cell, then turn the counts into ranges
+  cellStartH.assign(numCells, 0);
+  cellEndH.assign(numCells, 0);
+  for (int index = 0; index < numAllMarkers; index++) {
+    cellEndH[gridMarkerHash[index]]++;
+  }
+  uint start = 0;
+  for (int cell = 0; cell < numCells; cell++) {
+    uint count = cellEndH[cell];
+    cellStartH[cell] = start;
+    cellEndH[cell] = start;
+    start += count;
+  }
+  // cellEndH is used as an insertion cursor and ends past the last marker
+  for (int index = 0; index < numAllMarkers; index++) {
+    gridMarkerIndexH[cellEndH[gridMarkerHash[index]]++] = index;
+  }
+
+  // Reorder the marker data
+#pragma omp parallel for
+  for (int index = 0; index < numAllMarkers; index++) {
+    uint originalIndex = gridMarkerIndexH[index];
+    mapOriginalToSorted[originalIndex] = index;
+    sortedSphMarkersH.posRadH[index] = sphMarkersH->posRadH[originalIndex];
+    sortedSphMarkersH.velMasH[index] = sphMarkersH->velMasH[originalIndex];
+    sortedSphMarkersH.rhoPresMuH[index] =
+        sphMarkersH->rhoPresMuH[originalIndex];
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::CalcBceAcceleration(FsiBodiesDataH *fsiBodiesH) {
+#pragma omp parallel for
+  for (int bceIndex = 0; bceIndex < numObjectsH->numRigid_SphMarkers;
+       bceIndex++) {
+    int rigidBodyIndex = rigidIdentifierH[bceIndex];
+    // linear acceleration (CM)
+    Real3 acc3 = fsiBodiesH->accRigid_fsiBodies_H[rigidBodyIndex];
+
+    Real3 a1, a2, a3;
+    RotationMatrixFromQuaternion(a1, a2, a3,
+                                 fsiBodiesH->q_fsiBodies_H[rigidBodyIndex]);
+    Real3 wVel3 = fsiBodiesH->omegaVelLRF_fsiBodies_H[rigidBodyIndex];
+    Real3 rigidSPH_MeshPos_LRF = rigidSPH_MeshPos_LRF_H[bceIndex];
+    Real3 wVelCrossS = cross(wVel3, rigidSPH_MeshPos_LRF);
+    Real3 wVelCrossWVelCrossS = cross(wVel3, wVelCrossS);
+    // centrifugal acceleration
+    acc3 += Rotate_By_RotationMatrix(a1, a2, a3, wVelCrossWVelCrossS);
+
+    Real3 wAcc3 = fsiBodiesH->omegaAccLRF_fsiBodies_H[rigidBodyIndex];
+    Real3 wAccCrossS = cross(wAcc3, rigidSPH_MeshPos_LRF);
+    // tangential acceleration
+    acc3 += Rotate_By_RotationMatrix(a1, a2, a3, wAccCrossS);
+
+    bceAcc[bceIndex] = acc3;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::ModifyBceVelocity(SphMarkerDataH *sphMarkersH,
+                                           FsiBodiesDataH *fsiBodiesH) {
+  const SimParams &p = *paramsH;
+  const thrust::host_vector<::int4> &referenceArray =
+      fsiData->fsiGeneralData.referenceArray;
+  int2 updatePortion =
+      mI2(referenceArray[0].y,
+          referenceArray[2 + numObjectsH->numRigidBodies - 1].y);
+  int numRigidAndBoundaryMarkers = updatePortion.y - updatePortion.x;
+  if (velMas_ModifiedBCE.size() != numRigidAndBoundaryMarkers ||
+      rhoPreMu_ModifiedBCE.size() != numRigidAndBoundaryMarkers) {
+    throw std::runtime_error("Error! size error velMas_ModifiedBCE and "
+                             "rhoPreMu_ModifiedBCE. Thrown from "
+                             "ModifyBceVelocity!\n");
+  }
+
+  if (p.bceType != ADAMI) {
+    for (int bceIndex = 0; bceIndex < numRigidAndBoundaryMarkers; bceIndex++) {
+      velMas_ModifiedBCE[bceIndex] =
+          sphMarkersH->velMasH[bceIndex + updatePortion.x];
+      rhoPreMu_ModifiedBCE[bceIndex] =
+          sphMarkersH->rhoPresMuH[bceIndex + updatePortion.x];
+    }
+    return;
+  }
+
+  if (numObjectsH->numRigid_SphMarkers > 0) {
+    CalcBceAcceleration(fsiBodiesH);
+  }
+
+  const Real3 *sortedPosRad = sortedSphMarkersH.posRadH.data();
+  const Real3 *sortedVelMas = sortedSphMarkersH.velMasH.data();
+  const Real4 *sortedRhoPreMu = sortedSphMarkersH.rhoPresMuH.data();
+  const uint *cellStart = cellStartH.data();
+  const uint *cellEnd = cellEndH.data();
+  Real cutoff = RESOLUTION_LENGTH_MULT * p.HSML;
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int bceIndex = 0; bceIndex < numRigidAndBoundaryMarkers; bceIndex++) {
+    int sphIndex = bceIndex + updatePortion.x;
+    uint idA = mapOriginalToSorted[sphIndex];
+    Real4 rhoPreMuA = sortedRhoPreMu[idA];
+    Real3 posRadA = sortedPosRad[idA];
+    Real3 velMasA = sortedVelMas[idA];
+
+    bool isAffected = false;
+    Real3 sumVW = mR3(0);
+    Real sumWAll = 0;
+    Real3 sumRhoRW = mR3(0);
+    Real sumPW = 0;
+    Real sumWFluid = 0;
+
+    ForEachNeighbor(posRadA, p, cellStart, cellEnd, [&](uint j) {
+      Real4 rhoPresMuB = sortedRhoPreMu[j];
+      if (rhoPresMuB.w > -.1) {
+        return;
+      }
+      Real3 dist3 = Distance(posRadA, sortedPosRad[j], p);
+      Real d = length(dist3);
+      if (d > cutoff) {
+        return;
+      }
+      Real WdOvRho = W3(d, p) / rhoPresMuB.x;
+      isAffected = true;
+      sumVW += sortedVelMas[j] * WdOvRho;
+      sumWAll += WdOvRho;
+      sumRhoRW += rhoPresMuB.x * dist3 * WdOvRho;
+      sumPW += rhoPresMuB.y * WdOvRho;
+      sumWFluid += WdOvRho;
+    });
+
+    // markers with no fluid neighbor keep their previous values
+    if (!isAffected) {
+      continue;
+    }
+    velMas_ModifiedBCE[bceIndex] = 2 * velMasA - sumVW / sumWAll;
+
+    Real3 a3 = mR3(0);
+    if (std::abs(rhoPreMuA.w) > 0) { // rigid BCE
+      a3 = bceAcc[sphIndex - numObjectsH->startRigidMarkers];
+    }
+    Real pressure = (sumPW + dot(p.gravity - a3, sumRhoRW)) / sumWFluid;
+    rhoPreMu_ModifiedBCE[bceIndex] =
+        mR4(InvEos(pressure, p), pressure, rhoPreMuA.z, rhoPreMuA.w);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::CalculateXSPH_velocity() {
+  const SimParams &p = *paramsH;
+  int numAllMarkers = numObjectsH->numAllMarkers;
+  const Real3 *sortedPosRad = sortedSphMarkersH.posRadH.data();
+  const Real3 *sortedVelMas = sortedSphMarkersH.velMasH.data();
+  const Real4 *sortedRhoPreMu = sortedSphMarkersH.rhoPresMuH.data();
+  const uint *cellStart = cellStartH.data();
+  const uint *cellEnd = cellEndH.data();
+  Real cutoff = RESOLUTION_LENGTH_MULT * p.HSML;
+
+  bool isError = false;
+#pragma omp parallel for schedule(dynamic, 64) reduction(|| : isError)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real4 rhoPreMuA = sortedRhoPreMu[index];
+    Real3 velMasA = sortedVelMas[index];
+    // v_XSPH is calculated only for fluid markers
+    if (rhoPreMuA.w > -0.1) {
+      vel_XSPH_SortedH[index] = velMasA;
+      continue;
+    }
+    Real3 posRadA = sortedPosRad[index];
+    Real3 deltaV = mR3(0);
+
+    ForEachNeighbor(posRadA, p, cellStart, cellEnd, [&](uint j) {
+      if (j == (uint)index) {
+        return;
+      }
+      // B must be fluid, according to colagrossi (2003)
+      Real4 rhoPresMuB = sortedRhoPreMu[j];
+      if (rhoPresMuB.w > -.1) {
+        return;
+      }
+      Real d = length(Distance(posRadA, sortedPosRad[j], p));
+      if (d > cutoff) {
+        return;
+      }
+      Real multRho = 2 / (rhoPreMuA.x + rhoPresMuB.x);
+      deltaV += p.markerMass * (sortedVelMas[j] - velMasA) * W3(d, p) * multRho;
+    });
+
+    Real3 vXSPH = velMasA + p.EPS_XSPH * deltaV;
+    if (!isFinite3(vXSPH)) {
+      isError = true;
+    }
+    vel_XSPH_SortedH[index] = vXSPH;
+  }
+  if (isError) {
+    throw std::runtime_error("Error! particle vXSPH is NAN: thrown from "
+                             "CalculateXSPH_velocity!\n");
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The results are written directly at the original index of each marker, which
+// makes the sort back to the original order of the device version unnecessary.
+
+void ChFluidDynamicsCpu::Collide() {
+  const SimParams &p = *paramsH;
+  int numAllMarkers = numObjectsH->numAllMarkers;
+  int numFluidMarkers = numObjectsH->numFluidMarkers;
+  int numBceMarkers =
+      numObjectsH->numBoundaryMarkers + numObjectsH->numRigid_SphMarkers;
+  const Real3 *sortedPosRad = sortedSphMarkersH.posRadH.data();
+  const Real3 *sortedVelMas = sortedSphMarkersH.velMasH.data();
+  const Real4 *sortedRhoPreMu = sortedSphMarkersH.rhoPresMuH.data();
+  const Real3 *vel_XSPH_Sorted = vel_XSPH_SortedH.data();
+  const uint *gridMarkerIndex = gridMarkerIndexH.data();
+  const uint *cellStart = cellStartH.data();
+  const uint *cellEnd = cellEndH.data();
+  Real cutoff = RESOLUTION_LENGTH_MULT * p.HSML;
+
+  bool isError = false;
+#pragma omp parallel for schedule(dynamic, 64) reduction(|| : isError)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real3 posRadA = sortedPosRad[index];
+    Real3 velMasA = sortedVelMas[index];
+    Real4 rhoPreMuA = sortedRhoPreMu[index];
+    Real3 vel_XSPH_A = vel_XSPH_Sorted[index];
+    Real4 derivVelRho = mR4(0);
+
+    ForEachNeighbor(posRadA, p, cellStart, cellEnd, [&](uint j) {
+      if (j == (uint)index) {
+        return;
+      }
+      Real4 rhoPresMuB = sortedRhoPreMu[j];
+      // no rigid-rigid force
+      if (rhoPreMuA.w > -.1 && rhoPresMuB.w > -.1) {
+        return;
+      }
+      Real3 posRadB = sortedPosRad[j];
+      Real3 dist3Alpha = posRadA - posRadB;
+      Real3 dist3 = Modify_Local_PosB(posRadB, posRadA, p);
+      Real d = length(dist3);
+      if (d > cutoff) {
+        return;
+      }
+
+      modifyPressure(rhoPresMuB, dist3Alpha, p);
+      Real3 velMasB = sortedVelMas[j];
+      if (rhoPresMuB.w > -.1) {
+        int bceIndexB = gridMarkerIndex[j] - numFluidMarkers;
+        if (bceIndexB < 0 || bceIndexB >= numBceMarkers) {
+          isError = true;
+          return;
+        }
+        rhoPresMuB = rhoPreMu_ModifiedBCE[bceIndexB];
+        velMasB = velMas_ModifiedBCE[bceIndexB];
+      }
+      derivVelRho +=
+          DifVelocityRho(dist3, d, velMasA, vel_XSPH_A, velMasB,
+                         vel_XSPH_Sorted[j], rhoPreMuA, rhoPresMuB, 1, p);
+    });
+
+    if (!isFinite4(derivVelRho)) {
+      isError = true;
+    }
+    uint originalIndex = gridMarkerIndex[index];
+    derivVelRhoH[originalIndex] = derivVelRho;
+    vel_XSPH_H[originalIndex] = vel_XSPH_A;
+  }
+  if (isError) {
+    throw std::runtime_error("Error! particle derivVelRho is NAN or bceIndex "
+                             "out of bound: thrown from Collide!\n");
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Gravity is not added to rigids, BCE, and boundaries; it is added in ChSystem
+
+void ChFluidDynamicsCpu::AddGravityToFluid() {
+  Real4 totalFluidBodyForce4 = mR4(paramsH->bodyForce3 + paramsH->gravity, 0);
+  const ::int4 &fluidPortion = fsiData->fsiGeneralData.referenceArray[0];
+#pragma omp parallel for
+  for (int index = fluidPortion.x; index < fluidPortion.y; index++) {
+    derivVelRhoH[index] += totalFluidBodyForce4;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::UpdateFluid(SphMarkerDataH *sphMarkersH, Real dT) {
+  const SimParams &p = *paramsH;
+  const thrust::host_vector<::int4> &referenceArray =
+      fsiData->fsiGeneralData.referenceArray;
+  int numMarkers = referenceArray[referenceArray.size() - 1].y;
+  Real maxVel = p.tweakMultV * p.HSML / p.dT;
+  Real maxDerivRho = p.tweakMultRho * p.rho0 / p.dT;
+
+  bool isError = false;
+#pragma omp parallel for reduction(|| : isError)
+  for (int index = 0; index < numMarkers; index++) {
+    Real4 derivVelRho = derivVelRhoH[index];
+    Real4 rhoPresMu = sphMarkersH->rhoPresMuH[index];
+
+    if (rhoPresMu.w < 0) {
+      // ** position
+      Real3 vel_XSPH = vel_XSPH_H[index];
+      if (!isFinite3(vel_XSPH)) {
+        if (!p.enableAggressiveTweak) {
+          isError = true;
+          continue;
+        }
+        vel_XSPH = mR3(0);
+      }
+      if (p.enableTweak && length(vel_XSPH) > maxVel) {
+        vel_XSPH *= maxVel / length(vel_XSPH);
+      }
+      Real3 updatedPosition = sphMarkersH->posRadH[index] + vel_XSPH * dT;
+      if (!isFinite3(updatedPosition)) {
+        isError = true;
+        continue;
+      }
+      sphMarkersH->posRadH[index] = updatedPosition;
+
+      // ** velocity
+      Real3 updatedVelocity =
+          sphMarkersH->velMasH[index] + mR3(derivVelRho) * dT;
+      if (!isFinite3(updatedVelocity)) {
+        if (!p.enableAggressiveTweak) {
+          isError = true;
+          continue;
+        }
+        updatedVelocity = mR3(0);
+      }
+      if (p.enableTweak && length(updatedVelocity) > maxVel) {
+        updatedVelocity *= maxVel / length(updatedVelocity);
+      }
+      sphMarkersH->velMasH[index] = updatedVelocity;
+    }
+
+    // ** density and pressure
+    if (!std::isfinite(derivVelRho.w)) {
+      if (!p.enableAggressiveTweak) {
+        isError = true;
+        continue;
+      }
+      derivVelRho.w = 0;
+    }
+    if (p.enableTweak && std::abs(derivVelRho.w) > maxDerivRho) {
+      // to take care of the sign as well
+      derivVelRho.w *= maxDerivRho / std::abs(derivVelRho.w);
+    }
+    Real rho2 = rhoPresMu.x + derivVelRho.w * dT;
+    rhoPresMu.y = Eos(rho2, p);
+    rhoPresMu.x = rho2;
+    if (!isFinite4(rhoPresMu)) {
+      isError = true;
+      continue;
+    }
+    sphMarkersH->rhoPresMuH[index] = rhoPresMu;
+  }
+  if (isError) {
+    throw std::runtime_error("Error! particle state is NAN: thrown from "
+                             "UpdateFluid!\n");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::ApplyBoundarySPH_Markers(SphMarkerDataH *sphMarkersH) {
+  const SimParams &p = *paramsH;
+  Real3 period = p.cMax - p.cMin;
+  int numAllMarkers = numObjectsH->numAllMarkers;
+
+#pragma omp parallel for
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real4 rhoPresMu = sphMarkersH->rhoPresMuH[index];
+    // no need to do anything if it is a boundary particle
+    if (std::abs(rhoPresMu.w) < .1) {
+      continue;
+    }
+    bool isFluid = rhoPresMu.w < -.1;
+    Real3 posRad = sphMarkersH->posRadH[index];
+
+    if (posRad.x > p.cMax.x) {
+      posRad.x -= period.x;
+      rhoPresMu.y += isFluid ? p.deltaPress.x : 0;
+    } else if (posRad.x < p.cMin.x) {
+      posRad.x += period.x;
+      rhoPresMu.y -= isFluid ? p.deltaPress.x : 0;
+    }
+    if (posRad.y > p.cMax.y) {
+      posRad.y -= period.y;
+      rhoPresMu.y += isFluid ? p.deltaPress.y : 0;
+    } else if (posRad.y < p.cMin.y) {
+      posRad.y += period.y;
+      rhoPresMu.y -= isFluid ? p.deltaPress.y : 0;
+    }
+    if (posRad.z > p.cMax.z) {
+      posRad.z -= period.z;
+      rhoPresMu.y += isFluid ? p.deltaPress.z : 0;
+    } else if (posRad.z < p.cMin.z) {
+      posRad.z += period.z;
+      rhoPresMu.y -= isFluid ? p.deltaPress.z : 0;
+    }
+
+    sphMarkersH->posRadH[index] = posRad;
+    sphMarkersH->rhoPresMuH[index] = rhoPresMu;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::DensityReinitialization(SphMarkerDataH *sphMarkersH) {
+  const SimParams &p = *paramsH;
+  ArrangeData(sphMarkersH);
+
+  int numAllMarkers = numObjectsH->numAllMarkers;
+  const Real3 *sortedPosRad = sortedSphMarkersH.posRadH.data();
+  const Real4 *sortedRhoPreMu = sortedSphMarkersH.rhoPresMuH.data();
+  const uint *cellStart = cellStartH.data();
+  const uint *cellEnd = cellEndH.data();
+  Real cutoff = RESOLUTION_LENGTH_MULT * p.HSML;
+  // include the particle in its summation as well
+  Real selfDensity = p.markerMass * W3(0, p);
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int index = 0; index < numAllMarkers; index++) {
+    Real4 rhoPreMuA = sortedRhoPreMu[index];
+    if (rhoPreMuA.w > -.1) {
+      continue;
+    }
+    Real3 posRadA = sortedPosRad[index];
+    Real densityShare = 0;
+    Real denominator = 0;
+
+    ForEachNeighbor(posRadA, p, cellStart, cellEnd, [&](uint j) {
+      if (j == (uint)index) {
+        return;
+      }
+      Real d = length(Distance(posRadA, sortedPosRad[j], p));
+      if (d > cutoff) {
+        return;
+      }
+      Real partialDensity = p.markerMass * W3(d, p);
+      densityShare += partialDensity;
+      denominator += partialDensity / sortedRhoPreMu[j].x;
+    });
+
+    Real newDensity = densityShare + selfDensity;
+    Real newDenominator = denominator + selfDensity / rhoPreMuA.x;
+    rhoPreMuA.x = newDensity / newDenominator;
+    rhoPreMuA.y = Eos(rhoPreMuA.x, p);
+    sphMarkersH->rhoPresMuH[gridMarkerIndexH[index]] = rhoPreMuA;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The force is the mass-weighted sum of the accelerations of the BCE markers
+// of each body; the torque is taken about the current position of the body.
+
+void ChFluidDynamicsCpu::Rigid_Forces_Torques(SphMarkerDataH *sphMarkersH,
+                                              FsiBodiesDataH *fsiBodiesH) {
+  if (numObjectsH->numRigidBodies == 0) {
+    return;
+  }
+  const SimParams &p = *paramsH;
+  const thrust::host_vector<::int4> &referenceArray =
+      fsiData->fsiGeneralData.referenceArray;
+
+#pragma omp parallel for
+  for (int rigidSphereA = 0; rigidSphereA < numObjectsH->numRigidBodies;
+       rigidSphereA++) {
+    ::int4 referencePart = referenceArray[2 + rigidSphereA];
+    Real3 posRigid = fsiBodiesH->posRigid_fsiBodies_H[rigidSphereA];
+    Real3 force3 = mR3(0);
+    Real3 torque3 = mR3(0);
+    for (int index = referencePart.x; index < referencePart.y; index++) {
+      Real3 acc3 = mR3(derivVelRhoH[index]);
+      force3 += acc3;
+      torque3 += cross(Distance(sphMarkersH->posRadH[index], posRigid, p), acc3);
+    }
+    // markerMass converts from SPH acceleration to force
+    rigid_FSI_ForcesH[rigidSphereA] = p.markerMass * force3;
+    rigid_FSI_TorquesH[rigidSphereA] = p.markerMass * torque3;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamicsCpu::UpdateRigidMarkersPositionVelocity(
+    SphMarkerDataH *sphMarkersH, FsiBodiesDataH *fsiBodiesH) {
+  if (numObjectsH->numRigidBodies == 0) {
+    return;
+  }
+
+#pragma omp parallel for
+  for (int index = 0; index < numObjectsH->numRigid_SphMarkers; index++) {
+    int rigidMarkerIndex = index + numObjectsH->startRigidMarkers;
+    int rigidBodyIndex = rigidIdentifierH[index];
+
+    Real3 a1, a2, a3;
+    RotationMatrixFromQuaternion(a1, a2, a3,
+                                 fsiBodiesH->q_fsiBodies_H[rigidBodyIndex]);
+    Real3 rigidSPH_MeshPos_LRF = rigidSPH_MeshPos_LRF_H[index];
+
+    // position
+    sphMarkersH->posRadH[rigidMarkerIndex] =
+        fsiBodiesH->posRigid_fsiBodies_H[rigidBodyIndex] +
+        Rotate_By_RotationMatrix(a1, a2, a3, rigidSPH_MeshPos_LRF);
+
+    // velocity
+    Real3 omegaCrossS =
+        cross(fsiBodiesH->omegaVelLRF_fsiBodies_H[rigidBodyIndex],
+              rigidSPH_MeshPos_LRF);
+    sphMarkersH->velMasH[rigidMarkerIndex] =
+        mR3(fsiBodiesH->velMassRigid_fsiBodies_H[rigidBodyIndex]) +
+        Rotate_By_RotationMatrix(a1, a2, a3, omegaCrossS);
+  }
+}
+
+} // end namespace fsi
+} // end namespace chrono
@@ -0,0 +1,145 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Host implementation of the SPH fluid dynamics, parallelized with OpenMP.
+// =============================================================================
+
+#ifndef CH_FLUIDDYNAMICSCPU_H_
+#define CH_FLUIDDYNAMICSCPU_H_
+
+#include "chrono_fsi/ChApiFsi.h"
+#include "chrono_fsi/ChFsiDataManager.cuh"
+
+namespace chrono {
+namespace fsi {
+
+/// Host (CPU) implementation of the fluid dynamics system.
+///
+/// This class performs on the host the same sequence of operations as the
+/// device implementation spread over ChCollisionSystemFsi, ChBce,
+/// ChFsiForceParallel and ChFluidDynamics: the markers are binned in the
+/// uniform grid defined by the simulation parameters, the boundary condition
+/// enforcing (BCE) markers are modified, the XSPH velocity and the derivatives
+/// of velocity and density are computed from the 27 neighbor cells of each
+/// marker, and the fluid is advanced with an explicit Euler step. All marker
+/// loops are parallelized with OpenMP. The markers are processed in cell order
+/// so that the data of the neighbors is read from contiguous memory.
+///
+/// All data is kept in host vectors; no CUDA device is required at run time.
+class CH_FSI_API ChFluidDynamicsCpu {
+public:
+  /// Constructor of the host fluid dynamics system. The data manager,
+  /// simulation parameters and number of objects are shared with the fsi
+  /// system.
+  ChFluidDynamicsCpu(ChFsiDataManager *otherFsiData, SimParams *otherParamsH,
+                     NumberOfObjects *otherNumObjects);
+
+  /// Destructor of the host fluid dynamics system.
+  ~ChFluidDynamicsCpu();
+
+  /// Allocate the work arrays and compute the position of the BCE markers in
+  /// the local frame of their rigid body. Must be called once the data
+  /// manager is resized and the number of objects is known.
+  void Finalize(SphMarkerDataH *sphMarkersH, FsiBodiesDataH *fsiBodiesH);
+
+  /// Integrate the fluid over a time step dT. The forces are evaluated using
+  /// the markers in sphMarkersH1 and the rigid bodies in fsiBodiesH1; the
+  /// update is applied to sphMarkersH2.
+  void IntegrateSPH(SphMarkerDataH *sphMarkersH2, SphMarkerDataH *sphMarkersH1,
+                    FsiBodiesDataH *fsiBodiesH1, Real dT);
+
+  /// Recompute the density of the fluid markers from a kernel summation over
+  /// their neighbors, and update their pressure accordingly.
+  void DensityReinitialization(SphMarkerDataH *sphMarkersH);
+
+  /// Accumulate the forces and torques exerted by the fluid on each rigid body
+  /// from the accelerations of its BCE markers, computed by the last call to
+  /// IntegrateSPH().
+  void Rigid_Forces_Torques(SphMarkerDataH *sphMarkersH,
+                            FsiBodiesDataH *fsiBodiesH);
+
+  /// Update the position and velocity of the BCE markers from the state of
+  /// their rigid bodies.
+  void UpdateRigidMarkersPositionVelocity(SphMarkerDataH *sphMarkersH,
+                                          FsiBodiesDataH *fsiBodiesH);
+
+  /// Return the fluid forces on the rigid bodies.
+  const thrust::host_vector<Real3> &GetRigidForces() const {
+    return rigid_FSI_ForcesH;
+  }
+
+  /// Return the fluid torques on the rigid bodies.
+  const thrust::host_vector<Real3> &GetRigidTorques() const {
+    return rigid_FSI_TorquesH;
+  }
+
+private:
+  /// Compute the grid hash of all markers and sort them by cell. Fills the
+  /// sorted marker data, the cell ranges and the maps between the original
+  /// and sorted orders.
+  void ArrangeData(SphMarkerDataH *sphMarkersH);
+
+  /// Set the velocity and pressure used for the BCE markers (ADAMI), or copy
+  /// them from the markers (mORIGINAL).
+  void ModifyBceVelocity(SphMarkerDataH *sphMarkersH,
+                         FsiBodiesDataH *fsiBodiesH);
+
+  /// Compute the acceleration of the rigid BCE markers, required by ADAMI.
+  void CalcBceAcceleration(FsiBodiesDataH *fsiBodiesH);
+
+  /// Compute the XSPH velocity of the markers, in sorted order.
+  void CalculateXSPH_velocity();
+
+  /// Compute the derivatives of velocity and density of all markers and store
+  /// them, together with the XSPH velocity, in the original order.
+  void Collide();
+
+  /// Add the gravity and body force to the fluid markers.
+  void AddGravityToFluid();
+
+  /// Explicit Euler update of the markers; pressure follows from the equation
+  /// of state.
+  void UpdateFluid(SphMarkerDataH *sphMarkersH, Real dT);
+
+  /// Apply the periodic boundary conditions in x, y and z.
+  void ApplyBoundarySPH_Markers(SphMarkerDataH *sphMarkersH);
+
+  ChFsiDataManager *fsiData;    ///< pointer to the data manager
+  SimParams *paramsH;           ///< pointer to the simulation parameters
+  NumberOfObjects *numObjectsH; ///< pointer to the number of objects
+
+  SphMarkerDataH sortedSphMarkersH;               ///< markers sorted by cell
+  thrust::host_vector<uint> gridMarkerHashH;      ///< cell of each marker
+  thrust::host_vector<uint> gridMarkerIndexH;     ///< sorted to original
+  thrust::host_vector<uint> mapOriginalToSorted;  ///< original to sorted
+  thrust::host_vector<uint> cellStartH;           ///< first marker of a cell
+  thrust::host_vector<uint> cellEndH;             ///< past the last marker
+
+  thrust::host_vector<Real3> vel_XSPH_SortedH; ///< XSPH velocity, sorted
+  thrust::host_vector<Real3> vel_XSPH_H;       ///< XSPH velocity, original
+  thrust::host_vector<Real4> derivVelRhoH;     ///< derivatives, original
+
+  thrust::host_vector<Real3> velMas_ModifiedBCE;   ///< BCE velocity (ADAMI)
+  thrust::host_vector<Real4> rhoPreMu_ModifiedBCE; ///< BCE pressure (ADAMI)
+  thrust::host_vector<Real3> bceAcc; ///< acceleration of the rigid BCE markers
+
+  thrust::host_vector<Real3> rigidSPH_MeshPos_LRF_H; ///< BCE local position
+  thrust::host_vector<uint> rigidIdentifierH; ///< rigid body of BCE markers
+
+  thrust::host_vector<Real3> rigid_FSI_ForcesH;  ///< fluid force on bodies
+  thrust::host_vector<Real3> rigid_FSI_TorquesH; ///< fluid torque on bodies
+};
+
+} // end namespace fsi
+} // end namespace chrono
+
+#endif
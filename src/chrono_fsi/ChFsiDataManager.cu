@@ -350,5 +350,18 @@ void ChFsiDataManager::ResizeDataManager() {
   fsiGeneralData.rigidSPH_MeshPos_LRF_D.resize(numObjects.numRigid_SphMarkers);
 }
 
+void ChFsiDataManager::ResizeHostDataManager() {
+  ConstructReferenceArray();
+  if (numObjects.numAllMarkers != sphMarkersH.rhoPresMuH.size()) {
+    throw std::runtime_error(
+        "Error! numObjects wrong! thrown from ResizeHostDataManager !\n");
+  }
+  sphMarkersH.resize(numObjects.numAllMarkers);
+  sphMarkersH2 = sphMarkersH;
+
+  fsiBodiesH.resize(numObjects.numRigidBodies);
+  fsiBodiesH2.resize(numObjects.numRigidBodies);
+}
+
 } // end namespace fsi
 } // end namespace chrono
@@ -209,6 +209,9 @@ public:
 
   void AddSphMarker(Real3 pos, Real3 vel, Real4 rhoPresMu);
   void ResizeDataManager();
+  /// Resize only the host arrays, used by the CPU backend. No device memory
+  /// is allocated.
+  void ResizeHostDataManager();
 
   NumberOfObjects numObjects;
 
@@ -216,10 +219,12 @@ public:
   SphMarkerDataD sphMarkersD2;
   SphMarkerDataD sortedSphMarkersD;
   SphMarkerDataH sphMarkersH;
+  SphMarkerDataH sphMarkersH2; // half step markers, CPU backend only
 
   FsiBodiesDataD fsiBodiesD1;
   FsiBodiesDataD fsiBodiesD2;
   FsiBodiesDataH fsiBodiesH;
+  FsiBodiesDataH fsiBodiesH2; // half step bodies, CPU backend only
 
   FsiGeneralData fsiGeneralData;
 
@@ -44,6 +44,14 @@ ChFsiInterface::~ChFsiInterface() {
 // FSI_Bodies_Index_H[i] is the the index of the i_th sph represented rigid body
 // in ChSystem
 void ChFsiInterface::Add_Rigid_ForceTorques_To_ChSystem() {
+  thrust::host_vector<Real3> rigid_FSI_ForcesH = *rigid_FSI_ForcesD;
+  thrust::host_vector<Real3> rigid_FSI_TorquesH = *rigid_FSI_TorquesD;
+  Add_Rigid_ForceTorques_To_ChSystem(rigid_FSI_ForcesH, rigid_FSI_TorquesH);
+}
+//------------------------------------------------------------------------------------
+void ChFsiInterface::Add_Rigid_ForceTorques_To_ChSystem(
+    const thrust::host_vector<Real3> &rigid_FSI_ForcesH,
+    const thrust::host_vector<Real3> &rigid_FSI_TorquesH) {
   int numRigids = fsiBodeisPtr->size();
   //#pragma omp parallel for // Arman: you can bring it back later, when you
   //have a lot of bodies
@@ -96,9 +104,9 @@ void ChFsiInterface::Add_Rigid_ForceTorques_To_ChSystem() {
     }
 
     chrono::ChVector<> mforce =
-        ChFsiTypeConvert::Real3ToChVector((*rigid_FSI_ForcesD)[i]);
+        ChFsiTypeConvert::Real3ToChVector(rigid_FSI_ForcesH[i]);
     chrono::ChVector<> mtorque =
-        ChFsiTypeConvert::Real3ToChVector((*rigid_FSI_TorquesD)[i]);
+        ChFsiTypeConvert::Real3ToChVector(rigid_FSI_TorquesH[i]);
 
     hydroForce->SetVpoint(bodyPtr->GetPos());
     hydroForce->SetMforce(mforce.Length());
@@ -175,27 +183,32 @@ void ChFsiInterface::Copy_ChSystem_to_External() {
 // in ChSystem
 void ChFsiInterface::Copy_fsiBodies_ChSystem_to_FluidSystem(
     FsiBodiesDataD *fsiBodiesD) {
+  Copy_fsiBodies_ChSystem_to_FluidSystem(fsiBodiesH);
+  fsiBodiesD->CopyFromH(*fsiBodiesH);
+}
+//------------------------------------------------------------------------------------
+void ChFsiInterface::Copy_fsiBodies_ChSystem_to_FluidSystem(
+    FsiBodiesDataH *fsiBodiesTarget) {
   //#pragma omp parallel for // Arman: you can bring it back later, when you
   //have a lot of bodies
   int num_fsiBodies_Rigids = fsiBodeisPtr->size();
   for (int i = 0; i < num_fsiBodies_Rigids; i++) {
     auto bodyPtr = (*fsiBodeisPtr)[i];
-    fsiBodiesH->posRigid_fsiBodies_H[i] =
+    fsiBodiesTarget->posRigid_fsiBodies_H[i] =
         ChFsiTypeConvert::ChVectorToReal3(bodyPtr->GetPos());
-    fsiBodiesH->velMassRigid_fsiBodies_H[i] =
+    fsiBodiesTarget->velMassRigid_fsiBodies_H[i] =
         ChFsiTypeConvert::ChVectorRToReal4(bodyPtr->GetPos_dt(),
                                            bodyPtr->GetMass());
-    fsiBodiesH->accRigid_fsiBodies_H[i] =
+    fsiBodiesTarget->accRigid_fsiBodies_H[i] =
         ChFsiTypeConvert::ChVectorToReal3(bodyPtr->GetPos_dtdt());
 
-    fsiBodiesH->q_fsiBodies_H[i] =
+    fsiBodiesTarget->q_fsiBodies_H[i] =
         ChFsiTypeConvert::ChQuaternionToReal4(bodyPtr->GetRot());
-    fsiBodiesH->omegaVelLRF_fsiBodies_H[i] =
+    fsiBodiesTarget->omegaVelLRF_fsiBodies_H[i] =
         ChFsiTypeConvert::ChVectorToReal3(bodyPtr->GetWvel_loc());
-    fsiBodiesH->omegaAccLRF_fsiBodies_H[i] =
+    fsiBodiesTarget->omegaAccLRF_fsiBodies_H[i] =
         ChFsiTypeConvert::ChVectorToReal3(bodyPtr->GetWacc_loc());
   }
-  fsiBodiesD->CopyFromH(*fsiBodiesH);
 }
 //------------------------------------------------------------------------------------
 void ChFsiInterface::ResizeChronoBodiesData() {
@@ -35,10 +35,17 @@ public:
   ~ChFsiInterface(); // TODO
 
   virtual void Add_Rigid_ForceTorques_To_ChSystem();
+  /// Apply forces and torques already available on the host (CPU backend).
+  virtual void Add_Rigid_ForceTorques_To_ChSystem(
+      const thrust::host_vector<Real3> &rigid_FSI_ForcesH,
+      const thrust::host_vector<Real3> &rigid_FSI_TorquesH);
   virtual void Copy_External_To_ChSystem();
   virtual void Copy_ChSystem_to_External();
   virtual void
   Copy_fsiBodies_ChSystem_to_FluidSystem(FsiBodiesDataD *fsiBodiesD);
+  /// Copy the state of the fsi bodies to host data only (CPU backend).
+  virtual void
+  Copy_fsiBodies_ChSystem_to_FluidSystem(FsiBodiesDataH *fsiBodiesTarget);
   virtual void ResizeChronoBodiesData();
 
 private:
@@ -28,7 +28,7 @@ namespace fsi {
 
 ChSystemFsi::ChSystemFsi(ChSystem *other_physicalSystem, bool other_haveFluid)
     : mphysicalSystem(other_physicalSystem), haveFluid(other_haveFluid),
-      mTime(0) {
+      mTime(0), fluidBackend(ChFsiBackend::GPU) {
   fsiData = new ChFsiDataManager();
   paramsH = new SimParams;
   fsiBodeisPtr.resize(0);
@@ -38,6 +38,7 @@ ChSystemFsi::ChSystemFsi(ChSystem *other_physicalSystem, bool other_haveFluid)
       new ChBce(&(fsiData->sortedSphMarkersD), &(fsiData->markersProximityD),
                 &(fsiData->fsiGeneralData), paramsH, numObjectsH);
   fluidDynamics = new ChFluidDynamics(bceWorker, fsiData, paramsH, numObjectsH);
+  fluidDynamicsCpu = new ChFluidDynamicsCpu(fsiData, paramsH, numObjectsH);
   fsiInterface =
       new ChFsiInterface(&(fsiData->fsiBodiesH), mphysicalSystem, &fsiBodeisPtr,
                          &(fsiData->fsiGeneralData.rigid_FSI_ForcesD),
@@ -47,7 +48,9 @@ ChSystemFsi::ChSystemFsi(ChSystem *other_physicalSystem, bool other_haveFluid)
 
 void ChSystemFsi::Finalize() {
   FinalizeData();
-  if (haveFluid) {
+  if (haveFluid && fluidBackend == ChFsiBackend::CPU) {
+    fluidDynamicsCpu->Finalize(&(fsiData->sphMarkersH), &(fsiData->fsiBodiesH));
+  } else if (haveFluid) {
     bceWorker->Finalize(&(fsiData->sphMarkersD1), &(fsiData->fsiBodiesD1));
     fluidDynamics->Finalize();
   }
@@ -59,6 +62,7 @@ ChSystemFsi::~ChSystemFsi() {
   delete paramsH;
   delete bceWorker;
   delete fluidDynamics;
+  delete fluidDynamicsCpu;
   delete fsiInterface;
 }
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -88,6 +92,10 @@ int ChSystemFsi::DoStepChronoSystem(Real dT, double mTime) {
 //--------------------------------------------------------------------------------------------------------------------------------
 
 void ChSystemFsi::DoStepDynamics_FSI() {
+  if (fluidBackend == ChFsiBackend::CPU) {
+    DoStepDynamics_FSI_Cpu();
+    return;
+  }
   fsiInterface->Copy_ChSystem_to_External();
   this->CopyDeviceDataToHalfStep();
   ChDeviceUtils::FillMyThrust4(fsiData->fsiGeneralData.derivVelRhoD, mR4(0));
@@ -137,6 +145,52 @@ void ChSystemFsi::DoStepDynamics_FSI() {
   }
 }
 
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChSystemFsi::DoStepDynamics_FSI_Cpu() {
+  fsiInterface->Copy_ChSystem_to_External();
+  fsiData->sphMarkersH2 = fsiData->sphMarkersH;
+  fluidDynamicsCpu->IntegrateSPH(&(fsiData->sphMarkersH2),
+                                 &(fsiData->sphMarkersH),
+                                 &(fsiData->fsiBodiesH), 0.5 * paramsH->dT);
+
+  fluidDynamicsCpu->Rigid_Forces_Torques(&(fsiData->sphMarkersH),
+                                         &(fsiData->fsiBodiesH));
+  fsiInterface->Add_Rigid_ForceTorques_To_ChSystem(
+      fluidDynamicsCpu->GetRigidForces(), fluidDynamicsCpu->GetRigidTorques());
+  mTime += 0.5 * paramsH->dT;
+
+  DoStepChronoSystem(0.5 * paramsH->dT, mTime);
+
+  fsiInterface->Copy_fsiBodies_ChSystem_to_FluidSystem(&(fsiData->fsiBodiesH2));
+  fluidDynamicsCpu->UpdateRigidMarkersPositionVelocity(
+      &(fsiData->sphMarkersH2), &(fsiData->fsiBodiesH2));
+
+  fluidDynamicsCpu->IntegrateSPH(&(fsiData->sphMarkersH),
+                                 &(fsiData->sphMarkersH2),
+                                 &(fsiData->fsiBodiesH2), paramsH->dT);
+
+  fluidDynamicsCpu->Rigid_Forces_Torques(&(fsiData->sphMarkersH2),
+                                         &(fsiData->fsiBodiesH2));
+  fsiInterface->Add_Rigid_ForceTorques_To_ChSystem(
+      fluidDynamicsCpu->GetRigidForces(), fluidDynamicsCpu->GetRigidTorques());
+
+  mTime -= 0.5 * paramsH->dT;
+  fsiInterface->Copy_External_To_ChSystem();
+  mTime += paramsH->dT;
+
+  DoStepChronoSystem(1.0 * paramsH->dT, mTime);
+
+  fsiInterface->Copy_fsiBodies_ChSystem_to_FluidSystem(&(fsiData->fsiBodiesH));
+  fluidDynamicsCpu->UpdateRigidMarkersPositionVelocity(&(fsiData->sphMarkersH),
+                                                       &(fsiData->fsiBodiesH));
+
+  // Density re-initialization
+  int tStep = mTime / paramsH->dT;
+  if ((tStep % 10 == 0) && (paramsH->densityReinit != 0)) {
+    fluidDynamicsCpu->DensityReinitialization(&(fsiData->sphMarkersH));
+  }
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 void ChSystemFsi::DoStepDynamics_ChronoRK2() {
   fsiInterface->Copy_ChSystem_to_External();
@@ -154,6 +208,13 @@ void ChSystemFsi::DoStepDynamics_ChronoRK2() {
 
 //--------------------------------------------------------------------------------------------------------------------------------
 void ChSystemFsi::FinalizeData() {
+  if (fluidBackend == ChFsiBackend::CPU) {
+    fsiData->ResizeHostDataManager();
+    fsiInterface->ResizeChronoBodiesData();
+    fsiInterface->Copy_fsiBodies_ChSystem_to_FluidSystem(&(fsiData->fsiBodiesH));
+    fsiData->fsiBodiesH2 = fsiData->fsiBodiesH;
+    return;
+  }
   fsiData->ResizeDataManager();
   // Arman: very important: you cannot change the order of (1-3). Fix the issue
   // later
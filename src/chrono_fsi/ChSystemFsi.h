@@ -23,6 +23,7 @@
 #include "chrono/physics/ChSystem.h"
 #include "chrono_fsi/ChBce.cuh"
 #include "chrono_fsi/ChFluidDynamics.cuh"
+#include "chrono_fsi/ChFluidDynamicsCpu.h"
 #include "chrono_fsi/ChFsiDataManager.cuh"
 #include "chrono_fsi/ChFsiInterface.h"
 
@@ -33,6 +34,12 @@
 namespace chrono {
 namespace fsi {
 
+/// Hardware used to integrate the fluid dynamics
+enum class ChFsiBackend {
+  GPU, ///< CUDA implementation (default)
+  CPU  ///< host implementation, parallelized with OpenMP
+};
+
 /// Physical system for fluid-solid interaction problem
 ///
 /// This class is used to represent a fluid-solid interaction problem consist of
@@ -101,18 +108,31 @@ public:
   /// system have fluid.
   virtual void Finalize();
 
+  /// Select the hardware used for the fluid dynamics. Must be called before
+  /// Finalize(). With the CPU backend, all fluid data stays on the host and no
+  /// CUDA device is needed at run time.
+  void SetBackend(ChFsiBackend backend) { fluidBackend = backend; }
+
+  /// Return the hardware used for the fluid dynamics.
+  ChFsiBackend GetBackend() const { return fluidBackend; }
+
 private:
   /// Integrate the chrono system based on an explicit Euler scheme.
   int DoStepChronoSystem(Real dT, double mTime);
 
+  /// Same time integration as DoStepDynamics_FSI, on host data.
+  void DoStepDynamics_FSI_Cpu();
+
   ChFsiDataManager
       *fsiData; ///< pointer to data manager which holds all the data
   std::vector<std::shared_ptr<ChBody>>
       fsiBodeisPtr; ///< vector of a pointers to fsi bodies. fsi bodies
                     /// are those that interact with fluid
-  ChFluidDynamics *fluidDynamics; ///< pointer to the fluid system
-  ChFsiInterface *fsiInterface;   ///< pointer to the fsi interface system
-  ChBce *bceWorker;               ///< pointer to the bce workers
+  ChFluidDynamics *fluidDynamics;       ///< pointer to the fluid system
+  ChFluidDynamicsCpu *fluidDynamicsCpu; ///< pointer to the host fluid system
+  ChFsiBackend fluidBackend;    ///< hardware used for the fluid dynamics
+  ChFsiInterface *fsiInterface; ///< pointer to the fsi interface system
+  ChBce *bceWorker;             ///< pointer to the bce workers
 
   chrono::ChSystem *mphysicalSystem; ///< pointer to the multibody system
 
@@ -36,7 +36,14 @@ void PrintToFile(const thrust::device_vector<Real3> &posRadD,
   thrust::host_vector<Real3> posRadH = posRadD;
   thrust::host_vector<Real3> velMasH = velMasD;
   thrust::host_vector<Real4> rhoPresMuH = rhoPresMuD;
-
+  PrintToFile(posRadH, velMasH, rhoPresMuH, referenceArray, out_dir);
+}
+//*******************************************************************************************************************************
+void PrintToFile(const thrust::host_vector<Real3> &posRadH,
+                 const thrust::host_vector<Real3> &velMasH,
+                 const thrust::host_vector<Real4> &rhoPresMuH,
+                 const thrust::host_vector<int4> &referenceArray,
+                 const std::string &out_dir) {
   char fileCounter[5];
   static int dumNumChar = -1;
   dumNumChar++;
@@ -37,6 +37,13 @@ CH_FSI_API void PrintToFile(const thrust::device_vector<Real3> &posRadD,
                             const thrust::device_vector<Real4> &rhoPresMuD,
                             const thrust::host_vector<int4> &referenceArray,
                             const std::string &out_dir);
+
+/// function to save the fluid data into file, from host data (CPU backend)
+CH_FSI_API void PrintToFile(const thrust::host_vector<Real3> &posRadH,
+                            const thrust::host_vector<Real3> &velMasH,
+                            const thrust::host_vector<Real4> &rhoPresMuH,
+                            const thrust::host_vector<int4> &referenceArray,
+                            const std::string &out_dir);
 } // end namespace utils
 } // end namespace fsi
 } // end namespace chrono
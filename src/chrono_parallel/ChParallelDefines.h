@@ -39,21 +39,15 @@ typedef int shape_type;
 #define custom_vector std::vector
 #endif
 
-#if defined _MSC_VER
-class NullBuffer : public std::streambuf {
-  public:
-    int overflow(int c) { return c; }
-};
-static NullBuffer null_buffer;
-static std::ostream null_stream(&null_buffer);
-#define LOG(X) null_stream
-#else
-// Enable thread safe logging
-#define ELPP_THREAD_SAFE
-#include "chrono_thirdparty/easylogging/easylogging.h"
-#define LOGGINGENABLED
-
-#endif
+// Logging through the current ChLog, with the CH_LOG macro: LOG(INFO) and LOG(TRACE) messages
+// have levels CHSTATUS and CHTRACE, disabled by default (see ChSystemParallel::SetLoggingLevel).
+// Use a ChLogAsync to avoid the contention of threads on the log stream.
+#include "chrono/core/ChLog.h"
+#define CH_PARALLEL_LOG_ERROR chrono::ChLog::CHERROR
+#define CH_PARALLEL_LOG_WARNING chrono::ChLog::CHWARNING
+#define CH_PARALLEL_LOG_INFO chrono::ChLog::CHSTATUS
+#define CH_PARALLEL_LOG_TRACE chrono::ChLog::CHTRACE
+#define LOG(X) CH_LOG(CH_PARALLEL_LOG_##X)
 
 #if defined(CHRONO_OPENMP_ENABLED)
 #define THRUST_PAR thrust::omp::par,
@@ -123,6 +123,12 @@ class solver_settings {
         max_power_iteration = 15;
         power_iter_tolerance = 0.1;
         skip_residual = 1;
+        warm_start = false;
+        warm_start_factor = 1;
+        adaptive_restart = false;
+        adaptive_step_length = false;
+        mixed_precision = false;
+        refinement_iterations = 10;
     }
 
     // The solver type variable defines name of the solver that will be used to
@@ -166,6 +172,28 @@ class solver_settings {
     int max_power_iteration;
     real power_iter_tolerance;
 
+    // When enabled, contacts that persist from the previous step (same pair of
+    // collision shapes) start from their previous impulses instead of zero,
+    // bilateral impulses are kept if the number of bilaterals did not change.
+    // Only available with the parallel collision detection.
+    bool warm_start;
+    // Scaling applied to the impulses carried over from the previous step
+    real warm_start_factor;
+    // APGD: also restart the momentum when the objective increases, not only when
+    // the gradient points against the last update. SPGQP: stop as soon as the
+    // projected step vanishes.
+    bool adaptive_restart;
+    // APGD: only shrink the step length after iterations that did not need to
+    // backtrack, instead of shrinking it every iteration. SPGQP: start from a
+    // Barzilai-Borwein estimate of the step length instead of a fixed value.
+    bool adaptive_step_length;
+    // Mixed precision solve (DVI only): the Shur products of all but the last
+    // refinement_iterations iterations of each solve are computed with single
+    // precision copies of the system matrices, the remaining iterations refine
+    // the solution in the precision of the library.
+    bool mixed_precision;
+    uint refinement_iterations;
+
     // Contact force model for DEM
     ChSystemDEM::ContactForceModel contact_force_model;
     // Contact force model for DEM
@@ -238,10 +266,12 @@ class settings_container {
     solver_settings solver;
 
     // System level settings
-    // If set to true chrono parallel will automatically check to see if increasing
-    // the number of threads will improve performance. If performance is improved
-    // it changes the number of threads, if not, it decreases the number of threads
-    // back to the original value.
+    // If set to true chrono parallel will automatically search for the number of
+    // threads that gives the best performance. The search is done separately for
+    // the update, broadphase, narrowphase, Shur product and projection phases,
+    // each of which then runs with its own number of threads. The learned values
+    // can be saved and reused with ChSystemParallel::SaveThreadTuning and
+    // ChSystemParallel::LoadThreadTuning.
     bool perform_thread_tuning;
     // The minimum number of threads that will ever be used by this simulation.
     // If you know a good number of threads for your simulation set the minimum so
@@ -0,0 +1,229 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: Per-phase thread count governor (see ChThreadTuner.h).
+// =============================================================================
+
+#include <algorithm>
+#include <fstream>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono_parallel/ChThreadTuner.h"
+
+using namespace chrono;
+
+// Timers (registered in ChSystemParallel) that measure each of the tuned phases.
+const char* ChThreadTuner::timer_names[ChThreadTuner::num_phases] = {
+    "update", "collision_broad", "collision_narrow", "ShurProduct", "ChSolverParallel_Project"};
+
+ChThreadTuner::ChThreadTuner() : active(false), min_threads(0), max_threads(0), window(10), tolerance(0.05) {
+    for (int i = 0; i < num_phases; i++) {
+        phases[i].threads = 0;
+        phases[i].converged = false;
+    }
+    Reset();
+}
+
+const char* ChThreadTuner::GetPhaseName(TunedPhase phase) {
+    switch (phase) {
+        case TunedPhase::UPDATE:
+            return "update";
+        case TunedPhase::BROADPHASE:
+            return "broadphase";
+        case TunedPhase::NARROWPHASE:
+            return "narrowphase";
+        case TunedPhase::SHUR_PRODUCT:
+            return "shur_product";
+        case TunedPhase::PROJECTION:
+            return "projection";
+        default:
+            return "unknown";
+    }
+}
+
+void ChThreadTuner::Reset() {
+    for (int i = 0; i < num_phases; i++) {
+        phases[i].best_threads = 0;
+        phases[i].best_time = -1;
+        phases[i].stride = 0;
+        phases[i].direction = -1;
+        phases[i].flipped = false;
+        phases[i].converged = false;
+        phases[i].sample_sum = 0;
+        phases[i].sample_count = 0;
+    }
+    // Force a (re)initialization of the search at the next update.
+    min_threads = 0;
+    max_threads = 0;
+}
+
+void ChThreadTuner::Initialize(int min_thr, int max_thr) {
+    min_threads = std::max(min_thr, 1);
+    max_threads = std::max(max_thr, min_threads);
+
+    for (int i = 0; i < num_phases; i++) {
+        PhaseState& state = phases[i];
+        if (state.converged) {
+            // Thread counts loaded from file (or learned earlier) are kept, within the new bounds.
+            state.threads = std::min(std::max(state.threads, min_threads), max_threads);
+            state.best_threads = state.threads;
+            continue;
+        }
+        // Start from the maximum number of threads (the OpenMP default) and search downwards.
+        state.threads = max_threads;
+        state.best_threads = max_threads;
+        state.best_time = -1;
+        state.stride = std::max((max_threads - min_threads) / 4, 1);
+        state.direction = -1;
+        state.flipped = false;
+        state.sample_sum = 0;
+        state.sample_count = 0;
+        if (min_threads == max_threads)
+            state.converged = true;
+    }
+}
+
+void ChThreadTuner::Apply(TunedPhase phase) {
+    int threads = phases[static_cast<int>(phase)].threads;
+    if (!active || threads <= 0)
+        return;
+    CHOMPfunctions::SetNumThreads(threads);
+}
+
+void ChThreadTuner::Restore() {
+    if (!active || max_threads <= 0)
+        return;
+    CHOMPfunctions::SetNumThreads(max_threads);
+}
+
+void ChThreadTuner::Update(ChTimerParallel& timer, int min_thr, int max_thr) {
+    if (min_thr != min_threads || max_thr != max_threads)
+        Initialize(min_thr, max_thr);
+    active = true;
+
+    for (int i = 0; i < num_phases; i++) {
+        // Skip phases that did not run during this step (e.g. no contacts yet).
+        int runs = timer.GetRuns(timer_names[i]);
+        if (runs == 0)
+            continue;
+
+        AddSample(static_cast<TunedPhase>(i), timer.GetTime(timer_names[i]) / runs);
+    }
+}
+
+void ChThreadTuner::AddSample(TunedPhase phase, double time_per_call) {
+    PhaseState& state = phases[static_cast<int>(phase)];
+    if (state.converged || max_threads == 0)
+        return;
+
+    state.sample_sum += time_per_call;
+    state.sample_count++;
+
+    if (state.sample_count < window)
+        return;
+
+    double mean_time = state.sample_sum / state.sample_count;
+    state.sample_sum = 0;
+    state.sample_count = 0;
+    Evaluate(state, mean_time);
+
+    LOG(TRACE) << "ChThreadTuner: " << GetPhaseName(phase) << " threads " << state.threads
+               << (state.converged ? " (converged)" : "");
+}
+
+void ChThreadTuner::Evaluate(PhaseState& state, double mean_time) {
+    if (state.best_time < 0) {
+        // First measurement, at the initial thread count.
+        state.best_time = mean_time;
+        state.best_threads = state.threads;
+    } else if (mean_time < state.best_time * (1 - tolerance)) {
+        // Significant improvement: keep moving in the same direction. The opposite
+        // direction leads back to the previous best, so there is no need to test it.
+        state.best_time = mean_time;
+        state.best_threads = state.threads;
+        state.flipped = true;
+    } else if (!state.flipped) {
+        state.direction = -state.direction;
+        state.flipped = true;
+    } else {
+        state.stride /= 2;
+        state.direction = -state.direction;
+        state.flipped = false;
+    }
+
+    // Select the next candidate, skipping candidates outside the allowed range.
+    while (state.stride > 0) {
+        int candidate = state.best_threads + state.direction * state.stride;
+        if (candidate >= min_threads && candidate <= max_threads) {
+            state.threads = candidate;
+            return;
+        }
+        if (!state.flipped) {
+            state.direction = -state.direction;
+            state.flipped = true;
+        } else {
+            state.stride /= 2;
+            state.flipped = false;
+        }
+    }
+
+    state.threads = state.best_threads;
+    state.converged = true;
+}
+
+bool ChThreadTuner::IsConverged() const {
+    for (int i = 0; i < num_phases; i++) {
+        if (!phases[i].converged)
+            return false;
+    }
+    return true;
+}
+
+bool ChThreadTuner::Save(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    for (int i = 0; i < num_phases; i++) {
+        const PhaseState& state = phases[i];
+        int threads = state.converged ? state.threads : state.best_threads;
+        if (threads <= 0)
+            continue;
+        file << GetPhaseName(static_cast<TunedPhase>(i)) << " " << threads << "\n";
+    }
+
+    return file.good();
+}
+
+bool ChThreadTuner::Load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    std::string name;
+    int threads;
+    while (file >> name >> threads) {
+        for (int i = 0; i < num_phases; i++) {
+            if (name != GetPhaseName(static_cast<TunedPhase>(i)) || threads <= 0)
+                continue;
+            phases[i].threads = threads;
+            phases[i].best_threads = threads;
+            phases[i].converged = true;
+        }
+    }
+
+    // Clamp the loaded values against the current bounds at the next update.
+    min_threads = 0;
+    max_threads = 0;
+
+    return true;
+}
@@ -0,0 +1,116 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: Per-phase thread count governor. Each tuned phase of a parallel
+// step (update, broadphase, narrowphase, Shur product, projection) keeps its
+// own OpenMP thread count, which is searched independently using the time per
+// call reported by the corresponding ChTimerParallel timer.
+// =============================================================================
+
+#pragma once
+
+#include <string>
+
+#include "chrono_parallel/ChParallelDefines.h"
+#include "chrono_parallel/ChTimerParallel.h"
+
+namespace chrono {
+
+/// @addtogroup parallel_module
+/// @{
+
+/// Phases of a parallel time step for which the thread count is tuned separately.
+enum class TunedPhase { UPDATE, BROADPHASE, NARROWPHASE, SHUR_PRODUCT, PROJECTION, NUM_PHASES };
+
+/// Thread count governor for Chrono::Parallel.
+/// For every phase, the mean time per call is averaged over a window of steps.
+/// A pattern search (step in one direction while the time improves, then try the
+/// opposite direction, then halve the stride) moves the thread count of that phase
+/// until the stride vanishes, at which point the phase is considered converged.
+/// A candidate is only accepted if it improves the best known time by more than
+/// a relative tolerance, so that noise in the timers cannot keep the search alive.
+class CH_PARALLEL_API ChThreadTuner {
+  public:
+    ChThreadTuner();
+
+    /// Set the number of steps over which the time of each candidate is averaged (default: 10).
+    void SetWindow(int steps) { window = steps; }
+
+    /// Set the relative improvement required to accept a new thread count (default: 0.05).
+    void SetTolerance(real tol) { tolerance = tol; }
+
+    /// Set the OpenMP thread count for the given phase.
+    /// This is a no-op until the tuner has been activated by a call to Update().
+    void Apply(TunedPhase phase);
+
+    /// Reset the OpenMP thread count to the default value, used outside tuned phases.
+    void Restore();
+
+    /// Collect the per-phase timings of the last step and advance the search.
+    void Update(ChTimerParallel& timer, int min_threads, int max_threads);
+
+    /// Add a timing sample (mean time per call during one step) for the given phase.
+    /// Samples are ignored until the thread range has been set by a call to Update().
+    void AddSample(TunedPhase phase, double time_per_call);
+
+    /// Discard all learned thread counts and restart the search.
+    void Reset();
+
+    /// Return the thread count currently used for the given phase.
+    int GetThreads(TunedPhase phase) const { return phases[static_cast<int>(phase)].threads; }
+
+    /// Return true if the search for the given phase has converged.
+    bool IsConverged(TunedPhase phase) const { return phases[static_cast<int>(phase)].converged; }
+
+    /// Return true if all phases have converged.
+    bool IsConverged() const;
+
+    /// Write the learned thread counts to the specified file.
+    bool Save(const std::string& filename) const;
+
+    /// Read thread counts saved by a previous run.
+    /// Phases found in the file are marked as converged and are not tuned further.
+    bool Load(const std::string& filename);
+
+    /// Return the name of the given phase (as used in the files written by Save()).
+    static const char* GetPhaseName(TunedPhase phase);
+
+  private:
+    struct PhaseState {
+        int threads;       ///< thread count applied when the phase runs
+        int best_threads;  ///< best thread count found so far
+        double best_time;  ///< mean time per call at best_threads (negative if not yet measured)
+        int stride;        ///< current search stride
+        int direction;     ///< current search direction (+1 or -1)
+        bool flipped;      ///< the opposite direction was already tried at the current stride
+        bool converged;    ///< search finished
+        double sample_sum;
+        int sample_count;
+    };
+
+    static const int num_phases = static_cast<int>(TunedPhase::NUM_PHASES);
+    static const char* timer_names[num_phases];
+
+    void Initialize(int min_threads, int max_threads);
+    void Evaluate(PhaseState& state, double mean_time);
+
+    PhaseState phases[num_phases];
+    bool active;
+    int min_threads;
+    int max_threads;
+    int window;
+    real tolerance;
+};
+
+/// @} parallel_module
+
+}  // end namespace chrono
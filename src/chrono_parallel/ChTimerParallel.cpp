@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+#include "chrono_parallel/ChTimerParallel.h"
+
+using namespace chrono;
+
+ChTimerParallel::ChTimerParallel()
+    : total_time(0), total_timers(0), enabled(true), tracing(false), window(100), epoch(clock_type::now()), slots(NULL) {
+    // Reserve one accumulator per thread that may be active in a parallel region.
+    num_slots = std::max(std::max(CHOMPfunctions::GetNumProcs(), CHOMPfunctions::GetMaxThreads()), 1);
+    trace_events.resize(num_slots);
+}
+
+int ChTimerParallel::AddTimer(const std::string& name, int parent) {
+    int id = GetTimerId(name);
+    if (id >= 0)
+        return id;
+
+    TimerInfo info;
+    info.name = name;
+    info.parent = (parent >= 0 && parent < (int)timers.size()) ? parent : -1;
+    info.depth = (info.parent >= 0) ? timers[info.parent].depth + 1 : 0;
+    info.history.resize(window, 0);
+    info.history_head = 0;
+    info.history_count = 0;
+
+    id = (int)timers.size();
+    timers.push_back(info);
+
+    // Move the slots to a larger buffer, aligned to a cache line (the default allocator
+    // does not guarantee the alignment of over-aligned types), and clear the new ones.
+    size_t old_size = (size_t)id * num_slots * sizeof(TimerSlot);
+    size_t new_size = old_size + num_slots * sizeof(TimerSlot);
+    std::vector<char> buffer(new_size + CACHE_LINE);
+    uintptr_t address = reinterpret_cast<uintptr_t>(buffer.data());
+    char* base = buffer.data() + (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE;
+    if (old_size)
+        memcpy(base, slots, old_size);
+    memset(base + old_size, 0, new_size - old_size);
+    slot_buffer.swap(buffer);
+    slots = reinterpret_cast<TimerSlot*>(base);
+
+    timer_ids[name] = id;
+    total_timers++;
+
+    return id;
+}
+
+void ChTimerParallel::SetTracing(bool val) {
+    tracing = val;
+}
+
+void ChTimerParallel::SetWindow(int frames) {
+    window = std::max(frames, 1);
+    for (auto& info : timers) {
+        info.history.assign(window, 0);
+        info.history_head = 0;
+        info.history_count = 0;
+    }
+}
+
+void ChTimerParallel::Reset() {
+    for (int id = 0; id < (int)timers.size(); id++) {
+        // Only frames in which the timer was actually used enter the statistics.
+        if (GetRuns(id) > 0) {
+            TimerInfo& info = timers[id];
+            info.history[info.history_head] = GetTime(id);
+            info.history_head = (info.history_head + 1) % window;
+            info.history_count = std::min(info.history_count + 1, window);
+        }
+        for (int tid = 0; tid < num_slots; tid++) {
+            Slot(id, tid).total = 0;
+            Slot(id, tid).runs = 0;
+        }
+    }
+}
+
+double ChTimerParallel::GetTime(int id) const {
+    if (id < 0)
+        return 0;
+    double time = 0;
+    for (int tid = 0; tid < num_slots; tid++)
+        time = std::max(time, Slot(id, tid).total);
+    return time;
+}
+
+double ChTimerParallel::GetThreadTime(int id, int thread) const {
+    if (id < 0 || thread < 0 || thread >= num_slots)
+        return 0;
+    return Slot(id, thread).total;
+}
+
+int ChTimerParallel::GetRuns(int id) const {
+    if (id < 0)
+        return 0;
+    int runs = 0;
+    for (int tid = 0; tid < num_slots; tid++)
+        runs += Slot(id, tid).runs;
+    return runs;
+}
+
+double ChTimerParallel::GetMinTime(int id) const {
+    if (id < 0 || timers[id].history_count == 0)
+        return 0;
+    const TimerInfo& info = timers[id];
+    return *std::min_element(info.history.begin(), info.history.begin() + info.history_count);
+}
+
+double ChTimerParallel::GetMaxTime(int id) const {
+    if (id < 0 || timers[id].history_count == 0)
+        return 0;
+    const TimerInfo& info = timers[id];
+    return *std::max_element(info.history.begin(), info.history.begin() + info.history_count);
+}
+
+double ChTimerParallel::GetMeanTime(int id) const {
+    if (id < 0 || timers[id].history_count == 0)
+        return 0;
+    const TimerInfo& info = timers[id];
+    double sum = 0;
+    for (int i = 0; i < info.history_count; i++)
+        sum += info.history[i];
+    return sum / info.history_count;
+}
+
+void ChTimerParallel::PrintTimer(int id, int depth) {
+    std::cout << "Name:\t" << std::string(2 * depth, ' ') << timers[id].name << "\t" << GetTime(id) << "\t["
+              << GetMinTime(id) << " " << GetMeanTime(id) << " " << GetMaxTime(id) << "]" << std::endl;
+    for (int child = 0; child < (int)timers.size(); child++) {
+        if (timers[child].parent == id)
+            PrintTimer(child, depth + 1);
+    }
+}
+
+void ChTimerParallel::PrintReport() {
+    total_time = 0;
+    std::cout << "Timer Report:" << std::endl;
+    std::cout << "------------" << std::endl;
+    for (int id = 0; id < (int)timers.size(); id++) {
+        if (timers[id].parent >= 0)
+            continue;
+        PrintTimer(id, 0);
+        total_time += GetTime(id);
+    }
+    std::cout << "------------" << std::endl;
+}
+
+void ChTimerParallel::RecordEvent(int id, int tid, clock_type::time_point start, clock_type::time_point end) {
+    TraceEvent event;
+    event.id = id;
+    event.start = std::chrono::duration<double, std::micro>(start - epoch).count();
+    event.duration = std::chrono::duration<double, std::micro>(end - start).count();
+    trace_events[tid].push_back(event);
+}
+
+void ChTimerParallel::ClearTrace() {
+    for (auto& events : trace_events)
+        events.clear();
+}
+
+bool ChTimerParallel::ExportTrace(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (int tid = 0; tid < num_slots; tid++) {
+        for (const auto& event : trace_events[tid]) {
+            if (!first)
+                file << ",\n";
+            first = false;
+            file << "{\"name\":\"" << timers[event.id].name << "\",\"cat\":\"chrono_parallel\",\"ph\":\"X\",\"ts\":"
+                 << event.start << ",\"dur\":" << event.duration << ",\"pid\":0,\"tid\":" << tid << "}";
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return file.good();
+}
@@ -12,94 +12,181 @@
 // Authors: Hammad Mazhar
 // =============================================================================
 //
-// Description: Parallel timer class that uses a map to query and add timers
+// Description: Parallel timer registry. Timers are registered once by name and
+// then started and stopped through integer handles. Each timer accumulates time
+// separately for every OpenMP thread, can be nested under a parent timer, keeps
+// statistics over a sliding window of frames and can optionally record events
+// that are exported in the Chrome trace format (chrome://tracing).
 // =============================================================================
 
 #pragma once
 
-#include <map>
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "chrono/core/ChTimer.h"
+#include "chrono/parallel/ChOpenMP.h"
 
 #include "chrono_parallel/ChParallelDefines.h"
 #include "chrono_parallel/math/ChParallelMath.h"
 
 namespace chrono {
 
-struct TimerData {
-    TimerData() : runs(0) {}
+class CH_PARALLEL_API ChTimerParallel {
+  public:
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    static const size_t CACHE_LINE = 64;
 
-    void Reset() {
-        runs = 0;
-        timer.reset();
+    ChTimerParallel();
+    ~ChTimerParallel() {}
+    ChTimerParallel(const ChTimerParallel&) = delete;
+    ChTimerParallel& operator=(const ChTimerParallel&) = delete;
+
+    /// Register a timer with the given name and return its handle.
+    /// If a timer with this name already exists, its handle is returned.
+    /// A parent handle can be specified to nest this timer in the report.
+    /// Timers must be registered during setup: registration is not safe while other
+    /// threads start or stop timers.
+    int AddTimer(const std::string& name, int parent = -1);
+
+    /// Register a timer nested under the timer with the specified name.
+    int AddTimer(const std::string& name, const std::string& parent) { return AddTimer(name, GetTimerId(parent)); }
+
+    /// Return the handle of the timer with the given name, or -1 if no such timer exists.
+    int GetTimerId(const std::string& name) const {
+        auto found = timer_ids.find(name);
+        return (found == timer_ids.end()) ? -1 : found->second;
     }
 
-    double GetSec() { return timer(); }
-    double GetMsec() { return timer() * 1000.0; }
+    /// Return the name of the timer with the given handle.
+    const std::string& GetName(int id) const { return timers[id].name; }
 
-    void start() {
-        runs++;
-        timer.start();
-    }
-    void stop() { timer.stop(); }
+    /// Return the number of registered timers.
+    int GetNumTimers() const { return (int)timers.size(); }
 
-    ChTimer<double> timer;
-    int runs;
-};
+    /// Enable or disable all timers (default: enabled).
+    /// When disabled, start() and stop() return immediately.
+    void SetEnabled(bool val) { enabled = val; }
+    bool IsEnabled() const { return enabled; }
 
-class CH_PARALLEL_API ChTimerParallel {
-  public:
-    ChTimerParallel() : total_timers(0), total_time(0) {}
-    ~ChTimerParallel() {}
+    /// Enable or disable recording of trace events (default: disabled).
+    /// Each start/stop pair then produces an event that can be written with ExportTrace().
+    void SetTracing(bool val);
+    bool IsTracing() const { return tracing; }
+
+    /// Set the number of frames used for the min/max/mean statistics (default: 100).
+    void SetWindow(int frames);
+
+    /// End the current frame: record the accumulated time of each timer in its
+    /// sliding window and reset the accumulated times and run counts.
+    void Reset();
 
-    void AddTimer(std::string name) {
-        TimerData temp;
-        timer_list[name] = temp;
-        total_timers++;
+    /// Start the timer with the given handle, on the calling thread.
+    void start(int id) {
+        if (!enabled || id < 0)
+            return;
+        TimerSlot& slot = Slot(id, ThreadSlot());
+        slot.runs++;
+        slot.start = clock_type::now();
     }
 
-    void Reset() {
-        for (std::map<std::string, TimerData>::iterator it = timer_list.begin(); it != timer_list.end(); it++) {
-            it->second.Reset();
-        }
+    /// Stop the timer with the given handle, on the calling thread.
+    void stop(int id) {
+        if (!enabled || id < 0)
+            return;
+        clock_type::time_point end = clock_type::now();
+        int tid = ThreadSlot();
+        TimerSlot& slot = Slot(id, tid);
+        slot.total += std::chrono::duration<double>(end - slot.start).count();
+        if (tracing)
+            RecordEvent(id, tid, slot.start, end);
     }
 
-    void start(std::string name) { timer_list[name].start(); }
+    /// Start the timer with the given name (ignored if no such timer was registered).
+    /// Prefer the handle-based version on hot paths.
+    void start(const std::string& name) { start(GetTimerId(name)); }
 
-    void stop(std::string name) { timer_list[name].stop(); }
+    /// Stop the timer with the given name.
+    void stop(const std::string& name) { stop(GetTimerId(name)); }
 
-    // Returns the time associated with a specific timer
-    double GetTime(std::string name) {
-        if (timer_list.count(name) == 0) {
-            return 0;
-        }
-        return timer_list[name].timer();
-    }
+    /// Return the time accumulated in the current frame by the timer with the given handle.
+    /// For timers used inside parallel regions, this is the largest time over all threads.
+    double GetTime(int id) const;
+    double GetTime(const std::string& name) const { return GetTime(GetTimerId(name)); }
 
-    // Returns the number of times a specific timer was called
-    int GetRuns(std::string name) {
-        if (timer_list.count(name) == 0) {
-            return 0;
-        }
-        return timer_list[name].runs;
-    }
-    void PrintReport() {
-        total_time = 0;
-        std::cout << "Timer Report:" << std::endl;
-        std::cout << "------------" << std::endl;
-        for (std::map<std::string, TimerData>::iterator it = timer_list.begin(); it != timer_list.end(); it++) {
-            std::cout << "Name:\t" << it->first << "\t" << it->second.timer();
-            std::cout << std::endl;
-            total_time += it->second.timer();
-        }
-        std::cout << "------------" << std::endl;
-    }
+    /// Return the time accumulated in the current frame on the specified thread.
+    double GetThreadTime(int id, int thread) const;
+
+    /// Return the number of times a timer was started in the current frame (over all threads).
+    int GetRuns(int id) const;
+    int GetRuns(const std::string& name) const { return GetRuns(GetTimerId(name)); }
+
+    /// Minimum, maximum and mean frame time of a timer over the sliding window.
+    double GetMinTime(int id) const;
+    double GetMaxTime(int id) const;
+    double GetMeanTime(int id) const;
+
+    /// Print the timers of the current frame, indented according to their nesting.
+    void PrintReport();
+
+    /// Write all recorded trace events to the specified file, in Chrome trace JSON format.
+    bool ExportTrace(const std::string& filename) const;
+
+    /// Discard all recorded trace events.
+    void ClearTrace();
 
     double total_time;
     int total_timers;
-    std::map<std::string, TimerData> timer_list;
-    std::map<std::string, TimerData>::iterator it;
+
+  private:
+    // Per-thread accumulator, padded to a cache line to avoid false sharing.
+    // Slots are stored at cache line boundaries (see AddTimer).
+    struct TimerSlot {
+        clock_type::time_point start;
+        double total;
+        int runs;
+        char padding[CACHE_LINE - sizeof(clock_type::time_point) - sizeof(double) - sizeof(int)];
+    };
+
+    struct TimerInfo {
+        std::string name;
+        int parent;
+        int depth;
+        std::vector<double> history;  // frame times in the sliding window (ring buffer)
+        int history_head;
+        int history_count;
+    };
+
+    struct TraceEvent {
+        int id;
+        double start;     // microseconds since construction of the registry
+        double duration;  // microseconds
+    };
+
+    int ThreadSlot() const {
+        int tid = CHOMPfunctions::GetThreadNum();
+        return (tid < num_slots) ? tid : tid % num_slots;
+    }
+    TimerSlot& Slot(int id, int tid) { return slots[id * num_slots + tid]; }
+    const TimerSlot& Slot(int id, int tid) const { return slots[id * num_slots + tid]; }
+
+    void RecordEvent(int id, int tid, clock_type::time_point start, clock_type::time_point end);
+    void PrintTimer(int id, int depth);
+
+    bool enabled;
+    bool tracing;
+    int window;
+    int num_slots;
+    clock_type::time_point epoch;
+
+    std::vector<TimerInfo> timers;
+    std::vector<char> slot_buffer;  // storage of the slots, with room to align them to a cache line
+    TimerSlot* slots;               // num_slots entries per timer
+    std::unordered_map<std::string, int> timer_ids;
+    std::vector<std::vector<TraceEvent> > trace_events;  // one list per thread
 };
 }
@@ -89,13 +89,16 @@ void ChCollisionSystemBulletParallel::Remove(ChCollisionModel* model) {
 }
 
 void ChCollisionSystemBulletParallel::Run() {
+    data_manager->thread_tuner.Apply(TunedPhase::BROADPHASE);
     data_manager->system_timer.start("collision_broad");
     if (bt_collision_world) {
         bt_collision_world->performDiscreteCollisionDetection();
     }
     data_manager->system_timer.stop("collision_broad");
+    data_manager->thread_tuner.Restore();
 }
 void ChCollisionSystemBulletParallel::ReportContacts(ChContactContainerBase* mcontactcontainer) {
+    data_manager->thread_tuner.Apply(TunedPhase::NARROWPHASE);
     data_manager->system_timer.start("collision_narrow");
     data_manager->host_data.norm_rigid_rigid.clear();
     data_manager->host_data.cpta_rigid_rigid.clear();
@@ -188,6 +191,7 @@ void ChCollisionSystemBulletParallel::ReportContacts(ChContactContainerBase* mco
 
     // mcontactcontainer->EndAddContact();
     data_manager->system_timer.stop("collision_narrow");
+    data_manager->thread_tuner.Restore();
 }
 
 }  // end namespace collision
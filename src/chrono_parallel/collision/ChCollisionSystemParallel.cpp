@@ -197,6 +197,7 @@ void ChCollisionSystemParallel::Run() {
             }
         }
     }
+    data_manager->thread_tuner.Apply(TunedPhase::BROADPHASE);
     data_manager->system_timer.start("collision_broad");
     data_manager->aabb_generator->GenerateAABB();
 
@@ -208,7 +209,9 @@ void ChCollisionSystemParallel::Run() {
     data_manager->broadphase->DispatchRigid();
 
     data_manager->system_timer.stop("collision_broad");
+    data_manager->thread_tuner.Restore();
 
+    data_manager->thread_tuner.Apply(TunedPhase::NARROWPHASE);
     data_manager->system_timer.start("collision_narrow");
     if (data_manager->num_fluid_bodies != 0) {
         data_manager->narrowphase->DispatchFluid();
@@ -227,6 +230,7 @@ void ChCollisionSystemParallel::Run() {
     }
 
     data_manager->system_timer.stop("collision_narrow");
+    data_manager->thread_tuner.Restore();
 }
 
 void ChCollisionSystemParallel::GetOverlappingAABB(custom_vector<char>& active_id, real3 Amin, real3 Amax) {
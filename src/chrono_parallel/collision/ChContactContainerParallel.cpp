@@ -5,6 +5,8 @@
 #include "chrono/physics/ChParticlesClones.h"
 #include "chrono/collision/ChCModelBullet.h"
 
+#include "chrono_parallel/constraints/ChConstraintUtils.h"
+
 namespace chrono {
 
 using namespace collision;
@@ -88,4 +90,57 @@ void ChContactContainerParallel::AddContact(const collision::ChCollisionInfo& mc
     }
 }
 
+static inline ChVector<> ToChVector(const real3& a) {
+    return ChVector<>(a.x, a.y, a.z);
+}
+
+void ChContactContainerParallel::GetContactData(ChContactArrays& data) {
+    int num_contacts = (int)data_manager->num_rigid_contacts;
+    data.Resize(num_contacts);
+
+    const real3* norm = data_manager->host_data.norm_rigid_rigid.data();
+    const real3* ptA = data_manager->host_data.cpta_rigid_rigid.data();
+    const real3* ptB = data_manager->host_data.cptb_rigid_rigid.data();
+    const real* dpth = data_manager->host_data.dpth_rigid_rigid.data();
+    const vec2* ids = data_manager->host_data.bids_rigid_rigid.data();
+    const std::vector<std::shared_ptr<ChBody>>& bodies = *data_manager->body_list;
+
+    // Contact impulses (normal, then sliding, then spinning) are at the beginning of gamma.
+    SolverMode solver_mode = data_manager->settings.solver.solver_mode;
+    const DynamicVector<real>& gamma = data_manager->host_data.gamma;
+    bool has_forces = data_manager->settings.system_type == SystemType::SYSTEM_DVI &&
+                      gamma.size() >= (size_t)num_contacts;
+    bool has_sliding = has_forces && solver_mode != SolverMode::NORMAL && gamma.size() >= 3 * (size_t)num_contacts;
+    bool has_spinning = has_sliding && solver_mode == SolverMode::SPINNING && gamma.size() >= 6 * (size_t)num_contacts;
+    real inv_step = 1 / data_manager->settings.step_size;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_contacts; i++) {
+        ChBody* bodyA = bodies[ids[i].x].get();
+        ChBody* bodyB = bodies[ids[i].y].get();
+        data.objA[i] = bodyA;
+        data.objB[i] = bodyB;
+        data.idA[i] = bodyA->GetIdentifier();
+        data.idB[i] = bodyB->GetIdentifier();
+        data.pointA[i] = ToChVector(ptA[i]);
+        data.pointB[i] = ToChVector(ptB[i]);
+        data.normal[i] = ToChVector(norm[i]);
+        data.distance[i] = dpth[i];
+
+        // Same tangent directions as those used for the contact jacobians
+        real3 U = norm[i], V, W;
+        Orthogonalize(U, V, W);
+        real3 force(0), torque(0);
+        if (has_forces)
+            force = U * gamma[i];
+        if (has_sliding)
+            force += V * gamma[num_contacts + 2 * i] + W * gamma[num_contacts + 2 * i + 1];
+        if (has_spinning)
+            torque = U * gamma[3 * num_contacts + 3 * i] + V * gamma[3 * num_contacts + 3 * i + 1] +
+                     W * gamma[3 * num_contacts + 3 * i + 2];
+        data.force[i] = ToChVector(force * inv_step);
+        data.torque[i] = ToChVector(torque * inv_step);
+    }
+}
+
 }  // end namespace chrono
@@ -41,6 +41,11 @@ class CH_PARALLEL_API ChContactContainerParallel : public ChContactContainerBase
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) override;
     virtual void EndAddContact() override;
 
+    /// Fill the given arrays with the data of all contacts between rigid bodies, in parallel.
+    /// Contact forces are available only for DVI systems, after a step (for DEM systems they are set to zero).
+    /// Rolling and spinning torques are available only with SolverMode::SPINNING.
+    virtual void GetContactData(ChContactArrays& data) override;
+
     /// Return the list of contacts between rigid bodies
     const std::list<ChContact_6_6*>& GetContactList() const { return contactlist_6_6; }
 
@@ -22,9 +22,7 @@
 
 using namespace chrono;
 using namespace chrono::collision;
-#ifdef LOGGINGENABLED
-INITIALIZE_EASYLOGGINGPP
-#endif
+
 ChSystemParallel::ChSystemParallel(unsigned int max_objects) : ChSystem(1000, 10000, false) {
     data_manager = new ChParallelDataManager();
 
@@ -34,33 +32,25 @@ ChSystemParallel::ChSystemParallel(unsigned int max_objects) : ChSystem(1000, 10
 
     collision_system_type = CollisionSystemType::COLLSYS_PARALLEL;
     counter = 0;
-    timer_accumulator.resize(10, 0);
     cd_accumulator.resize(10, 0);
-    frame_threads = 0;
     frame_bins = 0;
-    old_timer = 0;
     old_timer_cd = 0;
-    detect_optimal_threads = false;
     detect_optimal_bins = false;
     current_threads = 2;
 
-    data_manager->system_timer.AddTimer("step");
-    data_manager->system_timer.AddTimer("update");
-    data_manager->system_timer.AddTimer("collision");
-    data_manager->system_timer.AddTimer("collision_broad");
-    data_manager->system_timer.AddTimer("collision_narrow");
-    data_manager->system_timer.AddTimer("solver");
-
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_Solve");
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_Setup");
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_Stab");
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_M");
-
-#ifdef LOGGINGENABLED
-    el::Loggers::reconfigureAllLoggers(el::ConfigurationType::ToStandardOutput, "false");
-    el::Loggers::reconfigureAllLoggers(el::ConfigurationType::ToFile, "false");
-    el::Loggers::reconfigureAllLoggers(el::ConfigurationType::Format, "%datetime{%h:%m:%s:%g} %msg");
-#endif
+    // Register the timers, nested according to the structure of a step
+    ChTimerParallel& timer = data_manager->system_timer;
+    int step_id = timer.AddTimer("step");
+    timer.AddTimer("update", step_id);
+    int collision_id = timer.AddTimer("collision", step_id);
+    timer.AddTimer("collision_broad", collision_id);
+    timer.AddTimer("collision_narrow", collision_id);
+    int solver_id = timer.AddTimer("solver", step_id);
+
+    timer.AddTimer("ChIterativeSolverParallel_Solve", solver_id);
+    timer.AddTimer("ChIterativeSolverParallel_Setup", solver_id);
+    timer.AddTimer("ChIterativeSolverParallel_Stab", solver_id);
+    timer.AddTimer("ChIterativeSolverParallel_M", solver_id);
 }
 
 ChSystemParallel::ChSystemParallel(const ChSystemParallel& other) : ChSystem(other) {
@@ -84,9 +74,11 @@ bool ChSystemParallel::Integrate_Y() {
 
     Setup();
 
+    data_manager->thread_tuner.Apply(TunedPhase::UPDATE);
     data_manager->system_timer.start("update");
     Update();
     data_manager->system_timer.stop("update");
+    data_manager->thread_tuner.Restore();
 
     data_manager->system_timer.start("collision");
     collision_system->Run();
@@ -102,6 +94,7 @@ bool ChSystemParallel::Integrate_Y() {
     std::static_pointer_cast<ChIterativeSolverParallel>(solver_speed)->RunTimeStep();
     data_manager->system_timer.stop("solver");
 
+    data_manager->thread_tuner.Apply(TunedPhase::UPDATE);
     data_manager->system_timer.start("update");
 
     // Iterate over the active bilateral constraints and store their Lagrange
@@ -168,6 +161,7 @@ bool ChSystemParallel::Integrate_Y() {
     data_manager->node_container->UpdatePosition(ChTime);
     data_manager->fea_container->UpdatePosition(ChTime);
     data_manager->system_timer.stop("update");
+    data_manager->thread_tuner.Restore();
 
     //=============================================================================================
     ChTime += GetStep();
@@ -617,46 +611,25 @@ void ChSystemParallel::Setup() {
     nbodies_fixed = 0;
 }
 
+//
+// Advance the per-phase thread count search using the timers of the step just
+// completed. Each tuned phase applies its own thread count when it runs (see
+// ChThreadTuner), all other parts of the step use the maximum number of threads.
+//
 void ChSystemParallel::RecomputeThreads() {
 #ifdef CHRONO_OMP_FOUND
-    timer_accumulator.insert(timer_accumulator.begin(), data_manager->system_timer.GetTime("step"));
-    timer_accumulator.pop_back();
-
-    double sum_of_elems = std::accumulate(timer_accumulator.begin(), timer_accumulator.end(), 0.0);
-
-    if (frame_threads == 50 && detect_optimal_threads == false) {
-        frame_threads = 0;
-        if (current_threads + 2 < data_manager->settings.max_threads) {
-            detect_optimal_threads = true;
-            old_timer = sum_of_elems / 10.0;
-            current_threads += 2;
-            omp_set_num_threads(current_threads);
-
-            LOG(TRACE) << "current threads increased to " << current_threads;
-
-        } else {
-            current_threads = data_manager->settings.max_threads;
-            omp_set_num_threads(data_manager->settings.max_threads);
+    data_manager->thread_tuner.Update(data_manager->system_timer, data_manager->settings.min_threads,
+                                      data_manager->settings.max_threads);
+    current_threads = data_manager->settings.max_threads;
+#endif
+}
 
-            LOG(TRACE) << "current threads increased to " << current_threads;
-        }
-    } else if (frame_threads == 10 && detect_optimal_threads) {
-        double current_timer = sum_of_elems / 10.0;
-        detect_optimal_threads = false;
-        frame_threads = 0;
-        if (old_timer < current_timer) {
-            current_threads -= 2;
-            omp_set_num_threads(current_threads);
-            LOG(TRACE) << "current threads reduced back to " << current_threads;
-        }
-    }
+bool ChSystemParallel::SaveThreadTuning(const std::string& filename) const {
+    return data_manager->thread_tuner.Save(filename);
+}
 
-    if (current_threads < data_manager->settings.min_threads) {
-        current_threads = data_manager->settings.min_threads;
-        omp_set_num_threads(data_manager->settings.min_threads);
-    }
-    frame_threads++;
-#endif
+bool ChSystemParallel::LoadThreadTuning(const std::string& filename) {
+    return data_manager->thread_tuner.Load(filename);
 }
 
 void ChSystemParallel::ChangeCollisionSystem(CollisionSystemType type) {
@@ -675,28 +648,26 @@ void ChSystemParallel::ChangeCollisionSystem(CollisionSystemType type) {
 }
 
 void ChSystemParallel::SetLoggingLevel(LoggingLevel level, bool state) {
-#ifdef LOGGINGENABLED
-
-    std::string value = state ? "true" : "false";
-
     switch (level) {
         case LoggingLevel::LOG_NONE:
-            el::Loggers::reconfigureAllLoggers(el::ConfigurationType::ToStandardOutput, "false");
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_INFO, false);
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_TRACE, false);
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_WARNING, false);
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_ERROR, false);
             break;
         case LoggingLevel::LOG_INFO:
-            el::Loggers::reconfigureAllLoggers(el::Level::Info, el::ConfigurationType::ToStandardOutput, value);
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_INFO, state);
             break;
         case LoggingLevel::LOG_TRACE:
-            el::Loggers::reconfigureAllLoggers(el::Level::Trace, el::ConfigurationType::ToStandardOutput, value);
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_TRACE, state);
             break;
         case LoggingLevel::LOG_WARNING:
-            el::Loggers::reconfigureAllLoggers(el::Level::Warning, el::ConfigurationType::ToStandardOutput, value);
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_WARNING, state);
             break;
         case LoggingLevel::LOG_ERROR:
-            el::Loggers::reconfigureAllLoggers(el::Level::Error, el::ConfigurationType::ToStandardOutput, value);
+            GetLog().SetLevelEnabled(CH_PARALLEL_LOG_ERROR, state);
             break;
     }
-#endif
 }
 
 //
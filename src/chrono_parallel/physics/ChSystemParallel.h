@@ -69,6 +69,11 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
     void Update3DOFBodies();
     void RecomputeThreads();
 
+    /// Save the thread counts learned by the per-phase thread tuning to the specified file.
+    bool SaveThreadTuning(const std::string& filename) const;
+    /// Load thread counts saved by a previous run. The loaded phases are not tuned further.
+    bool LoadThreadTuning(const std::string& filename);
+
     virtual void AddMaterialSurfaceData(std::shared_ptr<ChBody> newbody) = 0;
     virtual void UpdateMaterialSurfaceData(int index, ChBody* body) = 0;
     virtual void Setup() override;
@@ -109,7 +114,7 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
     settings_container* GetSettings();
 
     // based on the passed logging level and the state of that level, enable or
-    // disable logging level
+    // disable logging level (in the current ChLog, see GetLog())
     void SetLoggingLevel(LoggingLevel level, bool state = true);
 
     /// Calculate the (linearized) bilateral constraint violations.
@@ -121,12 +126,11 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
     int current_threads;
 
   protected:
-    double old_timer, old_timer_cd;
-    bool detect_optimal_threads;
+    double old_timer_cd;
 
     int detect_optimal_bins;
-    std::vector<double> timer_accumulator, cd_accumulator;
-    uint frame_threads, frame_bins, counter;
+    std::vector<double> cd_accumulator;
+    uint frame_bins, counter;
     std::vector<ChLink*>::iterator it;
 
     CollisionSystemType collision_system_type;
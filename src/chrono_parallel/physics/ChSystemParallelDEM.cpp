@@ -12,7 +12,7 @@ ChSystemParallelDEM::ChSystemParallelDEM(unsigned int max_objects) : ChSystemPar
     // Set this so that the CD can check what type of system it is (needed for narrowphase)
     data_manager->settings.system_type = SystemType::SYSTEM_DEM;
 
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallelDEM_ProcessContact");
+    data_manager->system_timer.AddTimer("ChIterativeSolverParallelDEM_ProcessContact", "solver");
 }
 
 ChSystemParallelDEM::ChSystemParallelDEM(const ChSystemParallelDEM& other) : ChSystemParallel(other) {
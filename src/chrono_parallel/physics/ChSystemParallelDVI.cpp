@@ -12,20 +12,23 @@ ChSystemParallelDVI::ChSystemParallelDVI(unsigned int max_objects) : ChSystemPar
     // Set this so that the CD can check what type of system it is (needed for narrowphase)
     data_manager->settings.system_type = SystemType::SYSTEM_DVI;
 
-    data_manager->system_timer.AddTimer("ChSolverParallel_solverA");
-    data_manager->system_timer.AddTimer("ChSolverParallel_solverB");
-    data_manager->system_timer.AddTimer("ChSolverParallel_solverC");
-    data_manager->system_timer.AddTimer("ChSolverParallel_solverD");
-    data_manager->system_timer.AddTimer("ChSolverParallel_solverE");
-    data_manager->system_timer.AddTimer("ChSolverParallel_solverF");
-    data_manager->system_timer.AddTimer("ChSolverParallel_solverG");
-    data_manager->system_timer.AddTimer("ChSolverParallel_Project");
-    data_manager->system_timer.AddTimer("ChSolverParallel_Solve");
-    data_manager->system_timer.AddTimer("ShurProduct");
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_D");
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_E");
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_R");
-    data_manager->system_timer.AddTimer("ChIterativeSolverParallel_N");
+    ChTimerParallel& timer = data_manager->system_timer;
+    int solve_id = timer.AddTimer("ChIterativeSolverParallel_Solve");
+    timer.AddTimer("ChSolverParallel_solverA", solve_id);
+    timer.AddTimer("ChSolverParallel_solverB", solve_id);
+    timer.AddTimer("ChSolverParallel_solverC", solve_id);
+    timer.AddTimer("ChSolverParallel_solverD", solve_id);
+    timer.AddTimer("ChSolverParallel_solverE", solve_id);
+    timer.AddTimer("ChSolverParallel_solverF", solve_id);
+    timer.AddTimer("ChSolverParallel_solverG", solve_id);
+    int inner_id = timer.AddTimer("ChSolverParallel_Solve", solve_id);
+    timer.AddTimer("ChSolverParallel_Project", inner_id);
+    timer.AddTimer("ShurProduct", inner_id);
+    int setup_id = timer.AddTimer("ChIterativeSolverParallel_Setup");
+    timer.AddTimer("ChIterativeSolverParallel_D", setup_id);
+    timer.AddTimer("ChIterativeSolverParallel_E", setup_id);
+    timer.AddTimer("ChIterativeSolverParallel_R", setup_id);
+    timer.AddTimer("ChIterativeSolverParallel_N", setup_id);
 }
 
 ChSystemParallelDVI::ChSystemParallelDVI(const ChSystemParallelDVI& other) : ChSystemParallel(other) {
@@ -118,9 +121,11 @@ void ChSystemParallelDVI::SolveSystem() {
 
     Setup();
 
+    data_manager->thread_tuner.Apply(TunedPhase::UPDATE);
     data_manager->system_timer.start("update");
     Update();
     data_manager->system_timer.stop("update");
+    data_manager->thread_tuner.Restore();
 
     data_manager->system_timer.start("collision");
     collision_system->Run();
@@ -228,9 +233,11 @@ void ChSystemParallelDVI::Initialize() {
 
     data_manager->fea_container->Initialize();
 
+    data_manager->thread_tuner.Apply(TunedPhase::UPDATE);
     data_manager->system_timer.start("update");
     Update();
     data_manager->system_timer.stop("update");
+    data_manager->thread_tuner.Restore();
 
     data_manager->system_timer.start("collision");
     collision_system->Run();
@@ -84,10 +84,23 @@ class CH_PARALLEL_API ChIterativeSolverParallelDVI : public ChIterativeSolverPar
     void PreSolve();
     ///< This function is used to change the solver algorithm.
     void ChangeSolverType(SolverType type);
+    ///< Initialize gamma with the impulses of contacts that persist from the previous step
+    void WarmStart();
+    ///< Save the contact keys and impulses of the current step for the next warm start
+    void StoreWarmStart();
+    ///< Run the solver for the current local solver mode, in mixed precision if enabled
+    uint SolveLocal(uint max_iteration);
 
   private:
     ChShurProduct ShurProductFull;
+    ChShurProductSingle ShurProductSingle;
     ChProjectConstraints ProjectFull;
+
+    // Contact keys of the previous step in ascending order, with six impulse
+    // values (normal, sliding, spinning) per contact and the bilateral impulses.
+    std::vector<long long> warm_pairs;
+    std::vector<real> warm_gamma;
+    std::vector<real> warm_bilaterals;
 };
 
 class CH_PARALLEL_API ChIterativeSolverParallelDEM : public ChIterativeSolverParallel {
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <numeric>
+
 #include "chrono_parallel/solver/ChIterativeSolverParallel.h"
 
 using namespace chrono;
@@ -47,6 +50,10 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
     data_manager->host_data.gamma.resize(data_manager->num_constraints);
     data_manager->host_data.gamma.reset();
 
+    if (data_manager->settings.solver.warm_start) {
+        WarmStart();
+    }
+
     // Perform any setup tasks for all constraint types
     data_manager->rigid_rigid->Setup(data_manager);
     data_manager->bilateral->Setup(data_manager);
@@ -81,6 +88,9 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
                 (data_manager->host_data.v + data_manager->host_data.M_inv * data_manager->host_data.hf);
     }
     ShurProductFull.Setup(data_manager);
+    if (data_manager->settings.solver.mixed_precision) {
+        ShurProductSingle.Setup(data_manager);
+    }
     ShurProductBilateral.Setup(data_manager);
     ShurProductFEM.Setup(data_manager);
     ProjectFull.Setup(data_manager);
@@ -95,12 +105,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelDVI::RunTimeStep - Solve Normal";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                     //
-                              ProjectFull,                                         //
-                              data_manager->settings.solver.max_iteration_normal,  //
-                              data_manager->num_constraints,                       //
-                              data_manager->host_data.R,                           //
-                              data_manager->host_data.gamma);                      //
+                SolveLocal(data_manager->settings.solver.max_iteration_normal);
         }
     }
     if (data_manager->settings.solver.solver_mode == SolverMode::SLIDING ||
@@ -110,12 +115,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelDVI::RunTimeStep - Solve Sliding";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                      //
-                              ProjectFull,                                          //
-                              data_manager->settings.solver.max_iteration_sliding,  //
-                              data_manager->num_constraints,                        //
-                              data_manager->host_data.R,                            //
-                              data_manager->host_data.gamma);                       //
+                SolveLocal(data_manager->settings.solver.max_iteration_sliding);
         }
     }
     if (data_manager->settings.solver.solver_mode == SolverMode::SPINNING) {
@@ -124,12 +124,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelDVI::RunTimeStep - Solve Spinning";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                       //
-                              ProjectFull,                                           //
-                              data_manager->settings.solver.max_iteration_spinning,  //
-                              data_manager->num_constraints,                         //
-                              data_manager->host_data.R,                             //
-                              data_manager->host_data.gamma);                        //
+                SolveLocal(data_manager->settings.solver.max_iteration_spinning);
         }
     }
 
@@ -165,6 +160,10 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
 
     data_manager->system_timer.stop("ChIterativeSolverParallel_Solve");
 
+    if (data_manager->settings.solver.warm_start) {
+        StoreWarmStart();
+    }
+
     ComputeImpulses();
     for (int i = 0; i < data_manager->measures.solver.maxd_hist.size(); i++) {
         AtIterationEnd(data_manager->measures.solver.maxd_hist[i], data_manager->measures.solver.maxdeltalambda_hist[i],
@@ -180,6 +179,125 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
                << " iterations: " << tot_iterations;
 }
 
+uint ChIterativeSolverParallelDVI::SolveLocal(uint max_iteration) {
+    uint num_constraints = data_manager->num_constraints;
+    DynamicVector<real>& R = data_manager->host_data.R;
+    DynamicVector<real>& gamma = data_manager->host_data.gamma;
+
+    if (!data_manager->settings.solver.mixed_precision) {
+        return solver->Solve(ShurProductFull, ProjectFull, max_iteration, num_constraints, R, gamma);
+    }
+
+    // Most of the iterations use the single precision Shur product, the last ones
+    // continue from that solution with the full precision operator.
+    uint refinement = std::min(data_manager->settings.solver.refinement_iterations, max_iteration);
+    uint iterations = 0;
+    if (max_iteration > refinement) {
+        iterations +=
+            solver->Solve(ShurProductSingle, ProjectFull, max_iteration - refinement, num_constraints, R, gamma);
+    }
+    if (refinement > 0) {
+        iterations += solver->Solve(ShurProductFull, ProjectFull, refinement, num_constraints, R, gamma);
+    }
+    return iterations;
+}
+
+// Return the indices of the rigid contacts ordered by their shape pair key.
+// Multiple contact points between the same two shapes keep their narrowphase order.
+static void SortContactsByKey(const custom_vector<long long>& pairs, uint num_contacts, std::vector<uint>& order) {
+    order.resize(num_contacts);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&pairs](uint a, uint b) { return pairs[a] < pairs[b]; });
+}
+
+void ChIterativeSolverParallelDVI::WarmStart() {
+    DynamicVector<real>& gamma = data_manager->host_data.gamma;
+    const custom_vector<long long>& pairs = data_manager->host_data.contact_pairs;
+    uint num_contacts = data_manager->num_rigid_contacts;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    uint num_bilaterals = data_manager->num_bilaterals;
+    uint num_previous = (uint)warm_pairs.size();
+    int offset = data_manager->rigid_rigid->offset;
+    real factor = data_manager->settings.solver.warm_start_factor;
+
+    // Contact keys are only available with the parallel collision detection
+    if (num_contacts > 0 && num_previous > 0 && pairs.size() == num_contacts) {
+        std::vector<uint> order;
+        SortContactsByKey(pairs, num_contacts, order);
+
+        // Both lists are sorted by key: merge them, matching the k-th contact point
+        // of a shape pair with the k-th contact point of the same pair in the previous step
+        uint j = 0;
+        for (uint k = 0; k < num_contacts && j < num_previous; k++) {
+            uint i = order[k];
+            long long key = pairs[i];
+            while (j < num_previous && warm_pairs[j] < key) {
+                j++;
+            }
+            if (j == num_previous || warm_pairs[j] != key) {
+                continue;
+            }
+            const real* previous = &warm_gamma[6 * j];
+            gamma[i] = factor * previous[0];
+            if (offset == 3 || offset == 6) {
+                gamma[num_contacts + i * 2 + 0] = factor * previous[1];
+                gamma[num_contacts + i * 2 + 1] = factor * previous[2];
+            }
+            if (offset == 6) {
+                gamma[3 * num_contacts + i * 3 + 0] = factor * previous[3];
+                gamma[3 * num_contacts + i * 3 + 1] = factor * previous[4];
+                gamma[3 * num_contacts + i * 3 + 2] = factor * previous[5];
+            }
+            j++;
+        }
+    }
+
+    if (num_bilaterals > 0 && warm_bilaterals.size() == num_bilaterals) {
+        for (uint i = 0; i < num_bilaterals; i++) {
+            gamma[num_unilaterals + i] = factor * warm_bilaterals[i];
+        }
+    }
+}
+
+void ChIterativeSolverParallelDVI::StoreWarmStart() {
+    const DynamicVector<real>& gamma = data_manager->host_data.gamma;
+    const custom_vector<long long>& pairs = data_manager->host_data.contact_pairs;
+    uint num_contacts = data_manager->num_rigid_contacts;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    uint num_bilaterals = data_manager->num_bilaterals;
+    int offset = data_manager->rigid_rigid->offset;
+
+    warm_pairs.clear();
+    warm_gamma.clear();
+    if (num_contacts > 0 && pairs.size() == num_contacts) {
+        std::vector<uint> order;
+        SortContactsByKey(pairs, num_contacts, order);
+
+        warm_pairs.resize(num_contacts);
+        warm_gamma.assign(6 * num_contacts, 0);
+        for (uint k = 0; k < num_contacts; k++) {
+            uint i = order[k];
+            real* stored = &warm_gamma[6 * k];
+            warm_pairs[k] = pairs[i];
+            stored[0] = gamma[i];
+            if (offset == 3 || offset == 6) {
+                stored[1] = gamma[num_contacts + i * 2 + 0];
+                stored[2] = gamma[num_contacts + i * 2 + 1];
+            }
+            if (offset == 6) {
+                stored[3] = gamma[3 * num_contacts + i * 3 + 0];
+                stored[4] = gamma[3 * num_contacts + i * 3 + 1];
+                stored[5] = gamma[3 * num_contacts + i * 3 + 2];
+            }
+        }
+    }
+
+    warm_bilaterals.resize(num_bilaterals);
+    for (uint i = 0; i < num_bilaterals; i++) {
+        warm_bilaterals[i] = gamma[num_unilaterals + i];
+    }
+}
+
 void ChIterativeSolverParallelDVI::ComputeD() {
     LOG(INFO) << "ChIterativeSolverParallelDVI::ComputeD()";
     data_manager->system_timer.start("ChIterativeSolverParallel_D");
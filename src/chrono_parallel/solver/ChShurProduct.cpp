@@ -4,9 +4,11 @@ using namespace chrono;
 
 ChShurProduct::ChShurProduct() {
     data_manager = 0;
+    timer_id = -1;
 }
 void ChShurProduct::operator()(const DynamicVector<real>& x, DynamicVector<real>& output) {
-    data_manager->system_timer.start("ShurProduct");
+    data_manager->thread_tuner.Apply(TunedPhase::SHUR_PRODUCT);
+    data_manager->system_timer.start(timer_id);
 
     const DynamicVector<real>& E = data_manager->host_data.E;
 
@@ -87,7 +89,8 @@ void ChShurProduct::operator()(const DynamicVector<real>& x, DynamicVector<real>
             } break;
         }
     }
-    data_manager->system_timer.stop("ShurProduct");
+    data_manager->system_timer.stop(timer_id);
+    data_manager->thread_tuner.Restore();
 }
 
 void ChShurProductBilateral::Setup(ChParallelDataManager* data_container_) {
@@ -134,3 +137,73 @@ void ChShurProductFEM::operator()(const DynamicVector<real>& x, DynamicVector<re
                  x +
              blaze::subvector(data_manager->host_data.E, start_tet, num_constraints) * x;
 }
+
+void ChShurProductSingle::Setup(ChParallelDataManager* data_container_) {
+    ChShurProduct::Setup(data_container_);
+    current = false;
+}
+
+void ChShurProductSingle::Update() {
+    if (current) {
+        return;
+    }
+    D_T = data_manager->host_data.D_T;
+    M_invD = data_manager->host_data.M_invD;
+    E = data_manager->host_data.E;
+    current = true;
+}
+
+void ChShurProductSingle::operator()(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    data_manager->thread_tuner.Apply(TunedPhase::SHUR_PRODUCT);
+    data_manager->system_timer.start(timer_id);
+
+    Update();
+
+    uint num_rigid_contacts = data_manager->num_rigid_contacts;
+    uint num_unilaterals = data_manager->num_unilaterals;
+    uint num_bilaterals = data_manager->num_bilaterals;
+    uint size = (uint)x.size();
+
+    // Range of unilateral rows that take part in the current solve, the normal,
+    // sliding and spinning blocks are stored one after the other.
+    // Bilaterals always take part, other constraints only in a full solve.
+    uint num_active = num_unilaterals;
+    bool full = data_manager->settings.solver.local_solver_mode == data_manager->settings.solver.solver_mode;
+    if (!full) {
+        switch (data_manager->settings.solver.local_solver_mode) {
+            case SolverMode::BILATERAL:
+                num_active = 0;
+                break;
+            case SolverMode::NORMAL:
+                num_active = num_rigid_contacts;
+                break;
+            case SolverMode::SLIDING:
+                num_active = 3 * num_rigid_contacts;
+                break;
+            case SolverMode::SPINNING:
+                num_active = 6 * num_rigid_contacts;
+                break;
+        }
+    }
+    uint end_active = full ? size : num_unilaterals + num_bilaterals;
+
+    x_single.resize(size, false);
+#pragma omp parallel for
+    for (int i = 0; i < (signed)size; i++) {
+        bool active = (uint)i < num_active || ((uint)i >= num_unilaterals && (uint)i < end_active);
+        x_single[i] = active ? float(x[i]) : 0.0f;
+    }
+
+    tmp_single = M_invD * x_single;
+    output_single = D_T * tmp_single;
+
+    output.resize(size, false);
+#pragma omp parallel for
+    for (int i = 0; i < (signed)size; i++) {
+        bool active = (uint)i < num_active || ((uint)i >= num_unilaterals && (uint)i < end_active);
+        output[i] = active ? real(output_single[i] + E[i] * x_single[i]) : real(0);
+    }
+
+    data_manager->system_timer.stop(timer_id);
+    data_manager->thread_tuner.Restore();
+}
@@ -3,11 +3,13 @@
 using namespace chrono;
 
 void ChProjectConstraints::operator()(real* data) {
-    data_manager->system_timer.start("ChSolverParallel_Project");
+    data_manager->thread_tuner.Apply(TunedPhase::PROJECTION);
+    data_manager->system_timer.start(timer_id);
     data_manager->rigid_rigid->Project(data);
     data_manager->node_container->Project(data);
     data_manager->fea_container->Project(data);
-    data_manager->system_timer.stop("ChSolverParallel_Project");
+    data_manager->system_timer.stop(timer_id);
+    data_manager->thread_tuner.Restore();
 }
 
 ChSolverParallel::ChSolverParallel() {
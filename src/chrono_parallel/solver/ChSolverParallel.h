@@ -29,16 +29,21 @@ namespace chrono {
 
 class CH_PARALLEL_API ChProjectConstraints {
   public:
-    ChProjectConstraints() {}
+    ChProjectConstraints() : data_manager(0), timer_id(-1) {}
     virtual ~ChProjectConstraints() {}
 
-    virtual void Setup(ChParallelDataManager* data_container_) { data_manager = data_container_; }
+    virtual void Setup(ChParallelDataManager* data_container_) {
+        data_manager = data_container_;
+        timer_id = data_manager->system_timer.GetTimerId("ChSolverParallel_Project");
+    }
 
     // Project the Lagrange multipliers
     virtual void operator()(real* data);
 
     // Pointer to the system's data manager
     ChParallelDataManager* data_manager;
+    // Handle of the projection timer (looked up once in Setup)
+    int timer_id;
 };
 class CH_PARALLEL_API ChProjectNone : public ChProjectConstraints {
   public:
@@ -55,13 +60,18 @@ class CH_PARALLEL_API ChShurProduct {
     ChShurProduct();
     virtual ~ChShurProduct() {}
 
-    virtual void Setup(ChParallelDataManager* data_container_) { data_manager = data_container_; }
+    virtual void Setup(ChParallelDataManager* data_container_) {
+        data_manager = data_container_;
+        timer_id = data_manager->system_timer.GetTimerId("ShurProduct");
+    }
 
     // Perform the Shur Product
     virtual void operator()(const DynamicVector<real>& x, DynamicVector<real>& AX);
 
     // Pointer to the system's data manager
     ChParallelDataManager* data_manager;
+    // Handle of the Shur product timer (looked up once in Setup)
+    int timer_id;
 };
 
 class CH_PARALLEL_API ChShurProductBilateral : public ChShurProduct {
@@ -88,6 +98,30 @@ class CH_PARALLEL_API ChShurProductFEM : public ChShurProduct {
     CompressedMatrix<real> NshurB;
 };
 
+// Shur product evaluated in single precision, used for the bulk of the iterations
+// in the mixed precision solve mode. Single precision copies of D^T, M^-1 D and E
+// are made once per step, on the first product after Setup, and reused by all the
+// following products of the step; the product only involves the constraints of
+// the current local solver mode, like the double precision version.
+class CH_PARALLEL_API ChShurProductSingle : public ChShurProduct {
+  public:
+    ChShurProductSingle() : current(false) {}
+    virtual ~ChShurProductSingle() {}
+    virtual void Setup(ChParallelDataManager* data_container_);
+
+    // Perform the Shur Product
+    virtual void operator()(const DynamicVector<real>& x, DynamicVector<real>& AX);
+
+    // Make the single precision copies of the matrices of the current step, if not done yet
+    void Update();
+
+    CompressedMatrix<float> D_T;
+    CompressedMatrix<float> M_invD;
+    DynamicVector<float> E;
+    bool current;  // the copies are those of the current step
+    DynamicVector<float> x_single, tmp_single, output_single;
+};
+
 //========================================================================================================
 class CH_PARALLEL_API ChSolverParallel {
   public:
@@ -121,6 +121,14 @@ uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
 
     t = 1.0 / L;
     y = gamma;
+    const bool adaptive_restart = data_manager->settings.solver.adaptive_restart;
+    const bool adaptive_step_length = data_manager->settings.solver.adaptive_step_length;
+    // Objective value at the current iterate, used by the function value restart
+    real obj_current = 0;
+    if (adaptive_restart) {
+        ShurProduct(gamma, temp);
+        obj_current = (gamma, 0.5 * temp - r);
+    }
     // If no iterations are performed or the residual is NAN (which is shouldnt be)
     // make sure that gamma_hat has something inside of it. Otherwise gamma will be
     // overwritten with a vector of zero size
@@ -135,7 +143,9 @@ uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
         ShurProduct(gamma_new, N_gamma_new);
         obj2 = (y, 0.5 * temp - r);
         temp = gamma_new - y;
+        bool backtracked = false;
         while ((gamma_new, 0.5 * N_gamma_new - r) > obj2 + (g + 0.5 * L * temp, temp)) {
+            backtracked = true;
             L = 2.0 * L;
             t = 1.0 / L;
             gamma_new = y - t * g;
@@ -187,12 +197,24 @@ uint ChSolverParallelAPGD::Solve(ChShurProduct& ShurProduct,
             }
         }
 
-        if (dot_g_temp > 0) {
+        // Restart the momentum if the gradient points against the last update or,
+        // with adaptive restart, if the objective increased during this iteration
+        bool restart = dot_g_temp > 0;
+        if (adaptive_restart) {
+            real obj_new = (gamma_new, 0.5 * N_gamma_new - r);
+            restart = restart || obj_new > obj_current;
+            obj_current = obj_new;
+        }
+        if (restart) {
             y = gamma_new;
             theta_new = 1.0;
         }
 
-        L = 0.9 * L;
+        // A step that needed backtracking is already close to the local Lipschitz
+        // constant, with the adaptive policy it is not shrunk again
+        if (!adaptive_step_length || !backtracked) {
+            L = 0.9 * L;
+        }
         t = 1.0 / L;
 
         theta = theta_new;
@@ -72,6 +72,17 @@ uint ChSolverParallelSPGQP::Solve(ChShurProduct& ShurProduct,
 
     f_hist[0] = (0.5 * (g - r, x));
 
+    // Without a cached or estimated step length, start from the Barzilai-Borwein
+    // step along the initial gradient (particularly useful when warm starting)
+    if (data_manager->settings.solver.adaptive_step_length && !data_manager->settings.solver.cache_step_length &&
+        !data_manager->settings.solver.use_power_iteration) {
+        ShurProduct(g, Ad_k);
+        real g_dot_Ag = (g, Ad_k);
+        if (g_dot_Ag > 0) {
+            alpha = (g, g) / g_dot_Ag;
+        }
+    }
+
     for (current_iteration = 0; current_iteration < (signed)max_iter; current_iteration++) {
         temp = x - alpha * g;
         Project(temp.data());
@@ -94,6 +105,11 @@ uint ChSolverParallelSPGQP::Solve(ChShurProduct& ShurProduct,
         ShurProduct(d_k, Ad_k);
         real Ad_k_dot_d_k = (Ad_k, d_k);
 
+        // The projected step vanished: x is already a stationary point
+        if (data_manager->settings.solver.adaptive_restart && Ad_k_dot_d_k <= 0) {
+            break;
+        }
+
         xi = (f_max - f_hist[current_iteration]) / Ad_k_dot_d_k;
         beta_bar = -(g, d_k) / Ad_k_dot_d_k;
         beta_tilde = gam * beta_bar + Sqrt(gam * gam * beta_bar * beta_bar + 2 * xi);
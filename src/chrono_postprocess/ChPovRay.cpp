@@ -12,6 +12,9 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+#include <cmath>
+
 #include "chrono/assets/ChAssetLevel.h"
 #include "chrono/assets/ChBoxShape.h"
 #include "chrono/assets/ChCamera.h"
@@ -70,6 +73,13 @@ ChPovRay::ChPovRay(ChSystem* system) : ChPostProcessBase(system) {
     this->contacts_colormap_startscale = 0;
     this->contacts_colormap_endscale = 10;
     this->contacts_do_colormap = true;
+    this->incremental = false;
+    this->incremental_tolerance = 1e-6;
+    this->keyframe_interval = 100;
+    this->setup_nbodies = 0;
+    this->setup_nothers = 0;
+    this->setup_nlinks = 0;
+    this->key_age = 0;
 }
 
 void ChPovRay::Add(std::shared_ptr<ChPhysicsItem> mitem) {
@@ -177,6 +187,12 @@ void ChPovRay::SetupLists() {
             this->mdata.push_back(*myiterl);
         ++myiterl;
     }
+
+    // remember the system size, and force a new keyframe with the new list of items
+    setup_nbodies = mSystem->Get_bodylist()->size();
+    setup_nothers = mSystem->Get_otherphysicslist()->size();
+    setup_nlinks = mSystem->Get_linklist()->size();
+    key_filename.clear();
 }
 
 std::string replaceOnce(std::string result, const std::string& replaceWhat, const std::string& replaceWithWhat) {
@@ -245,6 +261,14 @@ void ChPovRay::SetShowContacts(bool show,
     }
 }
 
+void ChPovRay::SetIncrementalExport(bool active, double tolerance, unsigned int keyframe_interval) {
+    this->incremental = active;
+    if (active) {
+        this->incremental_tolerance = tolerance;
+        this->keyframe_interval = keyframe_interval;
+    }
+}
+
 void ChPovRay::ExportScript(const std::string& filename) {
     this->out_script_filename = filename;
 
@@ -361,6 +385,44 @@ void ChPovRay::ExportScript(const std::string& filename) {
     mfile << "// Include shape assets (triangle meshes): \n\n";
     mfile << "#include \"" << assets_filename << "\"\n\n";
 
+    // Write POV code to load the objects of a frame saved with incremental export
+
+    if (this->incremental) {
+        mfile << "// Load the objects of the last keyframe, then the ones moved since then: \n\n";
+        mfile << "#macro ch_load_frame(key_pov, key_dat, frame_dat)\n";
+        mfile << " #include key_pov\n";
+        mfile << " #fopen ChKeyFile key_dat read\n";
+        mfile << " #read (ChKeyFile, ch_ninstances)\n";
+        mfile << " #declare ch_obj = array[ch_ninstances + 1];\n";
+        mfile << " #declare ch_pos = array[ch_ninstances + 1];\n";
+        mfile << " #declare ch_rot = array[ch_ninstances + 1];\n";
+        mfile << " #declare Index = 0;\n";
+        mfile << " #while (Index < ch_ninstances)\n";
+        mfile << "  #read (ChKeyFile, aobj, apx, apy, apz, aq0, aq1, aq2, aq3)\n";
+        mfile << "  #declare ch_obj[Index] = aobj;\n";
+        mfile << "  #declare ch_pos[Index] = <apx, apy, apz>;\n";
+        mfile << "  #declare ch_rot[Index] = <aq0, aq1, aq2, aq3>;\n";
+        mfile << "  #declare Index = Index + 1;\n";
+        mfile << " #end\n";
+        mfile << " #fclose ChKeyFile\n";
+        mfile << " #fopen ChFrameFile frame_dat read\n";
+        mfile << " #read (ChFrameFile, ch_nmoved)\n";
+        mfile << " #declare Index = 0;\n";
+        mfile << " #while (Index < ch_nmoved)\n";
+        mfile << "  #read (ChFrameFile, ainst, apx, apy, apz, aq0, aq1, aq2, aq3)\n";
+        mfile << "  #declare ch_pos[ainst] = <apx, apy, apz>;\n";
+        mfile << "  #declare ch_rot[ainst] = <aq0, aq1, aq2, aq3>;\n";
+        mfile << "  #declare Index = Index + 1;\n";
+        mfile << " #end\n";
+        mfile << " #fclose ChFrameFile\n";
+        mfile << " #declare Index = 0;\n";
+        mfile << " #while (Index < ch_ninstances)\n";
+        mfile << "  object{ ch_objects[ch_obj[Index]] quatRotation(ch_rot[Index]) translate ch_pos[Index] }\n";
+        mfile << "  #declare Index = Index + 1;\n";
+        mfile << " #end\n";
+        mfile << "#end\n\n";
+    }
+
     // Write POV code to open the n.th scene file
 
     mfile << "// Include POV code to for the n.th scene file: \n\n";
@@ -756,20 +818,133 @@ void ChPovRay::_recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& ass
     mfilepov << "}\n";  // end union
 }
 
+void ChPovRay::_recurseFindCamera(std::vector<std::shared_ptr<ChAsset> >& assetlist, const ChFrame<>& parentframe) {
+    for (unsigned int k = 0; k < assetlist.size(); k++) {
+        std::shared_ptr<ChAsset> k_asset = assetlist[k];
+
+        if (auto mycamera = std::dynamic_pointer_cast<ChCamera>(k_asset)) {
+            this->camera_found_in_assets = true;
+
+            this->camera_location = mycamera->GetPosition() >> parentframe;
+            this->camera_aim = mycamera->GetAimPoint() >> parentframe;
+            this->camera_up = mycamera->GetUpVector() >> parentframe;
+            this->camera_angle = mycamera->GetAngle();
+            this->camera_orthographic = mycamera->GetOrthographic();
+        }
+
+        if (auto mylevel = std::dynamic_pointer_cast<ChAssetLevel>(k_asset)) {
+            _recurseFindCamera(mylevel->GetAssets(), mylevel->GetFrame() >> parentframe);
+        }
+    }
+}
+
+void ChPovRay::ExportKeyframe(const std::string& filename) {
+    char pathpov[200];
+    sprintf(pathpov, "%s.key.pov", filename.c_str());
+    ChStreamOutAsciiFile mfilepov(pathpov);
+
+    char pathdat[200];
+    sprintf(pathdat, "%s.key.dat", filename.c_str());
+    ChStreamOutAsciiFile mfiledat(pathdat);
+
+    // Declare the objects, i.e. the asset tree of each body or cluster of particles, without
+    // transformation. The camera, if any, is found again for each frame.
+    bool camera_found = this->camera_found_in_assets;
+    std::vector<std::shared_ptr<ChPhysicsItem> > objects;
+    for (unsigned int i = 0; i < this->mdata.size(); i++) {
+        if (std::dynamic_pointer_cast<ChBody>(mdata[i]) || std::dynamic_pointer_cast<ChParticlesClones>(mdata[i]))
+            objects.push_back(mdata[i]);
+    }
+    mfilepov << "// Objects referenced by the frames saved after " << filename.c_str() << ".pov\n\n";
+    mfilepov << "#declare ch_objects = array[" << (unsigned int)std::max<size_t>(objects.size(), 1) << "];\n";
+    ChFrame<> nullframe(CSYSNORM);
+    for (unsigned int i = 0; i < objects.size(); i++) {
+        mfilepov << "#declare ch_objects[" << i << "] = ";
+        _recurseExportObjData(objects[i]->GetAssets(), nullframe, mfilepov);
+    }
+    this->camera_found_in_assets = camera_found;
+
+    // Save the object index and the coordinates of all instances
+    mfiledat << (unsigned int)frame_objects.size() << ",\n";
+    for (size_t m = 0; m < frame_objects.size(); ++m) {
+        const ChCoordsys<>& csys = frame_coords[m];
+        mfiledat << frame_objects[m] << ", ";
+        mfiledat << csys.pos.x() << ", " << csys.pos.y() << ", " << csys.pos.z() << ", ";
+        mfiledat << csys.rot.e0() << ", " << csys.rot.e1() << ", " << csys.rot.e2() << ", " << csys.rot.e3() << ",\n";
+    }
+
+    this->key_filename = filename;
+    this->key_age = 0;
+    this->key_objects.swap(frame_objects);
+    this->key_coords.swap(frame_coords);
+}
+
+void ChPovRay::ExportInstances(const std::string& filename, ChStreamOutAsciiFile& mfiledat) {
+    // Gather the coordinates of all instances: one per body, one per particle of clusters of particles
+    frame_objects.clear();
+    frame_coords.clear();
+    int nobjects = 0;
+    for (unsigned int i = 0; i < this->mdata.size(); i++) {
+        if (auto mybody = std::dynamic_pointer_cast<ChBody>(mdata[i])) {
+            frame_objects.push_back(nobjects++);
+            frame_coords.push_back(mybody->GetFrame_REF_to_abs().GetCoord());
+        } else if (auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
+            for (unsigned int m = 0; m < myclones->GetNparticles(); ++m) {
+                frame_objects.push_back(nobjects);
+                frame_coords.push_back(myclones->GetParticle(m).GetCoord());
+            }
+            nobjects++;
+        }
+    }
+
+    // Save a new keyframe if needed, otherwise only the instances moved since the last keyframe
+    if (key_filename.empty() || key_age + 1 >= keyframe_interval || frame_objects != key_objects) {
+        ExportKeyframe(filename);
+        mfiledat << 0 << ",\n";
+        return;
+    }
+
+    std::vector<unsigned int> moved;
+    for (unsigned int m = 0; m < frame_coords.size(); ++m) {
+        const ChCoordsys<>& csys = frame_coords[m];
+        const ChCoordsys<>& key_csys = key_coords[m];
+        if ((csys.pos - key_csys.pos).Length() > incremental_tolerance ||
+            fabs(csys.rot.e0() - key_csys.rot.e0()) > incremental_tolerance ||
+            fabs(csys.rot.e1() - key_csys.rot.e1()) > incremental_tolerance ||
+            fabs(csys.rot.e2() - key_csys.rot.e2()) > incremental_tolerance ||
+            fabs(csys.rot.e3() - key_csys.rot.e3()) > incremental_tolerance)
+            moved.push_back(m);
+    }
+
+    mfiledat << (unsigned int)moved.size() << ",\n";
+    for (unsigned int m : moved) {
+        const ChCoordsys<>& csys = frame_coords[m];
+        mfiledat << m << ", ";
+        mfiledat << csys.pos.x() << ", " << csys.pos.y() << ", " << csys.pos.z() << ", ";
+        mfiledat << csys.rot.e0() << ", " << csys.rot.e1() << ", " << csys.rot.e2() << ", " << csys.rot.e3() << ",\n";
+    }
+
+    key_age++;
+}
+
 void ChPovRay::ExportData(const std::string& filename) {
     // Regenerate the list of objects that need POV rendering, by
     // scanning all ChPhysicsItems in the ChSystem that have a ChPovRayAsse attached.
     // Note that SetupLists() happens at each ExportData (i.e. at each timestep)
     // because maybe some object has been added or deleted during the simulation.
+    // With incremental export, this happens only if the number of items changed.
 
-    this->SetupLists();
+    if (!this->incremental || mSystem->Get_bodylist()->size() != setup_nbodies ||
+        mSystem->Get_otherphysicslist()->size() != setup_nothers || mSystem->Get_linklist()->size() != setup_nlinks) {
+        this->SetupLists();
 
-    // Populate the assets (because maybe that during the
-    // animation someone created an object with asset, after
-    // the initial call to ExportScript() - but note that already present
-    // assets won't be appended!)
+        // Populate the assets (because maybe that during the
+        // animation someone created an object with asset, after
+        // the initial call to ExportScript() - but note that already present
+        // assets won't be appended!)
 
-    this->ExportAssets();
+        this->ExportAssets();
+    }
 
     // Generate the nnnn.dat and nnnn.pov files:
 
@@ -791,11 +966,19 @@ void ChPovRay::ExportData(const std::string& filename) {
             mfilepov << "\n\n";
         }
 
-        // Tell POV to open the .dat file, that could be used by
-        // ChParticleClones for efficiency (xyz raw data with center of particles will
-        // be saved in dat and load using a #while POV loop, helping to reduce size of .pov file)
-        mfilepov << "#declare dat_file = \"" << pathdat << "\"\n";
-        mfilepov << "#fopen MyDatFile dat_file read \n\n";
+        if (this->incremental) {
+            // Save the moved instances in the .dat file (and a new keyframe, if needed),
+            // then tell POV to load all objects.
+            this->ExportInstances(filename, mfiledat);
+            mfilepov << "ch_load_frame(\"" << key_filename.c_str() << ".key.pov\", \"" << key_filename.c_str()
+                     << ".key.dat\", \"" << pathdat << "\")\n\n";
+        } else {
+            // Tell POV to open the .dat file, that could be used by
+            // ChParticleClones for efficiency (xyz raw data with center of particles will
+            // be saved in dat and load using a #while POV loop, helping to reduce size of .pov file)
+            mfilepov << "#declare dat_file = \"" << pathdat << "\"\n";
+            mfilepov << "#fopen MyDatFile dat_file read \n\n";
+        }
 
         // Save time-dependent data for the geometry of objects in ...nnnn.POV
         // and in ...nnnn.DAT file
@@ -809,7 +992,11 @@ void ChPovRay::ExportData(const std::string& filename) {
                 assetcsys = bodyframe.GetCoord();
 
                 // Dump the POV macro that generates the contained asset(s) tree!!!
-                _recurseExportObjData(mdata[i]->GetAssets(), bodyframe, mfilepov);
+                // (with incremental export, the object was already saved: only look for a camera)
+                if (this->incremental)
+                    _recurseFindCamera(mdata[i]->GetAssets(), bodyframe);
+                else
+                    _recurseExportObjData(mdata[i]->GetAssets(), bodyframe, mfilepov);
 
                 // Show body COG?
                 if (this->COGs_show) {
@@ -831,7 +1018,8 @@ void ChPovRay::ExportData(const std::string& filename) {
             }
 
             // #) saving a cluster of particles ?  (NEW method that uses a POV '#while' loop and a .dat file)
-            if (auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
+            auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i]);
+            if (myclones && !this->incremental) {
                 mfilepov << " \n";
                 // mfilepov << "union{\n";
                 mfilepov << "#declare Index = 0; \n";
@@ -951,7 +1139,8 @@ void ChPovRay::ExportData(const std::string& filename) {
         }
 
         // At the end of the .pov file, remember to close the .dat
-        mfilepov << "\n\n#fclose MyDatFile \n";
+        if (!this->incremental)
+            mfilepov << "\n\n#fclose MyDatFile \n";
     } catch (ChException) {
         char error[400];
         sprintf(error, "Can't save data into file %s.pov (or .dat)", filename.c_str());
@@ -167,6 +167,19 @@ class ChApiPostProcess ChPovRay : public ChPostProcessBase {
     /// override the formatted number by calling SetFramenumber(), before.
     virtual void SetFramenumber(unsigned int mn) { this->framenumber = mn; }
 
+    /// Turn on/off the incremental export of frame data, useful for long animations with many
+    /// objects (ex. ChParticlesClones with thousands of particles).
+    /// When active, the geometry of each rendered item is declared only once per keyframe, in a
+    /// ...nnnn.key.pov file, and referenced by index; the coordinates of all instances (bodies and
+    /// particles) are saved in a ...nnnn.key.dat file. At the other frames, the ...nnnn.dat file
+    /// contains only the instances that moved, with respect to the last keyframe, more than 'tolerance'
+    /// (in position, or in any quaternion component). A new keyframe is saved every 'keyframe_interval'
+    /// frames, or when the rendered items change.
+    /// Also, the list of rendered items is rebuilt only when items are added to or removed from the
+    /// system (so assets added later to an item already rendered are ignored).
+    /// Must be set before calling ExportScript().
+    virtual void SetIncrementalExport(bool active, double tolerance = 1e-6, unsigned int keyframe_interval = 100);
+
     /// This function is used to export the script that will
     /// be used by POV to process all the exported data and
     /// to render the complete animation.
@@ -198,12 +211,16 @@ class ChApiPostProcess ChPovRay : public ChPostProcessBase {
   protected:
     virtual void SetupLists();
     virtual void ExportAssets();
+    void ExportInstances(const std::string& filename, ChStreamOutAsciiFile& mfiledat);
+    void ExportKeyframe(const std::string& filename);
     void _recurseExportAssets(std::vector<std::shared_ptr<ChAsset> >& assetlist, ChStreamOutAsciiFile& assets_file);
 
     void _recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& assetlist,
                                ChFrame<> parentframe,
                                ChStreamOutAsciiFile& mfilepov);
 
+    void _recurseFindCamera(std::vector<std::shared_ptr<ChAsset> >& assetlist, const ChFrame<>& parentframe);
+
     std::vector<std::shared_ptr<ChPhysicsItem> > mdata;
     std::unordered_map<size_t, std::shared_ptr<ChAsset> > pov_assets;
 
@@ -252,6 +269,21 @@ class ChApiPostProcess ChPovRay : public ChPostProcessBase {
 
     std::string custom_script;
     std::string custom_data;
+
+    bool incremental;
+    double incremental_tolerance;
+    unsigned int keyframe_interval;
+
+    size_t setup_nbodies;  ///< number of items in the system when SetupLists() was last called
+    size_t setup_nothers;
+    size_t setup_nlinks;
+
+    std::string key_filename;                ///< filename of the last keyframe (empty if none)
+    unsigned int key_age;                    ///< number of frames exported since the last keyframe
+    std::vector<int> key_objects;            ///< object index of each instance, at the last keyframe
+    std::vector<ChCoordsys<> > key_coords;   ///< coordinates of each instance, at the last keyframe
+    std::vector<int> frame_objects;          ///< object index of each instance, at the current frame
+    std::vector<ChCoordsys<> > frame_coords; ///< coordinates of each instance, at the current frame
 };
 
 }  // end namespace postprocess
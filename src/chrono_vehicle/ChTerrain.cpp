@@ -20,5 +20,19 @@
 
 namespace chrono {
 namespace vehicle {
+
+void ChTerrain::GetHeightAndNormal(const std::vector<double>& x,
+                                   const std::vector<double>& y,
+                                   std::vector<double>& heights,
+                                   std::vector<ChVector<> >& normals) const {
+    size_t n = x.size();
+    heights.resize(n);
+    normals.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        heights[i] = GetHeight(x[i], y[i]);
+        normals[i] = GetNormal(x[i], y[i]);
+    }
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
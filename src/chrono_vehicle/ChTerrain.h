@@ -19,6 +19,8 @@
 #ifndef CH_TERRAIN_H
 #define CH_TERRAIN_H
 
+#include <vector>
+
 #include "chrono/core/ChVector.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
@@ -53,6 +55,15 @@ class CH_VEHICLE_API ChTerrain {
 
     /// Get the terrain normal at the specified (x,y) location.
     virtual ChVector<> GetNormal(double x, double y) const = 0;
+
+    /// Get the terrain height and normal at each of the specified (x,y) locations.
+    /// The default implementation calls GetHeight and GetNormal for each location;
+    /// derived classes may provide a faster batched query.
+    virtual void GetHeightAndNormal(const std::vector<double>& x,       ///< [in] x coordinates of the query points
+                                    const std::vector<double>& y,       ///< [in] y coordinates of the query points
+                                    std::vector<double>& heights,       ///< [out] terrain heights
+                                    std::vector<ChVector<> >& normals  ///< [out] terrain normals
+                                    ) const;
 };
 
 /// @} vehicle_terrain
@@ -21,7 +21,7 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 #include "chrono_vehicle/chassis/RigidChassis.h"
 
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -48,15 +48,8 @@ static ChQuaternion<> loadQuaternion(const Value& a) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 RigidChassis::RigidChassis(const std::string& filename) : ChChassis(""), m_has_mesh(false) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     Create(d);
 
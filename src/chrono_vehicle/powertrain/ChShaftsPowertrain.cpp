@@ -16,6 +16,9 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <cmath>
+
 #include "chrono/physics/ChSystem.h"
 
 #include "chrono_vehicle/powertrain/ChShaftsPowertrain.h"
@@ -29,23 +32,56 @@ namespace vehicle {
 // ChShaftsBody could transfer rolling torque to the chassis.
 // -----------------------------------------------------------------------------
 ChShaftsPowertrain::ChShaftsPowertrain(const ChVector<>& dir_motor_block)
-    : ChPowertrain(), m_dir_motor_block(dir_motor_block), m_last_time_gearshift(0), m_gear_shift_latency(0.5) {
-}
+    : ChPowertrain(),
+      m_quasi_static(false),
+      m_dir_motor_block(dir_motor_block),
+      m_last_time_gearshift(0),
+      m_gear_shift_latency(0.5),
+      m_crankshaft_inertia(0),
+      m_throttle(0),
+      m_motor_speed(0),
+      m_turbine_speed(0),
+      m_motor_torque(0),
+      m_tc_input_torque(0),
+      m_tc_output_torque(0),
+      m_output_torque(0) {}
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void ChShaftsPowertrain::Initialize(std::shared_ptr<ChBody> chassis, std::shared_ptr<ChShaft> driveshaft) {
+    // Let the derived class specify the gear ratios
+    SetGearRatios(m_gear_ratios);
+    assert(m_gear_ratios.size() > 1);
+    m_current_gear = 1;
+
+    // In quasi-static mode, only sample the maps provided by the derived class.
+    if (m_quasi_static) {
+        auto mTw = std::make_shared<ChFunction_Recorder>();
+        SetEngineTorqueMap(mTw);
+        m_engine_map.Sample(*mTw, 512);
+
+        auto mTw_losses = std::make_shared<ChFunction_Recorder>();
+        SetEngineLossesMap(mTw_losses);
+        m_losses_map.Sample(*mTw_losses, 512);
+
+        auto mK = std::make_shared<ChFunction_Recorder>();
+        SetTorqueConverterCapacityFactorMap(mK);
+        m_capacity_map.Sample(*mK, 256);
+
+        auto mT = std::make_shared<ChFunction_Recorder>();
+        SetTorqeConverterTorqueRatioMap(mT);
+        m_ratio_map.Sample(*mT, 256);
+
+        m_crankshaft_inertia = GetCrankshaftInertia();
+        return;
+    }
+
     assert(chassis);
     assert(driveshaft);
     assert(chassis->GetSystem());
 
     ChSystem* my_system = chassis->GetSystem();
 
-    // Let the derived class specify the gear ratios
-    SetGearRatios(m_gear_ratios);
-    assert(m_gear_ratios.size() > 1);
-    m_current_gear = 1;
-
     // CREATE  a 1 d.o.f. object: a 'shaft' with rotational inertia.
     // In this case it is the motor block. This because the ChShaftsThermalEngine
     // needs two 1dof items to apply the torque in-between them (the other will be
@@ -126,6 +162,42 @@ void ChShaftsPowertrain::Initialize(std::shared_ptr<ChBody> chassis, std::shared
     SetSelectedGear(1);
 }
 
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+double ChShaftsPowertrain::GetMotorSpeed() const {
+    return m_quasi_static ? m_motor_speed : m_crankshaft->GetPos_dt();
+}
+
+double ChShaftsPowertrain::GetMotorTorque() const {
+    return m_quasi_static ? m_motor_torque : m_engine->GetTorqueReactionOn1();
+}
+
+double ChShaftsPowertrain::GetTorqueConverterSlippage() const {
+    if (!m_quasi_static)
+        return m_torqueconverter->GetSlippage();
+    if (std::abs(m_motor_speed) < 10e-9 || std::abs(m_turbine_speed) < 10e-9)
+        return 1;
+    return 1 - m_turbine_speed / m_motor_speed;
+}
+
+double ChShaftsPowertrain::GetTorqueConverterInputTorque() const {
+    return m_quasi_static ? m_tc_input_torque : -m_torqueconverter->GetTorqueReactionOnInput();
+}
+
+double ChShaftsPowertrain::GetTorqueConverterOutputTorque() const {
+    return m_quasi_static ? m_tc_output_torque : m_torqueconverter->GetTorqueReactionOnOutput();
+}
+
+// -----------------------------------------------------------------------------
+// The in-gear shaft turns at the driveshaft speed divided by the gear ratio.
+// -----------------------------------------------------------------------------
+double ChShaftsPowertrain::GetOutputInertia() const {
+    if (m_drive_mode == NEUTRAL)
+        return 0;
+    double ratio = m_gear_ratios[m_current_gear];
+    return GetIngearShaftInertia() / (ratio * ratio);
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void ChShaftsPowertrain::SetSelectedGear(int igear) {
@@ -164,8 +236,21 @@ void ChShaftsPowertrain::SetDriveMode(ChPowertrain::DriveMode mmode) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void ChShaftsPowertrain::Synchronize(double time, double throttle, double shaft_speed) {
-    // Just update the throttle level in the thermal engine
-    m_engine->SetThrottle(throttle);
+    if (m_quasi_static) {
+        // The turbine is rigidly connected to the driveshaft through the gearbox
+        // (and assumed unloaded, turning with the engine, in neutral).
+        m_throttle = throttle;
+        if (m_drive_mode == NEUTRAL)
+            m_turbine_speed = m_motor_speed;
+        else
+            m_turbine_speed = shaft_speed / m_gear_ratios[m_current_gear];
+
+        ComputeQuasiStatic(m_motor_speed, m_motor_torque, m_tc_input_torque, m_tc_output_torque);
+        m_output_torque = (m_drive_mode == NEUTRAL) ? 0 : m_tc_output_torque / m_gear_ratios[m_current_gear];
+    } else {
+        // Just update the throttle level in the thermal engine
+        m_engine->SetThrottle(throttle);
+    }
 
     // To avoid bursts of gear shifts, do nothing if the last shift was too recent
     if (time - m_last_time_gearshift < m_gear_shift_latency)
@@ -177,7 +262,7 @@ void ChShaftsPowertrain::Synchronize(double time, double throttle, double shaft_
     if (m_drive_mode != FORWARD)
         return;
 
-    double gearshaft_speed = m_shaft_ingear->GetPos_dt();
+    double gearshaft_speed = m_quasi_static ? m_turbine_speed : m_shaft_ingear->GetPos_dt();
 
     if (gearshaft_speed > 2500 * CH_C_2PI / 60.0) {
         // upshift if possible
@@ -196,5 +281,99 @@ void ChShaftsPowertrain::Synchronize(double time, double throttle, double shaft_
     }
 }
 
+// -----------------------------------------------------------------------------
+// Advance the engine speed in quasi-static mode, with one linearly implicit
+// Euler step of  J * d(speed)/dt = T_engine + T_losses - T_converter_input
+// (the turbine speed is held fixed over the step).
+// -----------------------------------------------------------------------------
+void ChShaftsPowertrain::Advance(double step) {
+    if (!m_quasi_static)
+        return;
+
+    double T_motor, T_in, T_out;
+
+    ComputeQuasiStatic(m_motor_speed, T_motor, T_in, T_out);
+    double f0 = T_motor + m_losses_map.Eval(m_motor_speed) - T_in;
+
+    double delta = 1e-3 * std::max(std::abs(m_motor_speed), 1.0);
+    ComputeQuasiStatic(m_motor_speed + delta, T_motor, T_in, T_out);
+    double f1 = T_motor + m_losses_map.Eval(m_motor_speed + delta) - T_in;
+
+    // Only the stabilizing part of the Jacobian is used
+    double df = std::min((f1 - f0) / delta, 0.0);
+    m_motor_speed += step * f0 / (m_crankshaft_inertia - step * df);
+}
+
+// -----------------------------------------------------------------------------
+// Engine and torque converter torques in quasi-static mode. This replicates the
+// ChShaftsThermalEngine and ChShaftsTorqueConverter models, with the motor block
+// (torque converter stator) fixed.
+// -----------------------------------------------------------------------------
+void ChShaftsPowertrain::ComputeQuasiStatic(double motor_speed,
+                                            double& motor_torque,
+                                            double& tc_input,
+                                            double& tc_output) const {
+    motor_torque = m_throttle * m_engine_map.Eval(motor_speed);
+
+    // Speed ratio, with the same treatment of singular cases as ChShaftsTorqueConverter
+    double ratio = 0;
+    if (std::abs(motor_speed) >= 10e-9 && std::abs(m_turbine_speed) >= 10e-9)
+        ratio = m_turbine_speed / motor_speed;
+    bool reverse_flow = false;
+    if (ratio > 1) {
+        ratio = 1 - (ratio - 1);
+        reverse_flow = true;
+    }
+    if (ratio < 0)
+        ratio = 0;
+
+    if (motor_speed < 0) {
+        tc_input = 0;
+        tc_output = 0;
+        return;
+    }
+
+    double K = m_capacity_map.Eval(ratio);
+    double T = m_ratio_map.Eval(ratio);
+
+    tc_input = std::pow(motor_speed / K, 2);
+    if (reverse_flow)
+        tc_input = -tc_input;
+    tc_output = T * tc_input;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChShaftsPowertrain::LookupTable::Sample(ChFunction_Recorder& map, int num_samples) {
+    double xmin;
+    double xmax;
+    map.Estimate_x_range(xmin, xmax);
+
+    if (map.GetPoints().size() < 2 || xmax <= xmin) {
+        m_x0 = xmin;
+        m_dx_inv = 0;
+        m_y.assign(1, map.Get_y(xmin));
+        return;
+    }
+
+    double dx = (xmax - xmin) / (num_samples - 1);
+    m_x0 = xmin;
+    m_dx_inv = 1 / dx;
+    m_y.resize(num_samples);
+    for (int i = 0; i < num_samples; i++)
+        m_y[i] = map.Get_y(xmin + i * dx);
+}
+
+double ChShaftsPowertrain::LookupTable::Eval(double x) const {
+    double t = (x - m_x0) * m_dx_inv;
+    if (t <= 0)
+        return m_y.front();
+    size_t i = static_cast<size_t>(t);
+    if (i >= m_y.size() - 1)
+        return m_y.back();
+    double a = t - i;
+    return (1 - a) * m_y[i] + a * m_y[i + 1];
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
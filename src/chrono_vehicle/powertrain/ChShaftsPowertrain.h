@@ -19,6 +19,8 @@
 #ifndef CH_SHAFTS_POWERTRAIN_H
 #define CH_SHAFTS_POWERTRAIN_H
 
+#include <vector>
+
 #include "chrono_vehicle/ChApiVehicle.h"
 #include "chrono_vehicle/ChPowertrain.h"
 
@@ -43,7 +45,18 @@ namespace vehicle {
 // Forward reference
 class ChVehicle;
 
-/// Template for a powertrain model using shaft elements. 
+/// Template for a powertrain model using shaft elements.
+///
+/// Optionally, the same powertrain data can be used in a quasi-static mode (see
+/// SetQuasiStaticMode), in which no ChShaft elements are added to the system.
+/// The engine and torque converter maps are then sampled into uniform lookup
+/// tables, the engine speed is the only state (advanced by the powertrain itself),
+/// and the output torque is passed to the driveline through GetOutputTorque(),
+/// as for ChSimplePowertrain. The crankshaft inertia is retained. The inertia of
+/// the transmission shaft, reflected to the driveshaft (GetOutputInertia), must be
+/// accounted for by the driveline. The reaction torques on the chassis, which are
+/// balanced by those of the driveline conical gears up to the inertia torques, are
+/// neglected.
 class CH_VEHICLE_API ChShaftsPowertrain : public ChPowertrain {
   public:
     /// Construct a shafts-based powertrain model.
@@ -51,20 +64,27 @@ class CH_VEHICLE_API ChShaftsPowertrain : public ChPowertrain {
 
     virtual ~ChShaftsPowertrain() {}
 
+    /// Enable or disable the quasi-static mode (default: false).
+    /// Must be called before Initialize().
+    void SetQuasiStaticMode(bool val) { m_quasi_static = val; }
+
+    /// Return true if the powertrain is in quasi-static mode.
+    bool IsQuasiStaticMode() const { return m_quasi_static; }
+
     /// Return the current engine speed.
-    virtual double GetMotorSpeed() const override { return m_crankshaft->GetPos_dt(); }
+    virtual double GetMotorSpeed() const override;
 
     /// Return the current engine torque.
-    virtual double GetMotorTorque() const override { return m_engine->GetTorqueReactionOn1(); }
+    virtual double GetMotorTorque() const override;
 
     /// Return the value of slippage in the torque converter.
-    virtual double GetTorqueConverterSlippage() const override { return m_torqueconverter->GetSlippage(); }
+    virtual double GetTorqueConverterSlippage() const override;
 
     /// Return the input torque to the torque converter.
-    virtual double GetTorqueConverterInputTorque() const override { return -m_torqueconverter->GetTorqueReactionOnInput(); }
+    virtual double GetTorqueConverterInputTorque() const override;
 
     /// Return the output torque from the torque converter.
-    virtual double GetTorqueConverterOutputTorque() const override { return m_torqueconverter->GetTorqueReactionOnOutput(); }
+    virtual double GetTorqueConverterOutputTorque() const override;
 
     /// Return the current transmission gear.
     virtual int GetCurrentTransmissionGear() const override { return m_current_gear; }
@@ -73,8 +93,14 @@ class CH_VEHICLE_API ChShaftsPowertrain : public ChPowertrain {
     /// This is the torque that is passed to a vehicle system, thus providing the
     /// interface between the powertrain and vehcicle cosimulation modules.
     /// Since a ShaftsPowertrain is directly connected to the vehicle's driveline,
-    /// this function returns 0.
-    virtual double GetOutputTorque() const override { return 0; }
+    /// this function returns 0, except in quasi-static mode.
+    virtual double GetOutputTorque() const override { return m_quasi_static ? m_output_torque : 0; }
+
+    /// Return the inertia of the transmission shaft reflected to the driveshaft,
+    /// for the currently selected gear (0 in neutral).
+    /// In quasi-static mode, this is the inertia that a quasi-static driveline must
+    /// add on its input (see ChShaftsDriveline4WD::SetInputInertia).
+    double GetOutputInertia() const;
 
     /// Use this function to set the mode of automatic transmission.
     virtual void SetDriveMode(ChPowertrain::DriveMode mmode) override;
@@ -92,7 +118,8 @@ class CH_VEHICLE_API ChShaftsPowertrain : public ChPowertrain {
 
     /// Initialize this powertrain system.
     /// This creates all the wrapped ChShaft objects and their constraints, torques etc.
-    /// and connects the powertrain to the vehicle.
+    /// and connects the powertrain to the vehicle. In quasi-static mode, this only
+    /// builds the lookup tables and the driveshaft may be empty.
     virtual void Initialize(std::shared_ptr<ChBody> chassis,     ///< [in] chassis o the associated vehicle
                             std::shared_ptr<ChShaft> driveshaft  ///< [in] shaft connection to the vehicle driveline
                             ) override;
@@ -108,8 +135,8 @@ class CH_VEHICLE_API ChShaftsPowertrain : public ChPowertrain {
 
     /// Advance the state of this powertrain system by the specified time step.
     /// Since the state of a ShaftsPowertrain is advanced as part of the vehicle
-    /// state, this function does nothing.
-    virtual void Advance(double step) override {}
+    /// state, this function does nothing, except in quasi-static mode.
+    virtual void Advance(double step) override;
 
   protected:
     /// Set up the gears, i.e. the transmission ratios of the various gears.
@@ -136,6 +163,22 @@ class CH_VEHICLE_API ChShaftsPowertrain : public ChPowertrain {
     virtual void SetTorqeConverterTorqueRatioMap(std::shared_ptr<ChFunction_Recorder>& map) = 0;
 
   private:
+    /// Uniformly sampled copy of a map, used in quasi-static mode.
+    struct LookupTable {
+        void Sample(ChFunction_Recorder& map, int num_samples);
+        double Eval(double x) const;
+
+        double m_x0;              ///< first abscissa
+        double m_dx_inv;          ///< inverse of the sampling interval
+        std::vector<double> m_y;  ///< sampled values
+    };
+
+    /// Compute the engine and torque converter torques in quasi-static mode,
+    /// for the specified engine speed and the current turbine speed.
+    void ComputeQuasiStatic(double motor_speed, double& motor_torque, double& tc_input, double& tc_output) const;
+
+    bool m_quasi_static;
+
     std::shared_ptr<ChShaftsBody> m_motorblock_to_body;
     std::shared_ptr<ChShaft> m_motorblock;
     std::shared_ptr<ChShaftsThermalEngine> m_engine;
@@ -152,6 +195,20 @@ class CH_VEHICLE_API ChShaftsPowertrain : public ChPowertrain {
 
     double m_last_time_gearshift;
     double m_gear_shift_latency;
+
+    // Quasi-static mode data
+    LookupTable m_engine_map;     ///< engine speed-torque map
+    LookupTable m_losses_map;     ///< engine losses map
+    LookupTable m_capacity_map;   ///< torque converter capacity factor map
+    LookupTable m_ratio_map;      ///< torque converter torque ratio map
+    double m_crankshaft_inertia;  ///< inertia of crankshaft and flywheel
+    double m_throttle;            ///< current throttle input
+    double m_motor_speed;         ///< engine speed (state)
+    double m_turbine_speed;       ///< torque converter output speed
+    double m_motor_torque;        ///< engine torque
+    double m_tc_input_torque;     ///< torque converter input torque
+    double m_tc_output_torque;    ///< torque converter output torque
+    double m_output_torque;       ///< torque on the driveshaft
 };
 
 /// @} vehicle_powertrain
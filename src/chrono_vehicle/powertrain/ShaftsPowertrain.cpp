@@ -20,7 +20,7 @@
 
 #include "chrono_vehicle/powertrain/ShaftsPowertrain.h"
 
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -31,15 +31,8 @@ namespace vehicle {
 // Constructor a shafts powertrain using data from the specified JSON file.
 // -----------------------------------------------------------------------------
 ShaftsPowertrain::ShaftsPowertrain(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     Create(d);
 
@@ -20,7 +20,7 @@
 
 #include "chrono_vehicle/powertrain/SimplePowertrain.h"
 
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -30,15 +30,8 @@ namespace vehicle {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 SimplePowertrain::SimplePowertrain(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     Create(d);
 
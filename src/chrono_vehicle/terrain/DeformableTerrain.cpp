@@ -16,9 +16,12 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cmath>
 
+#include "chrono/ChConfig.h"
 #include "chrono/physics/ChMaterialSurface.h"
 #include "chrono/physics/ChMaterialSurfaceDEM.h"
 #include "chrono/assets/ChTexture.h"
@@ -28,6 +31,12 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 #include "chrono_vehicle/terrain/DeformableTerrain.h"
 
+#ifdef CHRONO_FEA
+#include "chrono_fea/ChContactSurfaceMesh.h"
+#include "chrono_fea/ChContactSurfaceNodeCloud.h"
+#include "chrono_fea/ChMesh.h"
+#endif
+
 #include "chrono_thirdparty/Easy_BMP/EasyBMP.h"
 #include "chrono_thirdparty/rapidjson/document.h"
 #include "chrono_thirdparty/rapidjson/filereadstream.h"
@@ -144,11 +153,20 @@ double DeformableTerrain::GetTestHighOffset() const {
     return m_ground->test_high_offset;
 }
 
+void DeformableTerrain::SetGridRayCasting(bool mg) {
+    m_ground->do_grid_raycast = mg;
+}
+
+bool DeformableTerrain::GetGridRayCasting() const {
+    return m_ground->do_grid_raycast;
+}
+
 // Set the color plot type.
 void DeformableTerrain::SetPlotType(DataPlotType mplot, double mmin, double mmax) {
     m_ground->plot_type = mplot;
     m_ground->plot_v_min = mmin;
     m_ground->plot_v_max = mmax;
+    m_ground->plot_all = true;
 }
 
 // Initialize the terrain as a flat grid
@@ -211,10 +229,13 @@ DeformableSoil::DeformableSoil(ChSystem* system) {
     plot_type = DeformableTerrain::PLOT_NONE;
     plot_v_min = 0;
     plot_v_max = 0.2;
+    plot_all = true;
 
     test_high_offset = 0.1;
     test_low_offset = 0.5;
 
+    do_grid_raycast = true;
+
     last_t = 0;
 }
 
@@ -285,6 +306,8 @@ void DeformableSoil::Initialize(double height, double sizeX, double sizeY, int n
 void DeformableSoil::Initialize(const std::string& mesh_file) {
     m_trimesh_shape->GetMesh().Clear();
     m_trimesh_shape->GetMesh().LoadWavefrontMesh(mesh_file, true, true);
+
+    SetupAuxData();
 }
 
 // Initialize the terrain from a specified height map.
@@ -409,47 +432,861 @@ void DeformableSoil::Initialize(const std::string& heightmap_file,
 }
 
 // Set up auxiliary data structures.
+void DeformableSoil::SetupVertexGrid() {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    int n_vertices = (int)vertices.size();
+
+    grid_nx = 0;
+    grid_nz = 0;
+    grid_cell_start.clear();
+    grid_vertices.clear();
+    if (n_vertices == 0)
+        return;
+
+    // Extent of the vertices on the soil plane
+    std::vector<ChVector<>> local_vertices(n_vertices);
+    double max_x = -1e30;
+    double max_z = -1e30;
+    grid_min_x = 1e30;
+    grid_min_z = 1e30;
+    for (int i = 0; i < n_vertices; ++i) {
+        local_vertices[i] = plane.TransformParentToLocal(vertices[i]);
+        grid_min_x = ChMin(grid_min_x, local_vertices[i].x());
+        grid_min_z = ChMin(grid_min_z, local_vertices[i].z());
+        max_x = ChMax(max_x, local_vertices[i].x());
+        max_z = ChMax(max_z, local_vertices[i].z());
+    }
+
+    // Cells hold a few vertices each, on average
+    double area = (max_x - grid_min_x) * (max_z - grid_min_z);
+    grid_cell_size = 2 * sqrt(area / n_vertices);
+    if (grid_cell_size <= 0)
+        grid_cell_size = 1;
+    grid_nx = (int)floor((max_x - grid_min_x) / grid_cell_size) + 1;
+    grid_nz = (int)floor((max_z - grid_min_z) / grid_cell_size) + 1;
+
+    // Counting sort of the vertices by cell
+    std::vector<int> vertex_cell(n_vertices);
+    grid_cell_start.assign(grid_nx * grid_nz + 1, 0);
+    for (int i = 0; i < n_vertices; ++i) {
+        int ix = (int)floor((local_vertices[i].x() - grid_min_x) / grid_cell_size);
+        int iz = (int)floor((local_vertices[i].z() - grid_min_z) / grid_cell_size);
+        vertex_cell[i] = ChMin(iz, grid_nz - 1) * grid_nx + ChMin(ix, grid_nx - 1);
+        grid_cell_start[vertex_cell[i] + 1]++;
+    }
+    for (int ic = 0; ic < grid_nx * grid_nz; ++ic) {
+        grid_cell_start[ic + 1] += grid_cell_start[ic];
+    }
+    std::vector<int> cell_fill(grid_cell_start.begin(), grid_cell_start.end() - 1);
+    grid_vertices.resize(n_vertices);
+    for (int i = 0; i < n_vertices; ++i) {
+        grid_vertices[cell_fill[vertex_cell[i]]++] = i;
+    }
+}
+
+// Collect the collision models of the bodies and of the FEA contact surfaces of an assembly
+// (and of its sub-assemblies). Returns false if the assembly contains other items that
+// collide (e.g. particle clouds), whose collision models cannot be enumerated.
+static bool CollectCollisionModels(ChAssembly* assembly, std::vector<collision::ChCollisionModel*>& models) {
+    for (auto& body : *assembly->Get_bodylist()) {
+        if (body->GetCollide() && body->GetCollisionModel())
+            models.push_back(body->GetCollisionModel().get());
+    }
+    for (auto& item : *assembly->Get_otherphysicslist()) {
+        if (auto subassembly = std::dynamic_pointer_cast<ChAssembly>(item)) {
+            if (!CollectCollisionModels(subassembly.get(), models))
+                return false;
+            continue;
+        }
+#ifdef CHRONO_FEA
+        if (auto mesh = std::dynamic_pointer_cast<fea::ChMesh>(item)) {
+            for (unsigned int is = 0; is < mesh->GetNcontactSurfaces(); ++is) {
+                auto surface = mesh->GetContactSurface(is);
+                if (auto trimesh = std::dynamic_pointer_cast<fea::ChContactSurfaceMesh>(surface)) {
+                    for (auto& face : trimesh->GetTriangleList())
+                        models.push_back(face->GetCollisionModel());
+                    for (auto& face : trimesh->GetTriangleListRot())
+                        models.push_back(face->GetCollisionModel());
+                } else if (auto cloud = std::dynamic_pointer_cast<fea::ChContactSurfaceNodeCloud>(surface)) {
+                    for (unsigned int in = 0; in < cloud->GetNnodes(); ++in)
+                        models.push_back(cloud->GetNode(in)->GetCollisionModel());
+                    for (unsigned int in = 0; in < cloud->GetNnodesRot(); ++in)
+                        models.push_back(cloud->GetNodeRot(in)->GetCollisionModel());
+                } else {
+                    return false;
+                }
+            }
+            continue;
+        }
+#endif
+        if (item->GetCollide())
+            return false;
+    }
+    return true;
+}
+
+void DeformableSoil::FindRayHits(const ChVector<>& N,
+                                 std::vector<int>& ray_vertices,
+                                 std::vector<collision::ChCollisionSystem::ChRayhitResult>& ray_hits) {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    collision::ChCollisionSystem* collision_system = this->GetSystem()->GetCollisionSystem().get();
+    int n_vertices = (int)vertices.size();
+
+    ray_vertices.clear();
+    ray_hits.clear();
+
+    // The grid is used only if the collision system can test single models
+    std::vector<collision::ChCollisionModel*> models;
+    if (!do_grid_raycast || !collision_system->SupportsModelRayHit() ||
+        !CollectCollisionModels(this->GetSystem(), models)) {
+        // Test every vertex against the whole collision system (not thread safe)
+        ray_vertices.resize(n_vertices);
+        ray_hits.resize(n_vertices);
+        for (int i = 0; i < n_vertices; ++i) {
+            ChVector<> to = vertices[i] + N * test_high_offset;
+            ChVector<> from = to - N * test_low_offset;
+            ray_vertices[i] = i;
+            collision_system->RayHit(from, to, ray_hits[i]);
+        }
+        return;
+    }
+
+    if (grid_vertices.size() != n_vertices)
+        SetupVertexGrid();
+
+    // Collect the (vertex, model) pairs such that the vertical ray of the vertex
+    // crosses the bounding box of a collision model
+    std::vector<std::pair<int, collision::ChCollisionModel*>> candidates;
+    for (auto model : models) {
+        // Bounding box of the model, in the soil plane coordinates
+        ChVector<> bbmin, bbmax;
+        model->GetAABB(bbmin, bbmax);
+        ChVector<> lmin(1e30, 1e30, 1e30);
+        ChVector<> lmax(-1e30, -1e30, -1e30);
+        for (int ic = 0; ic < 8; ++ic) {
+            ChVector<> corner((ic & 1) ? bbmax.x() : bbmin.x(), (ic & 2) ? bbmax.y() : bbmin.y(),
+                              (ic & 4) ? bbmax.z() : bbmin.z());
+            ChVector<> lcorner = plane.TransformParentToLocal(corner);
+            for (int k = 0; k < 3; ++k) {
+                lmin[k] = ChMin(lmin[k], lcorner[k]);
+                lmax[k] = ChMax(lmax[k], lcorner[k]);
+            }
+        }
+
+        int ix_min = ChMax((int)floor((lmin.x() - grid_min_x) / grid_cell_size), 0);
+        int ix_max = ChMin((int)floor((lmax.x() - grid_min_x) / grid_cell_size), grid_nx - 1);
+        int iz_min = ChMax((int)floor((lmin.z() - grid_min_z) / grid_cell_size), 0);
+        int iz_max = ChMin((int)floor((lmax.z() - grid_min_z) / grid_cell_size), grid_nz - 1);
+        for (int iz = iz_min; iz <= iz_max; ++iz) {
+            for (int ix = ix_min; ix <= ix_max; ++ix) {
+                int ic = iz * grid_nx + ix;
+                for (int k = grid_cell_start[ic]; k < grid_cell_start[ic + 1]; ++k) {
+                    int iv = grid_vertices[k];
+                    ChVector<> lv = plane.TransformParentToLocal(vertices[iv]);
+                    if (lv.x() < lmin.x() || lv.x() > lmax.x() || lv.z() < lmin.z() || lv.z() > lmax.z())
+                        continue;
+                    // the ray spans [level + high offset - low offset, level + high offset]
+                    if (lv.y() + test_high_offset < lmin.y() || lv.y() + test_high_offset - test_low_offset > lmax.y())
+                        continue;
+                    candidates.push_back(std::make_pair(iv, model));
+                }
+            }
+        }
+    }
+
+    // Group the candidates by vertex (keeping the model order within a vertex, for determinism)
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const std::pair<int, collision::ChCollisionModel*>& a,
+                        const std::pair<int, collision::ChCollisionModel*>& b) { return a.first < b.first; });
+    std::vector<int> ray_start;
+    for (int k = 0; k < candidates.size(); ++k) {
+        if (k == 0 || candidates[k].first != candidates[k - 1].first) {
+            ray_start.push_back(k);
+            ray_vertices.push_back(candidates[k].first);
+        }
+    }
+    ray_start.push_back((int)candidates.size());
+
+    // Cast the rays in parallel, directly against the candidate models; keep the closest hit
+    int n_rays = (int)ray_vertices.size();
+    ray_hits.resize(n_rays);
+#pragma omp parallel for schedule(dynamic, 16)
+    for (int ir = 0; ir < n_rays; ++ir) {
+        int iv = ray_vertices[ir];
+        ChVector<> to = vertices[iv] + N * test_high_offset;
+        ChVector<> from = to - N * test_low_offset;
+        collision::ChCollisionSystem::ChRayhitResult& closest = ray_hits[ir];
+        closest.hit = false;
+        for (int k = ray_start[ir]; k < ray_start[ir + 1]; ++k) {
+            collision::ChCollisionSystem::ChRayhitResult result;
+            if (collision_system->RayHit(from, to, candidates[k].second, result) &&
+                (!closest.hit || result.dist_factor < closest.dist_factor)) {
+                closest = result;
+            }
+        }
+    }
+}
+
 void DeformableSoil::SetupAuxData() {
-    // better readability:
+    // Reset the computation data: all nodes are in their initial state
+    p_nodes.clear();
+    active_vertices.clear();
+    plot_all = true;
+
+    SetupConnectivity();
+
+    m_trimesh_shape->GetMesh().ComputeNeighbouringTriangleMap(this->tri_map);
+
+    SetupVertexGrid();
+}
+
+DeformableSoil::NodeRecord::NodeRecord(const ChVector<>& vertex, double level, double area)
+    : vertex_initial(vertex),
+      speed(VNULL),
+      level(level),
+      level_initial(level),
+      hit_level(1e9),
+      sinkage(0),
+      sinkage_plastic(0),
+      sinkage_elastic(0),
+      step_plastic_flow(0),
+      kshear(0),
+      area(area),
+      sigma(0),
+      sigma_yeld(0),
+      tau(0),
+      massremainder(0),
+      id_island(0),
+      erosion(false),
+      active(false) {}
+
+DeformableSoil::NodeRecord DeformableSoil::GetNodeState(int iv) const {
+    if (const NodeRecord* node = FindNode(iv))
+        return *node;
+    const ChVector<>& vertex = m_trimesh_shape->GetMesh().getCoordsVertices()[iv];
+    return NodeRecord(vertex, plane.TransformParentToLocal(vertex).y(), ComputeVertexArea(iv));
+}
+
+DeformableSoil::NodeRecord& DeformableSoil::GetNode(int iv) {
+    auto it = p_nodes.find(iv);
+    if (it != p_nodes.end())
+        return it->second;
+    // The vertex of a node without record was never moved: it is the initial vertex
+    return p_nodes.emplace(iv, GetNodeState(iv)).first->second;
+}
+
+void DeformableSoil::SetupConnectivity() {
+    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+    int n_vertices = (int)m_trimesh_shape->GetMesh().getCoordsVertices().size();
+    int n_triangles = (int)idx_vertices.size();
+
+    // Triangles incident to each vertex (counting sort)
+    connected_triangles_start.assign(n_vertices + 1, 0);
+    for (int it = 0; it < n_triangles; ++it) {
+        for (int k = 0; k < 3; ++k)
+            connected_triangles_start[idx_vertices[it][k] + 1]++;
+    }
+    for (int iv = 0; iv < n_vertices; ++iv) {
+        connected_triangles_start[iv + 1] += connected_triangles_start[iv];
+    }
+    std::vector<int> tri_fill(connected_triangles_start.begin(), connected_triangles_start.end() - 1);
+    connected_triangles.resize(connected_triangles_start[n_vertices]);
+    for (int it = 0; it < n_triangles; ++it) {
+        for (int k = 0; k < 3; ++k)
+            connected_triangles[tri_fill[idx_vertices[it][k]]++] = it;
+    }
+
+    // Neighbouring vertices: the other vertices of the incident triangles, sorted and without duplicates
+    connected_start.assign(n_vertices + 1, 0);
+    connected_vertexes.clear();
+    connected_vertexes.reserve(connected_triangles.size());
+    std::vector<int> neighbours;
+    for (int iv = 0; iv < n_vertices; ++iv) {
+        neighbours.clear();
+        for (int k = connected_triangles_start[iv]; k < connected_triangles_start[iv + 1]; ++k) {
+            for (int j = 0; j < 3; ++j) {
+                int ivn = idx_vertices[connected_triangles[k]][j];
+                if (ivn != iv)
+                    neighbours.push_back(ivn);
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        connected_vertexes.insert(connected_vertexes.end(), neighbours.begin(), neighbours.end());
+        connected_start[iv + 1] = (int)connected_vertexes.size();
+    }
+}
+
+double DeformableSoil::ComputeVertexArea(int iv) const {
+    const std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    const std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+
+    // for a X-Z rectangular grid-like mesh it is simply area[i]= xsize/xsteps * zsize/zsteps,
+    // but the following is more general, also for generic meshes:
+    double area = 0;
+    for (int k = connected_triangles_start[iv]; k < connected_triangles_start[iv + 1]; ++k) {
+        const ChVector<int>& tri = idx_vertices[connected_triangles[k]];
+        ChVector<> AB = plane.TransformDirectionParentToLocal(vertices[tri[1]] - vertices[tri[0]]);
+        ChVector<> AC = plane.TransformDirectionParentToLocal(vertices[tri[2]] - vertices[tri[0]]);
+        AB.y() = 0;
+        AC.y() = 0;
+        area += 0.5 * (Vcross(AB, AC)).Length() / 3.0;
+    }
+    return area;
+}
+
+void DeformableSoil::InterpolateRefinedNodes(int n_vertices_old, const std::vector<std::pair<int, int>>& split_edges) {
+    // Vertices are processed in creation order, so that the state of both edge vertices is known
+    for (int k = 0; k < (int)split_edges.size(); ++k) {
+        int iv = n_vertices_old + k;
+        int ia = split_edges[k].first;
+        int ib = split_edges[k].second;
+
+        // Nodes between two nodes in their initial state are in their initial state too
+        if (!FindNode(ia) && !FindNode(ib))
+            continue;
+
+        NodeRecord node_a = GetNodeState(ia);
+        NodeRecord node_b = GetNodeState(ib);
+        NodeRecord& node = MarkActive(iv);
+        node.vertex_initial = (node_a.vertex_initial + node_b.vertex_initial) * 0.5;
+        node.speed = (node_a.speed + node_b.speed) * 0.5;
+        node.level = (node_a.level + node_b.level) * 0.5;
+        node.level_initial = (node_a.level_initial + node_b.level_initial) * 0.5;
+        node.hit_level = (node_a.hit_level + node_b.hit_level) * 0.5;
+        node.sinkage = (node_a.sinkage + node_b.sinkage) * 0.5;
+        node.sinkage_plastic = (node_a.sinkage_plastic + node_b.sinkage_plastic) * 0.5;
+        node.sinkage_elastic = (node_a.sinkage_elastic + node_b.sinkage_elastic) * 0.5;
+        node.step_plastic_flow = (node_a.step_plastic_flow + node_b.step_plastic_flow) * 0.5;
+        node.kshear = (node_a.kshear + node_b.kshear) * 0.5;
+        node.sigma = (node_a.sigma + node_b.sigma) * 0.5;
+        node.sigma_yeld = (node_a.sigma_yeld + node_b.sigma_yeld) * 0.5;
+        node.tau = (node_a.tau + node_b.tau) * 0.5;
+        node.massremainder = (node_a.massremainder + node_b.massremainder) * 0.5;
+        node.id_island = std::max(node_a.id_island, node_b.id_island);
+        node.erosion = node_a.erosion || node_b.erosion;
+    }
+
+    // The areas of the nodes around the split edges changed
+    for (auto& entry : p_nodes)
+        entry.second.area = ComputeVertexArea(entry.first);
+}
+
+void DeformableSoil::UpdateActiveNormals() {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
     std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+
+    // The soil meshes use the same indexes for vertices and normals
+    if (normals.size() != vertices.size())
+        return;
+
+    // The normal of a vertex changes if the vertex or one of its neighbours moved
+    std::vector<int> update_list(active_vertices);
+    for (auto iv : active_vertices) {
+        update_list.insert(update_list.end(), connected_vertexes.begin() + connected_start[iv],
+                           connected_vertexes.begin() + connected_start[iv + 1]);
+    }
+    std::sort(update_list.begin(), update_list.end());
+    update_list.erase(std::unique(update_list.begin(), update_list.end()), update_list.end());
+
+    // Average the normals of the adjacent faces
+    int n_update = (int)update_list.size();
+#pragma omp parallel for
+    for (int iu = 0; iu < n_update; ++iu) {
+        int iv = update_list[iu];
+        int n_faces = connected_triangles_start[iv + 1] - connected_triangles_start[iv];
+        if (n_faces == 0)
+            continue;
+        ChVector<> nrm_sum(0, 0, 0);
+        for (int k = connected_triangles_start[iv]; k < connected_triangles_start[iv + 1]; ++k) {
+            const ChVector<int>& tri = idx_vertices[connected_triangles[k]];
+            ChVector<> nrm = -Vcross(vertices[tri.y()] - vertices[tri.x()], vertices[tri.z()] - vertices[tri.x()]);
+            nrm.Normalize();
+            nrm_sum += nrm;
+        }
+        normals[iv] = nrm_sum / (double)n_faces;
+    }
+}
+
+// Raise a vertex by d_y, but not above the contact: the excess is stored as mass remainder.
+static double ClampRaise(double d_y, double level, double hit_level, double& massremainder) {
+    if (d_y > hit_level - level) {
+        massremainder += d_y - (hit_level - level);
+        return hit_level - level;
+    }
+    return d_y;
+}
+
+// Lower a vertex by -d_y, taking the material from the mass remainder first.
+static double ClampLower(double d_y, double& massremainder) {
+    if (massremainder > -d_y) {
+        massremainder -= -d_y;
+        return 0;
+    }
+    if ((massremainder < -d_y) && (massremainder > 0))
+        massremainder = 0;
+    return d_y;
+}
+
+void DeformableSoil::ComputeErosionFlow(const NodeRecord& node_i,
+                                        const NodeRecord& node_c,
+                                        int n_connected,
+                                        double dy_lim,
+                                        double& d_level_i,
+                                        double& d_mass_i,
+                                        double& d_level_c,
+                                        double& d_mass_c) const {
+    double level_i = node_i.level;
+    double level_c = node_c.level;
+    double mass_i = node_i.massremainder;
+    double mass_c = node_c.massremainder;
+    double area_i = node_i.area;
+    double area_c = node_c.area;
+
+    // flow remainder material
+    if (mass_i > mass_c) {
+        // if i higher than c: clamp c upward correction as it might invalidate
+        // the ceiling constraint, if collision is nearby
+        double d_y_c = (mass_i - mass_c) * (1.0 / n_connected) * area_i / (area_i + area_c);
+        double clamped_d_y_c = ClampRaise(d_y_c, level_c, node_c.hit_level, mass_c);
+        double d_y_i = -d_y_c * area_c / area_i;
+        double clamped_d_y_i = ClampLower(d_y_i, mass_i);
+        level_c += clamped_d_y_c;
+        level_i += clamped_d_y_i;
+    }
+
+    // smooth
+    if (node_c.sigma == 0) {
+        double dy = level_i + mass_i - level_c - mass_c;
+        if (fabs(dy) > dy_lim) {
+            double clamped_d_y_i;
+            double clamped_d_y_c;
+            if (dy > 0) {
+                double d_y_c = (fabs(dy) - dy_lim) * (1.0 / n_connected) * area_i / (area_i + area_c);
+                clamped_d_y_c = ClampRaise(d_y_c, level_c, node_c.hit_level, mass_c);
+                double d_y_i = -d_y_c * area_c / area_i;
+                clamped_d_y_i = ClampLower(d_y_i, mass_i);
+            } else {
+                // if c higher than i: clamp i upward correction as it might invalidate
+                // the ceiling constraint, if collision is nearby
+                double d_y_i = (fabs(dy) - dy_lim) * (1.0 / n_connected) * area_i / (area_i + area_c);
+                clamped_d_y_i = ClampRaise(d_y_i, level_i, node_i.hit_level, mass_i);
+                double d_y_c = -d_y_i * area_i / area_c;
+                clamped_d_y_c = ClampLower(d_y_c, mass_c);
+            }
+            level_c += clamped_d_y_c;
+            level_i += clamped_d_y_i;
+        }
+    }
+
+    d_level_i = level_i - node_i.level;
+    d_mass_i = mass_i - node_i.massremainder;
+    d_level_c = level_c - node_c.level;
+    d_mass_c = mass_c - node_c.massremainder;
+}
+
+// Flow material to the side of rut, using heuristics.
+// All passes are parallel and their result does not depend on the number of threads.
+void DeformableSoil::ComputeBulldozingFlow(const ChVector<>& N) {
     std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    double step = this->GetSystem()->GetStep();
+
+    // Pressure of a node (zero for the nodes in their initial state)
+    auto sigma = [this](int iv) {
+        const NodeRecord* node = FindNode(iv);
+        return node ? node->sigma : 0.0;
+    };
+
+    // All vertices in contact are active; the island ids were reset with the active vertices
+    std::vector<int> touched;
+    for (auto iv : active_vertices) {
+        if (p_nodes[iv].sigma > 0)
+            touched.push_back(iv);
+    }
+    std::sort(touched.begin(), touched.end());
+    int n_touched = (int)touched.size();
+    if (n_touched == 0)
+        return;
+
+    std::vector<NodeRecord*> touched_nodes(n_touched);
+    std::unordered_map<int, int> work_index;
+    for (int it = 0; it < n_touched; ++it) {
+        touched_nodes[it] = &p_nodes[touched[it]];
+        work_index[touched[it]] = it;
+    }
 
-    // Reset and initialize computation data:
     //
-    p_vertices_initial= vertices;
-    p_speeds.resize( vertices.size());
-    p_step_plastic_flow.resize( vertices.size());
-    p_level.resize( vertices.size());
-    p_level_initial.resize( vertices.size());
-    p_hit_level.resize( vertices.size());
-    p_sinkage.resize( vertices.size());
-    p_sinkage_plastic.resize( vertices.size());
-    p_sinkage_elastic.resize( vertices.size());
-    p_kshear.resize( vertices.size());
-    p_area.resize( vertices.size());
-    p_sigma.resize( vertices.size());
-    p_sigma_yeld.resize( vertices.size());
-    p_tau.resize( vertices.size());  
-    p_massremainder.resize( vertices.size());  
-    p_id_island.resize (vertices.size());
-    p_erosion.resize(vertices.size());
-
-    for (int i=0; i< vertices.size(); ++i) {
-        p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
-        p_level_initial[i] = p_level[i];
+    // Compute contact islands, as the connected components of the touched vertices.
+    // Parallel union-find, always linking a root below the root with smaller index:
+    // the root of an island is its first vertex, whatever the thread schedule.
+    //
+
+    std::vector<std::atomic<int>> parent(n_touched);
+    for (int it = 0; it < n_touched; ++it) {
+        parent[it].store(it, std::memory_order_relaxed);
+    }
+    auto find_root = [&parent](int it) {
+        int ip = parent[it].load(std::memory_order_relaxed);
+        while (ip != it) {
+            it = ip;
+            ip = parent[it].load(std::memory_order_relaxed);
+        }
+        return it;
+    };
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int it = 0; it < n_touched; ++it) {
+        int iv = touched[it];
+        for (int ic = connected_start[iv]; ic < connected_start[iv + 1]; ++ic) {
+            int ivconnect = connected_vertexes[ic];
+            if (ivconnect < iv || !(sigma(ivconnect) > 0))
+                continue;
+            int ra = find_root(it);
+            int rb = find_root(work_index.find(ivconnect)->second);
+            while (ra != rb) {
+                if (ra > rb)
+                    std::swap(ra, rb);
+                int expected = rb;
+                if (parent[rb].compare_exchange_strong(expected, ra))
+                    break;
+                ra = find_root(ra);
+                rb = find_root(rb);
+            }
+        }
     }
 
-    connected_vertexes.resize( vertices.size() );
-    for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-        connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][1]);
-        connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][2]);
-        connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][0]);
-        connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][2]);
-        connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][0]);
-        connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][1]);
+    // Number the islands in the order of their first vertex, and sum their displaced material
+    std::vector<int> island(n_touched);
+    std::vector<double> island_flow;
+    for (int it = 0; it < n_touched; ++it) {
+        int root = find_root(it);
+        if (root == it) {
+            island[it] = (int)island_flow.size();
+            island_flow.push_back(0);
+        } else {
+            island[it] = island[root];
+        }
+        NodeRecord& node = *touched_nodes[it];
+        node.id_island = island[it] + 1;
+        island_flow[island[it]] += node.area * node.step_plastic_flow * step;
     }
 
-    m_trimesh_shape->GetMesh().ComputeNeighbouringTriangleMap(this->tri_map);
+    //
+    // The island boundaries are the untouched neighbours of the touched vertices
+    // (a vertex can be on the boundary of more than one island)
+    //
+
+    std::vector<int> boundary;
+#pragma omp parallel
+    {
+        std::vector<int> boundary_thread;
+#pragma omp for nowait
+        for (int it = 0; it < n_touched; ++it) {
+            int iv = touched[it];
+            for (int ic = connected_start[iv]; ic < connected_start[iv + 1]; ++ic) {
+                if (sigma(connected_vertexes[ic]) == 0)
+                    boundary_thread.push_back(connected_vertexes[ic]);
+            }
+        }
+#pragma omp critical
+        boundary.insert(boundary.end(), boundary_thread.begin(), boundary_thread.end());
+    }
+    std::sort(boundary.begin(), boundary.end());
+    boundary.erase(std::unique(boundary.begin(), boundary.end()), boundary.end());
+    int n_boundary = (int)boundary.size();
+
+    // Islands adjacent to each boundary vertex, in compressed row storage
+    auto adjacent_islands = [&](int iv, std::vector<int>& islands) {
+        islands.clear();
+        for (int ic = connected_start[iv]; ic < connected_start[iv + 1]; ++ic) {
+            const NodeRecord* node = FindNode(connected_vertexes[ic]);
+            if (node && node->sigma > 0)
+                islands.push_back(node->id_island - 1);
+        }
+        std::sort(islands.begin(), islands.end());
+        islands.erase(std::unique(islands.begin(), islands.end()), islands.end());
+    };
+    std::vector<int> boundary_islands_start(n_boundary + 1, 0);
+#pragma omp parallel
+    {
+        std::vector<int> islands;
+#pragma omp for
+        for (int ib = 0; ib < n_boundary; ++ib) {
+            adjacent_islands(boundary[ib], islands);
+            boundary_islands_start[ib + 1] = (int)islands.size();
+        }
+    }
+    for (int ib = 0; ib < n_boundary; ++ib) {
+        boundary_islands_start[ib + 1] += boundary_islands_start[ib];
+    }
+    std::vector<int> boundary_islands(boundary_islands_start[n_boundary]);
+#pragma omp parallel
+    {
+        std::vector<int> islands;
+#pragma omp for
+        for (int ib = 0; ib < n_boundary; ++ib) {
+            adjacent_islands(boundary[ib], islands);
+            std::copy(islands.begin(), islands.end(), boundary_islands.begin() + boundary_islands_start[ib]);
+        }
+    }
+
+    // The boundary vertices are raised: they all need a record
+    std::vector<NodeRecord*> boundary_nodes(n_boundary);
+    for (int ib = 0; ib < n_boundary; ++ib) {
+        boundary_nodes[ib] = &MarkActive(boundary[ib]);
+    }
+
+    std::vector<double> island_area_boundary(island_flow.size(), 0);
+    for (int ib = 0; ib < n_boundary; ++ib) {
+        for (int k = boundary_islands_start[ib]; k < boundary_islands_start[ib + 1]; ++k)
+            island_area_boundary[boundary_islands[k]] += boundary_nodes[ib]->area;
+    }
+
+    // Raise the boundary because of material flow (it gives a sharp spike around the
+    // island boundary, but later we'll use the erosion algorithm to smooth it out)
+#pragma omp parallel for
+    for (int ib = 0; ib < n_boundary; ++ib) {
+        int ibv = boundary[ib];
+        NodeRecord& node = *boundary_nodes[ib];
+        double d_y = 0;
+        for (int k = boundary_islands_start[ib]; k < boundary_islands_start[ib + 1]; ++k) {
+            int isl = boundary_islands[k];
+            d_y += bulldozing_flow_factor * island_flow[isl] / island_area_boundary[isl];
+        }
+        double clamped_d_y = ClampRaise(d_y, node.level, node.hit_level, node.massremainder);
+        node.level          += clamped_d_y;
+        node.level_initial  += clamped_d_y;
+        vertices[ibv]       += N * clamped_d_y;
+        node.vertex_initial += N * clamped_d_y;
+        // negative to mark as boundary (of the last adjacent island)
+        node.id_island = -(boundary_islands[boundary_islands_start[ib + 1] - 1] + 1);
+    }
+
+    //
+    // Erosion domain area select, by topologically dilation of all the
+    // boundaries of the islands:
+    //
+
+    std::vector<int> domain_erosion = boundary;
+    for (int ib = 0; ib < n_boundary; ++ib) {
+        boundary_nodes[ib]->erosion = true;
+    }
+    std::vector<int> front_erosion = boundary;
+    for (int iloop = 0; iloop < bulldozing_erosion_n_propagations; ++iloop) {
+        std::vector<int> front_erosion2;
+#pragma omp parallel
+        {
+            std::vector<int> front_thread;
+#pragma omp for nowait
+            for (int k = 0; k < (int)front_erosion.size(); ++k) {
+                int is = front_erosion[k];
+                for (int ic = connected_start[is]; ic < connected_start[is + 1]; ++ic) {
+                    int ivconnect = connected_vertexes[ic];
+                    const NodeRecord* node = FindNode(ivconnect);
+                    if (!node || (node->id_island == 0 && !node->erosion))
+                        front_thread.push_back(ivconnect);
+                }
+            }
+#pragma omp critical
+            front_erosion2.insert(front_erosion2.end(), front_thread.begin(), front_thread.end());
+        }
+        std::sort(front_erosion2.begin(), front_erosion2.end());
+        front_erosion2.erase(std::unique(front_erosion2.begin(), front_erosion2.end()), front_erosion2.end());
+        // (records cannot be added concurrently)
+        for (auto ivconnect : front_erosion2) {
+            MarkActive(ivconnect).erosion = true;
+        }
+        domain_erosion.insert(domain_erosion.end(), front_erosion2.begin(), front_erosion2.end());
+        front_erosion.swap(front_erosion2);
+    }
+
+    //
+    // Erosion smoothing algorithm on domain. Each sweep computes the flow along all
+    // edges from the current levels (Jacobi iteration, double buffered); each vertex
+    // then gathers the flow of its own edges, so that no two threads write the same vertex.
+    //
+
+    int n_domain = (int)domain_erosion.size();
+
+    // Vertices changed by the erosion: the domain, followed by its other neighbours
+    std::vector<int> stencil = domain_erosion;
+    work_index.clear();
+    for (int id = 0; id < n_domain; ++id) {
+        work_index[domain_erosion[id]] = id;
+    }
+    for (auto is : domain_erosion) {
+        for (int ic = connected_start[is]; ic < connected_start[is + 1]; ++ic) {
+            if (work_index.emplace(connected_vertexes[ic], (int)stencil.size()).second)
+                stencil.push_back(connected_vertexes[ic]);
+        }
+    }
+    int n_stencil = (int)stencil.size();
+
+    // All the stencil vertices may change: they all need a record. The state of a
+    // neighbour that does not move is unchanged, so it is not marked active yet.
+    std::vector<NodeRecord*> stencil_nodes(n_stencil);
+    for (int k = 0; k < n_stencil; ++k) {
+        stencil_nodes[k] = &GetNode(stencil[k]);
+    }
+
+    // Edges from the domain vertices to their neighbours, grouped by domain vertex. The
+    // horizontal edge lengths do not change in the step, so the slope limits are computed once.
+    std::vector<int> edge_start(n_domain + 1, 0);
+    for (int id = 0; id < n_domain; ++id) {
+        int is = domain_erosion[id];
+        edge_start[id + 1] = edge_start[id] + connected_start[is + 1] - connected_start[is];
+    }
+    int n_edges = edge_start[n_domain];
+    std::vector<int> edge_target(n_edges);
+    std::vector<double> edge_dy_lim(n_edges);
+    double tan_erosion = tan(bulldozing_erosion_angle * CH_C_DEG_TO_RAD);
+#pragma omp parallel for
+    for (int id = 0; id < n_domain; ++id) {
+        int is = domain_erosion[id];
+        for (int ic = connected_start[is]; ic < connected_start[is + 1]; ++ic) {
+            int ivc = connected_vertexes[ic];
+            int ie = edge_start[id] + ic - connected_start[is];
+            edge_target[ie] = work_index.find(ivc)->second;
+            ChVector<> vdist = plane.TransformDirectionParentToLocal(vertices[ivc] - vertices[is]);
+            vdist.y() = 0;
+            edge_dy_lim[ie] = vdist.Length() * tan_erosion;
+        }
+    }
+
+    // Same edges, grouped by target vertex (counting sort, keeping the edge order)
+    std::vector<int> in_edge_start(n_stencil + 1, 0);
+    for (int ie = 0; ie < n_edges; ++ie) {
+        in_edge_start[edge_target[ie] + 1]++;
+    }
+    for (int k = 0; k < n_stencil; ++k) {
+        in_edge_start[k + 1] += in_edge_start[k];
+    }
+    std::vector<int> in_edge_fill(in_edge_start.begin(), in_edge_start.end() - 1);
+    std::vector<int> in_edges(n_edges);
+    for (int ie = 0; ie < n_edges; ++ie) {
+        in_edges[in_edge_fill[edge_target[ie]]++] = ie;
+    }
+
+    std::vector<double> edge_level_i(n_edges);
+    std::vector<double> edge_mass_i(n_edges);
+    std::vector<double> edge_level_c(n_edges);
+    std::vector<double> edge_mass_c(n_edges);
+    std::vector<double> d_level(n_stencil);
+    std::vector<double> d_mass(n_stencil);
+    std::vector<char> moved(n_stencil, 0);
+
+    for (int ismo = 0; ismo < bulldozing_erosion_n_iterations; ++ismo) {
+        // flow along the edges, from the levels at the beginning of the sweep
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int id = 0; id < n_domain; ++id) {
+            int is = domain_erosion[id];
+            int n_connected = connected_start[is + 1] - connected_start[is];
+            for (int ic = connected_start[is]; ic < connected_start[is + 1]; ++ic) {
+                int ie = edge_start[id] + ic - connected_start[is];
+                ComputeErosionFlow(*stencil_nodes[id], *stencil_nodes[edge_target[ie]], n_connected, edge_dy_lim[ie],
+                                   edge_level_i[ie], edge_mass_i[ie], edge_level_c[ie], edge_mass_c[ie]);
+            }
+        }
+
+        // gather the changes of each vertex, as source and as target of edges
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int k = 0; k < n_stencil; ++k) {
+            const NodeRecord& node = *stencil_nodes[k];
+            double dl = 0;
+            double dm = 0;
+            if (k < n_domain) {
+                for (int ie = edge_start[k]; ie < edge_start[k + 1]; ++ie) {
+                    dl += edge_level_i[ie];
+                    dm += edge_mass_i[ie];
+                }
+            }
+            for (int j = in_edge_start[k]; j < in_edge_start[k + 1]; ++j) {
+                dl += edge_level_c[in_edges[j]];
+                dm += edge_mass_c[in_edges[j]];
+            }
+            // the sum of the edge flows must still respect the ceiling constraint
+            double mass = node.massremainder + dm;
+            if (dl > 0)
+                dl = ClampRaise(dl, node.level, node.hit_level, mass);
+            d_level[k] = dl;
+            d_mass[k] = mass - node.massremainder;
+        }
+
+#pragma omp parallel for
+        for (int k = 0; k < n_stencil; ++k) {
+            int iv = stencil[k];
+            NodeRecord& node = *stencil_nodes[k];
+            node.level          += d_level[k];
+            node.level_initial  += d_level[k];
+            vertices[iv]        += N * d_level[k];
+            node.vertex_initial += N * d_level[k];
+            node.massremainder  += d_mass[k];
+            if (d_level[k] != 0 || d_mass[k] != 0)
+                moved[k] = 1;
+        }
+    }
+
+    for (int k = 0; k < n_stencil; ++k) {
+        if (moved[k])
+            MarkActive(stencil[k]);
+    }
+}
+
+// Color of a node in the current plot type.
+ChColor DeformableSoil::ComputeNodeColor(const NodeRecord& node) const {
+    ChColor mcolor;
+    switch (plot_type) {
+        case DeformableTerrain::PLOT_LEVEL:
+            mcolor = ChColor::ComputeFalseColor(node.level, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_LEVEL_INITIAL:
+            mcolor = ChColor::ComputeFalseColor(node.level_initial, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_SINKAGE:
+            mcolor = ChColor::ComputeFalseColor(node.sinkage, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_SINKAGE_ELASTIC:
+            mcolor = ChColor::ComputeFalseColor(node.sinkage_elastic, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_SINKAGE_PLASTIC:
+            mcolor = ChColor::ComputeFalseColor(node.sinkage_plastic, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_STEP_PLASTIC_FLOW:
+            mcolor = ChColor::ComputeFalseColor(node.step_plastic_flow, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_K_JANOSI:
+            mcolor = ChColor::ComputeFalseColor(node.kshear, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_PRESSURE:
+            mcolor = ChColor::ComputeFalseColor(node.sigma, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_PRESSURE_YELD:
+            mcolor = ChColor::ComputeFalseColor(node.sigma_yeld, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_SHEAR:
+            mcolor = ChColor::ComputeFalseColor(node.tau, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_MASSREMAINDER:
+            mcolor = ChColor::ComputeFalseColor(node.massremainder, plot_v_min, plot_v_max);
+            break;
+        case DeformableTerrain::PLOT_ISLAND_ID:
+            mcolor = ChColor(0,0,1);
+            if (node.erosion == true)
+                mcolor = ChColor(1,1,1);
+            if (node.id_island >0)
+                mcolor = ChColor::ComputeFalseColor(4 +(node.id_island % 8), 0, 12);
+            if (node.id_island <0)
+                mcolor = ChColor(0,0,0);
+            break;
+        case DeformableTerrain::PLOT_IS_TOUCHED:
+            if (node.sigma>0)
+                mcolor = ChColor(1,0,0);
+            else 
+                mcolor = ChColor(0,0,1);
+            break;
+    }
+    return mcolor;
 }
 
 // Reset the list of forces, and fills it with forces from a soil contact model.
@@ -457,10 +1294,7 @@ void DeformableSoil::ComputeInternalForces() {
 
     // Readibility aliases
     std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
-    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
     std::vector<ChVector<float> >& colors =  m_trimesh_shape->GetMesh().getCoordsColors();
-    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
-    std::vector<ChVector<int> >& idx_normals = m_trimesh_shape->GetMesh().getIndicesNormals();
     
     // 
     // Reset the load list
@@ -468,64 +1302,56 @@ void DeformableSoil::ComputeInternalForces() {
 
     this->GetLoadList().clear();
 
+    ChVector<> N    = plane.TransformDirectionLocalToParent(ChVector<>(0,1,0));
+
     //
-    // Compute (pseudo)areas per node
+    // Reset the per-step data of the vertices modified in the last step (the
+    // (pseudo)areas per node are computed only when the mesh topology changes)
     //
-    
-    // for a X-Z rectangular grid-like mesh it is simply area[i]= xsize/xsteps * zsize/zsteps, 
-    // but the following is more general, also for generic meshes:
-    for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
-        p_area[iv] = 0;
+
+    int n_active = (int)active_vertices.size();
+    std::vector<NodeRecord*> active_nodes(n_active);
+    for (int ia = 0; ia < n_active; ++ia) {
+        active_nodes[ia] = &p_nodes[active_vertices[ia]];
     }
-    for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-        ChVector<> AB = vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]];
-        ChVector<> AC = vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][1]];
-        AB = plane.TransformDirectionParentToLocal(AB);
-        AC = plane.TransformDirectionParentToLocal(AC);
-        AB.y()=0;
-        AC.y()=0;
-        double triangle_area = 0.5*(Vcross(AB,AC)).Length();
-        p_area[idx_normals[it][0]] += triangle_area /3.0;
-        p_area[idx_normals[it][1]] += triangle_area /3.0;
-        p_area[idx_normals[it][2]] += triangle_area /3.0;
+#pragma omp parallel for
+    for (int ia = 0; ia < n_active; ++ia) {
+        NodeRecord& node = *active_nodes[ia];
+        node.sigma = 0;
+        node.sinkage_elastic = 0;
+        node.step_plastic_flow = 0;
+        node.level = plane.TransformParentToLocal(vertices[active_vertices[ia]]).y();
+        node.hit_level = 1e9;
+        node.id_island = 0;
+        node.erosion = false;
+        node.active = false;
     }
+    active_vertices.clear();
 
-    ChVector<> N    = plane.TransformDirectionLocalToParent(ChVector<>(0,1,0));
-
-    //
+    // 
     // Perform ray-hit test to detect the contact point sinkage
     // 
-    
-    
-//#pragma omp parallel for
-    for (int i=0; i< vertices.size(); ++i) {
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
-        p_sigma[i] = 0;
-        p_sinkage_elastic[i] = 0;
-        p_step_plastic_flow[i]=0;
-        p_erosion[i] = false;
-
-        p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
-
-        ChVector<> to   = vertices[i] +N*test_high_offset; 
-        ChVector<> from = to - N*test_low_offset;
-        
-        p_hit_level[i] = 1e9;
-        double p_hit_offset = 1e9;
 
-        // DO THE RAY-HIT TEST HERE:
-        this->GetSystem()->GetCollisionSystem()->RayHit(from,to,mrayhit_result);
+    std::vector<int> ray_vertices;
+    std::vector<collision::ChCollisionSystem::ChRayhitResult> ray_hits;
+    FindRayHits(N, ray_vertices, ray_hits);
+
+    for (int ir=0; ir< ray_vertices.size(); ++ir) {
+        int i = ray_vertices[ir];
+        const collision::ChCollisionSystem::ChRayhitResult& mrayhit_result = ray_hits[ir];
+        double p_hit_offset = 1e9;
 
         if (mrayhit_result.hit == true) {
 
             ChContactable* contactable = mrayhit_result.hitModel->GetContactable();
+            NodeRecord& node = MarkActive(i);
 
-            p_hit_level[i] = plane.TransformParentToLocal(mrayhit_result.abs_hitPoint).y();
-            p_hit_offset = -p_hit_level[i] + p_level_initial[i];
+            node.hit_level = plane.TransformParentToLocal(mrayhit_result.abs_hitPoint).y();
+            p_hit_offset = -node.hit_level + node.level_initial;
 
-            p_speeds[i] = contactable->GetContactPointSpeed(vertices[i]);
+            node.speed = contactable->GetContactPointSpeed(vertices[i]);
 
-            ChVector<> T = -p_speeds[i];
+            ChVector<> T = -node.speed;
             T = plane.TransformDirectionParentToLocal(T);
             double Vn = -T.y();
             T.y() = 0;
@@ -537,50 +1363,50 @@ void DeformableSoil::ComputeInternalForces() {
             ChVector<> Ft;
 
             // Elastic try:
-            p_sigma[i] = elastic_K * (p_hit_offset - p_sinkage_plastic[i]);   
+            node.sigma = elastic_K * (p_hit_offset - node.sinkage_plastic);   
 
             // Handle unilaterality:
-            if (p_sigma[i] <0) {
-                p_sigma[i] =0;
+            if (node.sigma <0) {
+                node.sigma =0;
             } else {
                 
                 // add compressive speed-proportional damping 
                 //if (Vn < 0) {
-                //    p_sigma[i] += -Vn*this->damping_R;
+                //    node.sigma += -Vn*this->damping_R;
                 //}
                 
-                p_sinkage[i] = p_hit_offset;
-                p_level[i]   = p_hit_level[i];
+                node.sinkage = p_hit_offset;
+                node.level   = node.hit_level;
 
                 // Accumulate shear for Janosi-Hanamoto
-                p_kshear[i] += Vdot(p_speeds[i],-T) * this->GetSystem()->GetStep();
+                node.kshear += Vdot(node.speed,-T) * this->GetSystem()->GetStep();
 
                 // Plastic correction:
-                if (p_sigma[i] > p_sigma_yeld[i]) {
+                if (node.sigma > node.sigma_yeld) {
                     // Bekker formula, neglecting Bekker_Kc and 'b'
-                    p_sigma[i] = this->Bekker_Kphi * pow(p_sinkage[i], this->Bekker_n );
-                    p_sigma_yeld[i]= p_sigma[i];
-                    double old_sinkage_plastic = p_sinkage_plastic[i];
-                    p_sinkage_plastic[i] = p_sinkage[i] - p_sigma[i]/elastic_K;
-                    p_step_plastic_flow[i] =
-                        (p_sinkage_plastic[i] - old_sinkage_plastic) / this->GetSystem()->GetStep();
+                    node.sigma = this->Bekker_Kphi * pow(node.sinkage, this->Bekker_n );
+                    node.sigma_yeld= node.sigma;
+                    double old_sinkage_plastic = node.sinkage_plastic;
+                    node.sinkage_plastic = node.sinkage - node.sigma/elastic_K;
+                    node.step_plastic_flow =
+                        (node.sinkage_plastic - old_sinkage_plastic) / this->GetSystem()->GetStep();
                 }
 
-                p_sinkage_elastic[i] = p_sinkage[i] - p_sinkage_plastic[i];
+                node.sinkage_elastic = node.sinkage - node.sinkage_plastic;
 
                 // add compressive speed-proportional damping (not clamped by pressure yeld)
                 //if (Vn < 0) {
-                    p_sigma[i] += -Vn*this->damping_R;
+                    node.sigma += -Vn*this->damping_R;
                 //}
 
                 // Mohr-Coulomb
-                double tau_max = this->Mohr_cohesion + p_sigma[i] * tan(this->Mohr_friction*CH_C_DEG_TO_RAD);
+                double tau_max = this->Mohr_cohesion + node.sigma * tan(this->Mohr_friction*CH_C_DEG_TO_RAD);
 
                 // Janosi-Hanamoto
-                p_tau[i] = tau_max * (1.0 - exp(- (p_kshear[i]/this->Janosi_shear)));
+                node.tau = tau_max * (1.0 - exp(- (node.kshear/this->Janosi_shear)));
             
-                Fn = N * p_area[i] * p_sigma[i];
-                Ft = T * p_area[i] * p_tau[i];
+                Fn = N * node.area * node.sigma;
+                Ft = T * node.area * node.tau;
 
                 if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
                     // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody() 
@@ -602,7 +1428,7 @@ void DeformableSoil::ComputeInternalForces() {
                 }
                 
                 // Update mesh representation
-                vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
+                vertices[i] = node.vertex_initial - N * node.sinkage;
 
             } // end positive contact force
 
@@ -617,38 +1443,16 @@ void DeformableSoil::ComputeInternalForces() {
 
     if (do_refinement) {  
         
-        std::vector<std::vector<double>*> aux_data_double; 
-        aux_data_double.push_back(&p_level);
-        aux_data_double.push_back(&p_level_initial);
-        aux_data_double.push_back(&p_hit_level);
-        aux_data_double.push_back(&p_sinkage);
-        aux_data_double.push_back(&p_sinkage_plastic);
-        aux_data_double.push_back(&p_sinkage_elastic);
-        aux_data_double.push_back(&p_step_plastic_flow);
-        aux_data_double.push_back(&p_kshear);
-        aux_data_double.push_back(&p_area);
-        aux_data_double.push_back(&p_sigma);
-        aux_data_double.push_back(&p_sigma_yeld);
-        aux_data_double.push_back(&p_tau);
-        aux_data_double.push_back(&p_massremainder);
-        std::vector<std::vector<int>*> aux_data_int;  
-        aux_data_int.push_back(&p_id_island);
-        std::vector<std::vector<bool>*> aux_data_bool; 
-        aux_data_bool.push_back(&p_erosion);
-        std::vector<std::vector<ChVector<>>*> aux_data_vect;
-        aux_data_vect.push_back(&p_vertices_initial);
-        aux_data_vect.push_back(&p_speeds);
-
-        // loop on triangles to see which needs refinement
+        // mark the triangles with at least one touching vertex (all of them are active)
         std::vector<int> marked_tris;
-        for (int it = 0; it< idx_vertices.size(); ++it) {
-            // see if at least one of the vertexes are touching
-            if ( p_sigma[idx_vertices[it][0]] >0 || 
-                 p_sigma[idx_vertices[it][1]] >0 ||
-                 p_sigma[idx_vertices[it][2]] >0 ) {
-                marked_tris.push_back(it);
+        for (auto iv : active_vertices) {
+            if (p_nodes[iv].sigma > 0) {
+                marked_tris.insert(marked_tris.end(), connected_triangles.begin() + connected_triangles_start[iv],
+                                   connected_triangles.begin() + connected_triangles_start[iv + 1]);
             }
         }
+        std::sort(marked_tris.begin(), marked_tris.end());
+        marked_tris.erase(std::unique(marked_tris.begin(), marked_tris.end()), marked_tris.end());
     
         // custom edge refinement criterion: do not use default edge length, 
         // length of the edge as projected on soil plane
@@ -665,47 +1469,31 @@ void DeformableSoil::ComputeInternalForces() {
         MyRefinement refinement_criterion;
         refinement_criterion.A = ChMatrix33<>(this->plane.rot);
 
-        // perform refinement using the LEPP  algorithm, also refining the soil-specific vertex attributes
-        for (int i=0; i<1; ++i) {
-            m_trimesh_shape->GetMesh().RefineMeshEdges(
-                marked_tris, 
-                refinement_resolution, 
-                &refinement_criterion,
-                0, //&tri_map, // note, update triangle connectivity map incrementally
-                aux_data_double, 
-                aux_data_int, 
-                aux_data_bool, 
-                aux_data_vect);
-        }
+        int n_vertices_old = (int)vertices.size();
+
+        // perform refinement using the LEPP  algorithm; the soil-specific vertex attributes
+        // are not refined by the mesh, since they are stored only for the touched nodes
+        std::vector<std::vector<double>*> aux_data_double;
+        std::vector<std::vector<int>*> aux_data_int;
+        std::vector<std::vector<bool>*> aux_data_bool;
+        std::vector<std::vector<ChVector<>>*> aux_data_vect;
+        std::vector<std::pair<int, int>> split_edges;
+        m_trimesh_shape->GetMesh().RefineMeshEdges(
+            marked_tris, 
+            refinement_resolution, 
+            &refinement_criterion,
+            0, //&tri_map, // note, update triangle connectivity map incrementally
+            aux_data_double, 
+            aux_data_int, 
+            aux_data_bool, 
+            aux_data_vect,
+            &split_edges);
         // TO DO adjust this incrementally
-        
-        connected_vertexes.clear();
-        connected_vertexes.resize( vertices.size() );
-        for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-            connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][1]);
-            connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][2]);
-            connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][0]);
-            connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][2]);
-            connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][0]);
-            connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][1]);
-        }
 
-        // Recompute areas (could be optimized)
-        for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
-            p_area[iv] = 0;
-        }
-        for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-            ChVector<> AB = vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]];
-            ChVector<> AC = vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][0]];
-            AB = plane.TransformDirectionParentToLocal(AB);
-            AC = plane.TransformDirectionParentToLocal(AC);
-            AB.y() = 0;
-            AC.y() = 0;
-            double triangle_area = 0.5 * (Vcross(AB, AC)).Length();
-            p_area[idx_normals[it][0]] += triangle_area /3.0;
-            p_area[idx_normals[it][1]] += triangle_area /3.0;
-            p_area[idx_normals[it][2]] += triangle_area /3.0;
-        }
+        SetupConnectivity();
+
+        // The new vertices interpolate the data of the refined edges
+        InterpolateRefinedNodes(n_vertices_old, split_edges);
     }
 
     //
@@ -713,212 +1501,8 @@ void DeformableSoil::ComputeInternalForces() {
     // 
 
     if (do_bulldozing) {
-        std::set<int> touched_vertexes;
-        for (int iv = 0; iv< vertices.size(); ++iv) {
-            p_id_island[iv] = 0;
-            if (p_sigma[iv]>0)
-                touched_vertexes.insert(iv);
-        }
-
-        std::set<int> domain_boundaries;
-
-        // Compute contact islands (and their displaced material) by flood-filling the mesh
-        int id_island = 0;
-        for (auto fillseed = touched_vertexes.begin(); fillseed != touched_vertexes.end(); fillseed = touched_vertexes.begin()) {
-            // new island:
-            ++id_island;
-            std::set<int> fill_front;
-
-            std::set<int> boundary;
-            int n_vert_boundary = 0;
-            double tot_area_boundary = 0;
-
-            int n_vert_island = 1;
-            double tot_step_flow_island = p_area[*fillseed] * p_step_plastic_flow[*fillseed] * this->GetSystem()->GetStep();
-            double tot_Nforce_island = p_area[*fillseed] * p_sigma[*fillseed];
-            double tot_area_island = p_area[*fillseed];
-            fill_front.insert(*fillseed);
-            p_id_island[*fillseed] = id_island;
-            touched_vertexes.erase(fillseed);
-            while (fill_front.size() >0) {
-                // fill next front
-                std::set<int> fill_front_2;
-                for (auto ifront : fill_front) {
-                    for (auto ivconnect : connected_vertexes[ifront]) {
-                        if ((p_sigma[ivconnect]>0) && (p_id_island[ivconnect]==0)) {
-                            ++n_vert_island;
-                            tot_step_flow_island += p_area[ivconnect] * p_step_plastic_flow[ivconnect] * this->GetSystem()->GetStep();
-                            tot_Nforce_island += p_area[ivconnect] * p_sigma[ivconnect];
-                            tot_area_island += p_area[ivconnect];
-                            fill_front_2.insert(ivconnect);
-                            p_id_island[ivconnect] = id_island;
-                            touched_vertexes.erase(ivconnect);
-                        } 
-                        else if ((p_sigma[ivconnect] == 0) && (p_id_island[ivconnect] <= 0) && (p_id_island[ivconnect] != -id_island)) {
-                            ++n_vert_boundary;
-                            tot_area_boundary += p_area[ivconnect];
-                            p_id_island[ivconnect] = -id_island; // negative to mark as boundary
-                            boundary.insert(ivconnect);
-                        }
-                    }
-                }
-                // advance to next front
-                fill_front= fill_front_2;
-            }
-            //GetLog() << " island " << id_island << " flow volume =" << tot_step_flow_island << " N force=" << tot_Nforce_island << "\n"; 
-
-            // Raise the boundary because of material flow (it gives a sharp spike around the
-            // island boundary, but later we'll use the erosion algorithm to smooth it out)
-
-            for (auto ibv : boundary) {
-                double d_y = bulldozing_flow_factor * ((p_area[ibv]/tot_area_boundary) *  (1/p_area[ibv]) * tot_step_flow_island);
-                double clamped_d_y = d_y; // ChMin(d_y, ChMin(p_hit_level[ibv]-p_level[ibv], test_high_offset) );
-                if (d_y > p_hit_level[ibv]-p_level[ibv]) {
-                    p_massremainder[ibv] += d_y - (p_hit_level[ibv]-p_level[ibv]);
-                    clamped_d_y = p_hit_level[ibv]-p_level[ibv];
-                }
-                p_level[ibv]            += clamped_d_y;
-                p_level_initial[ibv]    += clamped_d_y;
-                vertices[ibv]           += N * clamped_d_y;
-                p_vertices_initial[ibv] += N * clamped_d_y;
-            }
-
-            domain_boundaries.insert(boundary.begin(), boundary.end());
-
-        }// end for islands
- //***TEST***
-//int mm = p_massremainder.size();
-//p_massremainder.clear();p_massremainder.resize(mm);
-
-        // Erosion domain area select, by topologically dilation of all the 
-        // boundaries of the islands:
-        std::set<int> domain_erosion= domain_boundaries;
-        for (auto ie : domain_boundaries)
-            p_erosion[ie] = true;
-        std::set<int> front_erosion = domain_boundaries;
-        for (int iloop = 0; iloop <10; ++iloop) {
-            std::set<int> front_erosion2;
-            for(auto is : front_erosion) {
-                for (auto ivconnect : connected_vertexes[is]) {
-                    if ((p_id_island[ivconnect]==0) && (p_erosion[ivconnect]==0)) {
-                        front_erosion2.insert(ivconnect);
-                        p_erosion[ivconnect] = true;
-                    }
-                }
-            }
-            domain_erosion.insert(front_erosion2.begin(), front_erosion2.end());
-            front_erosion = front_erosion2;
-        }
-        // Erosion smoothing algorithm on domain
-        for (int ismo = 0; ismo <3; ++ismo) {
-            for (auto is : domain_erosion) {
-                for (auto ivc : connected_vertexes[is]) {
-                    ChVector<> vis = this->plane.TransformParentToLocal(vertices[is]);
-                    // flow remainder material 
-                    if (true) {
-                        if (p_massremainder[is]>p_massremainder[ivc]) {
-                            double clamped_d_y_i;
-                            double clamped_d_y_c;
- 
-                            // if i higher than c: clamp c upward correction as it might invalidate 
-                            // the ceiling constraint, if collision is nearby
-                            double d_y_c = (p_massremainder[is]-p_massremainder[ivc])* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                            clamped_d_y_c = d_y_c; 
-                            if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
-                                p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
-                                clamped_d_y_c = p_hit_level[ivc]-p_level[ivc];
-                            }
-                            double d_y_i = - d_y_c * p_area[ivc]/p_area[is];
-                            clamped_d_y_i = d_y_i;
-                            if (p_massremainder[is] >  -d_y_i) {
-                                p_massremainder[is] -= -d_y_i;
-                                clamped_d_y_i = 0;
-                            } else
-                            if ((p_massremainder[is] < -d_y_i) && (p_massremainder[is] >0)) {
-                                p_massremainder[is] = 0;
-                                clamped_d_y_i = d_y_i + p_massremainder[is];
-                            }
-                            
-                            // correct vertexes
-                            p_level[ivc]            += clamped_d_y_c;
-                            p_level_initial[ivc]    += clamped_d_y_c;
-                            vertices[ivc]           += N * clamped_d_y_c;
-                            p_vertices_initial[ivc] += N * clamped_d_y_c;
-
-                            p_level[is]             += clamped_d_y_i;
-                            p_level_initial[is]     += clamped_d_y_i;
-                            vertices[is]            += N * clamped_d_y_i;
-                            p_vertices_initial[is]  += N * clamped_d_y_i;      
-                        }
-                    }
-                    // smooth
-                    if (p_sigma[ivc] == 0) {
-                        ChVector<> vic = this->plane.TransformParentToLocal(vertices[ivc]);
-                        ChVector<> vdist = vic-vis;
-                        vdist.y() = 0;
-                        double ddist = vdist.Length();
-                        double dy = p_level[is] + p_massremainder[is]  - p_level[ivc] - p_massremainder[ivc];
-                        double dy_lim = ddist * tan(bulldozing_erosion_angle*CH_C_DEG_TO_RAD);
-                        if (fabs(dy)>dy_lim) {
-                            double clamped_d_y_i;
-                            double clamped_d_y_c;
-                            if (dy > 0) { 
-                                // if i higher than c: clamp c upward correction as it might invalidate 
-                                // the ceiling constraint, if collision is nearby
-                                double d_y_c = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                                clamped_d_y_c = d_y_c; //clamped_d_y_c = ChMin(d_y_c, p_hit_level[ivc]-p_level[ivc] );
-                                if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
-                                    p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
-                                    clamped_d_y_c = p_hit_level[ivc]-p_level[ivc];
-                                }
-                                double d_y_i = - d_y_c * p_area[ivc]/p_area[is];
-                                clamped_d_y_i = d_y_i;
-                                if (p_massremainder[is] >  -d_y_i) {
-                                    p_massremainder[is] -= -d_y_i;
-                                    clamped_d_y_i = 0;
-                                } else
-                                if ((p_massremainder[is] < -d_y_i) && (p_massremainder[is] >0)) {
-                                    p_massremainder[is] = 0;
-                                    clamped_d_y_i = d_y_i + p_massremainder[is];
-                                }
-                            } else {
-                                // if c higher than i: clamp i upward correction as it might invalidate 
-                                // the ceiling constraint, if collision is nearby
-                                double d_y_i = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                                clamped_d_y_i = d_y_i; 
-                                if (d_y_i > p_hit_level[is]-p_level[is]) {
-                                    p_massremainder[is] += d_y_i - (p_hit_level[is]-p_level[is]);
-                                    clamped_d_y_i = p_hit_level[is]-p_level[is];
-                                }
-                                double d_y_c = - d_y_i * p_area[is]/p_area[ivc];
-                                clamped_d_y_c = d_y_c;
-                                if (p_massremainder[ivc] >  -d_y_c) {
-                                    p_massremainder[ivc] -= -d_y_c;
-                                    clamped_d_y_c = 0;
-                                } else
-                                if ((p_massremainder[ivc] < -d_y_c) && (p_massremainder[ivc] >0)) {
-                                    p_massremainder[ivc] = 0;
-                                    clamped_d_y_c = d_y_c + p_massremainder[ivc];
-                                }
-                            }
-
-                            // correct vertexes
-                            p_level[ivc]            += clamped_d_y_c;
-                            p_level_initial[ivc]    += clamped_d_y_c;
-                            vertices[ivc]           += N * clamped_d_y_c;
-                            p_vertices_initial[ivc] += N * clamped_d_y_c;
-
-                            p_level[is]             += clamped_d_y_i;
-                            p_level_initial[is]     += clamped_d_y_i;
-                            vertices[is]            += N * clamped_d_y_i;
-                            p_vertices_initial[is]  += N * clamped_d_y_i;      
-                        }
-                    }
-                }
-            }
-        }
-
-    } // end bulldozing flow 
+        ComputeBulldozingFlow(N);
+    }
 
 
 
@@ -926,91 +1510,34 @@ void DeformableSoil::ComputeInternalForces() {
     // Update the visualization colors
     // 
     if (plot_type != DeformableTerrain::PLOT_NONE) {
-        colors.resize(vertices.size());
-        for (size_t iv = 0; iv< vertices.size(); ++iv) {
-            ChColor mcolor;
-            switch (plot_type) {
-                case DeformableTerrain::PLOT_LEVEL:
-                    mcolor = ChColor::ComputeFalseColor(p_level[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_LEVEL_INITIAL:
-                    mcolor = ChColor::ComputeFalseColor(p_level_initial[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SINKAGE:
-                    mcolor = ChColor::ComputeFalseColor(p_sinkage[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SINKAGE_ELASTIC:
-                    mcolor = ChColor::ComputeFalseColor(p_sinkage_elastic[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SINKAGE_PLASTIC:
-                    mcolor = ChColor::ComputeFalseColor(p_sinkage_plastic[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_STEP_PLASTIC_FLOW:
-                    mcolor = ChColor::ComputeFalseColor(p_step_plastic_flow[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_K_JANOSI:
-                    mcolor = ChColor::ComputeFalseColor(p_kshear[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_PRESSURE:
-                    mcolor = ChColor::ComputeFalseColor(p_sigma[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_PRESSURE_YELD:
-                    mcolor = ChColor::ComputeFalseColor(p_sigma_yeld[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_SHEAR:
-                    mcolor = ChColor::ComputeFalseColor(p_tau[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_MASSREMAINDER:
-                    mcolor = ChColor::ComputeFalseColor(p_massremainder[iv], plot_v_min, plot_v_max);
-                    break;
-                case DeformableTerrain::PLOT_ISLAND_ID:
-                    mcolor = ChColor(0,0,1);
-                    if (p_erosion[iv] == true)
-                        mcolor = ChColor(1,1,1);
-                    if (p_id_island[iv] >0)
-                        mcolor = ChColor::ComputeFalseColor(4 +(p_id_island[iv] % 8), 0, 12);
-                    if (p_id_island[iv] <0)
-                        mcolor = ChColor(0,0,0);
-                    break;
-                case DeformableTerrain::PLOT_IS_TOUCHED:
-                    if (p_sigma[iv]>0)
-                        mcolor = ChColor(1,0,0);
-                    else 
-                        mcolor = ChColor(0,0,1);
-                    break;
+        // The nodes without record keep their initial color: all the vertices are
+        // colored only after a change of plot type or of mesh topology
+        if (plot_all || colors.size() != vertices.size()) {
+            colors.resize(vertices.size());
+            for (size_t iv = 0; iv < vertices.size(); ++iv) {
+                const NodeRecord* node = FindNode((int)iv);
+                double level = plane.TransformParentToLocal(vertices[iv]).y();
+                ChColor mcolor = node ? ComputeNodeColor(*node) : ComputeNodeColor(NodeRecord(vertices[iv], level, 0));
+                colors[iv] = {mcolor.R, mcolor.G, mcolor.B};
+            }
+            plot_all = false;
+        } else {
+            for (const auto& entry : p_nodes) {
+                ChColor mcolor = ComputeNodeColor(entry.second);
+                colors[entry.first] = {mcolor.R, mcolor.G, mcolor.B};
             }
-            colors[iv] = {mcolor.R, mcolor.G, mcolor.B};
         }
     } else {
         colors.clear();
+        plot_all = true;
     }
 
     //
     // Update the visualization normals
     // 
 
-    std::vector<int> accumulators(vertices.size(), 0);
-
-    // Calculate normals and then average the normals from all adjacent faces.
-    for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-        // Calculate the triangle normal as a normalized cross product.
-        ChVector<> nrm = -Vcross(vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]],
-                                vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][0]]);
-        nrm.Normalize();
-        // Increment the normals of all incident vertices by the face normal
-        normals[idx_normals[it][0]] += nrm;
-        normals[idx_normals[it][1]] += nrm;
-        normals[idx_normals[it][2]] += nrm;
-        // Increment the count of all incident vertices by 1
-        accumulators[idx_normals[it][0]] += 1;
-        accumulators[idx_normals[it][1]] += 1;
-        accumulators[idx_normals[it][2]] += 1;
-    }
-
-    // Set the normals to the average values.
-    for (unsigned int in = 0; in < vertices.size(); ++in) {
-        normals[in] /= (double)accumulators[in];
-    }
+    // Only the vertices around the moved ones need a new normal
+    UpdateActiveNormals();
 
     // 
     // Compute the forces 
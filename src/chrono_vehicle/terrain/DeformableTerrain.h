@@ -21,6 +21,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/assets/ChColorAsset.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
@@ -43,6 +44,10 @@ class DeformableSoil;
 /// Deformable terrain model.
 /// This class implements a terrain with variable heightmap. Unlike RigidTerrain, the vertical
 /// coordinates of this terrain mesh can be deformed because of interaction with ground vehicles.
+/// The soil state (sinkage, pressure, shear, ...) is stored only for the vertices touched by a
+/// contact or by the bulldozing flow, and the per-step update, including the color plot, is limited
+/// to those vertices. The mesh (vertices, normals, colors, indices), its connectivity and the ray
+/// casting grid are still stored for all vertices, and rebuilt over the whole mesh after a refinement.
 class CH_VEHICLE_API DeformableTerrain : public ChTerrain {
 public:
     enum DataPlotType {
@@ -149,6 +154,17 @@ public:
     void SetTestHighOffset(double moff);
     double GetTestHighOffset() const;
 
+    /// If true (default), the sinkage is found by casting rays only from the vertices that lie
+    /// under the bounding boxes of the collision models of the bodies and FEA contact surfaces in
+    /// the system, testing them directly against those models and in parallel. The cost then scales
+    /// with the contact area instead of the number of vertices. If false, a ray is cast against the
+    /// whole collision system from every vertex. The whole system is also tested, regardless of this
+    /// setting, if the collision system does not support per-model ray tests (see
+    /// ChCollisionSystem::SupportsModelRayHit) or if the system contains other colliding items
+    /// (e.g. particle clouds).
+    void SetGridRayCasting(bool mg);
+    bool GetGridRayCasting() const;
+
 
     /// Set the color plot type for the soil mesh.
     /// Also, when a scalar plot is used, also define which is the max-min range in the falsecolor colormap.
@@ -260,27 +276,110 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     // data structures for the mesh, aux. material data, etc.
     void SetupAuxData();
 
+    // Bin the vertices in a uniform grid on the soil plane, used to find the vertices
+    // under the collision models. Must be called again if vertices are added.
+    void SetupVertexGrid();
+
+    // Cast the vertical rays and store the closest hit of each tested vertex.
+    void FindRayHits(const ChVector<>& N,
+                     std::vector<int>& ray_vertices,
+                     std::vector<collision::ChCollisionSystem::ChRayhitResult>& ray_hits);
+
+    // Build the vertex-vertex and vertex-triangle adjacency. Must be called again
+    // if the mesh topology changes (ex. after refinement).
+    void SetupConnectivity();
+
+    // Compute the (pseudo)area of a vertex, as projected on the soil plane.
+    // Vertices only move along the plane normal, so this changes only when
+    // the mesh topology changes.
+    double ComputeVertexArea(int iv) const;
+
+    // Recompute the normals of the vertices adjacent to the active vertices.
+    void UpdateActiveNormals();
+
+    // Move material from the contact islands to their boundaries, and smooth it
+    // out by erosion over the neighbouring vertices.
+    void ComputeBulldozingFlow(const ChVector<>& N);
+
+    struct NodeRecord;
+
+    // Level and mass remainder changes of the nodes i and c caused by the erosion
+    // flow along the edge between them, as seen from node i, which has n_connected
+    // neighbours. The slope is limited to dy_lim, the edge length times the tangent
+    // of the erosion angle.
+    void ComputeErosionFlow(const NodeRecord& node_i,
+                            const NodeRecord& node_c,
+                            int n_connected,
+                            double dy_lim,
+                            double& d_level_i,
+                            double& d_mass_i,
+                            double& d_level_c,
+                            double& d_mass_c) const;
+
+    // State of a node of the soil. Only the nodes that were touched by a contact or
+    // moved by the bulldozing flow have a record; the others are still in their
+    // initial state, at the level of the initial mesh (or height map) vertex.
+    struct NodeRecord {
+        NodeRecord() {}
+        NodeRecord(const ChVector<>& vertex, double level, double area);
+
+        ChVector<> vertex_initial;
+        ChVector<> speed;
+        double level;
+        double level_initial;
+        double hit_level;
+        double sinkage;
+        double sinkage_plastic;
+        double sinkage_elastic;
+        double step_plastic_flow;
+        double kshear;  // Janosi-Hanamoto shear accumulator
+        double area;
+        double sigma;
+        double sigma_yeld;
+        double tau;
+        double massremainder;
+        int id_island;
+        bool erosion;
+        bool active;  // modified in the current step (listed in active_vertices)
+    };
+
+    // Get the record of a node, or NULL if the node is in its initial state.
+    // Thread safe, as long as no record is being added.
+    const NodeRecord* FindNode(int iv) const {
+        auto it = p_nodes.find(iv);
+        return (it == p_nodes.end()) ? nullptr : &it->second;
+    }
+
+    // Get the record of a node, created from its initial state if needed (not thread safe).
+    // References to records stay valid when other records are added.
+    NodeRecord& GetNode(int iv);
+
+    // Get the state of a node, from its record or from the initial state.
+    NodeRecord GetNodeState(int iv) const;
+
+    // Add a node to the list of nodes modified in the current step (not thread safe).
+    NodeRecord& MarkActive(int iv) {
+        NodeRecord& node = GetNode(iv);
+        if (!node.active) {
+            node.active = true;
+            active_vertices.push_back(iv);
+        }
+        return node;
+    }
+
+    // Create the records of the vertices added by the refinement, interpolating the
+    // state of the two vertices of the edge split by each of them.
+    void InterpolateRefinedNodes(int n_vertices_old, const std::vector<std::pair<int, int>>& split_edges);
+
+    // Color of a node in the current plot type.
+    ChColor ComputeNodeColor(const NodeRecord& node) const;
+
     std::shared_ptr<ChColorAsset> m_color;
     std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
     double m_height;
 
-    std::vector<ChVector<>> p_vertices_initial;
-    std::vector<ChVector<>> p_speeds;
-    std::vector<double> p_level;
-    std::vector<double> p_level_initial;
-    std::vector<double> p_hit_level;
-    std::vector<double> p_sinkage;
-    std::vector<double> p_sinkage_plastic;
-    std::vector<double> p_sinkage_elastic;
-    std::vector<double> p_step_plastic_flow;
-    std::vector<double> p_kshear; // Janosi-Hanamoto shear accumulator
-    std::vector<double> p_area;
-    std::vector<double> p_sigma;
-    std::vector<double> p_sigma_yeld;
-    std::vector<double> p_tau;
-    std::vector<double> p_massremainder;
-    std::vector<int>    p_id_island;
-    std::vector<bool>   p_erosion;
+    // records of the nodes that are not in their initial state, by vertex index
+    std::unordered_map<int, NodeRecord> p_nodes;
 
     double Bekker_Kphi;
     double Bekker_Kc;
@@ -294,13 +393,23 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     int plot_type;
     double plot_v_min;
     double plot_v_max;
+    bool plot_all;  // recompute the colors of all vertices at the next update
 
     ChCoordsys<> plane;
 
-    // aux. topology data
-    std::vector<std::set<int>> connected_vertexes;
+    // aux. topology data, in compressed row storage: the neighbours of vertex i are
+    // connected_vertexes[connected_start[i]] ... connected_vertexes[connected_start[i+1]-1]
+    std::vector<int> connected_start;
+    std::vector<int> connected_vertexes;
+    std::vector<int> connected_triangles_start;
+    std::vector<int> connected_triangles;
     std::vector<std::array<int, 4>> tri_map;
 
+    // vertices whose per-step data (pressure, hit level, island id, erosion flag) was
+    // set or whose position changed in the last step; only these are reset at the next
+    // step, so the per-step cost is proportional to the deformed footprint
+    std::vector<int> active_vertices;
+
     bool do_bulldozing;
     double bulldozing_flow_factor;
     double bulldozing_erosion_angle;
@@ -313,6 +422,16 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     double test_high_offset;
     double test_low_offset;
 
+    // vertex grid, in the (x,z) coordinates of the soil plane
+    bool do_grid_raycast;
+    double grid_min_x;
+    double grid_min_z;
+    double grid_cell_size;
+    int grid_nx;
+    int grid_nz;
+    std::vector<int> grid_cell_start;  // first entry of each cell in grid_vertices
+    std::vector<int> grid_vertices;    // vertex indices, grouped by cell
+
     friend class DeformableTerrain;
     
     double last_t; // for optimization
@@ -16,6 +16,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 
@@ -31,7 +32,7 @@
 
 #include "chrono_thirdparty/Easy_BMP/EasyBMP.h"
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -52,7 +53,11 @@ RigidTerrain::RigidTerrain(ChSystem* system)
       m_kn(2e5f),
       m_gn(40),
       m_kt(2e5f),
-      m_gt(20) {
+      m_gt(20),
+      m_hmap_nx(0),
+      m_hmap_ny(0),
+      m_grid_nx(0),
+      m_grid_ny(0) {
     // Create the ground body and add it to the system.
     m_ground = std::shared_ptr<ChBody>(system->NewBody());
     m_ground->SetIdentifier(-1);
@@ -86,7 +91,11 @@ RigidTerrain::RigidTerrain(ChSystem* system, const std::string& filename)
       m_kn(2e5f),
       m_gn(40),
       m_kt(2e5f),
-      m_gt(20) {
+      m_gt(20),
+      m_hmap_nx(0),
+      m_hmap_ny(0),
+      m_grid_nx(0),
+      m_grid_ny(0) {
     // Create the ground body and add it to the system.
     m_ground = std::shared_ptr<ChBody>(system->NewBody());
     m_ground->SetIdentifier(-1);
@@ -102,15 +111,8 @@ RigidTerrain::RigidTerrain(ChSystem* system, const std::string& filename)
     m_ground->AddAsset(m_color);
 
     // Open the JSON file and read data
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Read top-level data
     assert(d.HasMember("Type"));
@@ -293,6 +295,9 @@ void RigidTerrain::Initialize(const std::string& mesh_file, const std::string& m
 
     ApplyContactMaterial();
 
+    // Create the lookup structure for height queries.
+    SetupMeshGrid();
+
     m_mesh_name = mesh_name;
     m_type = MESH;
 }
@@ -428,10 +433,91 @@ void RigidTerrain::Initialize(const std::string& heightmap_file,
 
     ApplyContactMaterial();
 
+    // Height queries are answered directly from the grid of vertices.
+    m_hmap_nx = nv_x;
+    m_hmap_ny = nv_y;
+    m_hmap_x0 = -0.5 * sizeX;
+    m_hmap_y0 = -0.5 * sizeY;
+    m_hmap_dx = dx;
+    m_hmap_dy = dy;
+
     m_mesh_name = mesh_name;
     m_type = HEIGHT_MAP;
 }
 
+// -----------------------------------------------------------------------------
+// Bin the mesh triangles in a uniform grid over the (x,y) plane.
+// -----------------------------------------------------------------------------
+void RigidTerrain::SetupMeshGrid() {
+    const std::vector<ChVector<> >& vertices = m_trimesh.m_vertices;
+    const std::vector<ChVector<int> >& faces = m_trimesh.m_face_v_indices;
+    int n_faces = (int)faces.size();
+
+    m_grid_nx = 0;
+    m_grid_ny = 0;
+    m_grid_start.clear();
+    m_grid_triangles.clear();
+    if (n_faces == 0)
+        return;
+
+    double x_min = 1e30;
+    double x_max = -1e30;
+    double y_min = 1e30;
+    double y_max = -1e30;
+    for (const auto& v : vertices) {
+        x_min = std::min(x_min, v.x());
+        x_max = std::max(x_max, v.x());
+        y_min = std::min(y_min, v.y());
+        y_max = std::max(y_max, v.y());
+    }
+
+    // Cells hold about one triangle each, on average (and at most n_faces cells along a side)
+    double size_x = x_max - x_min;
+    double size_y = y_max - y_min;
+    m_grid_cell = std::max(std::sqrt(size_x * size_y / n_faces), std::max(size_x, size_y) / n_faces);
+    if (m_grid_cell <= 0)
+        m_grid_cell = 1;
+    m_grid_x0 = x_min;
+    m_grid_y0 = y_min;
+    m_grid_nx = (int)std::floor(size_x / m_grid_cell) + 1;
+    m_grid_ny = (int)std::floor(size_y / m_grid_cell) + 1;
+
+    // Range of cells overlapped by the bounding box of a triangle
+    auto cell_range = [&](int it, int& ix0, int& ix1, int& iy0, int& iy1) {
+        const ChVector<>& A = vertices[faces[it].x()];
+        const ChVector<>& B = vertices[faces[it].y()];
+        const ChVector<>& C = vertices[faces[it].z()];
+        ix0 = (int)std::floor((std::min(A.x(), std::min(B.x(), C.x())) - m_grid_x0) / m_grid_cell);
+        ix1 = (int)std::floor((std::max(A.x(), std::max(B.x(), C.x())) - m_grid_x0) / m_grid_cell);
+        iy0 = (int)std::floor((std::min(A.y(), std::min(B.y(), C.y())) - m_grid_y0) / m_grid_cell);
+        iy1 = (int)std::floor((std::max(A.y(), std::max(B.y(), C.y())) - m_grid_y0) / m_grid_cell);
+        ix0 = std::max(ix0, 0);
+        iy0 = std::max(iy0, 0);
+        ix1 = std::min(ix1, m_grid_nx - 1);
+        iy1 = std::min(iy1, m_grid_ny - 1);
+    };
+
+    // Count the triangles in each cell, then fill the cells
+    int ix0, ix1, iy0, iy1;
+    m_grid_start.assign(m_grid_nx * m_grid_ny + 1, 0);
+    for (int it = 0; it < n_faces; ++it) {
+        cell_range(it, ix0, ix1, iy0, iy1);
+        for (int iy = iy0; iy <= iy1; ++iy)
+            for (int ix = ix0; ix <= ix1; ++ix)
+                m_grid_start[iy * m_grid_nx + ix + 1]++;
+    }
+    for (int ic = 0; ic < m_grid_nx * m_grid_ny; ++ic)
+        m_grid_start[ic + 1] += m_grid_start[ic];
+    std::vector<int> cell_fill(m_grid_start.begin(), m_grid_start.end() - 1);
+    m_grid_triangles.resize(m_grid_start.back());
+    for (int it = 0; it < n_faces; ++it) {
+        cell_range(it, ix0, ix1, iy0, iy1);
+        for (int iy = iy0; iy <= iy1; ++iy)
+            for (int ix = ix0; ix <= ix1; ++ix)
+                m_grid_triangles[cell_fill[iy * m_grid_nx + ix]++] = it;
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Export the terrain mesh (if any) as a macro in a PovRay include file.
 // -----------------------------------------------------------------------------
@@ -453,45 +539,136 @@ void RigidTerrain::ExportMeshPovray(const std::string& out_dir) {
 // Return the terrain height at the specified location
 // -----------------------------------------------------------------------------
 double RigidTerrain::GetHeight(double x, double y) const {
-    switch (m_type) {
-        case FLAT:
-            return m_height;
-        case MESH: {
-            double height = 0;
-            //// TODO
-            return height;
-        }
-        case HEIGHT_MAP: {
-            double height = 0;
-            //// TODO
-            return height;
-        }
-        default:
-            return 0;
-    }
+    double height;
+    ChVector<> normal;
+    QuerySurface(x, y, height, normal);
+    return height;
 }
 
 // -----------------------------------------------------------------------------
 // Return the terrain normal at the specified location
 // -----------------------------------------------------------------------------
 ChVector<> RigidTerrain::GetNormal(double x, double y) const {
+    double height;
+    ChVector<> normal;
+    QuerySurface(x, y, height, normal);
+    return normal;
+}
+
+// -----------------------------------------------------------------------------
+// Return the terrain height and normal at a batch of locations
+// -----------------------------------------------------------------------------
+void RigidTerrain::GetHeightAndNormal(const std::vector<double>& x,
+                                      const std::vector<double>& y,
+                                      std::vector<double>& heights,
+                                      std::vector<ChVector<> >& normals) const {
+    int n = (int)x.size();
+    heights.resize(n);
+    normals.resize(n);
+    // (small batches are not worth the overhead of a parallel region)
+#pragma omp parallel for if (n > 1000)
+    for (int i = 0; i < n; i++) {
+        QuerySurface(x[i], y[i], heights[i], normals[i]);
+    }
+}
+
+void RigidTerrain::QuerySurface(double x, double y, double& height, ChVector<>& normal) const {
     switch (m_type) {
+        case MESH:
+            QueryMesh(x, y, height, normal);
+            return;
+        case HEIGHT_MAP:
+            QueryHeightMap(x, y, height, normal);
+            return;
         case FLAT:
-            return ChVector<>(0, 0, 1);
-        case MESH: {
-            ChVector<> normal(0, 0, 1);
-            //// TODO
-            return normal;
-        }
-        case HEIGHT_MAP: {
-            ChVector<> normal(0, 0, 1);
-            //// TODO
-            return normal;
-        }
+            height = m_height;
+            normal = ChVector<>(0, 0, 1);
+            return;
         default:
-            return ChVector<>(0, 0, 1);
+            height = 0;
+            normal = ChVector<>(0, 0, 1);
+            return;
     }
 }
 
+// Highest mesh triangle above or below the point. Outside the mesh, return a zero height.
+void RigidTerrain::QueryMesh(double x, double y, double& height, ChVector<>& normal) const {
+    height = 0;
+    normal = ChVector<>(0, 0, 1);
+
+    int ix = (int)std::floor((x - m_grid_x0) / m_grid_cell);
+    int iy = (int)std::floor((y - m_grid_y0) / m_grid_cell);
+    if (ix < 0 || ix >= m_grid_nx || iy < 0 || iy >= m_grid_ny)
+        return;
+
+    const std::vector<ChVector<> >& vertices = m_trimesh.m_vertices;
+    const std::vector<ChVector<int> >& faces = m_trimesh.m_face_v_indices;
+    const double eps = 1e-10;
+    bool found = false;
+
+    int ic = iy * m_grid_nx + ix;
+    for (int k = m_grid_start[ic]; k < m_grid_start[ic + 1]; ++k) {
+        const ChVector<int>& face = faces[m_grid_triangles[k]];
+        const ChVector<>& A = vertices[face.x()];
+        const ChVector<>& B = vertices[face.y()];
+        const ChVector<>& C = vertices[face.z()];
+
+        // Barycentric coordinates of the projection on the (x,y) plane
+        double det = (B.y() - C.y()) * (A.x() - C.x()) + (C.x() - B.x()) * (A.y() - C.y());
+        if (det == 0)
+            continue;
+        double la = ((B.y() - C.y()) * (x - C.x()) + (C.x() - B.x()) * (y - C.y())) / det;
+        double lb = ((C.y() - A.y()) * (x - C.x()) + (A.x() - C.x()) * (y - C.y())) / det;
+        double lc = 1 - la - lb;
+        if (la < -eps || lb < -eps || lc < -eps)
+            continue;
+
+        double z = la * A.z() + lb * B.z() + lc * C.z();
+        if (!found || z > height) {
+            found = true;
+            height = z;
+            normal = Vcross(B - A, C - A);
+            if (normal.z() < 0)
+                normal = -normal;
+            normal.Normalize();
+        }
+    }
+}
+
+// Interpolation on the triangles of the height map. Points outside the height map
+// take the height of the closest point on its border.
+void RigidTerrain::QueryHeightMap(double x, double y, double& height, ChVector<>& normal) const {
+    const std::vector<ChVector<> >& vertices = m_trimesh.m_vertices;
+
+    double u = (x - m_hmap_x0) / m_hmap_dx;
+    double v = (y - m_hmap_y0) / m_hmap_dy;
+    u = std::max(0.0, std::min(u, m_hmap_nx - 1.0));
+    v = std::max(0.0, std::min(v, m_hmap_ny - 1.0));
+    int ix = std::min((int)u, m_hmap_nx - 2);
+    int iy = std::min((int)v, m_hmap_ny - 2);
+    u -= ix;
+    v -= iy;
+
+    int v0 = ix + m_hmap_nx * iy;
+    double h00 = vertices[v0].z();
+    double h10 = vertices[v0 + 1].z();
+    double h01 = vertices[v0 + m_hmap_nx].z();
+    double h11 = vertices[v0 + m_hmap_nx + 1].z();
+
+    // Each cell is split along the diagonal from (0,0) to (1,1), as in Initialize()
+    double hx, hy;
+    if (u >= v) {
+        hx = h10 - h00;
+        hy = h11 - h10;
+    } else {
+        hx = h11 - h01;
+        hy = h01 - h00;
+    }
+
+    height = h00 + u * hx + v * hy;
+    normal = ChVector<>(-hx / m_hmap_dx, -hy / m_hmap_dy, 1);
+    normal.Normalize();
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -20,6 +20,7 @@
 #define RIGID_TERRAIN_H
 
 #include <string>
+#include <vector>
 
 #include "chrono/assets/ChColor.h"
 #include "chrono/assets/ChColorAsset.h"
@@ -139,6 +140,17 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     /// Get the terrain normal at the specified (x,y) location.
     virtual chrono::ChVector<> GetNormal(double x, double y) const override;
 
+    /// Get the terrain height and normal at each of the specified (x,y) locations.
+    /// For MESH and HEIGHT_MAP terrains, the points are located in a lookup structure built
+    /// at initialization (a uniform grid of the mesh triangles, or the height map itself)
+    /// and the normal is that of the triangle under the point. Large batches are processed
+    /// in parallel.
+    virtual void GetHeightAndNormal(const std::vector<double>& x,       ///< [in] x coordinates of the query points
+                                    const std::vector<double>& y,       ///< [in] y coordinates of the query points
+                                    std::vector<double>& heights,       ///< [out] terrain heights
+                                    std::vector<ChVector<> >& normals  ///< [out] terrain normals
+                                    ) const override;
+
   private:
     Type m_type;
     bool m_vis_enabled;
@@ -157,7 +169,32 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     float m_kt;
     float m_gt;
 
+    // height map lookup data (vertices ordered row after row, from the (x0,y0) corner)
+    int m_hmap_nx;
+    int m_hmap_ny;
+    double m_hmap_x0;
+    double m_hmap_y0;
+    double m_hmap_dx;
+    double m_hmap_dy;
+
+    // uniform grid of the mesh triangles, in the (x,y) plane
+    double m_grid_x0;
+    double m_grid_y0;
+    double m_grid_cell;
+    int m_grid_nx;
+    int m_grid_ny;
+    std::vector<int> m_grid_start;      // first entry of each cell in m_grid_triangles
+    std::vector<int> m_grid_triangles;  // triangle indices, grouped by cell
+
     void ApplyContactMaterial();
+
+    // Bin the mesh triangles in the uniform grid used for height queries.
+    void SetupMeshGrid();
+
+    // Return the height and the normal of the terrain surface at the specified (x,y) location.
+    void QuerySurface(double x, double y, double& height, ChVector<>& normal) const;
+    void QueryMesh(double x, double y, double& height, ChVector<>& normal) const;
+    void QueryHeightMap(double x, double y, double& height, ChVector<>& normal) const;
 };
 
 /// @} vehicle_terrain
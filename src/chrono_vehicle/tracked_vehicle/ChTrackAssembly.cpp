@@ -80,8 +80,15 @@ void ChTrackAssembly::Initialize(std::shared_ptr<ChBodyAuxRef> chassis,  // hand
     // road wheels, and idler. (Implemented by derived classes)
     bool ccw = Assemble(chassis);
 
-    // Loop over all track shoes and allow them to connect themselves to their
-    // neighbor.
+    // Connect the track shoes.
+    ConnectTrackShoes(ccw);
+}
+
+// -----------------------------------------------------------------------------
+// Loop over all track shoes and allow them to connect themselves to their
+// neighbor.
+// -----------------------------------------------------------------------------
+void ChTrackAssembly::ConnectTrackShoes(bool ccw) {
     size_t num_shoes = GetNumTrackShoes();
     std::shared_ptr<ChTrackShoe> next;
     for (size_t i = 0; i < num_shoes; ++i) {
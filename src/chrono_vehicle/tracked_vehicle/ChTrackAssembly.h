@@ -183,6 +183,11 @@ class CH_VEHICLE_API ChTrackAssembly : public ChPart {
     /// direction and false otherwise.
     virtual bool Assemble(std::shared_ptr<ChBodyAuxRef> chassis) = 0;
 
+    /// Connect the assembled track shoes.
+    /// The default implementation lets each track shoe connect itself to its
+    /// neighbor (in the direction given by the return value of Assemble()).
+    virtual void ConnectTrackShoes(bool ccw);
+
     VehicleSide m_side;                     ///< assembly on left/right vehicle side
     std::shared_ptr<ChIdler> m_idler;       ///< idler (and tensioner) subsystem
     std::shared_ptr<ChTrackBrake> m_brake;  ///< sprocket brake
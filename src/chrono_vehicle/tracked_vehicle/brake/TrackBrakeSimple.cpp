@@ -18,7 +18,7 @@
 
 #include "chrono_vehicle/tracked_vehicle/brake/TrackBrakeSimple.h"
 
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -28,15 +28,8 @@ namespace vehicle {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 TrackBrakeSimple::TrackBrakeSimple(const std::string& filename) : ChTrackBrakeSimple("") {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     Create(d);
 
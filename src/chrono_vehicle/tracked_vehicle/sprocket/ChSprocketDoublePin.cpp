@@ -18,6 +18,9 @@
 // =============================================================================
 
 #include <cmath>
+#include <vector>
+
+#include "chrono/parallel/ChOpenMP.h"
 
 #include "chrono_vehicle/tracked_vehicle/sprocket/ChSprocketDoublePin.h"
 #include "chrono_vehicle/tracked_vehicle/track_shoe/ChTrackShoeDoublePin.h"
@@ -67,7 +70,8 @@ class SprocketDoublePinContactCB : public ChSystem::ChCustomComputeCollisionCall
   private:
     // Test collision between a connector body and the sprocket's gear profiles.
     void CheckConnectorSprocket(std::shared_ptr<ChBody> connector,  // connector body
-                                const ChVector<>& locS_abs          // center of sprocket (global frame)
+                                const ChVector<>& locS_abs,         // center of sprocket (global frame)
+                                std::vector<collision::ChCollisionInfo>& contacts  // output contacts
                                 );
 
     // Test collision between a circle and the gear profile (in the plane of the gear).
@@ -80,7 +84,8 @@ class SprocketDoublePinContactCB : public ChSystem::ChCustomComputeCollisionCall
                             const ChVector<>& p1R,
                             const ChVector<>& p2R,
                             const ChVector<>& p3R,
-                            const ChVector<>& p4R);
+                            const ChVector<>& p4R,
+                            std::vector<collision::ChCollisionInfo>& contacts);
 
     void CheckCircleArc(std::shared_ptr<ChBody> connector,  // connector body
                         const ChVector<>& cc,               // circle center
@@ -88,14 +93,16 @@ class SprocketDoublePinContactCB : public ChSystem::ChCustomComputeCollisionCall
                         const ChVector<> ac,                // arc center
                         double ar,                          // arc radius
                         const ChVector<>& p1,               // arc end point 1
-                        const ChVector<>& p2                // arc end point 2
+                        const ChVector<>& p2,               // arc end point 2
+                        std::vector<collision::ChCollisionInfo>& contacts  // output contacts
                         );
 
     void CheckCircleSegment(std::shared_ptr<ChBody> connector,  // connector body
                             const ChVector<>& cc,               // circle center
                             double cr,                          // circle radius
                             const ChVector<>& p1,               // segment end point 1
-                            const ChVector<>& p2                // segment end point 2
+                            const ChVector<>& p2,               // segment end point 2
+                            std::vector<collision::ChCollisionInfo>& contacts  // output contacts
                             );
 
     ChTrackAssembly* m_track;                // pointer to containing track assembly
@@ -124,6 +131,8 @@ class SprocketDoublePinContactCB : public ChSystem::ChCustomComputeCollisionCall
     double m_shoe_Rhat;  // adjusted shoe cylinder radius
 
     double m_R_sum;  // test quantity for broadphase check
+
+    std::vector<std::vector<collision::ChCollisionInfo>> m_contacts;  // per-thread contact buffers
 };
 
 // Add contacts between the sprocket and track shoes.
@@ -135,20 +144,39 @@ void SprocketDoublePinContactCB::PerformCustomCollision(ChSystem* system) {
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all track shoes in the associated track
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
-        auto shoe = std::static_pointer_cast<ChTrackShoeDoublePin>(m_track->GetTrackShoe(is));
-
-        // Perform collision test for the "left" connector body
-        CheckConnectorSprocket(shoe->m_connector_L, locS_abs);
+    // Loop over all track shoes in the associated track. Contacts are collected in
+    // per-thread buffers; with a static schedule, merging the buffers in thread
+    // order adds the contacts in the same order as a serial loop.
+    int num_shoes = (int)m_track->GetNumTrackShoes();
+    m_contacts.resize(CHOMPfunctions::GetMaxThreads());
+
+#pragma omp parallel
+    {
+        std::vector<collision::ChCollisionInfo>& contacts = m_contacts[CHOMPfunctions::GetThreadNum()];
+#pragma omp for schedule(static)
+        for (int is = 0; is < num_shoes; ++is) {
+            auto shoe = std::static_pointer_cast<ChTrackShoeDoublePin>(m_track->GetTrackShoe(is));
+
+            // Perform collision test for the "left" connector body
+            CheckConnectorSprocket(shoe->m_connector_L, locS_abs, contacts);
+
+            // Perform collision test for the "right" connector body
+            CheckConnectorSprocket(shoe->m_connector_R, locS_abs, contacts);
+        }
+    }
 
-        // Perform collision test for the "right" connector body
-        CheckConnectorSprocket(shoe->m_connector_R, locS_abs);
+    // Add the contacts to the system.
+    for (auto& contacts : m_contacts) {
+        for (auto& contact : contacts)
+            system->GetContactContainer()->AddContact(contact);
+        contacts.clear();
     }
 }
 
 // Perform collision test between the specified connector body and the associated sprocket.
-void SprocketDoublePinContactCB::CheckConnectorSprocket(std::shared_ptr<ChBody> connector, const ChVector<>& locS_abs) {
+void SprocketDoublePinContactCB::CheckConnectorSprocket(std::shared_ptr<ChBody> connector,
+                                                        const ChVector<>& locS_abs,
+                                                        std::vector<collision::ChCollisionInfo>& contacts) {
     // (1) Express the center of the connector body in the sprocket frame
     ChVector<> loc = m_sprocket->GetGearBody()->TransformPointParentToLocal(connector->GetPos());
 
@@ -207,10 +235,10 @@ void SprocketDoublePinContactCB::CheckConnectorSprocket(std::shared_ptr<ChBody>
     ChVector<> P2 = m_sprocket->GetGearBody()->TransformPointParentToLocal(P2_abs);
 
     // (6) Perform collision test between the front end of the connector and the gear profile.
-    CheckCircleProfile(connector, P1, p1L, p2L, p3L, p4L, p1R, p2R, p3R, p4R);
+    CheckCircleProfile(connector, P1, p1L, p2L, p3L, p4L, p1R, p2R, p3R, p4R, contacts);
 
     // (7) Perform collision test between the rear end of the connector and the gear profile.
-    CheckCircleProfile(connector, P2, p1L, p2L, p3L, p4L, p1R, p2R, p3R, p4R);
+    CheckCircleProfile(connector, P2, p1L, p2L, p3L, p4L, p1R, p2R, p3R, p4R, contacts);
 }
 
 // Working in the (x-z) plane of the gear, perform a 2D collision test between a circle
@@ -224,21 +252,22 @@ void SprocketDoublePinContactCB::CheckCircleProfile(std::shared_ptr<ChBody> conn
                                                     const ChVector<>& p1R,
                                                     const ChVector<>& p2R,
                                                     const ChVector<>& p3R,
-                                                    const ChVector<>& p4R) {
+                                                    const ChVector<>& p4R,
+                                                    std::vector<collision::ChCollisionInfo>& contacts) {
     // Check circle against arc centered at p3L.
-    CheckCircleArc(connector, loc, m_shoe_R, p3L, m_gear_R, p2L, p4L);
+    CheckCircleArc(connector, loc, m_shoe_R, p3L, m_gear_R, p2L, p4L, contacts);
 
     // Check circle against arc centered at p3R.
-    CheckCircleArc(connector, loc, m_shoe_R, p3R, m_gear_R, p3R, p4R);
+    CheckCircleArc(connector, loc, m_shoe_R, p3R, m_gear_R, p3R, p4R, contacts);
 
     // Check circle against segment p1L - p2L.
-    CheckCircleSegment(connector, loc, m_shoe_R, p1L, p2L);
+    CheckCircleSegment(connector, loc, m_shoe_R, p1L, p2L, contacts);
 
     // Check circle against segment p1R - p2R.
-    CheckCircleSegment(connector, loc, m_shoe_R, p1R, p2R);
+    CheckCircleSegment(connector, loc, m_shoe_R, p1R, p2R, contacts);
 
     // Check circle against segment p4L - p4R.
-    CheckCircleSegment(connector, loc, m_shoe_R, p4L, p4R);
+    CheckCircleSegment(connector, loc, m_shoe_R, p4L, p4R, contacts);
 }
 
 // Working in the (x-z) plane, perform a 2D collision test between a circle of radius 'cr'
@@ -250,8 +279,8 @@ void SprocketDoublePinContactCB::CheckCircleArc(std::shared_ptr<ChBody> connecto
                                                 const ChVector<> ac,                // arc center
                                                 double ar,                          // arc radius
                                                 const ChVector<>& p1,               // arc end point 1
-                                                const ChVector<>& p2                // arc end point 2
-                                                ) {
+                                                const ChVector<>& p2,               // arc end point 2
+                                                std::vector<collision::ChCollisionInfo>& contacts) {
     // Find distance between centers
     ChVector<> delta = cc - ac;
     double dist2 = delta.Length2();
@@ -277,7 +306,7 @@ void SprocketDoublePinContactCB::CheckCircleArc(std::shared_ptr<ChBody> connecto
     ChVector<> pt_gear = ac - m_gear_R * normal;
     ChVector<> pt_shoe = cc - m_shoe_R * normal;
 
-    // Fill in contact information and add the contact to the system.
+    // Fill in contact information and add the contact to the output list.
     // Express all vectors in the global frame
     collision::ChCollisionInfo contact;
     contact.modelA = m_sprocket->GetGearBody()->GetCollisionModel().get();
@@ -287,7 +316,7 @@ void SprocketDoublePinContactCB::CheckCircleArc(std::shared_ptr<ChBody> connecto
     contact.vpB = m_sprocket->GetGearBody()->TransformPointLocalToParent(pt_shoe);
     contact.distance = Rdiff - dist;
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    contacts.push_back(contact);
 }
 
 // Working in the (x-z) plane, perform a 2D collision test between the circle of radius 'cr'
@@ -297,8 +326,8 @@ void SprocketDoublePinContactCB::CheckCircleSegment(std::shared_ptr<ChBody> conn
                                                     const ChVector<>& cc,               // circle center
                                                     double cr,                          // circle radius
                                                     const ChVector<>& p1,               // segment end point 1
-                                                    const ChVector<>& p2                // segment end point 2
-                                                    ) {
+                                                    const ChVector<>& p2,               // segment end point 2
+                                                    std::vector<collision::ChCollisionInfo>& contacts) {
     // Find closest point on segment to circle center: X = p1 + t * (p2-p1)
     ChVector<> s = p2 - p1;
     double t = Vdot(cc - p1, s) / Vdot(s, s);
@@ -317,7 +346,7 @@ void SprocketDoublePinContactCB::CheckCircleSegment(std::shared_ptr<ChBody> conn
     ChVector<> normal = delta / dist;
     ChVector<> pt_shoe = cc - cr * normal;
 
-    // Fill in contact information and add the contact to the system.
+    // Fill in contact information and add the contact to the output list.
     // Express all vectors in the global frame
     collision::ChCollisionInfo contact;
     contact.modelA = m_sprocket->GetGearBody()->GetCollisionModel().get();
@@ -327,7 +356,7 @@ void SprocketDoublePinContactCB::CheckCircleSegment(std::shared_ptr<ChBody> conn
     contact.vpB = m_sprocket->GetGearBody()->TransformPointLocalToParent(pt_shoe);
     contact.distance = dist - cr;
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    contacts.push_back(contact);
 }
 
 // -----------------------------------------------------------------------------
@@ -17,7 +17,11 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
+
+#include "chrono/parallel/ChOpenMP.h"
 
 #include "chrono_vehicle/tracked_vehicle/sprocket/ChSprocketSinglePin.h"
 #include "chrono_vehicle/tracked_vehicle/track_shoe/ChTrackShoeSinglePin.h"
@@ -58,6 +62,7 @@ class SprocketSinglePinContactCB : public ChSystem::ChCustomComputeCollisionCall
         m_R_sum = m_gear_RO + m_shoe_R + safety_factor * m_envelope;
         m_R_diff = m_gear_R - m_shoe_R;
         m_Rhat_diff = m_gear_Rhat - m_shoe_Rhat;
+        m_R_shoe = m_R_sum + std::max(std::abs(m_shoe_locF), std::abs(m_shoe_locR));
     }
 
     virtual void PerformCustomCollision(ChSystem* system) override;
@@ -68,13 +73,15 @@ class SprocketSinglePinContactCB : public ChSystem::ChCustomComputeCollisionCall
     void CheckCylinderSprocket(std::shared_ptr<ChBody> shoe,  // shoe body
                                const ChVector<>& locC_abs,    // center of shoe contact cylinder (global frame)
                                const ChVector<>& dirC_abs,    // direction of shoe contact cylinder (global frame)
-                               const ChVector<> locS_abs      // center of sprocket (global frame)
+                               const ChVector<> locS_abs,     // center of sprocket (global frame)
+                               std::vector<collision::ChCollisionInfo>& contacts  // output contacts
                                );
 
     // Test collision of a shoe contact circle with a gear plane profile.
     // This may introduce one contact.
     void CheckCircleProfile(std::shared_ptr<ChBody> shoe,  // shoe body
-                            const ChVector<>& loc          // shoe contact circle center (sprocket frame)
+                            const ChVector<>& loc,         // shoe contact circle center (sprocket frame)
+                            std::vector<collision::ChCollisionInfo>& contacts  // output contacts
                             );
 
     // Find the center of the profile arc that is closest to the specified location.
@@ -101,6 +108,9 @@ class SprocketSinglePinContactCB : public ChSystem::ChCustomComputeCollisionCall
     double m_R_sum;      // test quantity for broadphase check
     double m_R_diff;     // test quantity for narrowphase check
     double m_Rhat_diff;  // test quantity for narrowphase check
+    double m_R_shoe;     // test quantity for shoe-level broadphase check
+
+    std::vector<std::vector<collision::ChCollisionInfo>> m_contacts;  // per-thread contact buffers
 };
 
 void SprocketSinglePinContactCB::PerformCustomCollision(ChSystem* system) {
@@ -111,23 +121,45 @@ void SprocketSinglePinContactCB::PerformCustomCollision(ChSystem* system) {
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all shoes in the associated track.
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
-        std::shared_ptr<ChTrackShoe> shoe = m_track->GetTrackShoe(is);
-
-        // Calculate locations of the centers of the shoe's contact cylinders
-        // (expressed in the global frame)
-        ChVector<> locF_abs = shoe->GetShoeBody()->TransformPointLocalToParent(ChVector<>(m_shoe_locF, 0, 0));
-        ChVector<> locR_abs = shoe->GetShoeBody()->TransformPointLocalToParent(ChVector<>(m_shoe_locR, 0, 0));
-
-        // Express contact cylinder direction (common for both cylinders) in the global frame
-        ChVector<> dir_abs = shoe->GetShoeBody()->GetA().Get_A_Yaxis();
-
-        // Perform collision test for the front contact cylinder.
-        CheckCylinderSprocket(shoe->GetShoeBody(), locF_abs, dir_abs, locS_abs);
+    // Loop over all shoes in the associated track. Contacts are collected in
+    // per-thread buffers; with a static schedule, merging the buffers in thread
+    // order adds the contacts in the same order as a serial loop.
+    int num_shoes = (int)m_track->GetNumTrackShoes();
+    m_contacts.resize(CHOMPfunctions::GetMaxThreads());
+
+#pragma omp parallel
+    {
+        std::vector<collision::ChCollisionInfo>& contacts = m_contacts[CHOMPfunctions::GetThreadNum()];
+#pragma omp for schedule(static)
+        for (int is = 0; is < num_shoes; ++is) {
+            std::shared_ptr<ChBody> shoe = m_track->GetTrackShoe(is)->GetShoeBody();
+
+            // Coarse test: skip shoes that are not wrapped on the sprocket (both
+            // contact cylinders are then too far from the sprocket center).
+            if ((shoe->GetPos() - locS_abs).Length2() > m_R_shoe * m_R_shoe)
+                continue;
+
+            // Calculate locations of the centers of the shoe's contact cylinders
+            // (expressed in the global frame)
+            ChVector<> locF_abs = shoe->TransformPointLocalToParent(ChVector<>(m_shoe_locF, 0, 0));
+            ChVector<> locR_abs = shoe->TransformPointLocalToParent(ChVector<>(m_shoe_locR, 0, 0));
+
+            // Express contact cylinder direction (common for both cylinders) in the global frame
+            ChVector<> dir_abs = shoe->GetA().Get_A_Yaxis();
+
+            // Perform collision test for the front contact cylinder.
+            CheckCylinderSprocket(shoe, locF_abs, dir_abs, locS_abs, contacts);
+
+            // Perform collision test for the rear contact cylinder.
+            CheckCylinderSprocket(shoe, locR_abs, dir_abs, locS_abs, contacts);
+        }
+    }
 
-        // Perform collision test for the rear contact cylinder.
-        CheckCylinderSprocket(shoe->GetShoeBody(), locR_abs, dir_abs, locS_abs);
+    // Add the contacts to the system.
+    for (auto& contacts : m_contacts) {
+        for (auto& contact : contacts)
+            system->GetContactContainer()->AddContact(contact);
+        contacts.clear();
     }
 }
 
@@ -136,7 +168,8 @@ void SprocketSinglePinContactCB::PerformCustomCollision(ChSystem* system) {
 void SprocketSinglePinContactCB::CheckCylinderSprocket(std::shared_ptr<ChBody> shoe,
                                                        const ChVector<>& locC_abs,
                                                        const ChVector<>& dirC_abs,
-                                                       const ChVector<> locS_abs) {
+                                                       const ChVector<> locS_abs,
+                                                       std::vector<collision::ChCollisionInfo>& contacts) {
     // Broadphase collision test: no contact if the cylinder center is too far from
     // the sprocket center.
     if ((locC_abs - locS_abs).Length2() > m_R_sum * m_R_sum)
@@ -157,15 +190,17 @@ void SprocketSinglePinContactCB::CheckCylinderSprocket(std::shared_ptr<ChBody> s
     ChVector<> locN = locC + alphaN * dirC;
 
     // Perform collision test with the "positive" gear profile.
-    CheckCircleProfile(shoe, locP);
+    CheckCircleProfile(shoe, locP, contacts);
 
     // Perform collision test with the "negative" gear profile.
-    CheckCircleProfile(shoe, locN);
+    CheckCircleProfile(shoe, locN, contacts);
 }
 
 // Working in the (x-z) plane of the gear, perform a 2D collision test between the
 // gear profile and a circle centered at the specified location.
-void SprocketSinglePinContactCB::CheckCircleProfile(std::shared_ptr<ChBody> shoe, const ChVector<>& loc) {
+void SprocketSinglePinContactCB::CheckCircleProfile(std::shared_ptr<ChBody> shoe,
+                                                    const ChVector<>& loc,
+                                                    std::vector<collision::ChCollisionInfo>& contacts) {
     // No contact if the circle center is too far from the gear center.
     if (loc.x() * loc.x() + loc.z() * loc.z() > m_gear_RC * m_gear_RC)
         return;
@@ -199,7 +234,7 @@ void SprocketSinglePinContactCB::CheckCircleProfile(std::shared_ptr<ChBody> shoe
     if (pt_gear.x() * pt_gear.x() + pt_gear.z() * pt_gear.z() > m_gear_RO * m_gear_RO)
         return;
 
-    // Fill in contact information and add the contact to the system.
+    // Fill in contact information and add the contact to the output list.
     // Express all vectors in the global frame
     collision::ChCollisionInfo contact;
     contact.modelA = m_sprocket->GetGearBody()->GetCollisionModel().get();
@@ -209,7 +244,7 @@ void SprocketSinglePinContactCB::CheckCircleProfile(std::shared_ptr<ChBody> shoe
     contact.vpB = m_sprocket->GetGearBody()->TransformPointLocalToParent(pt_shoe);
     contact.distance = m_R_diff - dist;
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    contacts.push_back(contact);
 }
 
 // Find the center of the profile arc that is closest to the specified location.
@@ -24,7 +24,7 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -44,15 +44,8 @@ static ChVector<> loadVector(const Value& a) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void LinearDamperRWAssembly::LoadRoadWheel(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a road-wheel specification file.
     assert(d.HasMember("Type"));
@@ -77,15 +70,8 @@ void LinearDamperRWAssembly::LoadRoadWheel(const std::string& filename) {
 // -----------------------------------------------------------------------------
 LinearDamperRWAssembly::LinearDamperRWAssembly(const std::string& filename, bool has_shock)
     : ChLinearDamperRWAssembly("", has_shock), m_torsion_force(nullptr), m_shock_forceCB(nullptr) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     Create(d);
 
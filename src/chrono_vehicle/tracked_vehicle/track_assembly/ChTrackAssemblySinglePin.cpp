@@ -23,12 +23,47 @@
 #include <cmath>
 
 #include "chrono/core/ChLog.h"
+#include "chrono/physics/ChSystem.h"
 
 #include "chrono_vehicle/tracked_vehicle/track_assembly/ChTrackAssemblySinglePin.h"
 
 namespace chrono {
 namespace vehicle {
 
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChTrackAssemblySinglePin::EnableReducedChain(double k_lin, double c_lin, double k_rot, double c_rot) {
+    m_chain = std::make_shared<ChTrackChainSinglePin>();
+    m_chain->SetPinParameters(k_lin, c_lin, k_rot, c_rot);
+}
+
+// -----------------------------------------------------------------------------
+// Connect the track shoes. With the reduced-order chain enabled, the shoe bodies
+// are passed to the chain item in connection order: each shoe is pinned to the
+// next one in the assembly direction.
+// The chain loads the contact forces of the current step, which are available only
+// with DEM contact (with DVI, the reactions of the previous step would make the
+// stiff chain unstable).
+// -----------------------------------------------------------------------------
+void ChTrackAssemblySinglePin::ConnectTrackShoes(bool ccw) {
+    if (!m_chain) {
+        ChTrackAssembly::ConnectTrackShoes(ccw);
+        return;
+    }
+
+    ChSystem* system = m_shoes[0]->GetShoeBody()->GetSystem();
+    if (system->GetContactMethod() != ChMaterialSurfaceBase::DEM)
+        throw ChException("The reduced-order track chain requires DEM contact");
+
+    size_t num_shoes = m_shoes.size();
+    std::vector<std::shared_ptr<ChBody>> shoes(num_shoes);
+    for (size_t i = 0; i < num_shoes; ++i)
+        shoes[i] = m_shoes[ccw ? i : (num_shoes - i) % num_shoes]->GetShoeBody();
+
+    m_chain->Initialize(shoes, m_shoes[0]->GetPitch());
+    system->AddOtherPhysicsItem(m_chain);
+}
+
 // -----------------------------------------------------------------------------
 // Assemble track shoes over wheels.
 //
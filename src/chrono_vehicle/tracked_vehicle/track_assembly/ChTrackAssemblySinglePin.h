@@ -28,6 +28,7 @@
 #include "chrono_vehicle/ChApiVehicle.h"
 #include "chrono_vehicle/tracked_vehicle/ChTrackAssembly.h"
 #include "chrono_vehicle/tracked_vehicle/sprocket/ChSprocketSinglePin.h"
+#include "chrono_vehicle/tracked_vehicle/track_assembly/ChTrackChainSinglePin.h"
 #include "chrono_vehicle/tracked_vehicle/track_shoe/ChTrackShoeSinglePin.h"
 
 namespace chrono {
@@ -58,15 +59,33 @@ class CH_VEHICLE_API ChTrackAssemblySinglePin : public ChTrackAssembly {
     /// Get a handle to the specified track shoe subsystem.
     virtual std::shared_ptr<ChTrackShoe> GetTrackShoe(size_t id) const override { return m_shoes[id]; }
 
+    /// Connect the track shoes through a single reduced-order chain item instead of
+    /// individual shoe-to-shoe joints (see ChTrackChainSinglePin).
+    /// Must be called before Initialize(). The reduced chain requires smooth (DEM)
+    /// contact; Initialize() throws a ChException for a DVI system.
+    void EnableReducedChain(double k_lin,  ///< translational pin stiffness [N/m]
+                            double c_lin,  ///< translational pin damping [N s/m]
+                            double k_rot,  ///< rotational pin stiffness [N m/rad]
+                            double c_rot   ///< rotational pin damping [N m s/rad]
+                            );
+
+    /// Get a handle to the reduced-order track chain.
+    /// Returns an empty pointer if the track shoes are connected with joints.
+    std::shared_ptr<ChTrackChainSinglePin> GetReducedChain() const { return m_chain; }
+
   protected:
     std::shared_ptr<ChSprocketSinglePin> m_sprocket;  ///< sprocket subsystem
     ChTrackShoeSinglePinList m_shoes;                 ///< track shoes
+    std::shared_ptr<ChTrackChainSinglePin> m_chain;   ///< reduced-order chain (if enabled)
 
   private:
     /// Assemble track shoes over wheels.
     /// Return true if the track shoes were initialized in a counter clockwise
     /// direction and false otherwise.
     virtual bool Assemble(std::shared_ptr<ChBodyAuxRef> chassis) override;
+
+    /// Connect the track shoes, with joints or through the reduced-order chain.
+    virtual void ConnectTrackShoes(bool ccw) override;
 };
 
 /// @} vehicle_tracked
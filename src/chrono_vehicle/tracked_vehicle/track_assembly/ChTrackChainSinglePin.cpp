@@ -0,0 +1,419 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Reduced-order connection of the track shoes of a single-pin track assembly.
+//
+// Each shoe has 6 velocity unknowns (linear velocity and angular velocity, both
+// in the global frame). Each pin i, between shoes a = i and b = i+1, has 6 rows:
+// the separation d of the pin points and the misalignment e of the pin axes.
+// With r_a, r_b the pin points relative to the shoe centers and P the projector
+// orthogonal to the pin axis, the pin velocity Jacobians are
+//     J_a = [ -I  [r_a]x ]      J_b = [ I  -[r_b]x ]
+//           [  0   -P    ]            [ 0    P     ]
+// One linearly implicit Euler step of the chain, under the current applied and
+// contact forces f on the shoes, gives
+//     (M + J^T (h*C + h^2*K) J) dv = h (f + J^T lambda)
+// with lambda = -K (g + h*J*v) - C*J*v the pin forces at the current state. The
+// matrix is block tridiagonal with one 6x6 block per shoe, plus the two corner
+// blocks that close the chain. It is solved as a block tridiagonal system over
+// the first n-1 shoes, bordered by the last shoe. The pin forces applied to the
+// shoes are then J^T phi, with phi = lambda - (C + h*K) J dv.
+//
+// =============================================================================
+
+#include <cassert>
+#include <cmath>
+
+#include "chrono/physics/ChContactContainerBase.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_vehicle/tracked_vehicle/track_assembly/ChTrackChainSinglePin.h"
+
+namespace chrono {
+namespace vehicle {
+
+// -----------------------------------------------------------------------------
+// Dense kernels for 6x6 blocks, stored row-major.
+// -----------------------------------------------------------------------------
+
+// In-place Cholesky factorization (lower triangle) of a symmetric positive definite 6x6 matrix.
+static void Cholesky6(double* A) {
+    for (int j = 0; j < 6; j++) {
+        double d = A[6 * j + j];
+        for (int k = 0; k < j; k++)
+            d -= A[6 * j + k] * A[6 * j + k];
+        d = std::sqrt(d);
+        A[6 * j + j] = d;
+        for (int i = j + 1; i < 6; i++) {
+            double s = A[6 * i + j];
+            for (int k = 0; k < j; k++)
+                s -= A[6 * i + k] * A[6 * j + k];
+            A[6 * i + j] = s / d;
+        }
+    }
+}
+
+// Solve L L^T X = B in place, with B a 6 x ncol matrix.
+static void CholeskySolve6(const double* L, double* B, int ncol) {
+    for (int c = 0; c < ncol; c++) {
+        for (int i = 0; i < 6; i++) {
+            double s = B[ncol * i + c];
+            for (int k = 0; k < i; k++)
+                s -= L[6 * i + k] * B[ncol * k + c];
+            B[ncol * i + c] = s / L[6 * i + i];
+        }
+        for (int i = 5; i >= 0; i--) {
+            double s = B[ncol * i + c];
+            for (int k = i + 1; k < 6; k++)
+                s -= L[6 * k + i] * B[ncol * k + c];
+            B[ncol * i + c] = s / L[6 * i + i];
+        }
+    }
+}
+
+// C -= A^T B, with A 6x6 and B, C 6 x ncol.
+static void SubtractAtB(const double* A, const double* B, double* C, int ncol) {
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < ncol; j++) {
+            double s = 0;
+            for (int k = 0; k < 6; k++)
+                s += A[6 * k + i] * B[ncol * k + j];
+            C[ncol * i + j] -= s;
+        }
+}
+
+// C -= A B, with A 6x6 and B, C 6 x ncol.
+static void SubtractAB(const double* A, const double* B, double* C, int ncol) {
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < ncol; j++) {
+            double s = 0;
+            for (int k = 0; k < 6; k++)
+                s += A[6 * i + k] * B[ncol * k + j];
+            C[ncol * i + j] -= s;
+        }
+}
+
+// C += X^T Y, with X, Y, C 6x6.
+static void AddXtY(const double* X, const double* Y, double* C) {
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < 6; j++) {
+            double s = 0;
+            for (int k = 0; k < 6; k++)
+                s += X[6 * k + i] * Y[6 * k + j];
+            C[6 * i + j] += s;
+        }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+ChTrackChainSinglePin::ChTrackChainSinglePin()
+    : m_pitch(0), m_k_lin(1e8), m_c_lin(1e5), m_k_rot(1e5), m_c_rot(1e2) {}
+
+void ChTrackChainSinglePin::SetPinParameters(double k_lin, double c_lin, double k_rot, double c_rot) {
+    m_k_lin = k_lin;
+    m_c_lin = c_lin;
+    m_k_rot = k_rot;
+    m_c_rot = c_rot;
+}
+
+void ChTrackChainSinglePin::Initialize(const std::vector<std::shared_ptr<ChBody>>& shoes, double pitch) {
+    assert(shoes.size() >= 3);
+
+    m_shoes = shoes;
+    m_pitch = pitch;
+
+    size_t n = m_shoes.size();
+    m_force.assign(n, VNULL);
+    m_torque.assign(n, VNULL);
+    m_pin_force.assign(n, VNULL);
+}
+
+// -----------------------------------------------------------------------------
+// Pin forces from one linearly implicit Euler step of the chain.
+// -----------------------------------------------------------------------------
+void ChTrackChainSinglePin::ComputeForces() {
+    int n = (int)m_shoes.size();
+    if (n < 3)
+        return;
+
+    double h = GetSystem()->GetStep();
+    double w_lin = h * m_c_lin + h * h * m_k_lin;
+    double w_rot = h * m_c_rot + h * h * m_k_rot;
+
+    // Work arrays: diagonal blocks (n), upper blocks A(i,i+1) (n, the last one
+    // being A(n-1,0)), pin Jacobians (2 per pin), pin forces lambda (6 per pin),
+    // right-hand sides and the 6x7 block solution of the bordered system (n).
+    m_work.assign(36 * n * 4 + 6 * n + 6 * n + 42 * n + 36 * n, 0.0);
+    double* D = &m_work[0];
+    double* U = D + 36 * n;
+    double* Ja = U + 36 * n;
+    double* Jb = Ja + 36 * n;
+    double* lambda = Jb + 36 * n;
+    double* r = lambda + 6 * n;
+    double* X = r + 6 * n;
+    double* W = X + 42 * n;
+
+    // Resultant contact forces on the shoes, as already gathered by the contact
+    // container (DEM only: forces at the current configuration).
+    auto contact_container = GetSystem()->GetContactContainer();
+
+    // Mass matrices of the shoes (inertia in the global frame) and right-hand
+    // sides from the applied and contact forces: h * f
+    for (int i = 0; i < n; i++) {
+        const auto& body = m_shoes[i];
+        ChVector<> f = body->Get_Xforce() + contact_container->GetContactableForce(body.get());
+        ChVector<> t = body->TransformDirectionLocalToParent(body->Get_Xtorque()) +
+                       contact_container->GetContactableTorque(body.get());
+        for (int k = 0; k < 3; k++) {
+            r[6 * i + k] = h * f[k];
+            r[6 * i + 3 + k] = h * t[k];
+        }
+
+        const ChMatrix33<>& A = body->GetA();
+        const ChMatrix33<>& J = body->GetInertia();
+        double* Di = D + 36 * i;
+        for (int k = 0; k < 3; k++)
+            Di[6 * k + k] = body->GetMass();
+        for (int k = 0; k < 3; k++)
+            for (int l = 0; l < 3; l++) {
+                double s = 0;
+                for (int p = 0; p < 3; p++)
+                    for (int q = 0; q < 3; q++)
+                        s += A(k, p) * J(p, q) * A(l, q);
+                Di[6 * (3 + k) + 3 + l] = s;
+            }
+    }
+
+    // Pin contributions
+    for (int i = 0; i < n; i++) {
+        int a = i;
+        int b = (i + 1) % n;
+        const auto& body_a = m_shoes[a];
+        const auto& body_b = m_shoes[b];
+
+        ChVector<> r_a = body_a->GetA().Get_A_Xaxis() * (m_pitch / 2);
+        ChVector<> r_b = body_b->GetA().Get_A_Xaxis() * (-m_pitch / 2);
+        ChVector<> y_a = body_a->GetA().Get_A_Yaxis();
+        ChVector<> y_b = body_b->GetA().Get_A_Yaxis();
+        ChVector<> y = (y_a + y_b).GetNormalized();
+
+        double P[3][3];
+        for (int k = 0; k < 3; k++)
+            for (int l = 0; l < 3; l++)
+                P[k][l] = (k == l ? 1.0 : 0.0) - y[k] * y[l];
+
+        // Jacobians J_a and J_b
+        double* Jai = Ja + 36 * i;
+        double* Jbi = Jb + 36 * i;
+        double Ra[3][3] = {{0, -r_a.z(), r_a.y()}, {r_a.z(), 0, -r_a.x()}, {-r_a.y(), r_a.x(), 0}};
+        double Rb[3][3] = {{0, -r_b.z(), r_b.y()}, {r_b.z(), 0, -r_b.x()}, {-r_b.y(), r_b.x(), 0}};
+        for (int k = 0; k < 3; k++) {
+            Jai[6 * k + k] = -1;
+            Jbi[6 * k + k] = 1;
+            for (int l = 0; l < 3; l++) {
+                Jai[6 * k + 3 + l] = Ra[k][l];
+                Jbi[6 * k + 3 + l] = -Rb[k][l];
+                Jai[6 * (3 + k) + 3 + l] = -P[k][l];
+                Jbi[6 * (3 + k) + 3 + l] = P[k][l];
+            }
+        }
+
+        // Pin violation and its rate
+        ChVector<> d = (body_b->GetPos() + r_b) - (body_a->GetPos() + r_a);
+        ChVector<> e = Vcross(y_a, y_b);
+        ChVector<> d_dt = (body_b->GetPos_dt() + Vcross(body_b->GetWvel_par(), r_b)) -
+                          (body_a->GetPos_dt() + Vcross(body_a->GetWvel_par(), r_a));
+        ChVector<> w_rel = body_b->GetWvel_par() - body_a->GetWvel_par();
+
+        // Pin forces at the current state, with the stiffness term evaluated at the
+        // end of the step: lambda = -K (g + h*g_dt) - C*g_dt
+        double* li = lambda + 6 * i;
+        for (int k = 0; k < 3; k++) {
+            double e_dt = 0;
+            double e_proj = 0;
+            for (int l = 0; l < 3; l++) {
+                e_dt += P[k][l] * w_rel[l];
+                e_proj += P[k][l] * e[l];
+            }
+            li[k] = -m_k_lin * (d[k] + h * d_dt[k]) - m_c_lin * d_dt[k];
+            li[3 + k] = -m_k_rot * (e_proj + h * e_dt) - m_c_rot * e_dt;
+        }
+
+        // Right-hand sides: h * J^T lambda
+        double* ra = r + 6 * a;
+        double* rb = r + 6 * b;
+        for (int k = 0; k < 6; k++) {
+            double sa = 0;
+            double sb = 0;
+            for (int l = 0; l < 6; l++) {
+                sa += Jai[6 * l + k] * li[l];
+                sb += Jbi[6 * l + k] * li[l];
+            }
+            ra[k] += h * sa;
+            rb[k] += h * sb;
+        }
+
+        // Matrix blocks: J^T (h*C + h^2*K) J. The weights are w_lin on the
+        // translational rows and w_rot * P on the rotational rows; the rotational
+        // rows of J are already projected with P, so a scalar weight suffices.
+        double WJa[36];
+        double WJb[36];
+        for (int k = 0; k < 3; k++)
+            for (int l = 0; l < 6; l++) {
+                WJa[6 * k + l] = w_lin * Jai[6 * k + l];
+                WJb[6 * k + l] = w_lin * Jbi[6 * k + l];
+                WJa[6 * (3 + k) + l] = w_rot * Jai[6 * (3 + k) + l];
+                WJb[6 * (3 + k) + l] = w_rot * Jbi[6 * (3 + k) + l];
+            }
+        AddXtY(Jai, WJa, D + 36 * a);
+        AddXtY(Jbi, WJb, D + 36 * b);
+        AddXtY(Jai, WJb, U + 36 * i);
+    }
+
+    // Bordered system: the block tridiagonal part T over shoes 0..m-1 (m = n-1),
+    // coupled to the last shoe through the columns C. Right-hand sides of T are
+    // the 6 columns of C and r, stored as a 6x7 block per shoe.
+    int m = n - 1;
+    const double* U_last = U + 36 * (n - 1);  // A(n-1,0)
+    const double* U_prev = U + 36 * (n - 2);  // A(n-2,n-1)
+    for (int i = 0; i < m; i++) {
+        double* Xi = X + 42 * i;
+        for (int k = 0; k < 6; k++)
+            Xi[7 * k + 6] = r[6 * i + k];
+    }
+    for (int k = 0; k < 6; k++)
+        for (int l = 0; l < 6; l++) {
+            X[7 * k + l] += U_last[6 * l + k];           // A(0,n-1) = A(n-1,0)^T
+            X[42 * (m - 1) + 7 * k + l] += U_prev[6 * k + l];  // A(n-2,n-1)
+        }
+
+    // Forward elimination: D'_i = D_i - U_{i-1}^T D'_{i-1}^-1 U_{i-1}, with
+    // W_{i-1} = D'_{i-1}^-1 U_{i-1}, and the matching update of the right-hand sides.
+    for (int i = 0; i < m; i++) {
+        double* Di = D + 36 * i;
+        double* Xi = X + 42 * i;
+        if (i > 0) {
+            SubtractAtB(U + 36 * (i - 1), W + 36 * (i - 1), Di, 6);
+            SubtractAtB(U + 36 * (i - 1), X + 42 * (i - 1), Xi, 7);
+        }
+        Cholesky6(Di);
+        CholeskySolve6(Di, Xi, 7);
+        if (i < m - 1) {
+            double* Wi = W + 36 * i;
+            for (int k = 0; k < 36; k++)
+                Wi[k] = U[36 * i + k];
+            CholeskySolve6(Di, Wi, 6);
+        }
+    }
+
+    // Back substitution: X_i -= W_i X_{i+1}
+    for (int i = m - 2; i >= 0; i--)
+        SubtractAB(W + 36 * i, X + 42 * (i + 1), X + 42 * i, 7);
+
+    // Schur complement for the last shoe: S = D_last - C^T Y, s = r_last - C^T z
+    double* S = D + 36 * (n - 1);
+    double CtX[42] = {0};
+    for (int k = 0; k < 6; k++)
+        for (int l = 0; l < 7; l++) {
+            double s = 0;
+            for (int p = 0; p < 6; p++)
+                s += U_last[6 * k + p] * X[7 * p + l] + U_prev[6 * p + k] * X[42 * (m - 1) + 7 * p + l];
+            CtX[7 * k + l] = s;
+        }
+    double dv_last[6];
+    for (int k = 0; k < 6; k++) {
+        for (int l = 0; l < 6; l++)
+            S[6 * k + l] -= CtX[7 * k + l];
+        dv_last[k] = r[6 * (n - 1) + k] - CtX[7 * k + 6];
+    }
+    Cholesky6(S);
+    CholeskySolve6(S, dv_last, 1);
+
+    // Velocity increments of all shoes (stored in place of r)
+    double* dv = r;
+    for (int i = 0; i < m; i++) {
+        const double* Xi = X + 42 * i;
+        for (int k = 0; k < 6; k++) {
+            double s = Xi[7 * k + 6];
+            for (int l = 0; l < 6; l++)
+                s -= Xi[7 * k + l] * dv_last[l];
+            dv[6 * i + k] = s;
+        }
+    }
+    for (int k = 0; k < 6; k++)
+        dv[6 * (n - 1) + k] = dv_last[k];
+
+    // Effective pin forces, phi = lambda - (C + h*K) J dv, and shoe forces J^T phi
+    for (int i = 0; i < n; i++) {
+        m_force[i] = VNULL;
+        m_torque[i] = VNULL;
+    }
+    for (int i = 0; i < n; i++) {
+        int a = i;
+        int b = (i + 1) % n;
+        const double* Jai = Ja + 36 * i;
+        const double* Jbi = Jb + 36 * i;
+        const double* li = lambda + 6 * i;
+        double phi[6];
+        for (int k = 0; k < 6; k++) {
+            double s = 0;
+            for (int l = 0; l < 6; l++)
+                s += Jai[6 * k + l] * dv[6 * a + l] + Jbi[6 * k + l] * dv[6 * b + l];
+            phi[k] = li[k] - (k < 3 ? w_lin : w_rot) / h * s;
+        }
+        for (int k = 0; k < 6; k++) {
+            double fa = 0;
+            double fb = 0;
+            for (int l = 0; l < 6; l++) {
+                fa += Jai[6 * l + k] * phi[l];
+                fb += Jbi[6 * l + k] * phi[l];
+            }
+            if (k < 3) {
+                m_force[a][k] += fa;
+                m_force[b][k] += fb;
+            } else {
+                m_torque[a][k - 3] += fa;
+                m_torque[b][k - 3] += fb;
+            }
+        }
+        m_pin_force[i] = ChVector<>(phi[0], phi[1], phi[2]);
+    }
+
+    // Torques are applied in the shoe local frames
+    for (int i = 0; i < n; i++)
+        m_torque[i] = m_shoes[i]->TransformDirectionParentToLocal(m_torque[i]);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChTrackChainSinglePin::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
+    ComputeForces();
+
+    for (size_t i = 0; i < m_shoes.size(); i++) {
+        if (!m_shoes[i]->Variables().IsActive())
+            continue;
+        R.PasteSumVector(m_force[i] * c, m_shoes[i]->Variables().GetOffset(), 0);
+        R.PasteSumVector(m_torque[i] * c, m_shoes[i]->Variables().GetOffset() + 3, 0);
+    }
+}
+
+void ChTrackChainSinglePin::VariablesFbLoadForces(double factor) {
+    ComputeForces();
+
+    for (size_t i = 0; i < m_shoes.size(); i++) {
+        m_shoes[i]->Variables().Get_fb().PasteSumVector(m_force[i] * factor, 0, 0);
+        m_shoes[i]->Variables().Get_fb().PasteSumVector(m_torque[i] * factor, 3, 0);
+    }
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
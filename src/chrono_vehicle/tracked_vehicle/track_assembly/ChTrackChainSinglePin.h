@@ -0,0 +1,120 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Reduced-order connection of the track shoes of a single-pin track assembly.
+//
+// =============================================================================
+
+#ifndef CH_TRACK_CHAIN_SINGLE_PIN_H
+#define CH_TRACK_CHAIN_SINGLE_PIN_H
+
+#include <vector>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChPhysicsItem.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_tracked
+/// @{
+
+/// Reduced-order connection of the track shoes of a single-pin track assembly.
+///
+/// This physics item replaces the shoe-to-shoe revolute joints of a closed chain
+/// of single-pin track shoes with stiff visco-elastic pins, all handled by this one
+/// item. Each pin resists the separation of the two pin points (at +pitch/2 on a
+/// shoe and -pitch/2 on the next one) and the misalignment of the two pin axes
+/// (the shoe Y axes), but not the rotation about the pin axis.
+///
+/// The pin forces are evaluated with a linearly implicit (backward Euler) update
+/// of the chain alone over the current integration step. The resulting linear
+/// system, M + h*D + h^2*K, is block tridiagonal and cyclic along the chain (one
+/// 6x6 block per shoe) and is solved directly at each step, at a cost linear in the
+/// number of track shoes. The pins therefore introduce no bilateral constraints in
+/// the system descriptor and can be very stiff even with the default iterative
+/// solvers. The applied and contact forces on the shoes (gravity, ground, wheels,
+/// sprocket) enter this update as known loads, so that the chain distributes them
+/// within the same step, as the joints would; they reach the shoe bodies as usual.
+/// The contact forces are those already gathered by the contact container, which with
+/// DEM contact are the forces at the current configuration (gathered by the system
+/// after collision detection). The chain is therefore restricted to DEM contact: with
+/// DVI, only the reactions of the previous step would be available.
+class CH_VEHICLE_API ChTrackChainSinglePin : public ChPhysicsItem {
+  public:
+    ChTrackChainSinglePin();
+    ~ChTrackChainSinglePin() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChTrackChainSinglePin* Clone() const override { return new ChTrackChainSinglePin(*this); }
+
+    /// Set the pin stiffness and damping.
+    /// The translational coefficients act on the separation of the pin points; the
+    /// rotational coefficients act on the misalignment of the pin axes.
+    void SetPinParameters(double k_lin,  ///< translational stiffness [N/m]
+                          double c_lin,  ///< translational damping [N s/m]
+                          double k_rot,  ///< rotational stiffness [N m/rad]
+                          double c_rot   ///< rotational damping [N m s/rad]
+                          );
+
+    /// Initialize the chain with the specified shoe bodies, in connection order.
+    /// Shoe i is connected at its pin point (+pitch/2, 0, 0) to the pin point
+    /// (-pitch/2, 0, 0) of shoe i+1; the last shoe is connected to the first.
+    void Initialize(const std::vector<std::shared_ptr<ChBody>>& shoes,  ///< [in] shoe bodies
+                    double pitch                                        ///< [in] track shoe pitch
+                    );
+
+    /// Get the number of shoes in the chain.
+    size_t GetNumShoes() const { return m_shoes.size(); }
+
+    /// Get the force at the pin between shoe i and shoe i+1, as applied to shoe i+1
+    /// (expressed in the global frame), from the last force evaluation.
+    ChVector<> GetPinForce(size_t i) const { return m_pin_force[i]; }
+
+    // STATE FUNCTIONS
+
+    virtual void IntLoadResidual_F(const unsigned int off,  ///< offset in R residual
+                                   ChVectorDynamic<>& R,    ///< result: the R residual, R += c*F
+                                   const double c           ///< a scaling factor
+                                   ) override;
+
+    // SOLVER INTERFACE
+
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+
+  private:
+    /// Evaluate the pin forces on all shoes at the current state.
+    void ComputeForces();
+
+    std::vector<std::shared_ptr<ChBody>> m_shoes;  ///< shoe bodies, in connection order
+    double m_pitch;                                ///< track shoe pitch
+
+    double m_k_lin;  ///< translational pin stiffness
+    double m_c_lin;  ///< translational pin damping
+    double m_k_rot;  ///< rotational pin stiffness
+    double m_c_rot;  ///< rotational pin damping
+
+    std::vector<ChVector<>> m_force;      ///< pin forces on each shoe (global frame)
+    std::vector<ChVector<>> m_torque;     ///< pin torques on each shoe (shoe local frame)
+    std::vector<ChVector<>> m_pin_force;  ///< force at each pin
+
+    std::vector<double> m_work;  ///< work space for the block solve
+};
+
+/// @} vehicle_tracked
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
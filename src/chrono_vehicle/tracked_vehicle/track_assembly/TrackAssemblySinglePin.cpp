@@ -33,7 +33,7 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -53,15 +53,8 @@ static ChVector<> loadVector(const Value& a) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackAssemblySinglePin::LoadSprocket(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a sprocket specification file.
     assert(d.HasMember("Type"));
@@ -82,15 +75,8 @@ void TrackAssemblySinglePin::LoadSprocket(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackAssemblySinglePin::LoadBrake(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a brake specification file.
     assert(d.HasMember("Type"));
@@ -112,15 +98,8 @@ void TrackAssemblySinglePin::LoadBrake(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackAssemblySinglePin::LoadIdler(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is an idler specification file.
     assert(d.HasMember("Type"));
@@ -144,15 +123,8 @@ void TrackAssemblySinglePin::LoadIdler(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackAssemblySinglePin::LoadSuspension(const std::string& filename, int which, bool has_shock) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a road-wheel assembly specification file.
     assert(d.HasMember("Type"));
@@ -174,15 +146,8 @@ void TrackAssemblySinglePin::LoadSuspension(const std::string& filename, int whi
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackAssemblySinglePin::LoadRoller(const std::string& filename, int which) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a roller specification file.
     assert(d.HasMember("Type"));
@@ -204,15 +169,8 @@ void TrackAssemblySinglePin::LoadRoller(const std::string& filename, int which)
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackAssemblySinglePin::LoadTrackShoes(const std::string& filename, int num_shoes) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a track shoe specification file.
     assert(d.HasMember("Type"));
@@ -235,15 +193,8 @@ void TrackAssemblySinglePin::LoadTrackShoes(const std::string& filename, int num
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 TrackAssemblySinglePin::TrackAssemblySinglePin(const std::string& filename) : ChTrackAssemblySinglePin("", LEFT) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     Create(d);
 
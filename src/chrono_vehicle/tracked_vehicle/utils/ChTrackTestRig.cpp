@@ -38,7 +38,7 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -106,15 +106,8 @@ ChTrackTestRig::ChTrackTestRig(const std::string& filename,
                                ChMaterialSurfaceBase::ContactMethod contact_method)
     : ChVehicle(contact_method), m_location(location), m_max_torque(0) {
     // Open and parse the input file (track assembly JSON specification file)
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Read top-level data
     assert(d.HasMember("Type"));
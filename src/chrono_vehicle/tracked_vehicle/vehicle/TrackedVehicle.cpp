@@ -33,7 +33,7 @@
 #include "chrono_vehicle/tracked_vehicle/driveline/SimpleTrackDriveline.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -59,15 +59,8 @@ static ChQuaternion<> loadQuaternion(const Value& a) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackedVehicle::LoadChassis(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a chassis specification file.
     assert(d.HasMember("Type"));
@@ -89,15 +82,8 @@ void TrackedVehicle::LoadChassis(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackedVehicle::LoadTrackAssembly(const std::string& filename, VehicleSide side) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a steering specification file.
     assert(d.HasMember("Type"));
@@ -121,15 +107,8 @@ void TrackedVehicle::LoadTrackAssembly(const std::string& filename, VehicleSide
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void TrackedVehicle::LoadDriveline(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a driveline specification file.
     assert(d.HasMember("Type"));
@@ -165,15 +144,8 @@ void TrackedVehicle::Create(const std::string& filename) {
     // -------------------------------------------
     // Open and parse the input file
     // -------------------------------------------
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Read top-level data
     assert(d.HasMember("Type"));
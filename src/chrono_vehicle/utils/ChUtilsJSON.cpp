@@ -0,0 +1,217 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Utility functions for reading the JSON specification files of vehicles and
+// vehicle subsystems.
+//
+// The binary image of a parsed document is the sequence of its SAX events:
+// a one-byte tag, followed by the value (numbers), the length and characters
+// (strings and keys), or the number of members/elements (end of objects and
+// arrays). The document is rebuilt by replaying the events.
+//
+// =============================================================================
+
+#include <cstdio>
+
+#include "chrono/core/ChLog.h"
+#include "chrono/core/ChModelCache.h"
+
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
+
+#include "chrono_thirdparty/rapidjson/filereadstream.h"
+
+using namespace rapidjson;
+
+namespace chrono {
+namespace vehicle {
+
+namespace {
+
+enum EventTag : char {
+    TAG_NULL,
+    TAG_FALSE,
+    TAG_TRUE,
+    TAG_INT,
+    TAG_UINT,
+    TAG_INT64,
+    TAG_UINT64,
+    TAG_DOUBLE,
+    TAG_STRING,
+    TAG_KEY,
+    TAG_START_OBJECT,
+    TAG_END_OBJECT,
+    TAG_START_ARRAY,
+    TAG_END_ARRAY
+};
+
+// SAX handler writing the events to a binary image
+class ImageWriter {
+  public:
+    ImageWriter(ChModelImageOut& image) : m_image(image) {}
+
+    bool Null() { return Tag(TAG_NULL); }
+    bool Bool(bool b) { return Tag(b ? TAG_TRUE : TAG_FALSE); }
+    bool Int(int i) { return Value(TAG_INT, i); }
+    bool Uint(unsigned u) { return Value(TAG_UINT, u); }
+    bool Int64(int64_t i) { return Value(TAG_INT64, i); }
+    bool Uint64(uint64_t u) { return Value(TAG_UINT64, u); }
+    bool Double(double d) { return Value(TAG_DOUBLE, d); }
+    bool RawNumber(const char* str, SizeType length, bool copy) { return String(str, length, copy); }
+    bool String(const char* str, SizeType length, bool copy) { return Text(TAG_STRING, str, length); }
+    bool Key(const char* str, SizeType length, bool copy) { return Text(TAG_KEY, str, length); }
+    bool StartObject() { return Tag(TAG_START_OBJECT); }
+    bool EndObject(SizeType count) { return Value(TAG_END_OBJECT, count); }
+    bool StartArray() { return Tag(TAG_START_ARRAY); }
+    bool EndArray(SizeType count) { return Value(TAG_END_ARRAY, count); }
+
+  private:
+    bool Tag(char tag) {
+        m_image.Write(tag);
+        return true;
+    }
+    template <class T>
+    bool Value(char tag, T value) {
+        m_image.Write(tag);
+        m_image.Write(value);
+        return true;
+    }
+    bool Text(char tag, const char* str, SizeType length) {
+        m_image.Write(tag);
+        m_image.Write(length);
+        m_image.WriteBytes(str, length);
+        return true;
+    }
+
+    ChModelImageOut& m_image;
+};
+
+// Generator replaying the events of a binary image (see GenericDocument::Populate)
+class ImageReader {
+  public:
+    ImageReader(const char* data, size_t size) : m_image(data, size) {}
+
+    template <typename Handler>
+    bool operator()(Handler& handler) {
+        char tag;
+        while (m_image.Read(tag)) {
+            bool ok = false;
+            switch (tag) {
+                case TAG_NULL:
+                    ok = handler.Null();
+                    break;
+                case TAG_FALSE:
+                    ok = handler.Bool(false);
+                    break;
+                case TAG_TRUE:
+                    ok = handler.Bool(true);
+                    break;
+                case TAG_INT: {
+                    int i;
+                    ok = m_image.Read(i) && handler.Int(i);
+                    break;
+                }
+                case TAG_UINT: {
+                    unsigned u;
+                    ok = m_image.Read(u) && handler.Uint(u);
+                    break;
+                }
+                case TAG_INT64: {
+                    int64_t i;
+                    ok = m_image.Read(i) && handler.Int64(i);
+                    break;
+                }
+                case TAG_UINT64: {
+                    uint64_t u;
+                    ok = m_image.Read(u) && handler.Uint64(u);
+                    break;
+                }
+                case TAG_DOUBLE: {
+                    double d;
+                    ok = m_image.Read(d) && handler.Double(d);
+                    break;
+                }
+                case TAG_STRING:
+                case TAG_KEY: {
+                    SizeType length;
+                    const char* str = m_image.Read(length) ? m_image.ReadBytes(length) : NULL;
+                    if (str)
+                        ok = (tag == TAG_KEY) ? handler.Key(str, length, true) : handler.String(str, length, true);
+                    break;
+                }
+                case TAG_START_OBJECT:
+                    ok = handler.StartObject();
+                    break;
+                case TAG_START_ARRAY:
+                    ok = handler.StartArray();
+                    break;
+                case TAG_END_OBJECT:
+                case TAG_END_ARRAY: {
+                    SizeType count;
+                    if (m_image.Read(count))
+                        ok = (tag == TAG_END_OBJECT) ? handler.EndObject(count) : handler.EndArray(count);
+                    break;
+                }
+            }
+            if (!ok)
+                return false;
+        }
+        return m_image.IsAtEnd();
+    }
+
+  private:
+    ChModelImageIn m_image;
+};
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ReadFileJSON(const std::string& filename, Document& d) {
+    // Rebuild the document from the cached image, if any
+    std::string key;
+    bool cached = ChModelCache::IsEnabled() && ChModelCache::GetKey(filename, "json", "", key);
+    if (cached) {
+        if (auto file = ChModelCache::Load(key)) {
+            ImageReader reader(file->GetData(), file->GetSize());
+            d.Populate(reader);
+            if (!d.IsNull())
+                return;
+        }
+    }
+
+    FILE* fp = fopen(filename.c_str(), "r");
+    if (!fp) {
+        GetLog() << "Error: cannot open JSON file " << filename.c_str() << "\n";
+        d.SetNull();
+        return;
+    }
+
+    char readBuffer[65536];
+    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    fclose(fp);
+
+    if (d.HasParseError()) {
+        GetLog() << "Error: invalid JSON file " << filename.c_str() << "\n";
+        return;
+    }
+
+    if (cached) {
+        ChModelImageOut image;
+        ImageWriter writer(image);
+        d.Accept(writer);
+        ChModelCache::Store(key, image);
+    }
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,44 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Utility functions for reading the JSON specification files of vehicles and
+// vehicle subsystems.
+//
+// =============================================================================
+
+#ifndef CH_UTILS_JSON_H
+#define CH_UTILS_JSON_H
+
+#include <string>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+#include "chrono_thirdparty/rapidjson/document.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_utils
+/// @{
+
+/// Load and parse the specified JSON file (comments are allowed).
+/// If the ChModelCache is enabled, the parsed document is cached as a compact binary image,
+/// which is used instead of the file in subsequent runs (as long as the file does not change).
+/// On error, a message is printed and the document is left empty.
+CH_VEHICLE_API void ReadFileJSON(const std::string& filename, rapidjson::Document& d);
+
+/// @} vehicle_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
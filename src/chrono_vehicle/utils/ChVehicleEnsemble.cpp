@@ -0,0 +1,187 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batch runner for many independent vehicle simulations in a single process.
+//
+// The members of the ensemble are distributed dynamically over a pool of
+// std::thread workers: each worker repeatedly claims the next member through an
+// atomic counter and simulates it to completion.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "chrono/core/ChException.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+#include "chrono_vehicle/utils/ChVehicleEnsemble.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
+
+using namespace rapidjson;
+
+namespace chrono {
+namespace vehicle {
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+ChVehicleEnsemble::ChVehicleEnsemble() : m_wall_time(0), m_sim_time(0), m_num_steps(0) {
+    m_num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+// -----------------------------------------------------------------------------
+// Shared read-only data.
+// The first request for a file inserts a future in the cache and loads the file
+// outside the lock; concurrent requests for the same file wait on that future.
+// If the file cannot be read, the waiting requests get the exception and the
+// entry is removed from the cache, so that a later request tries again.
+// -----------------------------------------------------------------------------
+std::shared_ptr<const Document> ChVehicleEnsemble::GetJSON(const std::string& filename) {
+    std::promise<std::shared_ptr<const Document>> promise;
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        auto it = m_json_cache.find(filename);
+        if (it != m_json_cache.end())
+            return it->second.get();
+        m_json_cache[filename] = promise.get_future().share();
+    }
+
+    auto d = std::make_shared<Document>();
+    ReadFileJSON(filename, *d);
+    if (d->IsNull() || d->HasParseError()) {
+        auto error = std::make_exception_ptr(ChException("Cannot read JSON file " + filename));
+        {
+            std::lock_guard<std::mutex> lock(m_cache_mutex);
+            m_json_cache.erase(filename);
+        }
+        promise.set_exception(error);
+        std::rethrow_exception(error);
+    }
+
+    promise.set_value(d);
+    return d;
+}
+
+std::shared_ptr<const geometry::ChTriangleMeshConnected> ChVehicleEnsemble::GetMesh(const std::string& filename) {
+    std::promise<std::shared_ptr<const geometry::ChTriangleMeshConnected>> promise;
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        auto it = m_mesh_cache.find(filename);
+        if (it != m_mesh_cache.end())
+            return it->second.get();
+        m_mesh_cache[filename] = promise.get_future().share();
+    }
+
+    // A missing or unreadable file leaves the mesh empty
+    auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
+    std::exception_ptr error;
+    try {
+        trimesh->LoadWavefrontMesh(filename, true, false);
+        if (trimesh->getNumTriangles() == 0)
+            throw ChException("Cannot read mesh file " + filename);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    if (error) {
+        {
+            std::lock_guard<std::mutex> lock(m_cache_mutex);
+            m_mesh_cache.erase(filename);
+        }
+        promise.set_exception(error);
+        std::rethrow_exception(error);
+    }
+
+    promise.set_value(trimesh);
+    return trimesh;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+double ChVehicleEnsemble::RunMember(Member& member, double end_time, double step, long long& num_steps) {
+    member.Initialize(*this);
+
+    double start_time = member.GetVehicle().GetChTime();
+    double time = start_time;
+    while (time < end_time - 1e-10 && !member.Done()) {
+        member.Synchronize(time);
+        member.Advance(step);
+        time = member.GetVehicle().GetChTime();
+        num_steps++;
+    }
+
+    member.Finalize();
+
+    return time - start_time;
+}
+
+void ChVehicleEnsemble::Run(double end_time, double step) {
+    std::atomic<size_t> next(0);
+    std::mutex result_mutex;
+    std::exception_ptr error;
+    double sim_time = 0;
+    long long num_steps = 0;
+
+    auto worker = [&]() {
+        // Each system is advanced by a single thread.
+        CHOMPfunctions::SetNumThreads(1);
+
+        double my_sim_time = 0;
+        long long my_num_steps = 0;
+        size_t i;
+        while ((i = next++) < m_members.size()) {
+            try {
+                my_sim_time += RunMember(*m_members[i], end_time, step, my_num_steps);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(result_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(result_mutex);
+        sim_time += my_sim_time;
+        num_steps += my_num_steps;
+    };
+
+    int num_workers = (int)std::min((size_t)std::max(1, m_num_threads), m_members.size());
+
+    // The calling thread also acts as a worker; restore its OpenMP settings on return.
+    int omp_threads = CHOMPfunctions::GetMaxThreads();
+
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < num_workers; t++)
+        workers.push_back(std::thread(worker));
+    worker();
+    for (auto& w : workers)
+        w.join();
+
+    timer.stop();
+
+    CHOMPfunctions::SetNumThreads(omp_threads);
+
+    m_wall_time = timer();
+    m_sim_time = sim_time;
+    m_num_steps = num_steps;
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,151 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batch runner for many independent vehicle simulations in a single process.
+//
+// =============================================================================
+
+#ifndef CH_VEHICLE_ENSEMBLE_H
+#define CH_VEHICLE_ENSEMBLE_H
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/ChVehicle.h"
+
+#include "chrono_thirdparty/rapidjson/document.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_utils
+/// @{
+
+/// Batch runner for an ensemble of independent vehicle simulations.
+///
+/// Each member of the ensemble owns its own ChSystem, with its vehicle, terrain,
+/// driver and any other subsystems. The members are created, initialized and
+/// advanced to the final time by a pool of worker threads, one member per task:
+/// idle workers take the next unprocessed member, so members of very different
+/// cost are balanced across the pool. Within a worker, the OpenMP parallel
+/// regions of the member (solver, terrain) are run with a single thread.
+///
+/// Read-only data (parsed JSON specification files and triangle meshes) can be
+/// shared between members through GetJSON() and GetMesh(); each file is read
+/// once, no matter how many members request it. Members must only access the
+/// shared data through const methods.
+class CH_VEHICLE_API ChVehicleEnsemble {
+  public:
+    /// Base class for a member of the ensemble.
+    /// A concrete class creates its own vehicle, terrain and driver in
+    /// Initialize() and implements the inter-module communication of one
+    /// simulation step in Synchronize() and Advance(), as done in the main
+    /// loop of a single-vehicle program.
+    class CH_VEHICLE_API Member {
+      public:
+        virtual ~Member() {}
+
+        /// Construct and initialize all subsystems of this member.
+        /// Called from a worker thread; shared data can be obtained from the ensemble.
+        virtual void Initialize(ChVehicleEnsemble& ensemble) = 0;
+
+        /// Return the vehicle of this member (used to query its current time).
+        virtual ChVehicle& GetVehicle() = 0;
+
+        /// Update all subsystems at the current time.
+        virtual void Synchronize(double time) = 0;
+
+        /// Advance the state of all subsystems by the specified time step.
+        virtual void Advance(double step) = 0;
+
+        /// Return true if the simulation of this member should stop before the final time.
+        virtual bool Done() { return false; }
+
+        /// Called once the simulation of this member is over, from the same worker thread.
+        /// A concrete class may collect its results here and release its subsystems.
+        virtual void Finalize() {}
+    };
+
+    ChVehicleEnsemble();
+    ~ChVehicleEnsemble() {}
+
+    /// Add a member to the ensemble.
+    void AddMember(std::shared_ptr<Member> member) { m_members.push_back(member); }
+
+    /// Get the number of members in the ensemble.
+    size_t GetNumMembers() const { return m_members.size(); }
+
+    /// Get the specified member of the ensemble.
+    std::shared_ptr<Member> GetMember(size_t i) const { return m_members[i]; }
+
+    /// Set the number of worker threads (default: number of hardware threads).
+    void SetNumThreads(int num_threads) { m_num_threads = num_threads; }
+
+    /// Get the number of worker threads.
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Return the parsed JSON document for the specified file.
+    /// The file is read and parsed on first request only. Thread safe.
+    /// Throws a ChException if the file cannot be read or parsed.
+    std::shared_ptr<const rapidjson::Document> GetJSON(const std::string& filename);
+
+    /// Return the triangle mesh loaded from the specified Wavefront OBJ file.
+    /// The file is loaded on first request only. Thread safe.
+    /// Throws if the file cannot be read or contains no triangles.
+    std::shared_ptr<const geometry::ChTriangleMeshConnected> GetMesh(const std::string& filename);
+
+    /// Initialize all members and advance each of them, with the specified step
+    /// size, until the final time or until the member reports it is done.
+    void Run(double end_time, double step);
+
+    /// Get the wall-clock time of the last call to Run() (in seconds).
+    double GetWallTime() const { return m_wall_time; }
+
+    /// Get the total simulated time over all members in the last call to Run() (in seconds).
+    double GetSimulatedTime() const { return m_sim_time; }
+
+    /// Get the total number of simulation steps over all members in the last call to Run().
+    long long GetNumSteps() const { return m_num_steps; }
+
+    /// Get the aggregate throughput of the last call to Run(),
+    /// in simulated seconds per wall-clock second.
+    double GetThroughput() const { return m_wall_time > 0 ? m_sim_time / m_wall_time : 0; }
+
+  private:
+    /// Initialize and simulate the specified member; return the simulated time.
+    double RunMember(Member& member, double end_time, double step, long long& num_steps);
+
+    std::vector<std::shared_ptr<Member>> m_members;  ///< members of the ensemble
+    int m_num_threads;                               ///< number of worker threads
+
+    std::mutex m_cache_mutex;  ///< protects the two caches below
+    std::map<std::string, std::shared_future<std::shared_ptr<const rapidjson::Document>>> m_json_cache;
+    std::map<std::string, std::shared_future<std::shared_ptr<const geometry::ChTriangleMeshConnected>>> m_mesh_cache;
+
+    double m_wall_time;      ///< wall-clock time of last run
+    double m_sim_time;       ///< total simulated time in last run
+    long long m_num_steps;   ///< total number of steps in last run
+};
+
+/// @} vehicle_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -71,7 +71,7 @@ class CH_VEHICLE_API ChCosimManager {
                                    const std::vector<ChVector<>>& vert_pos,
                                    const std::vector<ChVector<>>& vert_vel,
                                    const std::vector<ChVector<int>>& triangles) = 0;
-    virtual void OnSendTireForces(int which, std::vector<ChVector<>>& vert_forces, std::vector<int> vert_indeces) = 0;
+    virtual void OnSendTireForces(int which, std::vector<ChVector<>>& vert_forces, std::vector<int>& vert_indeces) = 0;
     virtual void OnAdvanceTerrain() {}
 
     // Functions invoked only on a TIRE node
@@ -84,6 +84,13 @@ class CH_VEHICLE_API ChCosimManager {
 
     void SetVerbose(bool val) { m_verbose = val; }
 
+    /// Enable/disable one-step-lagged coupling between the tire and terrain nodes (default: false).
+    /// With lagged coupling, the tire nodes do not wait for the terrain forces computed at the
+    /// current step, but apply those computed at the previous step. This lets the tire and terrain
+    /// nodes compute concurrently, at the cost of an explicit (lagged) force coupling.
+    /// Must be called before Initialize().
+    void SetLaggedCoupling(bool val) { m_lagged = val; }
+
     bool Initialize();
     void Abort();
 
@@ -94,6 +101,7 @@ class CH_VEHICLE_API ChCosimManager {
     int m_rank;
     int m_num_tires;
     bool m_verbose;
+    bool m_lagged;
 
     ChCosimVehicleNode* m_vehicle_node;
     ChCosimTerrainNode* m_terrain_node;
@@ -17,6 +17,7 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cstdio>
 
 #include "chrono_vehicle/wheeled_vehicle/cosim/ChCosimManager.h"
 #include "chrono_vehicle/wheeled_vehicle/cosim/ChCosimTerrainNode.h"
@@ -25,10 +26,22 @@ namespace chrono {
 namespace vehicle {
 
 ChCosimTerrainNode::ChCosimTerrainNode(int rank, ChSystem* system, ChTerrain* terrain, int num_tires)
-    : ChCosimNode(rank, system), m_terrain(terrain), m_num_tires(num_tires) {}
+    : ChCosimNode(rank, system),
+      m_terrain(terrain),
+      m_num_tires(num_tires),
+      m_triangles(num_tires),
+      m_vert_data(num_tires),
+      m_index_data(num_tires),
+      m_force_data(num_tires),
+      m_vert_requests(num_tires, MPI_REQUEST_NULL),
+      m_force_requests(2 * num_tires, MPI_REQUEST_NULL) {}
+
+ChCosimTerrainNode::~ChCosimTerrainNode() {
+    MPI_Waitall(2 * m_num_tires, m_force_requests.data(), MPI_STATUSES_IGNORE);
+}
 
 void ChCosimTerrainNode::Initialize() {
-    // Receive contact specification from tire nodes
+    // Receive contact specification and mesh connectivity from tire nodes
     for (int it = 0; it < m_num_tires; it++) {
         unsigned int props[2];
         MPI_Status status;
@@ -39,39 +52,47 @@ void ChCosimTerrainNode::Initialize() {
             printf("Terrain node %d.  Recv from %d props = %d %d\n", m_rank, TIRE_NODE_RANK(it), props[0], props[1]);
         }
 
+        std::vector<int> tri_data(3 * props[1]);
+        MPI_Recv(tri_data.data(), 3 * props[1], MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
+        m_triangles[it].resize(props[1]);
+        for (unsigned int i = 0; i < props[1]; i++) {
+            m_triangles[it][i] = ChVector<int>(tri_data[3 * i + 0], tri_data[3 * i + 1], tri_data[3 * i + 2]);
+        }
+
+        // Allocate persistent communication buffers
+        m_vert_data[it].resize(2 * 3 * props[0]);
+        m_index_data[it].reserve(props[0]);
+        m_force_data[it].reserve(3 * props[0]);
+
         m_manager->OnReceiveTireInfo(it, props[0], props[1]);
     }
 }
 
 void ChCosimTerrainNode::Synchronize(double time) {
+    // Post receives for the tire mesh vertex locations and velocities from all tire nodes
     for (int it = 0; it < m_num_tires; it++) {
-        // Receive tire mesh vertex locations and velocities from the tire node
-        MPI_Status status;
-        unsigned int num_vert = m_num_vertices[it];
-        unsigned int num_tri = m_num_triangles[it];
-        double* vert_data = new double[2 * 3 * num_vert];
-        int* tri_data = new int[3 * num_tri];
-        MPI_Recv(vert_data, 2 * 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
-        MPI_Recv(tri_data, 3 * num_tri, MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
+        MPI_Irecv(m_vert_data[it].data(), 2 * 3 * m_num_vertices[it], MPI_DOUBLE, TIRE_NODE_RANK(it), it,
+                  MPI_COMM_WORLD, &m_vert_requests[it]);
+    }
+
+    // Process tire data in the order in which it arrives
+    for (int k = 0; k < m_num_tires; k++) {
+        int it;
+        MPI_Waitany(m_num_tires, m_vert_requests.data(), &it, MPI_STATUS_IGNORE);
 
         // Unpack received data
-        std::vector<ChVector<>> vert_pos;
-        std::vector<ChVector<>> vert_vel;
-        std::vector<ChVector<int>> triangles;
+        unsigned int num_vert = m_num_vertices[it];
+        const std::vector<double>& vert_data = m_vert_data[it];
+        std::vector<ChVector<>> vert_pos(num_vert);
+        std::vector<ChVector<>> vert_vel(num_vert);
         for (unsigned int i = 0; i < num_vert; i++) {
-            vert_pos.push_back(ChVector<>(vert_data[3 * i + 0], vert_data[3 * i + 1], vert_data[3 * i + 2]));
-            vert_vel.push_back(ChVector<>(vert_data[3 * num_vert + 3 * i + 0], vert_data[3 * num_vert + 3 * i + 1],
-                                          vert_data[3 * num_vert + 3 * i + 2]));
-        }
-        for (unsigned int i = 0; i < num_tri; i++) {
-            triangles.push_back(ChVector<int>(tri_data[3 * i + 0], tri_data[3 * i + 1], tri_data[3 * i + 2]));
+            vert_pos[i] = ChVector<>(vert_data[3 * i + 0], vert_data[3 * i + 1], vert_data[3 * i + 2]);
+            vert_vel[i] = ChVector<>(vert_data[3 * num_vert + 3 * i + 0], vert_data[3 * num_vert + 3 * i + 1],
+                                     vert_data[3 * num_vert + 3 * i + 2]);
         }
 
-        delete[] vert_data;
-        delete[] tri_data;
-
         // Let derived class process received data
-        m_manager->OnReceiveTireData(it, vert_pos, vert_vel, triangles);
+        m_manager->OnReceiveTireData(it, vert_pos, vert_vel, m_triangles[it]);
 
         // Let derived class produce tire contact forces
         std::vector<ChVector<>> vert_forces;
@@ -79,18 +100,21 @@ void ChCosimTerrainNode::Synchronize(double time) {
         m_manager->OnSendTireForces(it, vert_forces, vert_indeces);
         num_vert = (unsigned int)vert_indeces.size();
 
+        // Complete the previous sends to this tire node before reusing the send buffers
+        MPI_Waitall(2, &m_force_requests[2 * it], MPI_STATUSES_IGNORE);
+
         // Send vertex indeces and forces to the tire node
-        //// TODO: use custom derived MPI types?
-        double* force_data = new double[3 * num_vert];
+        m_index_data[it] = vert_indeces;
+        m_force_data[it].resize(3 * num_vert);
         for (unsigned int i = 0; i < num_vert; i++) {
-            force_data[3 * i + 0] = vert_forces[i].x;
-            force_data[3 * i + 1] = vert_forces[i].y;
-            force_data[3 * i + 2] = vert_forces[i].z;
+            m_force_data[it][3 * i + 0] = vert_forces[i].x();
+            m_force_data[it][3 * i + 1] = vert_forces[i].y();
+            m_force_data[it][3 * i + 2] = vert_forces[i].z();
         }
-        MPI_Send(vert_indeces.data(), num_vert, MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD);
-        MPI_Send(force_data, 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD);
-
-        delete[] force_data;
+        MPI_Isend(m_index_data[it].data(), num_vert, MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD,
+                  &m_force_requests[2 * it + 0]);
+        MPI_Isend(m_force_data[it].data(), 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD,
+                  &m_force_requests[2 * it + 1]);
     }
 
     m_terrain->Synchronize(time);
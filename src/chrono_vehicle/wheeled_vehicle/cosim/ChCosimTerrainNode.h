@@ -38,6 +38,7 @@ class ChCosimManager;
 class CH_VEHICLE_API ChCosimTerrainNode : public ChCosimNode {
   public:
     ChCosimTerrainNode(int rank, ChSystem* system, ChTerrain* terrain, int num_tires);
+    ~ChCosimTerrainNode();
 
     void Initialize();
     void Synchronize(double time);
@@ -50,6 +51,13 @@ class CH_VEHICLE_API ChCosimTerrainNode : public ChCosimNode {
     std::vector<unsigned int> m_num_vertices;   ///< number of contact vertices received from each tire
     std::vector<unsigned int> m_num_triangles;  ///< number of contact triangles received from each tire
 
+    std::vector<std::vector<ChVector<int>>> m_triangles;  ///< contact mesh connectivity of each tire (received once)
+    std::vector<std::vector<double>> m_vert_data;         ///< receive buffers for vertex states
+    std::vector<std::vector<int>> m_index_data;           ///< send buffers for loaded vertex indices
+    std::vector<std::vector<double>> m_force_data;        ///< send buffers for vertex forces
+    std::vector<MPI_Request> m_vert_requests;             ///< pending vertex state receives (one per tire)
+    std::vector<MPI_Request> m_force_requests;            ///< pending force sends (two per tire)
+
     friend class ChCosimManager;
 };
 
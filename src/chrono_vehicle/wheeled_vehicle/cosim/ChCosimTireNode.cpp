@@ -28,7 +28,16 @@ namespace chrono {
 namespace vehicle {
 
 ChCosimTireNode::ChCosimTireNode(int rank, ChSystem* system, ChDeformableTire* tire, WheelID id)
-    : ChCosimNode(rank, system), m_tire(tire), m_id(id) {}
+    : ChCosimNode(rank, system), m_tire(tire), m_id(id), m_lagged(false), m_num_vert(0) {
+    m_send_requests[0] = m_send_requests[1] = MPI_REQUEST_NULL;
+    m_force_requests[0] = m_force_requests[1] = MPI_REQUEST_NULL;
+}
+
+ChCosimTireNode::~ChCosimTireNode() {
+    // Complete outstanding communication (in lagged mode, the forces for the last step)
+    MPI_Waitall(2, m_send_requests, MPI_STATUSES_IGNORE);
+    MPI_Waitall(2, m_force_requests, MPI_STATUSES_IGNORE);
+}
 
 void ChCosimTireNode::Initialize() {
     // Ghost wheel body (driven kinematically through messages from vehicle node)
@@ -76,91 +85,91 @@ void ChCosimTireNode::Initialize() {
             printf("Tire node %d. Send to %d props = %d %d\n", m_rank, TERRAIN_NODE_RANK, props[0], props[1]);
         }
     }
+
+    // Send the contact mesh connectivity to the terrain node (only once, as it does not change)
+    {
+        std::vector<ChVector<>> vert_pos;
+        std::vector<ChVector<>> vert_vel;
+        std::vector<ChVector<int>> triangles;
+        m_contact_load->OutputSimpleMesh(vert_pos, vert_vel, triangles);
+        unsigned int num_tri = (unsigned int)triangles.size();
+        std::vector<int> tri_data(3 * num_tri);
+        for (unsigned int it = 0; it < num_tri; it++) {
+            tri_data[3 * it + 0] = triangles[it].x();
+            tri_data[3 * it + 1] = triangles[it].y();
+            tri_data[3 * it + 2] = triangles[it].z();
+        }
+        MPI_Send(tri_data.data(), 3 * num_tri, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
+        m_num_vert = (unsigned int)vert_pos.size();
+    }
+
+    // Allocate persistent communication buffers
+    m_vert_data.resize(2 * 3 * m_num_vert);
+    m_index_data.resize(m_num_vert);
+    m_force_data.resize(3 * m_num_vert);
 }
 
 void ChCosimTireNode::Synchronize(double time) {
-    // Send tire force to the vehicle node
-    TireForce tire_force = m_tire->GetTireForce(true);
-    double bufTF[9];
-    bufTF[0] = tire_force.force.x;
-    bufTF[1] = tire_force.force.y;
-    bufTF[2] = tire_force.force.z;
-    bufTF[3] = tire_force.moment.x;
-    bufTF[4] = tire_force.moment.y;
-    bufTF[5] = tire_force.moment.z;
-    bufTF[6] = tire_force.point.x;
-    bufTF[7] = tire_force.point.y;
-    bufTF[8] = tire_force.point.z;
-    MPI_Send(bufTF, 9, MPI_DOUBLE, VEHICLE_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
-
-    // Receive wheel state from the vehicle node
-    double bufWS[14];
-    MPI_Status statusWS;
-    MPI_Recv(bufWS, 14, MPI_DOUBLE, VEHICLE_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &statusWS);
-    WheelState wheel_state;
-    wheel_state.pos = ChVector<>(bufWS[0], bufWS[1], bufWS[2]);
-    wheel_state.rot = ChQuaternion<>(bufWS[3], bufWS[4], bufWS[5], bufWS[6]);
-    wheel_state.lin_vel = ChVector<>(bufWS[7], bufWS[8], bufWS[9]);
-    wheel_state.ang_vel = ChVector<>(bufWS[10], bufWS[11], bufWS[12]);
-    wheel_state.omega = bufWS[13];
+    // Complete the sends from the previous step before reusing their buffers
+    MPI_Waitall(2, m_send_requests, MPI_STATUSES_IGNORE);
 
-    // Extract tire mesh vertex locations and velocities
+    // Send tire force to the vehicle node and post the receive for the wheel state
+    TireForce tire_force = m_tire->GetTireForce(true);
+    m_bufTF[0] = tire_force.force.x();
+    m_bufTF[1] = tire_force.force.y();
+    m_bufTF[2] = tire_force.force.z();
+    m_bufTF[3] = tire_force.moment.x();
+    m_bufTF[4] = tire_force.moment.y();
+    m_bufTF[5] = tire_force.moment.z();
+    m_bufTF[6] = tire_force.point.x();
+    m_bufTF[7] = tire_force.point.y();
+    m_bufTF[8] = tire_force.point.z();
+    MPI_Isend(m_bufTF, 9, MPI_DOUBLE, VEHICLE_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &m_send_requests[0]);
+
+    MPI_Request requestWS;
+    MPI_Irecv(m_bufWS, 14, MPI_DOUBLE, VEHICLE_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &requestWS);
+
+    // Extract tire mesh vertex locations and velocities and send them to the terrain node.
+    // The mesh connectivity was already sent at initialization.
     std::vector<ChVector<>> vert_pos;
     std::vector<ChVector<>> vert_vel;
     std::vector<ChVector<int>> triangles;
     m_contact_load->OutputSimpleMesh(vert_pos, vert_vel, triangles);
-    unsigned int num_vert = (unsigned int)vert_pos.size();
-    unsigned int num_tri = (unsigned int)triangles.size();
-
-    // Send tire mesh vertex locations and velocities to the terrain node
-    //// TODO: use custom derived MPI types?
-    double* vert_data = new double[2 * 3 * num_vert];
-    int* tri_data = new int[3 * num_tri];
-    for (unsigned int iv = 0; iv < num_vert; iv++) {
-        vert_data[3 * iv + 0] = vert_pos[iv].x;
-        vert_data[3 * iv + 1] = vert_pos[iv].y;
-        vert_data[3 * iv + 2] = vert_pos[iv].z;
+    for (unsigned int iv = 0; iv < m_num_vert; iv++) {
+        m_vert_data[3 * iv + 0] = vert_pos[iv].x();
+        m_vert_data[3 * iv + 1] = vert_pos[iv].y();
+        m_vert_data[3 * iv + 2] = vert_pos[iv].z();
     }
-    for (unsigned int iv = 0; iv < num_vert; iv++) {
-        vert_data[3 * num_vert + 3 * iv + 0] = vert_vel[iv].x;
-        vert_data[3 * num_vert + 3 * iv + 1] = vert_vel[iv].y;
-        vert_data[3 * num_vert + 3 * iv + 2] = vert_vel[iv].z;
+    for (unsigned int iv = 0; iv < m_num_vert; iv++) {
+        m_vert_data[3 * m_num_vert + 3 * iv + 0] = vert_vel[iv].x();
+        m_vert_data[3 * m_num_vert + 3 * iv + 1] = vert_vel[iv].y();
+        m_vert_data[3 * m_num_vert + 3 * iv + 2] = vert_vel[iv].z();
     }
-    for (unsigned int it = 0; it < num_tri; it++) {
-        tri_data[3 * it + 0] = triangles[it].x;
-        tri_data[3 * it + 1] = triangles[it].y;
-        tri_data[3 * it + 2] = triangles[it].z;
+    MPI_Isend(m_vert_data.data(), 2 * 3 * m_num_vert, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD,
+              &m_send_requests[1]);
+
+    // Apply terrain forces to the mesh vertices.
+    // - strict coupling: wait for the forces produced for the vertex states just sent.
+    // - lagged coupling: use the forces produced for the vertex states sent at the previous
+    //   step (none at the first step), then post the receive for the current ones.
+    if (m_lagged) {
+        if (m_force_requests[0] != MPI_REQUEST_NULL)
+            ApplyForces();
+        PostForceReceive();
+    } else {
+        PostForceReceive();
+        ApplyForces();
     }
-    MPI_Send(vert_data, 2 * 3 * num_vert, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
-    MPI_Send(tri_data, 3 * num_tri, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
-
-    delete[] vert_data;
-    delete[] tri_data;
-
-    // Receive terrain force(s) from the terrain node
-    // Note that we use MPI_Probe to figure out the number of indeces and forces received.
-    MPI_Status status;
-    int count;
-    MPI_Probe(TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &status);
-    MPI_Get_count(&status, MPI_INT, &count);
-    int* index_data = new int[count];
-    double* force_data = new double[3 * count];
-    MPI_Recv(index_data, count, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &status);
-    MPI_Recv(force_data, 3 * count, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &status);
-
-    // Repack data and apply forces to the mesh vertices
-    std::vector<ChVector<>> vert_forces;
-    std::vector<int> vert_indeces;
-    for (int iv = 0; iv < count; iv++) {
-        vert_forces.push_back(ChVector<>(force_data[3 * iv + 0], force_data[3 * iv + 1], force_data[3 * iv + 2]));
-        vert_indeces.push_back(index_data[iv]);
-    }
-    m_contact_load->InputSimpleForces(vert_forces, vert_indeces);
-
-    delete[] index_data;
-    delete[] force_data;
 
     // Synchronize the ghost wheel and the tire
+    MPI_Wait(&requestWS, MPI_STATUS_IGNORE);
+    WheelState wheel_state;
+    wheel_state.pos = ChVector<>(m_bufWS[0], m_bufWS[1], m_bufWS[2]);
+    wheel_state.rot = ChQuaternion<>(m_bufWS[3], m_bufWS[4], m_bufWS[5], m_bufWS[6]);
+    wheel_state.lin_vel = ChVector<>(m_bufWS[7], m_bufWS[8], m_bufWS[9]);
+    wheel_state.ang_vel = ChVector<>(m_bufWS[10], m_bufWS[11], m_bufWS[12]);
+    wheel_state.omega = m_bufWS[13];
+
     m_wheel->SetPos(wheel_state.pos);
     m_wheel->SetRot(wheel_state.rot);
     m_wheel->SetPos_dt(wheel_state.lin_vel);
@@ -169,6 +178,30 @@ void ChCosimTireNode::Synchronize(double time) {
     m_tire->Synchronize(time, wheel_state, *m_terrain);
 }
 
+// Post receives for the vertex indices and forces sent by the terrain node.
+// The terrain node never sends more forces than there are mesh vertices.
+void ChCosimTireNode::PostForceReceive() {
+    MPI_Irecv(m_index_data.data(), m_num_vert, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD,
+              &m_force_requests[0]);
+    MPI_Irecv(m_force_data.data(), 3 * m_num_vert, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD,
+              &m_force_requests[1]);
+}
+
+// Wait for the posted force receives and apply the forces to the mesh vertices.
+void ChCosimTireNode::ApplyForces() {
+    MPI_Status status[2];
+    int count;
+    MPI_Waitall(2, m_force_requests, status);
+    MPI_Get_count(&status[0], MPI_INT, &count);
+
+    std::vector<ChVector<>> vert_forces(count);
+    std::vector<int> vert_indeces(m_index_data.begin(), m_index_data.begin() + count);
+    for (int iv = 0; iv < count; iv++) {
+        vert_forces[iv] = ChVector<>(m_force_data[3 * iv + 0], m_force_data[3 * iv + 1], m_force_data[3 * iv + 2]);
+    }
+    m_contact_load->InputSimpleForces(vert_forces, vert_indeces);
+}
+
 void ChCosimTireNode::Advance(double step) {
     double t = 0;
     while (t < step) {
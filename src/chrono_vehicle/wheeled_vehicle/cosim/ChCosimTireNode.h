@@ -19,6 +19,7 @@
 #ifndef CH_COSIM_TIRE_NODE_H
 #define CH_COSIM_TIRE_NODE_H
 
+#include <vector>
 #include "mpi.h"
 
 #include "chrono/physics/ChSystem.h"
@@ -37,17 +38,39 @@ class CH_VEHICLE_API ChCosimTireNode : public ChCosimNode {
   public:
     ChCosimTireNode(int rank, ChSystem* system, ChDeformableTire* tire, WheelID id);
 
+    ~ChCosimTireNode();
+
+    /// Enable/disable one-step-lagged coupling with the terrain node (default: false).
+    /// If enabled, the contact forces applied to the tire at a given step are those computed
+    /// by the terrain node for the vertex states sent at the previous step. This allows the
+    /// tire and terrain nodes to compute concurrently.
+    void SetLaggedCoupling(bool val) { m_lagged = val; }
+
     void Initialize();
     void Synchronize(double time);
     void Advance(double step);
 
   private:
+    void PostForceReceive();
+    void ApplyForces();
+
     ChDeformableTire* m_tire;
     WheelID m_id;
     std::shared_ptr<ChBody> m_wheel;
     std::shared_ptr<ChTerrain> m_terrain;
 
     std::shared_ptr<fea::ChLoadContactSurfaceMesh> m_contact_load;
+
+    bool m_lagged;                    ///< use one-step-lagged coupling with the terrain node?
+    unsigned int m_num_vert;          ///< number of contact mesh vertices
+    double m_bufTF[9];                ///< send buffer for tire force (to vehicle node)
+    double m_bufWS[14];               ///< receive buffer for wheel state (from vehicle node)
+    std::vector<double> m_vert_data;  ///< send buffer for vertex states (to terrain node)
+    std::vector<int> m_index_data;    ///< receive buffer for loaded vertex indices (from terrain node)
+    std::vector<double> m_force_data; ///< receive buffer for vertex forces (from terrain node)
+
+    MPI_Request m_send_requests[2];   ///< pending sends (tire force, vertex states)
+    MPI_Request m_force_requests[2];  ///< pending receives (vertex indices, vertex forces)
 };
 
 /// @} vehicle_wheeled_cosim
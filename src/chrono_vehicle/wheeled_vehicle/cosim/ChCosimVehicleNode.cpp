@@ -29,6 +29,14 @@ ChCosimVehicleNode::ChCosimVehicleNode(int rank, ChWheeledVehicle* vehicle, ChPo
     : ChCosimNode(rank, m_vehicle->GetSystem()), m_vehicle(vehicle), m_powertrain(powertrain), m_driver(driver) {
     m_num_wheels = 2 * m_vehicle->GetNumberAxles();
     m_tire_forces.resize(m_num_wheels);
+    m_bufTF.resize(9 * m_num_wheels);
+    m_bufWS.resize(14 * m_num_wheels);
+    m_requestsTF.resize(m_num_wheels, MPI_REQUEST_NULL);
+    m_requestsWS.resize(m_num_wheels, MPI_REQUEST_NULL);
+}
+
+ChCosimVehicleNode::~ChCosimVehicleNode() {
+    MPI_Waitall(m_num_wheels, m_requestsWS.data(), MPI_STATUSES_IGNORE);
 }
 
 void ChCosimVehicleNode::SetStepsize(double stepsize) {
@@ -47,9 +55,9 @@ void ChCosimVehicleNode::Initialize(const ChCoordsys<>& chassisPos) {
         double mass = m_vehicle->GetWheelBody(WheelID(iw))->GetMass();
         ChVector<> inertia = m_vehicle->GetWheelBody(WheelID(iw))->GetInertiaXX();
         props[0] = mass;
-        props[1] = inertia.x;
-        props[2] = inertia.y;
-        props[3] = inertia.z;
+        props[1] = inertia.x();
+        props[2] = inertia.y();
+        props[3] = inertia.z();
         MPI_Send(props, 4, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD);
         if (m_verbose) {
             printf("Vehicle node %d.  Send to %d props = %g %g %g %g\n", m_rank, TIRE_NODE_RANK(iw), props[0], props[1],
@@ -68,35 +76,42 @@ void ChCosimVehicleNode::Synchronize(double time) {
     double driveshaft_speed = m_vehicle->GetDriveshaftSpeed();
     double powertrain_torque = m_powertrain->GetOutputTorque();
 
-    // Receive tire forces from each of the tire nodes
-    double bufTF[9];
-    MPI_Status statusTF;
+    // Post receives for the tire forces from each of the tire nodes
     for (int iw = 0; iw < m_num_wheels; iw++) {
-        MPI_Recv(bufTF, 9, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD, &statusTF);
-        m_tire_forces[iw].force = ChVector<>(bufTF[0], bufTF[1], bufTF[2]);
-        m_tire_forces[iw].moment = ChVector<>(bufTF[3], bufTF[4], bufTF[5]);
-        m_tire_forces[iw].point = ChVector<>(bufTF[6], bufTF[7], bufTF[8]);
+        MPI_Irecv(&m_bufTF[9 * iw], 9, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD, &m_requestsTF[iw]);
     }
 
+    // Complete the previous wheel state sends before reusing the send buffer
+    MPI_Waitall(m_num_wheels, m_requestsWS.data(), MPI_STATUSES_IGNORE);
+
     // Send wheel states to each of the tire nodes
-    double bufWS[14];
     for (int iw = 0; iw < m_num_wheels; iw++) {
         WheelState wheel_state = m_vehicle->GetWheelState(WheelID(iw));
-        bufWS[0] = wheel_state.pos.x;
-        bufWS[1] = wheel_state.pos.y;
-        bufWS[2] = wheel_state.pos.z;
-        bufWS[3] = wheel_state.rot.e0;
-        bufWS[4] = wheel_state.rot.e1;
-        bufWS[5] = wheel_state.rot.e2;
-        bufWS[6] = wheel_state.rot.e3;
-        bufWS[7] = wheel_state.lin_vel.x;
-        bufWS[8] = wheel_state.lin_vel.y;
-        bufWS[9] = wheel_state.lin_vel.z;
-        bufWS[10] = wheel_state.ang_vel.x;
-        bufWS[11] = wheel_state.ang_vel.y;
-        bufWS[12] = wheel_state.ang_vel.z;
+        double* bufWS = &m_bufWS[14 * iw];
+        bufWS[0] = wheel_state.pos.x();
+        bufWS[1] = wheel_state.pos.y();
+        bufWS[2] = wheel_state.pos.z();
+        bufWS[3] = wheel_state.rot.e0();
+        bufWS[4] = wheel_state.rot.e1();
+        bufWS[5] = wheel_state.rot.e2();
+        bufWS[6] = wheel_state.rot.e3();
+        bufWS[7] = wheel_state.lin_vel.x();
+        bufWS[8] = wheel_state.lin_vel.y();
+        bufWS[9] = wheel_state.lin_vel.z();
+        bufWS[10] = wheel_state.ang_vel.x();
+        bufWS[11] = wheel_state.ang_vel.y();
+        bufWS[12] = wheel_state.ang_vel.z();
         bufWS[13] = wheel_state.omega;
-        MPI_Send(bufWS, 14, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD);
+        MPI_Isend(bufWS, 14, MPI_DOUBLE, TIRE_NODE_RANK(iw), iw, MPI_COMM_WORLD, &m_requestsWS[iw]);
+    }
+
+    // Wait for the tire forces
+    MPI_Waitall(m_num_wheels, m_requestsTF.data(), MPI_STATUSES_IGNORE);
+    for (int iw = 0; iw < m_num_wheels; iw++) {
+        const double* bufTF = &m_bufTF[9 * iw];
+        m_tire_forces[iw].force = ChVector<>(bufTF[0], bufTF[1], bufTF[2]);
+        m_tire_forces[iw].moment = ChVector<>(bufTF[3], bufTF[4], bufTF[5]);
+        m_tire_forces[iw].point = ChVector<>(bufTF[6], bufTF[7], bufTF[8]);
     }
 
     // Synchronize vehicle, powertrain, and driver
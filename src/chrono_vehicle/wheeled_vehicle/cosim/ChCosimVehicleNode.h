@@ -19,6 +19,7 @@
 #ifndef CH_COSIM_VEHICLE_NODE_H
 #define CH_COSIM_VEHICLE_NODE_H
 
+#include <vector>
 #include "mpi.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
@@ -36,6 +37,7 @@ namespace vehicle {
 class CH_VEHICLE_API ChCosimVehicleNode : public ChCosimNode {
   public:
     ChCosimVehicleNode(int rank, ChWheeledVehicle* vehicle, ChPowertrain* powertrain, ChDriver* driver);
+    ~ChCosimVehicleNode();
     int GetNumberAxles() const { return m_vehicle->GetNumberAxles(); }
 
     virtual void SetStepsize(double stepsize) override;
@@ -50,6 +52,11 @@ class CH_VEHICLE_API ChCosimVehicleNode : public ChCosimNode {
 
     int m_num_wheels;
     TireForces m_tire_forces;
+
+    std::vector<double> m_bufTF;           ///< receive buffer for tire forces (9 values per wheel)
+    std::vector<double> m_bufWS;           ///< send buffer for wheel states (14 values per wheel)
+    std::vector<MPI_Request> m_requestsTF;  ///< pending tire force receives
+    std::vector<MPI_Request> m_requestsWS;  ///< pending wheel state sends
 };
 
 /// @} vehicle_wheeled_cosim
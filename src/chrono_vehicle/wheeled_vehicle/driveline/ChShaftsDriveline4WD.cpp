@@ -32,7 +32,11 @@ namespace vehicle {
 // could transfer pitch torque to the chassis.
 // -----------------------------------------------------------------------------
 ChShaftsDriveline4WD::ChShaftsDriveline4WD(const std::string& name)
-    : ChDriveline(name), m_dir_motor_block(ChVector<>(1, 0, 0)), m_dir_axle(ChVector<>(0, 1, 0)) {}
+    : ChDriveline(name),
+      m_quasi_static(false),
+      m_input_inertia(0),
+      m_dir_motor_block(ChVector<>(1, 0, 0)),
+      m_dir_axle(ChVector<>(0, 1, 0)) {}
 
 // -----------------------------------------------------------------------------
 // Initialize the driveline subsystem.
@@ -47,6 +51,23 @@ void ChShaftsDriveline4WD::Initialize(std::shared_ptr<ChBody> chassis,
 
     m_driven_axles = driven_axles;
 
+    m_axles[0] = suspensions[m_driven_axles[0]]->GetAxle(LEFT);
+    m_axles[1] = suspensions[m_driven_axles[0]]->GetAxle(RIGHT);
+    m_axles[2] = suspensions[m_driven_axles[1]]->GetAxle(LEFT);
+    m_axles[3] = suspensions[m_driven_axles[1]]->GetAxle(RIGHT);
+
+    // In quasi-static mode, the torque is applied directly to the wheel axles and
+    // its reaction, about the axle direction, to the chassis.
+    if (m_quasi_static) {
+        for (int i = 0; i < 4; i++)
+            m_axle_inertias[i] = m_axles[i]->GetInertia();
+        m_chassis_torque = std::make_shared<ChForce>();
+        chassis->AddForce(m_chassis_torque);
+        m_chassis_torque->SetMode(ChForce::TORQUE);
+        m_chassis_torque->SetRelDir(m_dir_axle);
+        return;
+    }
+
     ChSystem* my_system = chassis->GetSystem();
 
     // Create the driveshaft, a 1 d.o.f. object with rotational inertia which
@@ -169,9 +190,88 @@ void ChShaftsDriveline4WD::Initialize(std::shared_ptr<ChBody> chassis,
     m_driveshaft->SetPos_dt(omega_driveshaft);
 }
 
+// -----------------------------------------------------------------------------
+// Quasi-static mode.
+// A differential with ordinary ratio t0 (Willis formula) constrains the speeds of
+// the carrier c and the two outputs as  w3 - t0 * w2 = (1 - t0) * wc  and splits
+// the carrier torque T as  T2 = -t0 * T / (1 - t0),  T3 = T / (1 - t0).
+// A conical gear with ratio t has  w_out = t * w_in  and  T_out = T_in / t.
+// With all wheels turning at the same speed w, the differential boxes turn at w,
+// the front and rear shafts at w / t_conical, and the driveshaft at k * w, which
+// gives the inertia of the driveline reduced to the wheel axles.
+// The conical gears react the torque of the differential boxes on the chassis,
+// about the axle direction (their reaction about the driveshaft direction balances
+// that of the powertrain, up to the inertia torques).
+// -----------------------------------------------------------------------------
+double ChShaftsDriveline4WD::GetDriveshaftSpeed() const {
+    if (!m_quasi_static)
+        return m_driveshaft->GetPos_dt();
+
+    double t_front = GetFrontDifferentialRatio();
+    double t_rear = GetRearDifferentialRatio();
+    double t_central = GetCentralDifferentialRatio();
+
+    double omega_front_differentialbox = (m_axles[1]->GetPos_dt() - t_front * m_axles[0]->GetPos_dt()) / (1 - t_front);
+    double omega_rear_differentialbox = (m_axles[3]->GetPos_dt() - t_rear * m_axles[2]->GetPos_dt()) / (1 - t_rear);
+
+    double omega_front_shaft = omega_front_differentialbox / GetFrontConicalGearRatio();
+    double omega_rear_shaft = omega_rear_differentialbox / GetRearConicalGearRatio();
+
+    // The central differential has the rear shaft as first output
+    return (omega_front_shaft - t_central * omega_rear_shaft) / (1 - t_central);
+}
+
+void ChShaftsDriveline4WD::Synchronize(double torque) {
+    if (!m_quasi_static) {
+        m_driveshaft->SetAppliedTorque(torque);
+        return;
+    }
+
+    double t_front = GetFrontDifferentialRatio();
+    double t_rear = GetRearDifferentialRatio();
+    double t_central = GetCentralDifferentialRatio();
+    double t_front_conical = GetFrontConicalGearRatio();
+    double t_rear_conical = GetRearConicalGearRatio();
+
+    // Driveline and powertrain inertia, lumped in equal parts onto the wheel axles
+    double k = (1 / t_front_conical - t_central / t_rear_conical) / (1 - t_central);
+    double inertia = GetFrontDifferentialBoxInertia() + GetRearDifferentialBoxInertia() +
+                     GetToFrontDiffShaftInertia() / (t_front_conical * t_front_conical) +
+                     GetToRearDiffShaftInertia() / (t_rear_conical * t_rear_conical) +
+                     (GetDriveshaftInertia() + m_input_inertia) * k * k;
+    for (int i = 0; i < 4; i++)
+        m_axles[i]->SetInertia(m_axle_inertias[i] + inertia / 4);
+
+    double torque_rear_shaft = -t_central * torque / (1 - t_central);
+    double torque_front_shaft = torque / (1 - t_central);
+
+    double torque_front_differentialbox = torque_front_shaft / t_front_conical;
+    double torque_rear_differentialbox = torque_rear_shaft / t_rear_conical;
+
+    m_axles[0]->SetAppliedTorque(-t_front * torque_front_differentialbox / (1 - t_front));
+    m_axles[1]->SetAppliedTorque(torque_front_differentialbox / (1 - t_front));
+    m_axles[2]->SetAppliedTorque(-t_rear * torque_rear_differentialbox / (1 - t_rear));
+    m_axles[3]->SetAppliedTorque(torque_rear_differentialbox / (1 - t_rear));
+
+    m_chassis_torque->SetMforce(torque_front_differentialbox + torque_rear_differentialbox);
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 double ChShaftsDriveline4WD::GetWheelTorque(const WheelID& wheel_id) const {
+    if (m_quasi_static) {
+        // Applied torque, less the part that accelerates the lumped driveline inertia
+        int i;
+        if (wheel_id.axle() == m_driven_axles[0])
+            i = (wheel_id.side() == LEFT) ? 0 : 1;
+        else if (wheel_id.axle() == m_driven_axles[1])
+            i = (wheel_id.side() == LEFT) ? 2 : 3;
+        else
+            return 0;
+        double inertia = m_axles[i]->GetInertia() - m_axle_inertias[i];
+        return -(m_axles[i]->GetAppliedTorque() - inertia * m_axles[i]->GetPos_dtdt());
+    }
+
     if (wheel_id.axle() == m_driven_axles[0]) {
         switch (wheel_id.side()) {
             case LEFT:
@@ -22,6 +22,7 @@
 #include "chrono_vehicle/ChApiVehicle.h"
 #include "chrono_vehicle/wheeled_vehicle/ChDriveline.h"
 
+#include "chrono/physics/ChForce.h"
 #include "chrono/physics/ChShaftsGear.h"
 #include "chrono/physics/ChShaftsGearboxAngled.h"
 #include "chrono/physics/ChShaftsPlanetary.h"
@@ -36,6 +37,18 @@ namespace vehicle {
 /// @{
 
 /// 4WD driveline model template based on ChShaft objects.
+///
+/// Optionally, the same driveline data can be used in a quasi-static mode (see
+/// SetQuasiStaticMode), in which no ChShaft elements are added to the system. The
+/// driveshaft speed is then obtained from the wheel axle speeds and the torque from
+/// the powertrain is split algebraically, through the gear ratios and the Willis
+/// relations of the differentials, and applied directly to the wheel axles. The
+/// inertia of the driveline shafts, and that of the powertrain on the driveshaft
+/// (see SetInputInertia), is lumped in equal parts onto the four wheel axles, which
+/// is exact when the wheels turn at the same speed. The reaction torque of the
+/// conical gears about the axle direction is applied to the chassis. This mode
+/// requires a powertrain that passes its torque through GetOutputTorque() (such as
+/// a ChShaftsPowertrain in quasi-static mode).
 class CH_VEHICLE_API ChShaftsDriveline4WD : public ChDriveline {
   public:
     ChShaftsDriveline4WD(const std::string& name);
@@ -54,6 +67,19 @@ class CH_VEHICLE_API ChShaftsDriveline4WD : public ChDriveline {
     /// system, this is typically [0, 1, 0]).
     void SetAxleDirection(const ChVector<>& dir) { m_dir_axle = dir; }
 
+    /// Enable or disable the quasi-static mode (default: false).
+    /// Must be called before Initialize().
+    void SetQuasiStaticMode(bool val) { m_quasi_static = val; }
+
+    /// Return true if the driveline is in quasi-static mode.
+    bool IsQuasiStaticMode() const { return m_quasi_static; }
+
+    /// Set the inertia of the powertrain connected to the driveshaft (default: 0).
+    /// Only used in quasi-static mode, where it should be updated before each call to
+    /// Synchronize() (for instance from ChShaftsPowertrain::GetOutputInertia, which
+    /// depends on the current gear).
+    void SetInputInertia(double inertia) { m_input_inertia = inertia; }
+
     /// Return the number of driven axles.
     /// A ChShaftsDriveline4WD driveline connects to two axles.
     virtual int GetNumDrivenAxles() const final override { return 2; }
@@ -66,6 +92,12 @@ class CH_VEHICLE_API ChShaftsDriveline4WD : public ChDriveline {
                             const std::vector<int>& driven_axles  ///< indexes of the driven vehicle axles
                             ) override;
 
+    /// Get the angular speed of the driveshaft.
+    virtual double GetDriveshaftSpeed() const override;
+
+    /// Update the driveline subsystem: apply the specified motor torque.
+    virtual void Synchronize(double torque) override;
+
     /// Get the motor torque to be applied to the specified wheel.
     virtual double GetWheelTorque(const WheelID& wheel_id) const override;
 
@@ -95,6 +127,14 @@ class CH_VEHICLE_API ChShaftsDriveline4WD : public ChDriveline {
     virtual double GetCentralDifferentialRatio() const = 0;
 
   private:
+    bool m_quasi_static;
+
+    // Wheel axles, driven directly in quasi-static mode (front left/right, rear left/right)
+    std::shared_ptr<ChShaft> m_axles[4];
+    double m_axle_inertias[4];  ///< own inertias of the wheel axles
+    double m_input_inertia;     ///< powertrain inertia on the driveshaft (quasi-static mode)
+    std::shared_ptr<ChForce> m_chassis_torque;  ///< reaction torque on the chassis (quasi-static mode)
+
     std::shared_ptr<ChShaftsPlanetary> m_central_differential;
     std::shared_ptr<ChShaft> m_front_shaft;
     std::shared_ptr<ChShaft> m_rear_shaft;
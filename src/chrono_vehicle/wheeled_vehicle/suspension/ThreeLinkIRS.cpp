@@ -20,7 +20,7 @@
 
 #include "chrono_vehicle/wheeled_vehicle/suspension/ThreeLinkIRS.h"
 
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -43,15 +43,8 @@ static ChVector<> loadVector(const Value& a) {
 // -----------------------------------------------------------------------------
 ThreeLinkIRS::ThreeLinkIRS(const std::string& filename)
     : ChThreeLinkIRS(""), m_springForceCB(nullptr), m_shockForceCB(nullptr) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     Create(d);
 
@@ -42,7 +42,7 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -103,15 +103,8 @@ const double ChSuspensionTestRig::m_post_radius = 0.4;
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void ChSuspensionTestRig::LoadSteering(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a steering specification file.
     assert(d.HasMember("Type"));
@@ -134,15 +127,8 @@ void ChSuspensionTestRig::LoadSteering(const std::string& filename) {
 }
 
 void ChSuspensionTestRig::LoadSuspension(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a suspension specification file.
     assert(d.HasMember("Type"));
@@ -168,15 +154,8 @@ void ChSuspensionTestRig::LoadSuspension(const std::string& filename) {
 }
 
 void ChSuspensionTestRig::LoadWheel(const std::string& filename, int side) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a wheel specification file.
     assert(d.HasMember("Type"));
@@ -205,15 +184,8 @@ ChSuspensionTestRig::ChSuspensionTestRig(const std::string& filename,
                                          ChMaterialSurfaceBase::ContactMethod contact_method)
     : ChVehicle(contact_method), m_displ_limit(displ_limit) {
     // Open and parse the input file (vehicle JSON specification file)
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Read top-level data
     assert(d.HasMember("Type"));
@@ -260,15 +232,8 @@ ChSuspensionTestRig::ChSuspensionTestRig(const std::string& filename,
                                          ChMaterialSurfaceBase::ContactMethod contact_method)
     : ChVehicle(contact_method) {
     // Open and parse the input file (rig JSON specification file)
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Read top-level data
     assert(d.HasMember("Type"));
@@ -19,7 +19,7 @@
 #include "chrono/core/ChCubicSpline.h"
 #include "chrono_vehicle/wheeled_vehicle/tire/ANCFTire.h"
 
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace chrono::fea;
 using namespace rapidjson;
@@ -47,15 +47,8 @@ static ChQuaternion<> loadQuaternion(const Value& a) {
 // Constructors for ANCFTire
 // -----------------------------------------------------------------------------
 ANCFTire::ANCFTire(const std::string& filename) : ChANCFTire("") {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     ProcessJSON(d);
 
@@ -16,6 +16,8 @@
 //
 // =============================================================================
 
+#include <vector>
+
 #include "chrono_vehicle/wheeled_vehicle/tire/ChDeformableTire.h"
 
 namespace chrono {
@@ -23,6 +25,104 @@ namespace vehicle {
 
 using namespace chrono::fea;
 
+// -----------------------------------------------------------------------------
+// Custom collision callback for contact between the nodes of a node cloud contact
+// surface and a height-field terrain.
+// The terrain height and normal below all nodes are obtained with a single batched
+// query; each node is then tested against the plane tangent to the terrain at that
+// point (in parallel) and the resulting contacts are added to the system contact
+// container in node order.
+// -----------------------------------------------------------------------------
+class DeformableTireTerrainContactCB : public ChSystem::ChCustomComputeCollisionCallback {
+  public:
+    DeformableTireTerrainContactCB(std::shared_ptr<ChContactSurfaceNodeCloud> surface,  ///< tire contact nodes
+                                   const ChTerrain* terrain,                            ///< height-field terrain
+                                   std::shared_ptr<ChBody> ground,                      ///< terrain collision body
+                                   double radius                                        ///< contact node radius
+                                   )
+        : m_surface(surface), m_terrain(terrain), m_ground(ground), m_radius(radius) {}
+
+    virtual void PerformCustomCollision(ChSystem* system) override;
+
+  private:
+    std::shared_ptr<ChContactSurfaceNodeCloud> m_surface;  // tire contact nodes
+    const ChTerrain* m_terrain;                            // height-field terrain
+    std::shared_ptr<ChBody> m_ground;                      // terrain collision body
+    double m_radius;                                       // contact node radius
+
+    std::vector<ChVector<>> m_pos;                      // node positions
+    std::vector<collision::ChCollisionModel*> m_models;  // node collision models
+    std::vector<double> m_x;                            // query x coordinates
+    std::vector<double> m_y;                            // query y coordinates
+    std::vector<double> m_height;                       // terrain heights below nodes
+    std::vector<ChVector<>> m_normal;                   // terrain normals below nodes
+    std::vector<collision::ChCollisionInfo> m_contacts;  // per-node contact information
+    std::vector<char> m_active;                         // per-node contact flags
+};
+
+void DeformableTireTerrainContactCB::PerformCustomCollision(ChSystem* system) {
+    if (!m_ground->GetCollide())
+        return;
+
+    int num_xyz = (int)m_surface->GetNnodes();
+    int num_nodes = num_xyz + (int)m_surface->GetNnodesRot();
+
+    m_pos.resize(num_nodes);
+    m_models.resize(num_nodes);
+    m_x.resize(num_nodes);
+    m_y.resize(num_nodes);
+    m_contacts.resize(num_nodes);
+    m_active.resize(num_nodes);
+
+    // Collect the current node positions.
+    for (int i = 0; i < num_xyz; i++) {
+        auto node = m_surface->GetNode(i);
+        m_pos[i] = node->GetNode()->GetPos();
+        m_models[i] = node->GetCollisionModel();
+    }
+    for (int i = num_xyz; i < num_nodes; i++) {
+        auto node = m_surface->GetNodeRot(i - num_xyz);
+        m_pos[i] = node->GetNode()->GetPos();
+        m_models[i] = node->GetCollisionModel();
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        m_x[i] = m_pos[i].x();
+        m_y[i] = m_pos[i].y();
+    }
+
+    // Terrain height and normal below each node.
+    m_terrain->GetHeightAndNormal(m_x, m_y, m_height, m_normal);
+
+    // Test each node sphere against the terrain tangent plane.
+    collision::ChCollisionModel* model_ground = m_ground->GetCollisionModel().get();
+
+#pragma omp parallel for
+    for (int i = 0; i < num_nodes; i++) {
+        const ChVector<>& normal = m_normal[i];
+        double depth = (m_pos[i].z() - m_height[i]) * normal.z();
+        double distance = depth - m_radius;
+
+        m_active[i] = distance < m_models[i]->GetEnvelope();
+        if (!m_active[i])
+            continue;
+
+        collision::ChCollisionInfo& contact = m_contacts[i];
+        contact.modelA = model_ground;
+        contact.modelB = m_models[i];
+        contact.vN = normal;
+        contact.vpA = m_pos[i] - depth * normal;
+        contact.vpB = m_pos[i] - m_radius * normal;
+        contact.distance = distance;
+        contact.reaction_cache = 0;
+    }
+
+    // Add the contacts to the system.
+    for (int i = 0; i < num_nodes; i++) {
+        if (m_active[i])
+            system->GetContactContainer()->AddContact(m_contacts[i]);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 ChDeformableTire::ChDeformableTire(const std::string& name)
@@ -41,7 +141,19 @@ ChDeformableTire::ChDeformableTire(const std::string& name)
       m_kt(2e5),
       m_gn(40),
       m_gt(20),
-      m_pressure(-1) {}
+      m_pressure(-1),
+      m_terrain(NULL),
+      m_terrain_callback(NULL) {}
+
+ChDeformableTire::~ChDeformableTire() {
+    // Unregister the terrain contact callback, unless the system was already destroyed
+    // (in which case the mesh was removed from it).
+    if (m_terrain_callback) {
+        if (ChSystem* system = m_mesh->GetSystem())
+            system->UnregisterCustomCollisionCallback(m_terrain_callback);
+        delete m_terrain_callback;
+    }
+}
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
@@ -51,6 +163,11 @@ void ChDeformableTire::SetContactMaterialProperties(float young_modulus,
     m_poisson_ratio = poisson_ratio;
 }
 
+void ChDeformableTire::EnableTerrainContact(const ChTerrain* terrain, std::shared_ptr<ChBody> ground) {
+    m_terrain = terrain;
+    m_terrain_body = ground;
+}
+
 void ChDeformableTire::SetContactMaterialCoefficients(float kn, float gn, float kt, float gt) {
     m_kn = kn;
     m_gn = gn;
@@ -102,6 +219,15 @@ void ChDeformableTire::Initialize(std::shared_ptr<ChBody> wheel, VehicleSide sid
     if (m_contact_enabled) {
         // Let the derived class create the contact surface and add it to the mesh.
         CreateContactSurface();
+
+        // If requested, handle contact of a node cloud with the terrain outside the collision system.
+        auto node_cloud = std::dynamic_pointer_cast<ChContactSurfaceNodeCloud>(m_mesh->GetContactSurface(0));
+        if (m_terrain && node_cloud) {
+            node_cloud->SurfaceRemoveCollisionModelsFromSystem(system);
+            m_terrain_callback =
+                new DeformableTireTerrainContactCB(node_cloud, m_terrain, m_terrain_body, m_contact_node_radius);
+            system->SetCustomComputeCollisionCallback(m_terrain_callback);
+        }
     }
 
     // Enable tire connection to rim
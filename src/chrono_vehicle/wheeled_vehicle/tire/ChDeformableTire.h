@@ -32,6 +32,7 @@
 #include "chrono_fea/ChNodeFEAbase.h"
 #include "chrono_fea/ChVisualizationFEAmesh.h"
 
+#include "chrono_vehicle/ChTerrain.h"
 #include "chrono_vehicle/wheeled_vehicle/ChTire.h"
 
 namespace chrono {
@@ -50,6 +51,8 @@ class CH_VEHICLE_API ChDeformableTire : public ChTire {
     ChDeformableTire(const std::string& name  ///< [in] name of this tire system
                      );
 
+    virtual ~ChDeformableTire();
+
     /// Set the type of contact surface.
     void SetContactSurfaceType(ContactSurfaceType type) { m_contact_type = type; }
     ContactSurfaceType GetContactSurfaceType() const { return m_contact_type; }
@@ -119,6 +122,17 @@ class CH_VEHICLE_API ChDeformableTire : public ChTire {
     void EnableContact(bool val) { m_contact_enabled = val; }
     bool IsContactEnabled() const { return m_contact_enabled; }
 
+    /// Enable contact of the tire nodes with a height-field terrain.
+    /// This must be called before tire initialization and is relevant only for the NODE_CLOUD
+    /// contact surface type. The contact nodes are then not added to the collision system;
+    /// instead, at each collision detection step, all nodes are tested against the terrain
+    /// height and normal below them and the resulting contacts with the specified terrain
+    /// body are added directly to the system contact container. The terrain surface must be
+    /// a height field (as with any RigidTerrain) and the terrain object must outlive the tire.
+    void EnableTerrainContact(const ChTerrain* terrain,       ///< [in] height-field terrain
+                              std::shared_ptr<ChBody> ground  ///< [in] terrain collision body
+                              );
+
     /// Enable/disable tire-rim connection (default: true).
     void EnableRimConnection(bool val) { m_connection_enabled = val; }
     bool IsRimConnectionEnabled() const { return m_connection_enabled; }
@@ -227,6 +241,10 @@ class CH_VEHICLE_API ChDeformableTire : public ChTire {
 
     std::shared_ptr<ChMaterialSurfaceDEM> m_contact_mat;           ///< tire contact material
     std::shared_ptr<fea::ChVisualizationFEAmesh> m_visualization;  ///< tire mesh visualization
+
+    const ChTerrain* m_terrain;                                      ///< height-field terrain (node-terrain contact)
+    std::shared_ptr<ChBody> m_terrain_body;                          ///< terrain collision body
+    ChSystem::ChCustomComputeCollisionCallback* m_terrain_callback;  ///< node-terrain contact callback
 };
 
 /// @} vehicle_wheeled_tire
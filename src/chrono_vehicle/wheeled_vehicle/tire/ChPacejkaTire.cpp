@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include <algorithm>
 
+#include "chrono/ChConfig.h"
 #include "chrono/physics/ChGlobal.h"
 #include "chrono/core/ChTimer.h"
 
@@ -383,7 +384,7 @@ void ChPacejkaTire::Advance(double step) {
 
     // Update M_x, apply to both m_FM and m_FM_combined
     // gamma should already be corrected for L/R side, so need to swap Fy if on opposite side
-    double Mx = m_sameSide * calc_Mx(m_sameSide * m_FM_combined.force.y(), m_slip->gammaP);
+    double Mx = m_sameSide * calc_Mx(m_slip->gammaP, m_sameSide * m_FM_combined.force.y());
     m_FM_pure.moment.x() = Mx;
     m_FM_combined.moment.x() = Mx;
 
@@ -1316,6 +1317,144 @@ double ChPacejkaTire::calc_My(double Fx_combined) {
     return M_y;
 }
 
+// -----------------------------------------------------------------------------
+// Batched evaluation of the steady-state combined slip reactions.
+// The per-sample computations are the same as in the pure and combined slip
+// functions above (with cos(alpha') = 1 and positive forward velocity), written
+// without branches and without updating the intermediate coefficient structures,
+// so that the loop over samples can be vectorized.
+// -----------------------------------------------------------------------------
+void ChPacejkaTire::EvaluateReactions(size_t num,
+                                      const double* kappa,
+                                      const double* alpha,
+                                      const double* gamma,
+                                      const double* Fz,
+                                      double* Fx,
+                                      double* Fy,
+                                      double* Mx,
+                                      double* Mz) const {
+    const longitudinal_coefficients& lo = m_params->longitudinal;
+    const lateral_coefficients& la = m_params->lateral;
+    const aligning_coefficients& al = m_params->aligning;
+    const overturning_coefficients& ov = m_params->overturning;
+    const scaling_coefficients& sc = m_params->scaling;
+    const zetaCoefs z = *m_zeta;
+
+    const double fnomin = m_params->vertical.fnomin;
+    const double Fz_max = Fz_thresh;
+    const double R0 = m_R0;
+
+    // Load-independent coefficients
+    const double C_x = lo.pcx1 * sc.lcx;
+    const double C_y = la.pcy1 * sc.lcy;
+    const double C_r = z.z7;
+    const double C_t = al.qcz1;
+    const double C_xAlpha = lo.rcx1;
+    const double C_yKappa = la.rcy1;
+    const double S_HxAlpha = lo.rhx1;
+    const double rbx3 = 1.0;
+    const double rby4 = 0;
+
+#ifdef CHRONO_OMP_40
+#pragma omp simd
+#endif
+    for (size_t i = 0; i < num; i++) {
+        // Samples without vertical load are evaluated at the nominal load and then zeroed
+        double on = (Fz[i] > 0) ? 1.0 : 0.0;
+        double F_z = (Fz[i] > 0) ? std::min(Fz[i], Fz_max) : fnomin;
+        double dF_z = (F_z - fnomin) / fnomin;
+        // Magic Formula inputs, as set by the kinematic slips in Advance()
+        double g = std::sin(gamma[i]);
+        double k = kappa[i];
+        double a = std::tan(alpha[i]);
+        double cos_a = std::cos(alpha[i]);
+
+        // Fx, pure longitudinal slip
+        double S_Hx = (lo.phx1 + lo.phx2 * dF_z) * sc.lhx;
+        double kappa_x = k + S_Hx;
+        double mu_x = (lo.pdx1 + lo.pdx2 * dF_z) * (1.0 - lo.pdx3 * g * g) * sc.lmux;
+        double K_x = F_z * (lo.pkx1 + lo.pkx2 * dF_z) * std::exp(lo.pkx3 * dF_z) * sc.lkx;
+        double D_x = mu_x * F_z * z.z1;
+        double B_x = K_x / (C_x * D_x);
+        double sign_kap = (kappa_x >= 0) ? 1.0 : -1.0;
+        double E_x = (lo.pex1 + lo.pex2 * dF_z + lo.pex3 * dF_z * dF_z) * (1.0 - lo.pex4 * sign_kap) * sc.lex;
+        double S_Vx = F_z * (lo.pvx1 + lo.pvx2 * dF_z) * sc.lvx * sc.lmux * z.z1;
+        double Bk = B_x * kappa_x;
+        double Fx0 = D_x * std::sin(C_x * std::atan(Bk - E_x * (Bk - std::atan(Bk)))) - S_Vx;
+
+        // Fy, pure lateral slip
+        double mu_y = (la.pdy1 + la.pdy2 * dF_z) * (1.0 - la.pdy3 * g * g) * sc.lmuy;
+        double D_y = mu_y * F_z * z.z2;
+        double K_y = la.pky1 * fnomin * std::sin(2.0 * std::atan(F_z / (la.pky2 * fnomin))) *
+                     (1.0 - la.pky3 * std::abs(g)) * z.z3 * sc.lyka;
+        double B_y = K_y / (C_y * D_y);
+        double S_Hy = (la.phy1 + la.phy2 * dF_z) * sc.lhy + (la.phy3 * g * z.z0) + z.z4 - 1;
+        double alpha_y = a + S_Hy;
+        double sign_alpha = (alpha_y >= 0) ? 1.0 : -1.0;
+        double E_y = (la.pey1 + la.pey2 * dF_z) * (1.0 - (la.pey3 + la.pey4 * g) * sign_alpha) * sc.ley;
+        double S_Vy = F_z * ((la.pvy1 + la.pvy2 * dF_z) * sc.lvy + (la.pvy3 + la.pvy4 * dF_z) * g) * sc.lmuy * z.z2;
+        double Ba = B_y * alpha_y;
+        double Fy0 = D_y * std::sin(C_y * std::atan(Ba - E_y * (Ba - std::atan(Ba)))) + S_Vy;
+
+        // Mz, pure lateral slip (coefficients only)
+        double alpha_r = a + S_Hy + S_Vy / K_y;
+        double alpha_t = a + al.qhz1 + al.qhz2 * dF_z + (al.qhz3 + al.qhz4 * dF_z) * g;
+        double B_r = (al.qbz9 * (sc.lky / sc.lmuy) + al.qbz10 * B_y * C_y) * z.z6;
+        double D_r =
+            F_z * R0 * ((al.qdz6 + al.qdz7 * dF_z) * sc.lres + (al.qdz8 + al.qdz9 * dF_z) * g) * sc.lmuy * cos_a +
+            z.z8 - 1.0;
+        double B_t = (al.qbz1 + al.qbz2 * dF_z + al.qbz3 * dF_z * dF_z) *
+                     (1.0 + al.qbz4 * g + al.qbz5 * std::abs(g)) * sc.lvyka / sc.lmuy;
+        double D_t = F_z * (R0 / fnomin) * (al.qdz1 + al.qdz2 * dF_z) *
+                     (1.0 + al.qdz3 * std::abs(g) + al.qdz4 * g * g) * z.z5 * sc.ltr;
+        double E_t = (al.qez1 + al.qez2 * dF_z + al.qez3 * dF_z * dF_z) *
+                     (1.0 + (al.qez4 + al.qez5 * g) * (2.0 / CH_C_PI) * std::atan(B_t * C_t * alpha_t));
+
+        // Fx, combined slip
+        double alpha_S = a + S_HxAlpha;
+        double B_xAlpha = (lo.rbx1 + rbx3 * g * g) * std::cos(std::atan(lo.rbx2 * k)) * sc.lxal;
+        double E_xAlpha = lo.rex1 + lo.rex2 * dF_z;
+        double Bx0 = B_xAlpha * S_HxAlpha;
+        double Bx1 = B_xAlpha * alpha_S;
+        double G_xAlpha = std::cos(C_xAlpha * std::atan(Bx1 - E_xAlpha * (Bx1 - std::atan(Bx1)))) /
+                          std::cos(C_xAlpha * std::atan(Bx0 - E_xAlpha * (Bx0 - std::atan(Bx0))));
+        double F_x = G_xAlpha * Fx0;
+
+        // Fy, combined slip
+        double S_HyKappa = la.rhy1 + la.rhy2 * dF_z;
+        double kappa_S = k + S_HyKappa;
+        double B_yKappa = (la.rby1 + rby4 * g * g) * std::cos(std::atan(la.rby2 * (a - la.rby3))) * sc.lyka;
+        double E_yKappa = la.rey1 + la.rey2 * dF_z;
+        double D_VyKappa = mu_y * F_z * (la.rvy1 + la.rvy2 * dF_z + la.rvy3 * g) * std::cos(std::atan(la.rvy4 * a)) *
+                           z.z2;
+        double S_VyKappa = D_VyKappa * std::sin(la.rvy5 * std::atan(la.rvy6 * k)) * sc.lvyka;
+        double By0 = B_yKappa * S_HyKappa;
+        double By1 = B_yKappa * kappa_S;
+        double G_yKappa = std::cos(C_yKappa * std::atan(By1 - E_yKappa * (By1 - std::atan(By1)))) /
+                          std::cos(C_yKappa * std::atan(By0 - E_yKappa * (By0 - std::atan(By0))));
+        double F_y = G_yKappa * Fy0 + S_VyKappa;
+
+        // Mz, combined slip
+        double FP_y = F_y - S_VyKappa;
+        double s = R0 * (al.ssz1 + al.ssz2 * (F_y / fnomin) + (al.ssz3 + al.ssz4 * dF_z) * g) * sc.ls;
+        double Kk = (K_x / K_y) * k;
+        double alpha_t_eq = ((alpha_t >= 0) ? 1.0 : -1.0) * std::sqrt(alpha_t * alpha_t + Kk * Kk);
+        double alpha_r_eq = ((alpha_r >= 0) ? 1.0 : -1.0) * std::sqrt(alpha_r * alpha_r + Kk * Kk);
+        double M_zr = D_r * std::cos(C_r * std::atan(B_r * alpha_r_eq)) * cos_a;
+        double Bt = B_t * alpha_t_eq;
+        double t = D_t * std::cos(C_t * std::atan(Bt - E_t * (Bt - std::atan(Bt)))) * cos_a;
+        double M_z = -t * FP_y + M_zr + s * F_x;
+
+        // Mx, overturning couple
+        double M_x = F_z * R0 * (ov.qsx1 - ov.qsx2 * g + ov.qsx3 * (F_y / fnomin)) * sc.lmx;
+
+        Fx[i] = on * F_x;
+        Fy[i] = on * F_y;
+        Mx[i] = on * M_x;
+        Mz[i] = on * M_z;
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Load a PacTire specification file.
 //
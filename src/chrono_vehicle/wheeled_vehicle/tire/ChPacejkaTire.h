@@ -129,6 +129,26 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
     /// Manually set the vertical wheel load as an input.
     void set_Fz_override(double Fz) { m_Fz_override = Fz; }
 
+    /// Evaluate the steady-state combined slip reactions for a batch of wheel states.
+    /// All arrays have length 'num'. Slips, camber angles, and the output reactions are
+    /// expressed in the TYDEX W-Axis system, for the tire side specified in the parameter
+    /// file. The slips are used as given (no transient slip model) and the wheel is assumed
+    /// to roll forward; as in Advance(), the Magic Formula is evaluated with tan(alpha) and
+    /// sin(gamma). The vertical load is capped as in Advance(); entries with a zero or
+    /// negative load return zero reactions. This function does not change the state of the
+    /// tire, so it can be used to evaluate at once the reactions of all tires (or all time
+    /// samples) that share the parameters of this tire. The tire must be initialized.
+    void EvaluateReactions(size_t num,             ///< [in] number of wheel states
+                           const double* kappa,    ///< [in] longitudinal slips
+                           const double* alpha,    ///< [in] slip angles
+                           const double* gamma,    ///< [in] camber angles
+                           const double* Fz,       ///< [in] vertical loads
+                           double* Fx,             ///< [out] longitudinal forces
+                           double* Fy,             ///< [out] lateral forces
+                           double* Mx,             ///< [out] overturning moments
+                           double* Mz              ///< [out] aligning moments
+                           ) const;
+
     /// Return orientation, Vx (global) and omega/omega_y (global).
     /// Assumes the tire is going straight forward (global x-dir), and the
     /// returned state's orientation yields gamma and alpha, as x and z NASA angles
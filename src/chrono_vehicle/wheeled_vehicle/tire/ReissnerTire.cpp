@@ -21,7 +21,7 @@
 #include "chrono_fea/ChElementHexa_8.h"
 #include "chrono_fea/ChLinkPointTriface.h"
 
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace chrono::fea;
 using namespace rapidjson;
@@ -49,15 +49,8 @@ static ChQuaternion<> loadQuaternion(const Value& a) {
 // Constructors for ReissnerTire
 // -----------------------------------------------------------------------------
 ReissnerTire::ReissnerTire(const std::string& filename) : ChReissnerTire("") {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     ProcessJSON(d);
 
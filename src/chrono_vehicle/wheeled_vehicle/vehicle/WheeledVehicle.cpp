@@ -51,7 +51,7 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 using namespace rapidjson;
 
@@ -77,15 +77,8 @@ static ChQuaternion<> loadQuaternion(const Value& a) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadChassis(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a chassis specification file.
     assert(d.HasMember("Type"));
@@ -107,15 +100,8 @@ void WheeledVehicle::LoadChassis(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadSteering(const std::string& filename, int which) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a steering specification file.
     assert(d.HasMember("Type"));
@@ -139,15 +125,8 @@ void WheeledVehicle::LoadSteering(const std::string& filename, int which) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadDriveline(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a driveline specification file.
     assert(d.HasMember("Type"));
@@ -173,15 +152,8 @@ void WheeledVehicle::LoadDriveline(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadSuspension(const std::string& filename, int axle) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a suspension specification file.
     assert(d.HasMember("Type"));
@@ -215,15 +187,8 @@ void WheeledVehicle::LoadSuspension(const std::string& filename, int axle) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadAntirollbar(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is an antirollbar specification file.
     assert(d.HasMember("Type"));
@@ -244,15 +209,8 @@ void WheeledVehicle::LoadAntirollbar(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadWheel(const std::string& filename, int axle, int side) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a wheel specification file.
     assert(d.HasMember("Type"));
@@ -274,15 +232,8 @@ void WheeledVehicle::LoadWheel(const std::string& filename, int axle, int side)
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadBrake(const std::string& filename, int axle, int side) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Check that the given file is a brake specification file.
     assert(d.HasMember("Type"));
@@ -318,15 +269,8 @@ void WheeledVehicle::Create(const std::string& filename) {
     // -------------------------------------------
     // Open and parse the input file
     // -------------------------------------------
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
     Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    ReadFileJSON(filename, d);
 
     // Read top-level data
     assert(d.HasMember("Type"));
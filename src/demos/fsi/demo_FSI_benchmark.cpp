@@ -0,0 +1,200 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark of the fluid dynamics backends of Chrono::FSI. A block of fluid
+// collapses in a closed box (dam break). The same problem can be run with the
+// CUDA or the OpenMP backend and the throughput is reported in particle-steps
+// per second.
+//
+// Usage: demo_FSI_benchmark [cpu|gpu] [num_steps] [num_threads]
+// =============================================================================
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChUtilsGenerators.h"
+
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChFsiTypeConvert.h"
+#include "chrono_fsi/ChSystemFsi.h"
+#include "chrono_fsi/utils/ChUtilsGeneratorFsi.h"
+
+using namespace chrono;
+
+using std::cout;
+using std::endl;
+
+typedef fsi::Real Real;
+
+// Dimensions of the box (half sizes) and of the fluid block
+Real hdimX = 1.0;
+Real hdimY = 0.5;
+Real hdimZ = 0.5;
+Real hthick = 0.1;
+
+Real fluidDimX = 0.8;
+Real fluidHeight = 0.6;
+
+//------------------------------------------------------------------
+// Set the simulation parameters, following SetupParamsH of the
+// cylinder drop demo
+//------------------------------------------------------------------
+
+void SetupParams(fsi::SimParams* paramsH) {
+    paramsH->sizeScale = 1;
+    paramsH->HSML = 0.04;
+    paramsH->MULT_INITSPACE = 1.0;
+    paramsH->epsMinMarkersDis = .001;
+    paramsH->NUM_BOUNDARY_LAYERS = 3;
+    paramsH->toleranceZone = paramsH->NUM_BOUNDARY_LAYERS * (paramsH->HSML * paramsH->MULT_INITSPACE);
+    paramsH->BASEPRES = 0;
+    paramsH->LARGE_PRES = 0;
+    paramsH->deltaPress = fsi::mR3(0);
+    paramsH->multViscosity_FSI = 1;
+    paramsH->gravity = fsi::mR3(0, 0, -9.81);
+    paramsH->bodyForce3 = fsi::mR3(0, 0, 0);
+    paramsH->rho0 = 1000;
+    paramsH->markerMass = pow(paramsH->MULT_INITSPACE * paramsH->HSML, 3) * paramsH->rho0;
+    paramsH->mu0 = .001;
+    paramsH->v_Max = 3;
+    paramsH->EPS_XSPH = .5f;
+    paramsH->dT = 2e-4;
+    paramsH->tFinal = 1;
+    paramsH->timePause = 0;
+    paramsH->kdT = 5;
+    paramsH->gammaBB = 0.5;
+    paramsH->densityReinit = 0;
+    paramsH->enableTweak = 1;
+    paramsH->enableAggressiveTweak = 0;
+    paramsH->tweakMultV = 0.1;
+    paramsH->tweakMultRho = .002;
+    paramsH->bceType = fsi::ADAMI;
+
+    // The domain includes the walls and their BCE markers
+    Real margin = 2 * hthick + 4 * paramsH->HSML;
+    paramsH->cMin = fsi::mR3(-hdimX - margin, -hdimY - margin, -hdimZ - margin);
+    paramsH->cMax = fsi::mR3(hdimX + margin, hdimY + margin, hdimZ + margin);
+
+    // Bins are cubes of size at least 2 * HSML that tile the domain
+    Real binSize = 2 * paramsH->HSML;
+    int3 side = mI3(int(ceil((paramsH->cMax.x - paramsH->cMin.x) / binSize)),
+                    int(ceil((paramsH->cMax.y - paramsH->cMin.y) / binSize)),
+                    int(ceil((paramsH->cMax.z - paramsH->cMin.z) / binSize)));
+    paramsH->binSize0 = binSize;
+    paramsH->cMax = paramsH->cMin + binSize * fsi::mR3(side);
+    paramsH->boxDims = paramsH->cMax - paramsH->cMin;
+    paramsH->gridSize = side;
+    paramsH->worldOrigin = paramsH->cMin;
+    paramsH->cellSize = fsi::mR3(binSize, binSize, binSize);
+
+    paramsH->cMinInit = fsi::mR3(-hdimX, -hdimY, -hdimZ);
+    paramsH->cMaxInit = fsi::mR3(-hdimX + fluidDimX, hdimY, -hdimZ + fluidHeight);
+    paramsH->straightChannelBoundaryMin = paramsH->cMinInit;
+    paramsH->straightChannelBoundaryMax = paramsH->cMaxInit;
+}
+
+//------------------------------------------------------------------
+// Create the fixed box and its BCE markers
+//------------------------------------------------------------------
+
+void CreateContainer(ChSystem& mphysicalSystem, fsi::ChSystemFsi& myFsiSystem, fsi::SimParams* paramsH) {
+    auto ground = std::make_shared<ChBody>();
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(false);
+    mphysicalSystem.AddBody(ground);
+
+    ChVector<> sizeBottom(hdimX + 2 * hthick, hdimY + 2 * hthick, hthick);
+    ChVector<> sizeX(hthick, hdimY + 2 * hthick, hdimZ);
+    ChVector<> sizeY(hdimX, hthick, hdimZ);
+
+    fsi::ChFsiDataManager* fsiData = myFsiSystem.GetDataManager();
+    fsi::utils::AddBoxBce(fsiData, paramsH, ground, ChVector<>(0, 0, -hdimZ - hthick), QUNIT, sizeBottom);
+    fsi::utils::AddBoxBce(fsiData, paramsH, ground, ChVector<>(-hdimX - hthick, 0, 0), QUNIT, sizeX);
+    fsi::utils::AddBoxBce(fsiData, paramsH, ground, ChVector<>(hdimX + hthick, 0, 0), QUNIT, sizeX);
+    fsi::utils::AddBoxBce(fsiData, paramsH, ground, ChVector<>(0, -hdimY - hthick, 0), QUNIT, sizeY);
+    fsi::utils::AddBoxBce(fsiData, paramsH, ground, ChVector<>(0, hdimY + hthick, 0), QUNIT, sizeY);
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    fsi::ChFsiBackend backend = fsi::ChFsiBackend::CPU;
+    int numSteps = 200;
+    int threads = 0;
+
+    if (argc > 1) {
+        backend = (std::string(argv[1]) == "gpu") ? fsi::ChFsiBackend::GPU : fsi::ChFsiBackend::CPU;
+    }
+    if (argc > 2) {
+        numSteps = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        threads = atoi(argv[3]);
+    }
+    if (threads > 0) {
+        CHOMPfunctions::SetNumThreads(threads);
+    }
+
+    ChSystem mphysicalSystem;
+    fsi::ChSystemFsi myFsiSystem(&mphysicalSystem, true);
+    myFsiSystem.SetBackend(backend);
+
+    fsi::SimParams* paramsH = myFsiSystem.GetSimParams();
+    SetupParams(paramsH);
+    mphysicalSystem.Set_G_acc(ChVector<>(paramsH->gravity.x, paramsH->gravity.y, paramsH->gravity.z));
+
+    // Fluid markers
+    Real initSpace0 = paramsH->MULT_INITSPACE * paramsH->HSML;
+    utils::GridSampler<> sampler(initSpace0);
+    fsi::Real3 boxCenter = 0.5 * (paramsH->cMinInit + paramsH->cMaxInit);
+    fsi::Real3 boxHalfDim = 0.5 * (paramsH->cMaxInit - paramsH->cMinInit) - fsi::mR3(initSpace0);
+    utils::Generator::PointVector points = sampler.SampleBox(fsi::ChFsiTypeConvert::Real3ToChVector(boxCenter),
+                                                             fsi::ChFsiTypeConvert::Real3ToChVector(boxHalfDim));
+    int numPart = points.size();
+    for (int i = 0; i < numPart; i++) {
+        myFsiSystem.GetDataManager()->AddSphMarker(fsi::mR3(points[i].x(), points[i].y(), points[i].z()), fsi::mR3(0),
+                                                   fsi::mR4(paramsH->rho0, paramsH->BASEPRES, paramsH->mu0, -1));
+    }
+    myFsiSystem.GetDataManager()->fsiGeneralData.referenceArray.push_back(mI4(0, numPart, -1, -1));
+    myFsiSystem.GetDataManager()->fsiGeneralData.referenceArray.push_back(mI4(numPart, numPart, 0, 0));
+
+    // Walls
+    CreateContainer(mphysicalSystem, myFsiSystem, paramsH);
+
+    myFsiSystem.Finalize();
+    myFsiSystem.InitializeChronoGraphics(ChVector<>(0, -4, 0), ChVector<>(0, 0, 0));
+
+    int numMarkers = myFsiSystem.GetDataManager()->numObjects.numAllMarkers;
+    cout << "Backend:          " << (backend == fsi::ChFsiBackend::CPU ? "cpu" : "gpu") << endl;
+    cout << "Threads:          " << CHOMPfunctions::GetMaxThreads() << endl;
+    cout << "Fluid markers:    " << numPart << endl;
+    cout << "All markers:      " << numMarkers << endl;
+    cout << "Steps:            " << numSteps << endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int tStep = 0; tStep < numSteps; tStep++) {
+        myFsiSystem.DoStepDynamics_FSI();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    cout << "Elapsed time (s): " << seconds << endl;
+    cout << "Particle-steps/s: " << double(numMarkers) * numSteps / seconds << endl;
+
+    return 0;
+}
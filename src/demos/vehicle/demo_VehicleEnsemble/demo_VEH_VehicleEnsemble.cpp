@@ -0,0 +1,205 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Demonstration of a batch of independent vehicle simulations run concurrently
+// in one process. Each member of the ensemble is a wheeled vehicle specified
+// through JSON files, driven through a step-steer maneuver of different
+// amplitude. Tire and powertrain specification files are parsed only once and
+// shared by all members.
+//
+// Usage: demo_VEH_VehicleEnsemble [num_members] [num_threads]
+//
+// The vehicle reference frame has Z up, X towards the front of the vehicle, and
+// Y pointing to the left.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/driver/ChDataDriver.h"
+#include "chrono_vehicle/powertrain/SimplePowertrain.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/utils/ChVehicleEnsemble.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/RigidTire.h"
+#include "chrono_vehicle/wheeled_vehicle/vehicle/WheeledVehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// =============================================================================
+
+// JSON files for vehicle, terrain, powertrain and tire models
+std::string vehicle_file("generic/vehicle/Vehicle_DoubleWishbones.json");
+std::string rigidterrain_file("terrain/RigidPlane.json");
+std::string simplepowertrain_file("generic/powertrain/SimplePowertrain.json");
+std::string rigidtire_file("generic/tire/RigidTire.json");
+
+// Initial vehicle position and orientation
+ChVector<> initLoc(0, 0, 1.0);
+ChQuaternion<> initRot(1, 0, 0, 0);
+
+// Simulation step size and length
+double step_size = 1e-3;
+double tend = 5.0;
+
+// =============================================================================
+
+// One member of the ensemble: vehicle, terrain, powertrain, tires and driver,
+// all attached to the vehicle's own ChSystem.
+class StepSteerRun : public ChVehicleEnsemble::Member {
+  public:
+    StepSteerRun(double steering) : m_steering(steering), m_max_roll(0) {}
+
+    virtual void Initialize(ChVehicleEnsemble& ensemble) override {
+        m_vehicle = std::make_shared<WheeledVehicle>(vehicle::GetDataFile(vehicle_file), ChMaterialSurfaceBase::DEM);
+        m_vehicle->Initialize(ChCoordsys<>(initLoc, initRot));
+
+        m_terrain = std::make_shared<RigidTerrain>(m_vehicle->GetSystem(), vehicle::GetDataFile(rigidterrain_file));
+
+        // Specification files shared with the other members
+        auto powertrain_doc = ensemble.GetJSON(vehicle::GetDataFile(simplepowertrain_file));
+        auto tire_doc = ensemble.GetJSON(vehicle::GetDataFile(rigidtire_file));
+
+        m_powertrain = std::make_shared<SimplePowertrain>(*powertrain_doc);
+        m_powertrain->Initialize(m_vehicle->GetChassisBody(), m_vehicle->GetDriveshaft());
+
+        int num_wheels = 2 * m_vehicle->GetNumberAxles();
+        m_tires.resize(num_wheels);
+        for (int i = 0; i < num_wheels; i++) {
+            m_tires[i] = std::make_shared<RigidTire>(*tire_doc);
+            m_tires[i]->Initialize(m_vehicle->GetWheelBody(i), VehicleSide(i % 2));
+        }
+
+        // Accelerate, then apply the steering step at 2 s
+        std::vector<ChDataDriver::Entry> data;
+        data.push_back(ChDataDriver::Entry(0.0, 0, 0.5, 0));
+        data.push_back(ChDataDriver::Entry(2.0, 0, 0.5, 0));
+        data.push_back(ChDataDriver::Entry(2.1, m_steering, 0.5, 0));
+        data.push_back(ChDataDriver::Entry(tend, m_steering, 0.5, 0));
+        m_driver = std::make_shared<ChDataDriver>(*m_vehicle, data);
+        m_driver->Initialize();
+
+        m_tire_forces.resize(num_wheels);
+        m_wheel_states.resize(num_wheels);
+    }
+
+    virtual ChVehicle& GetVehicle() override { return *m_vehicle; }
+
+    virtual void Synchronize(double time) override {
+        // Collect output data from modules (for inter-module communication)
+        double throttle_input = m_driver->GetThrottle();
+        double steering_input = m_driver->GetSteering();
+        double braking_input = m_driver->GetBraking();
+        double powertrain_torque = m_powertrain->GetOutputTorque();
+        double driveshaft_speed = m_vehicle->GetDriveshaftSpeed();
+        for (size_t i = 0; i < m_tires.size(); i++) {
+            m_tire_forces[i] = m_tires[i]->GetTireForce();
+            m_wheel_states[i] = m_vehicle->GetWheelState(i);
+        }
+
+        // Update modules (process inputs from other modules)
+        m_driver->Synchronize(time);
+        m_powertrain->Synchronize(time, throttle_input, driveshaft_speed);
+        m_vehicle->Synchronize(time, steering_input, braking_input, powertrain_torque, m_tire_forces);
+        m_terrain->Synchronize(time);
+        for (size_t i = 0; i < m_tires.size(); i++)
+            m_tires[i]->Synchronize(time, m_wheel_states[i], *m_terrain);
+    }
+
+    virtual void Advance(double step) override {
+        m_driver->Advance(step);
+        m_powertrain->Advance(step);
+        m_vehicle->Advance(step);
+        m_terrain->Advance(step);
+        for (size_t i = 0; i < m_tires.size(); i++)
+            m_tires[i]->Advance(step);
+
+        // Track the largest roll angle of the chassis
+        ChVector<> y_axis = m_vehicle->GetVehicleRot().GetYaxis();
+        m_max_roll = std::max(m_max_roll, std::abs(std::asin(ChClamp(y_axis.z(), -1.0, 1.0))));
+    }
+
+    virtual void Finalize() override {
+        m_final_speed = m_vehicle->GetVehicleSpeed();
+
+        // Release the subsystems of this run
+        m_tires.clear();
+        m_driver.reset();
+        m_powertrain.reset();
+        m_terrain.reset();
+        m_vehicle.reset();
+    }
+
+    double GetSteering() const { return m_steering; }
+    double GetMaxRoll() const { return m_max_roll; }
+    double GetFinalSpeed() const { return m_final_speed; }
+
+  private:
+    double m_steering;
+    double m_max_roll;
+    double m_final_speed;
+
+    std::shared_ptr<WheeledVehicle> m_vehicle;
+    std::shared_ptr<RigidTerrain> m_terrain;
+    std::shared_ptr<SimplePowertrain> m_powertrain;
+    std::vector<std::shared_ptr<RigidTire> > m_tires;
+    std::shared_ptr<ChDataDriver> m_driver;
+
+    TireForces m_tire_forces;
+    WheelStates m_wheel_states;
+};
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    int num_members = 8;
+    int num_threads = 0;
+
+    if (argc > 1)
+        num_members = atoi(argv[1]);
+    if (argc > 2)
+        num_threads = atoi(argv[2]);
+
+    ChVehicleEnsemble ensemble;
+    if (num_threads > 0)
+        ensemble.SetNumThreads(num_threads);
+
+    std::vector<std::shared_ptr<StepSteerRun> > runs;
+    for (int i = 0; i < num_members; i++) {
+        double steering = (num_members > 1) ? -1.0 + 2.0 * i / (num_members - 1) : 0.5;
+        auto run = std::make_shared<StepSteerRun>(steering);
+        runs.push_back(run);
+        ensemble.AddMember(run);
+    }
+
+    ensemble.Run(tend, step_size);
+
+    for (auto run : runs) {
+        std::cout << "steering: " << run->GetSteering() << "   max roll: " << run->GetMaxRoll()
+                  << "   final speed: " << run->GetFinalSpeed() << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Members:          " << ensemble.GetNumMembers() << std::endl;
+    std::cout << "Threads:          " << ensemble.GetNumThreads() << std::endl;
+    std::cout << "Steps:            " << ensemble.GetNumSteps() << std::endl;
+    std::cout << "Simulated time:   " << ensemble.GetSimulatedTime() << std::endl;
+    std::cout << "Wall time (s):    " << ensemble.GetWallTime() << std::endl;
+    std::cout << "Throughput:       " << ensemble.GetThroughput() << " sim s / wall s" << std::endl;
+
+    return 0;
+}
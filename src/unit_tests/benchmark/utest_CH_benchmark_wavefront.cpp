@@ -0,0 +1,90 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2013 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+// -----------------------------------------------------------------------
+// Benchmark of the Wavefront parsers of ChTriangleMeshConnected: the
+// sequential parser (LoadWavefrontMeshSequential) and the parallel parser
+// (LoadWavefrontMesh), with an increasing number of OpenMP threads.
+//
+// Usage:  utest_CH_benchmark_wavefront [file.obj]
+// Without arguments, a grid mesh with 2 million triangles is generated.
+// -----------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+using namespace chrono;
+using namespace chrono::geometry;
+
+void WriteGrid(const std::string& filename, int n) {
+    FILE* fp = fopen(filename.c_str(), "w");
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            fprintf(fp, "v %.6f %.6f %.6f\n", i * 0.1, j * 0.1, 0.01 * ((i * 7 + j * 13) % 17));
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            fprintf(fp, "vn %.6f %.6f %.6f\nvt %.6f %.6f\n", 0.0, 0.1 * ((i + j) % 3), 1.0, (double)i / n,
+                    (double)j / n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int a = i * (n + 1) + j + 1;
+            int b = a + n + 1;
+            fprintf(fp, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, b + 1, b + 1, b + 1);
+            fprintf(fp, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b + 1, b + 1, b + 1, a + 1, a + 1, a + 1);
+        }
+    }
+    fclose(fp);
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = "utest_benchmark_wavefront.obj";
+    bool generated = (argc < 2);
+    if (generated)
+        WriteGrid(filename, 1000);
+    else
+        filename = argv[1];
+
+    ChTimer<double> timer;
+
+    ChTriangleMeshConnected mesh_seq;
+    timer.start();
+    mesh_seq.LoadWavefrontMeshSequential(filename, true, true);
+    timer.stop();
+    double time_seq = timer();
+    std::cout << "triangles: " << mesh_seq.getIndicesVertexes().size() << std::endl;
+    std::cout << "sequential parser:  " << time_seq << " s" << std::endl;
+
+    int max_threads = CHOMPfunctions::GetNumProcs();
+    for (int threads = 1;; threads = std::min(2 * threads, max_threads)) {
+        CHOMPfunctions::SetNumThreads(threads);
+        ChTriangleMeshConnected mesh;
+        timer.reset();
+        timer.start();
+        mesh.LoadWavefrontMesh(filename, true, true);
+        timer.stop();
+        bool same = mesh.getIndicesVertexes() == mesh_seq.getIndicesVertexes() &&
+                    mesh.getCoordsVertices().size() == mesh_seq.getCoordsVertices().size();
+        std::cout << "parallel parser, " << threads << " threads:  " << timer() << " s  (speedup "
+                  << time_seq / timer() << ")" << (same ? "" : "  MISMATCH") << std::endl;
+        if (threads >= max_threads)
+            break;
+    }
+
+    if (generated)
+        std::remove(filename.c_str());
+
+    return 0;
+}
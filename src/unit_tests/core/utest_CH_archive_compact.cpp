@@ -0,0 +1,286 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2013 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+// -----------------------------------------------------------------------
+// Unit test for the compact binary archive. Objects with matrices, vectors,
+// shared pointers and polymorphic classes are serialized and deserialized,
+// then compared with the originals. Size and timing are also compared with
+// those of the default binary archive.
+// A large ChSystem (bodies connected by revolute joints) is also written with
+// both archives, and its state vectors are read back and compared.
+// Note: ChSystem::ArchiveIN cannot restore a whole system with any archive
+// (collision models, solvers etc. are not registered in the class factory),
+// so only the state of the system is read back.
+// -----------------------------------------------------------------------
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChClassFactory.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/serialization/ChArchiveBinary.h"
+#include "chrono/serialization/ChArchiveBinaryCompact.h"
+
+using namespace chrono;
+
+// A simple polymorphic hierarchy, registered in the class factory.
+
+class myItem {
+  public:
+    int id;
+    double value;
+    std::vector<double> samples;
+
+    myItem() : id(0), value(0) {}
+    virtual ~myItem() {}
+
+    virtual void ArchiveOUT(ChArchiveOut& marchive) {
+        marchive.VersionWrite<myItem>();
+        marchive << CHNVP(id);
+        marchive << CHNVP(value);
+        marchive << CHNVP(samples);
+    }
+    virtual void ArchiveIN(ChArchiveIn& marchive) {
+        int version = marchive.VersionRead<myItem>();
+        marchive >> CHNVP(id);
+        marchive >> CHNVP(value);
+        marchive >> CHNVP(samples);
+    }
+};
+
+CH_FACTORY_REGISTER(myItem)
+
+class myLabeledItem : public myItem {
+  public:
+    std::string label;
+    ChMatrixDynamic<> matrix;
+    std::shared_ptr<myItem> link;
+
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override {
+        marchive.VersionWrite<myLabeledItem>();
+        myItem::ArchiveOUT(marchive);
+        marchive << CHNVP(label);
+        marchive << CHNVP(matrix);
+        marchive << CHNVP(link);
+    }
+    virtual void ArchiveIN(ChArchiveIn& marchive) override {
+        int version = marchive.VersionRead<myLabeledItem>();
+        myItem::ArchiveIN(marchive);
+        marchive >> CHNVP(label);
+        marchive >> CHNVP(matrix);
+        marchive >> CHNVP(link);
+    }
+};
+
+CH_FACTORY_REGISTER(myLabeledItem)
+
+// ------------------------------------------------------------------
+
+std::vector<std::shared_ptr<myItem>> CreateItems(int num_items) {
+    std::vector<std::shared_ptr<myItem>> items;
+    for (int i = 0; i < num_items; i++) {
+        std::shared_ptr<myItem> item;
+        if (i % 2) {
+            auto labeled = std::make_shared<myLabeledItem>();
+            labeled->label = "item_" + std::to_string(i);
+            labeled->matrix.Reset(6, 6);
+            for (int k = 0; k < 36; k++)
+                labeled->matrix.ElementN(k) = 0.1 * i + k;
+            labeled->link = items[i - 1];  // shared with the previous item
+            item = labeled;
+        } else {
+            item = std::make_shared<myItem>();
+        }
+        item->id = -i;
+        item->value = 1.5 * i;
+        item->samples.resize(i % 50);
+        for (size_t k = 0; k < item->samples.size(); k++)
+            item->samples[k] = 1.0 / (k + 1) + i;
+        items.push_back(item);
+    }
+    return items;
+}
+
+bool CompareItems(const std::vector<std::shared_ptr<myItem>>& a, const std::vector<std::shared_ptr<myItem>>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i]->id != b[i]->id || a[i]->value != b[i]->value || a[i]->samples != b[i]->samples)
+            return false;
+        auto la = std::dynamic_pointer_cast<myLabeledItem>(a[i]);
+        auto lb = std::dynamic_pointer_cast<myLabeledItem>(b[i]);
+        if (!la != !lb)
+            return false;
+        if (!la)
+            continue;
+        if (la->label != lb->label || !la->matrix.Equals(lb->matrix))
+            return false;
+        // Shared pointers must be rebuilt as shared, not duplicated
+        if (lb->link != b[i - 1])
+            return false;
+    }
+    return true;
+}
+
+template <class ArchiveOut, class ArchiveIn>
+bool TestArchive(const std::string& name,
+                 const std::string& filename,
+                 const std::vector<std::shared_ptr<myItem>>& items,
+                 long& size,
+                 double& time) {
+    ChTimer<> timer;
+    timer.reset();
+    timer.start();
+    {
+        ChStreamOutBinaryFile mfileo(filename.c_str());
+        ArchiveOut marchiveout(mfileo);
+        marchiveout << CHNVP(items);
+    }
+    std::vector<std::shared_ptr<myItem>> items_in;
+    {
+        ChStreamInBinaryFile mfilei(filename.c_str());
+        ArchiveIn marchivein(mfilei);
+        marchivein >> CHNVP(items_in);
+    }
+    timer.stop();
+    time = timer();
+
+    FILE* file = fopen(filename.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fclose(file);
+    std::remove(filename.c_str());
+
+    bool passed = CompareItems(items, items_in);
+    std::cout << name << ": " << size << " bytes, " << time << " s  " << (passed ? "Passed" : "Failed") << std::endl;
+    return passed;
+}
+
+// ------------------------------------------------------------------
+
+void CreateSystem(ChSystem& system, int num_bodies) {
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(0.1 * i, 0.01 * i, 0));
+        body->SetPos_dt(ChVector<>(0, 1e-3 * i, 0));
+        body->SetMass(1.0 + i % 7);
+        system.AddBody(body);
+
+        auto joint = std::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(0.1 * i, 0, 0)));
+        system.AddLink(joint);
+        prev = body;
+    }
+    system.Setup();
+}
+
+template <class ArchiveOut, class ArchiveIn>
+bool TestSystemArchive(const std::string& name,
+                       const std::string& filename,
+                       ChSystem& system,
+                       long& size,
+                       double& time) {
+    ChState x(system.GetNcoords_x(), &system);
+    ChStateDelta v(system.GetNcoords_v(), &system);
+    double T;
+    system.StateGather(x, v, T);
+
+    ChTimer<> timer;
+    timer.reset();
+    timer.start();
+    {
+        ChStreamOutBinaryFile mfileo(filename.c_str());
+        ArchiveOut marchiveout(mfileo);
+        marchiveout << CHNVP(x);
+        marchiveout << CHNVP(v);
+        marchiveout << CHNVP(T);
+        marchiveout << CHNVP(system);
+    }
+    timer.stop();
+    time = timer();
+
+    FILE* file = fopen(filename.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fclose(file);
+
+    // Read back the state, which precedes the system data
+    ChState x_in;
+    ChStateDelta v_in;
+    double T_in;
+    {
+        ChStreamInBinaryFile mfilei(filename.c_str());
+        ArchiveIn marchivein(mfilei);
+        marchivein >> CHNVP(x_in);
+        marchivein >> CHNVP(v_in);
+        marchivein >> CHNVP(T_in);
+    }
+    std::remove(filename.c_str());
+
+    bool passed = x.Equals(x_in) && v.Equals(v_in) && T == T_in;
+    std::cout << name << " (system): " << size << " bytes, write " << time << " s  "
+              << (passed ? "Passed" : "Failed") << std::endl;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    auto items = CreateItems(20000);
+
+    long size_binary, size_compact;
+    double time_binary, time_compact;
+    bool passed = true;
+
+    try {
+        passed &= TestArchive<ChArchiveOutBinary, ChArchiveInBinary>("binary ", "archive_binary.dat", items,
+                                                                      size_binary, time_binary);
+        passed &= TestArchive<ChArchiveOutBinaryCompact, ChArchiveInBinaryCompact>(
+            "compact", "archive_compact.dat", items, size_compact, time_compact);
+    } catch (ChException& e) {
+        std::cout << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "size ratio: " << (double)size_binary / size_compact
+              << "   time ratio: " << time_binary / time_compact << std::endl;
+
+    // The compact archive must not be larger than the default binary one
+    passed &= (size_compact < size_binary);
+
+    ChSystem system;
+    CreateSystem(system, 5000);
+
+    try {
+        passed &= TestSystemArchive<ChArchiveOutBinary, ChArchiveInBinary>("binary ", "archive_binary.dat", system,
+                                                                            size_binary, time_binary);
+        passed &= TestSystemArchive<ChArchiveOutBinaryCompact, ChArchiveInBinaryCompact>(
+            "compact", "archive_compact.dat", system, size_compact, time_compact);
+    } catch (ChException& e) {
+        std::cout << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "size ratio: " << (double)size_binary / size_compact
+              << "   time ratio: " << time_binary / time_compact << std::endl;
+
+    passed &= (size_compact < size_binary);
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
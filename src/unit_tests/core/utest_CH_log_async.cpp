@@ -0,0 +1,120 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2013 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+// -----------------------------------------------------------------------
+// Unit test for the asynchronous logger. Several threads send messages,
+// both with the CH_LOG macro and with the << operator (with a level set by
+// each thread with the - operator); all messages must be written, complete,
+// in order for each thread and with their level, and the messages of
+// disabled levels must be discarded.
+// -----------------------------------------------------------------------
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChLogAsync.h"
+#include "chrono/core/ChTimer.h"
+
+using namespace chrono;
+
+// Expected level of a message: every fourth message is a warning.
+ChLog::eChLogLevel MessageLevel(int message) {
+    return (message % 4 == 0) ? ChLog::CHWARNING : ChLog::CHMESSAGE;
+}
+
+// Log collecting all the text written to it, and checking the level of each message.
+class myCollectorLog : public ChLog {
+  public:
+    virtual void OutputMessage(eChLogLevel mlev, const char* data, size_t n) override {
+        text.append(data, n);
+        std::string line(data, n);
+        int thread, message;
+        eChLogLevel expected = CHMESSAGE;
+        if (sscanf(line.c_str(), "thread %d message %d", &thread, &message) == 2)
+            expected = MessageLevel(message);
+        if (mlev != expected)
+            wrong_levels++;
+    }
+
+    std::string text;
+    int wrong_levels = 0;
+
+  protected:
+    virtual void Output(const char* data, size_t n) override { text.append(data, n); }
+};
+
+int num_threads = 4;
+int num_messages = 20000;
+
+void SendMessages(int thread) {
+    for (int i = 0; i < num_messages; i++) {
+        if (i % 2)
+            CH_LOG(ChLog::CHMESSAGE) << "thread " << thread << " message " << i;
+        else
+            GetLog() - MessageLevel(i) << "thread " << thread << " message " << i << "\n";
+        CH_LOG(ChLog::CHTRACE) << "disabled " << thread;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    myCollectorLog collector;
+    ChTimer<> timer;
+    unsigned long long dropped;
+
+    {
+        ChLogAsync async_log(&collector, 1 << 15);
+        SetLog(async_log);
+
+        timer.start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++)
+            threads.push_back(std::thread(SendMessages, t));
+        for (auto& t : threads)
+            t.join();
+        timer.stop();
+
+        GetLog() << "last line, without newline";
+        GetLog().Flush();
+        dropped = async_log.GetNumDropped();
+
+        SetLogDefault();
+    }
+
+    // Check that the messages of each thread are all present, and in order.
+    bool passed = (dropped == 0 && collector.wrong_levels == 0);
+    std::vector<int> next(num_threads, 0);
+    std::istringstream lines(collector.text);
+    std::string line;
+    int num_lines = 0;
+    while (std::getline(lines, line)) {
+        num_lines++;
+        int thread, message;
+        if (sscanf(line.c_str(), "thread %d message %d", &thread, &message) == 2) {
+            passed &= (thread >= 0 && thread < num_threads && message == next[thread]);
+            if (thread >= 0 && thread < num_threads)
+                next[thread]++;
+        } else {
+            passed &= (line == "last line, without newline");
+        }
+    }
+    for (int t = 0; t < num_threads; t++)
+        passed &= (next[t] == num_messages);
+    passed &= (num_lines == num_threads * num_messages + 1);
+
+    std::cout << "messages: " << num_lines << "  dropped: " << dropped << "  wrong levels: " << collector.wrong_levels
+              << "  time: " << timer() << " s  " << (passed ? "Passed" : "Failed") << std::endl;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,159 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2013 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+// -----------------------------------------------------------------------
+// Unit test for the model cache. A Wavefront file is loaded with and
+// without the cache, and the meshes are compared; the cached image must
+// be invalidated when the file changes. The convex decomposition of a
+// mesh is also compared with its cached image.
+// -----------------------------------------------------------------------
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChModelCache.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace chrono::geometry;
+
+// Write a grid of n x n quads, as triangles with normals and UV coordinates.
+void WriteGrid(const std::string& filename, int n, double height) {
+    FILE* fp = fopen(filename.c_str(), "w");
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            fprintf(fp, "v %g %g %g\n", (double)i, (double)j, height * ((i + j) % 3));
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            fprintf(fp, "vn 0 0 1\nvt %g %g\n", (double)i / n, (double)j / n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int a = i * (n + 1) + j + 1;
+            int b = a + n + 1;
+            fprintf(fp, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, b + 1, b + 1, b + 1);
+            fprintf(fp, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b + 1, b + 1, b + 1, a + 1, a + 1, a + 1);
+        }
+    }
+    fclose(fp);
+}
+
+void WriteBox(const std::string& filename) {
+    FILE* fp = fopen(filename.c_str(), "w");
+    fprintf(fp, "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0 0 1\nv 1 0 1\nv 1 1 1\nv 0 1 1\n");
+    fprintf(fp, "f 1 3 2\nf 1 4 3\nf 5 6 7\nf 5 7 8\nf 1 2 6\nf 1 6 5\n");
+    fprintf(fp, "f 2 3 7\nf 2 7 6\nf 3 4 8\nf 3 8 7\nf 4 1 5\nf 4 5 8\n");
+    fclose(fp);
+}
+
+template <class T>
+bool Equal(const std::vector<T>& a, const std::vector<T>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!(a[i] == b[i]))
+            return false;
+    }
+    return true;
+}
+
+bool Equal(ChTriangleMeshConnected& a, ChTriangleMeshConnected& b) {
+    return Equal(a.getCoordsVertices(), b.getCoordsVertices()) && Equal(a.getCoordsNormals(), b.getCoordsNormals()) &&
+           Equal(a.getCoordsUV(), b.getCoordsUV()) && Equal(a.getIndicesVertexes(), b.getIndicesVertexes()) &&
+           Equal(a.getIndicesNormals(), b.getIndicesNormals()) && Equal(a.getIndicesUV(), b.getIndicesUV());
+}
+
+bool Check(const std::string& name, bool passed) {
+    std::cout << name << ": " << (passed ? "Passed" : "Failed") << std::endl;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    std::string mesh_file = "utest_model_cache_grid.obj";
+    std::string box_file = "utest_model_cache_box.obj";
+    WriteGrid(mesh_file, 200, 0.1);
+    WriteBox(box_file);
+
+    bool passed = true;
+    ChTimer<double> timer;
+
+    // Reference meshes, parsed without cache
+    ChModelCache::SetDirectory("");
+    ChTriangleMeshConnected mesh_ref;
+    timer.start();
+    mesh_ref.LoadWavefrontMesh(mesh_file, true, true);
+    timer.stop();
+    double time_parse = timer();
+    ChTriangleMeshConnected mesh_ref_nouv;
+    mesh_ref_nouv.LoadWavefrontMesh(mesh_file, true, false);
+
+    ChModelCache::SetDirectory("utest_model_cache");
+
+    // First load stores the image, then the image is loaded
+    ChTriangleMeshConnected mesh1;
+    mesh1.LoadWavefrontMesh(mesh_file, true, true);
+    passed &= Check("mesh (stored)", Equal(mesh1, mesh_ref));
+
+    ChTriangleMeshConnected mesh2;
+    timer.reset();
+    timer.start();
+    mesh2.LoadWavefrontMesh(mesh_file, true, true);
+    timer.stop();
+    double time_cache = timer();
+    passed &= Check("mesh (cached)", Equal(mesh2, mesh_ref));
+    passed &= Check("mesh filename", mesh2.GetFileName() == mesh_file);
+
+    ChTriangleMeshConnected mesh3;
+    mesh3.LoadWavefrontMesh(mesh_file, true, false);
+    passed &= Check("mesh without UV (cached)", Equal(mesh3, mesh_ref_nouv));
+
+    std::string key;
+    ChModelCache::GetKey(mesh_file, "obj", "2", key);
+    passed &= Check("image", (bool)ChModelCache::Load(key));
+
+    // Changing the file invalidates the image
+    WriteGrid(mesh_file, 200, 0.2);
+    std::string key_changed;
+    ChModelCache::GetKey(mesh_file, "obj", "2", key_changed);
+    passed &= Check("key changed", key_changed != key);
+
+    ChTriangleMeshConnected mesh4;
+    mesh4.LoadWavefrontMesh(mesh_file, true, true);
+    ChModelCache::SetDirectory("");
+    ChTriangleMeshConnected mesh4_ref;
+    mesh4_ref.LoadWavefrontMesh(mesh_file, true, true);
+    passed &= Check("mesh (changed file)", Equal(mesh4, mesh4_ref) && !Equal(mesh4, mesh_ref));
+
+    // Convex decomposition, computed then cached
+    ChTriangleMeshConnected box_mesh;
+    std::vector<std::vector<ChVector<> > > hulls_ref;
+    utils::LoadConvexMesh(box_file, box_mesh, hulls_ref, ChVector<>(1, 2, 3));
+
+    ChModelCache::SetDirectory("utest_model_cache");
+    std::vector<std::vector<ChVector<> > > hulls1;
+    std::vector<std::vector<ChVector<> > > hulls2;
+    utils::LoadConvexMesh(box_file, box_mesh, hulls1, ChVector<>(1, 2, 3));
+    utils::LoadConvexMesh(box_file, box_mesh, hulls2, ChVector<>(1, 2, 3));
+    bool hulls_equal = !hulls_ref.empty() && hulls1.size() == hulls_ref.size() && hulls2.size() == hulls_ref.size();
+    for (size_t c = 0; hulls_equal && c < hulls_ref.size(); c++)
+        hulls_equal = Equal(hulls1[c], hulls_ref[c]) && Equal(hulls2[c], hulls_ref[c]);
+    passed &= Check("convex hulls", hulls_equal);
+
+    ChModelCache::SetDirectory("");
+    std::remove(mesh_file.c_str());
+    std::remove(box_file.c_str());
+
+    std::cout << "parse: " << time_parse << " s  cache: " << time_cache << " s" << std::endl;
+
+    return !passed;
+}
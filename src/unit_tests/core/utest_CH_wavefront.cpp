@@ -0,0 +1,120 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2013 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+// -----------------------------------------------------------------------
+// Unit test for the parallel Wavefront parser of ChTriangleMeshConnected.
+// Meshes are loaded with LoadWavefrontMesh and with the sequential parser
+// (LoadWavefrontMeshSequential), and compared. The sequential parser reads
+// coordinates in single precision.
+// -----------------------------------------------------------------------
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+using namespace chrono;
+using namespace chrono::geometry;
+
+bool Equal(const std::vector<ChVector<double> >& a, const std::vector<ChVector<double> >& b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+            if ((float)a[i][k] != (float)b[i][k])
+                return false;
+        }
+    }
+    return true;
+}
+
+bool Equal(const std::vector<ChVector<int> >& a, const std::vector<ChVector<int> >& b) {
+    return a == b;
+}
+
+bool Compare(const std::string& name, const std::string& filename) {
+    ChTriangleMeshConnected mesh;
+    mesh.LoadWavefrontMesh(filename, true, true);
+    ChTriangleMeshConnected mesh_ref;
+    mesh_ref.LoadWavefrontMeshSequential(filename, true, true);
+
+    bool passed = !mesh.getIndicesVertexes().empty() &&
+                  Equal(mesh.getCoordsVertices(), mesh_ref.getCoordsVertices()) &&
+                  Equal(mesh.getCoordsNormals(), mesh_ref.getCoordsNormals()) &&
+                  Equal(mesh.getCoordsUV(), mesh_ref.getCoordsUV()) &&
+                  Equal(mesh.getIndicesVertexes(), mesh_ref.getIndicesVertexes()) &&
+                  Equal(mesh.getIndicesNormals(), mesh_ref.getIndicesNormals()) &&
+                  Equal(mesh.getIndicesUV(), mesh_ref.getIndicesUV());
+    std::cout << name << ": " << mesh.getIndicesVertexes().size() << " triangles  " << (passed ? "Passed" : "Failed")
+              << std::endl;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = "utest_wavefront.obj";
+    bool passed = true;
+
+    // Triangles and quads, with all face vertex formats, comment lines, CRLF line ends and blank lines
+    FILE* fp = fopen(filename.c_str(), "wb");
+    fprintf(fp, "# test mesh\r\n\r\nmtllib test.mtl\r\no box\r\n");
+    fprintf(fp, "v 0 0 0\r\nv 1.5 0 0\r\nv 1.5 1 0\r\nv 0 1 0\r\n");
+    fprintf(fp, "v 0 0 1e-3\r\nv 1.5 0 1.25E+1\r\nv\t1.5\t1\t-0.1\r\nv -0 1 .5\r\n");
+    fprintf(fp, "vt 0 0\r\nvt 1 0 0\r\nvt 1 1\r\nvt 0 1\r\n");
+    fprintf(fp, "vn 0 0 -1\r\nvn 0 0 1\r\nvn 0.3333333333333333 0.6666666666666666 0.123456789012345678901\r\n");
+    fprintf(fp, "usemtl red\r\ns off\r\n");
+    fprintf(fp, "f 1/1/1 3/3/1 2/2/1\r\nf 1/1/1 4/4/1 3/3/1\r\n");
+    fprintf(fp, "f 5/1/2 6/2/2 7/3/2 8/4/2\r\n");
+    fprintf(fp, "f 1//3 2//3 6//3 5//3\r\n");
+    fprintf(fp, "f 2 3 7\r\nf 2 7 6");
+    fclose(fp);
+    passed &= Compare("formats", filename);
+
+    // Large mesh (parsed in several chunks), with polygonal faces
+    fp = fopen(filename.c_str(), "w");
+    int n = 300;
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            fprintf(fp, "v %.6f %.6f %.9g\nvt %g %g\nvn 0 %.4f 1\n", i * 0.01, j * 0.01, 1e-3 * ((i * j) % 7),
+                    (double)i / n, (double)j / n, 0.001 * j);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j += 2) {
+            int a = i * (n + 1) + j + 1;
+            int b = a + n + 1;
+            fprintf(fp, "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, b + 1, b + 1,
+                    b + 1, b + 2, b + 2, b + 2, a + 2, a + 2, a + 2, a + 1, a + 1, a + 1);
+        }
+    }
+    fclose(fp);
+    passed &= Compare("grid", filename);
+
+    // Relative (negative) indexes and comments after the data, not supported by the sequential parser
+    fp = fopen(filename.c_str(), "w");
+    fprintf(fp, "v 0 0 0\nv 1 0 0\nv 1 1 0  # comment\nf -3 -2 -1\nv 0 1 0\nf 1 3 -1\n");
+    fclose(fp);
+    ChTriangleMeshConnected mesh;
+    mesh.LoadWavefrontMesh(filename);
+    bool relative = mesh.getCoordsVertices().size() == 4 && mesh.getIndicesVertexes().size() == 2 &&
+                    mesh.getIndicesVertexes()[0] == ChVector<int>(0, 1, 2) &&
+                    mesh.getIndicesVertexes()[1] == ChVector<int>(0, 2, 3);
+    std::cout << "relative indexes, comments: " << (relative ? "Passed" : "Failed") << std::endl;
+    passed &= relative;
+
+    // Missing file
+    mesh.LoadWavefrontMesh("utest_wavefront_missing.obj");
+    bool missing = mesh.getCoordsVertices().empty() && mesh.getIndicesVertexes().empty();
+    std::cout << "missing file: " << (missing ? "Passed" : "Failed") << std::endl;
+    passed &= missing;
+
+    std::remove(filename.c_str());
+
+    return !passed;
+}
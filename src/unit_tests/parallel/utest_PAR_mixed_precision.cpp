@@ -0,0 +1,151 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the mixed precision mode of the DVI solver.
+// A pile of balls is settled in a box, with and without mixed precision. The
+// test checks that:
+// - the single precision Shur product matches the double precision one, up to
+//   the single precision round-off;
+// - the solver residual and the contact force on the box are close to those
+//   of the double precision solve.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+#include "chrono_parallel/solver/ChSolverParallel.h"
+
+using namespace chrono;
+
+double time_step = 1e-3;
+double settle_time = 0.5;
+double radius = 0.1;
+
+double product_tolerance = 1e-5;  // relative difference of the Shur products
+double residual_tolerance = 1e-4;  // difference of the solver residuals
+double force_tolerance = 1e-3;     // relative difference of the contact forces
+
+ChSystemParallelDVI* CreatePile(bool mixed_precision, std::shared_ptr<ChBody>& container) {
+    ChSystemParallelDVI* system = new ChSystemParallelDVI;
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+    system->GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    system->GetSettings()->solver.max_iteration_normal = 0;
+    system->GetSettings()->solver.max_iteration_sliding = 200;
+    system->GetSettings()->solver.max_iteration_spinning = 0;
+    system->GetSettings()->solver.max_iteration_bilateral = 0;
+    system->GetSettings()->solver.tol_speed = 1e-6;
+    system->GetSettings()->solver.alpha = 0;
+    system->GetSettings()->solver.contact_recovery_speed = 1;
+    system->GetSettings()->solver.mixed_precision = mixed_precision;
+    system->GetSettings()->solver.refinement_iterations = 20;
+    system->GetSettings()->collision.collision_envelope = 0.05 * radius;
+    system->GetSettings()->collision.bins_per_axis = vec3(4, 4, 4);
+    system->ChangeSolverType(SolverType::APGD);
+
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.5f);
+
+    container = utils::CreateBoxContainer(system, 0, material, ChVector<>(0.4, 0.4, 0.4), 0.05, ChVector<>(0, 0, 0),
+                                          ChQuaternion<>(1, 0, 0, 0), true, false, true, false);
+
+    // 3 layers of 3 x 3 balls
+    int id = 1;
+    for (int k = 0; k < 3; k++) {
+        for (int i = -1; i <= 1; i++) {
+            for (int j = -1; j <= 1; j++) {
+                auto ball = std::shared_ptr<ChBody>(system->NewBody());
+                ball->SetIdentifier(id++);
+                ball->SetMass(1);
+                ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+                ball->SetPos(ChVector<>(2 * radius * i, 2 * radius * j, radius + 2 * radius * k));
+                ball->SetCollide(true);
+                ball->SetMaterialSurface(material);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), radius);
+                ball->GetCollisionModel()->BuildModel();
+                system->AddBody(ball);
+            }
+        }
+    }
+
+    while (system->GetChTime() < settle_time)
+        system->DoStepDynamics(time_step);
+
+    return system;
+}
+
+// Compare the single and double precision Shur products, with the matrices of the last step.
+bool TestProduct(ChSystemParallelDVI* system) {
+    ChParallelDataManager* data_manager = system->data_manager;
+    uint size = data_manager->num_constraints;
+
+    ChShurProduct product;
+    ChShurProductSingle product_single;
+    product.Setup(data_manager);
+    product_single.Setup(data_manager);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    DynamicVector<real> x(size);
+    for (uint i = 0; i < size; i++)
+        x[i] = distribution(generator);
+
+    DynamicVector<real> y(size), y_single(size);
+    product(x, y);
+    product_single(x, y_single);
+    // A second product reuses the single precision matrices of the step
+    product_single(x, y_single);
+
+    double error = std::sqrt((double)((y - y_single), (y - y_single)));
+    double norm = std::sqrt((double)(y, y));
+    std::cout << "Shur product: " << size << " constraints  relative difference " << error / norm << std::endl;
+    return size > 0 && error <= product_tolerance * norm;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    std::shared_ptr<ChBody> container;
+    ChSystemParallelDVI* system = CreatePile(false, container);
+    system->CalculateContactForces();
+    double force = system->GetBodyContactForce(container).z;
+    double residual = system->data_manager->measures.solver.residual;
+
+    std::shared_ptr<ChBody> container_mixed;
+    ChSystemParallelDVI* system_mixed = CreatePile(true, container_mixed);
+    system_mixed->CalculateContactForces();
+    double force_mixed = system_mixed->GetBodyContactForce(container_mixed).z;
+    double residual_mixed = system_mixed->data_manager->measures.solver.residual;
+
+    passed &= TestProduct(system_mixed);
+
+    std::cout << "residual: double " << residual << "  mixed " << residual_mixed << std::endl;
+    std::cout << "contact force: double " << force << "  mixed " << force_mixed << std::endl;
+    if (std::abs(residual_mixed - residual) > residual_tolerance) {
+        std::cout << "FAILED: residual" << std::endl;
+        passed = false;
+    }
+    if (std::abs(force_mixed - force) > force_tolerance * std::abs(force)) {
+        std::cout << "FAILED: contact force" << std::endl;
+        passed = false;
+    }
+
+    delete system;
+    delete system_mixed;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
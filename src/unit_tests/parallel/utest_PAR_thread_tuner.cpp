@@ -0,0 +1,87 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the per-phase thread tuner
+// =============================================================================
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include "chrono_parallel/ChThreadTuner.h"
+
+using namespace chrono;
+
+// Synthetic cost of a phase as a function of the number of threads, with a
+// minimum at sqrt(a/b) threads. A small deterministic perturbation mimics noise.
+double Cost(int threads, double a, double b, int sample) {
+    double noise = 0.01 * ((sample % 3) - 1);
+    return (a / threads + b * threads) * (1 + noise);
+}
+
+int main(int argc, char* argv[]) {
+    ChTimerParallel timer;
+    ChThreadTuner tuner;
+
+    // Set the thread range (no timers are registered, so no samples are added).
+    tuner.Update(timer, 1, 32);
+
+    // Broadphase scales well (optimum at 32 threads), the Shur product does not
+    // (optimum at 4 threads).
+    int sample = 0;
+    while (!tuner.IsConverged(TunedPhase::BROADPHASE) || !tuner.IsConverged(TunedPhase::SHUR_PRODUCT)) {
+        if (sample > 10000) {
+            std::cout << "Thread tuner did not converge" << std::endl;
+            return 1;
+        }
+        tuner.AddSample(TunedPhase::BROADPHASE, Cost(tuner.GetThreads(TunedPhase::BROADPHASE), 1.0, 1e-5, sample));
+        tuner.AddSample(TunedPhase::SHUR_PRODUCT, Cost(tuner.GetThreads(TunedPhase::SHUR_PRODUCT), 1.0, 0.0625, sample));
+        sample++;
+    }
+
+    int broad = tuner.GetThreads(TunedPhase::BROADPHASE);
+    int shur = tuner.GetThreads(TunedPhase::SHUR_PRODUCT);
+    std::cout << "broadphase: " << broad << " threads, Shur product: " << shur << " threads, after " << sample
+              << " samples" << std::endl;
+
+    if (broad < 28) {
+        std::cout << "Unexpected broadphase thread count" << std::endl;
+        return 1;
+    }
+    if (shur < 3 || shur > 5) {
+        std::cout << "Unexpected Shur product thread count" << std::endl;
+        return 1;
+    }
+
+    // Persist the learned values and reload them in a new tuner.
+    if (!tuner.Save("thread_tuner.dat")) {
+        std::cout << "Could not save thread counts" << std::endl;
+        return 1;
+    }
+
+    ChThreadTuner tuner2;
+    if (!tuner2.Load("thread_tuner.dat")) {
+        std::cout << "Could not load thread counts" << std::endl;
+        return 1;
+    }
+    tuner2.Update(timer, 1, 32);
+
+    if (!tuner2.IsConverged(TunedPhase::SHUR_PRODUCT) || tuner2.GetThreads(TunedPhase::SHUR_PRODUCT) != shur ||
+        tuner2.GetThreads(TunedPhase::BROADPHASE) != broad) {
+        std::cout << "Reloaded thread counts do not match" << std::endl;
+        return 1;
+    }
+
+    std::remove("thread_tuner.dat");
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the timer registry
+// =============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "chrono_parallel/ChTimerParallel.h"
+
+using namespace chrono;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cout << "FAILED: " << message << std::endl;
+        exit(1);
+    }
+}
+
+void Wait(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+int main(int argc, char* argv[]) {
+    ChTimerParallel timer;
+
+    int step = timer.AddTimer("step");
+    int solve = timer.AddTimer("solve", step);
+    int shur = timer.AddTimer("shur", "solve");
+
+    Check(step == 0 && solve == 1 && shur == 2, "timer handles");
+    Check(timer.AddTimer("solve") == solve, "re-registration returns the existing handle");
+    Check(timer.GetTimerId("shur") == shur, "lookup by name");
+    Check(timer.GetTimerId("unknown") == -1, "lookup of unknown timer");
+
+    // The name-based interface does not register timers.
+    timer.start("unknown");
+    timer.stop("unknown");
+    Check(timer.GetNumTimers() == 3, "start of unknown timer");
+
+    timer.SetTracing(true);
+
+    // Three frames, with 2, 4 and 6 ms spent in the inner timer.
+    for (int frame = 1; frame <= 3; frame++) {
+        timer.Reset();
+        timer.start(step);
+        timer.start(solve);
+        for (int i = 0; i < 2 * frame; i++) {
+            timer.start(shur);
+            Wait(1);
+            timer.stop(shur);
+        }
+        timer.stop(solve);
+        timer.stop(step);
+    }
+
+    Check(timer.GetRuns(shur) == 6, "number of runs");
+    Check(timer.GetTime(shur) >= 0.006, "accumulated time");
+    Check(timer.GetTime(step) >= timer.GetTime(solve), "nested times");
+    Check(timer.GetTime("shur") == timer.GetTime(shur), "access by name and handle");
+
+    // Close the last frame and check the window statistics.
+    timer.Reset();
+    Check(timer.GetRuns(shur) == 0 && timer.GetTime(shur) == 0, "reset");
+    Check(timer.GetMinTime(shur) >= 0.002 && timer.GetMinTime(shur) < timer.GetMaxTime(shur), "min/max statistics");
+    Check(timer.GetMeanTime(shur) >= timer.GetMinTime(shur) && timer.GetMeanTime(shur) <= timer.GetMaxTime(shur),
+          "mean statistics");
+
+    // A disabled registry does not accumulate anything.
+    timer.SetEnabled(false);
+    timer.start(shur);
+    Wait(1);
+    timer.stop(shur);
+    Check(timer.GetRuns(shur) == 0, "disabled timers");
+
+    // Trace output: one event per start/stop pair.
+    Check(timer.ExportTrace("timer_trace.json"), "trace export");
+    std::ifstream trace("timer_trace.json");
+    std::string contents((std::istreambuf_iterator<char>(trace)), std::istreambuf_iterator<char>());
+    size_t events = 0;
+    for (size_t pos = contents.find("\"ph\":\"X\""); pos != std::string::npos;
+         pos = contents.find("\"ph\":\"X\"", pos + 1))
+        events++;
+    Check(events == 18, "number of trace events");
+    trace.close();
+    std::remove("timer_trace.json");
+
+    // Concurrent use of a timer from all threads.
+    timer.SetEnabled(true);
+    timer.SetTracing(false);
+    int threads = CHOMPfunctions::GetNumProcs();
+#pragma omp parallel for num_threads(threads)
+    for (int i = 0; i < 100 * threads; i++) {
+        timer.start(shur);
+        timer.stop(shur);
+    }
+    Check(timer.GetRuns(shur) == 100 * threads, "parallel runs");
+
+    timer.PrintReport();
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the warm start of the DVI solver.
+// A pile of balls is settled in a box. The test checks that:
+// - with warm start, the impulses of the settled contacts are carried over to
+//   the next step (matched by shape pair), so that a step without iterations
+//   reproduces the contact forces of the previous step;
+// - with warm start, the solver needs fewer iterations on the settled pile.
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+
+double time_step = 1e-3;
+double settle_time = 1.0;
+int num_measured_steps = 100;
+double radius = 0.1;
+
+ChSystemParallelDVI* CreatePile(SolverType type, bool warm_start, std::vector<std::shared_ptr<ChBody>>& balls) {
+    ChSystemParallelDVI* system = new ChSystemParallelDVI;
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+    system->GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    system->GetSettings()->solver.max_iteration_normal = 0;
+    system->GetSettings()->solver.max_iteration_sliding = 1000;
+    system->GetSettings()->solver.max_iteration_spinning = 0;
+    system->GetSettings()->solver.max_iteration_bilateral = 0;
+    system->GetSettings()->solver.tol_speed = 1e-5;
+    system->GetSettings()->solver.alpha = 0;
+    system->GetSettings()->solver.contact_recovery_speed = 1;
+    system->GetSettings()->solver.warm_start = warm_start;
+    system->GetSettings()->collision.collision_envelope = 0.05 * radius;
+    system->GetSettings()->collision.bins_per_axis = vec3(4, 4, 4);
+    system->ChangeSolverType(type);
+
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.5f);
+
+    utils::CreateBoxContainer(system, 0, material, ChVector<>(0.4, 0.4, 0.4), 0.05, ChVector<>(0, 0, 0),
+                              ChQuaternion<>(1, 0, 0, 0), true, false, true, false);
+
+    // 3 layers of 3 x 3 balls, in contact with their neighbors
+    int id = 1;
+    for (int k = 0; k < 3; k++) {
+        for (int i = -1; i <= 1; i++) {
+            for (int j = -1; j <= 1; j++) {
+                auto ball = std::shared_ptr<ChBody>(system->NewBody());
+                ball->SetIdentifier(id++);
+                ball->SetMass(1);
+                ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+                ball->SetPos(ChVector<>(2 * radius * i, 2 * radius * j, radius + 2 * radius * k));
+                ball->SetCollide(true);
+                ball->SetMaterialSurface(material);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), radius);
+                ball->GetCollisionModel()->BuildModel();
+                system->AddBody(ball);
+                balls.push_back(ball);
+            }
+        }
+    }
+
+    while (system->GetChTime() < settle_time)
+        system->DoStepDynamics(time_step);
+
+    return system;
+}
+
+// Average number of solver iterations per step on the settled pile.
+double MeasureIterations(ChSystemParallelDVI* system) {
+    double iterations = 0;
+    for (int i = 0; i < num_measured_steps; i++) {
+        system->DoStepDynamics(time_step);
+        iterations += system->data_manager->measures.solver.total_iteration;
+    }
+    return iterations / num_measured_steps;
+}
+
+// Take one step without solver iterations and check that the contact forces on
+// the balls are those of the previous step.
+bool CheckCarryOver(ChSystemParallelDVI* system, const std::vector<std::shared_ptr<ChBody>>& balls) {
+    system->CalculateContactForces();
+    std::vector<real3> forces;
+    for (auto ball : balls)
+        forces.push_back(system->GetBodyContactForce(ball));
+
+    system->GetSettings()->solver.max_iteration_sliding = 0;
+    system->DoStepDynamics(time_step);
+    system->CalculateContactForces();
+    system->GetSettings()->solver.max_iteration_sliding = 1000;
+
+    double error = 0;
+    double scale = 0;
+    for (size_t i = 0; i < balls.size(); i++) {
+        real3 force = system->GetBodyContactForce(balls[i]);
+        error = std::max(error, (double)Length(force - forces[i]));
+        scale = std::max(scale, (double)Length(forces[i]));
+    }
+    std::cout << "  max force change: " << error << "  (max force: " << scale << ")" << std::endl;
+    return scale > 0 && error < 1e-3 * scale;
+}
+
+bool TestSolver(SolverType type, const char* name) {
+    std::cout << name << std::endl;
+    bool passed = true;
+
+    std::vector<std::shared_ptr<ChBody>> cold_balls;
+    ChSystemParallelDVI* cold = CreatePile(type, false, cold_balls);
+    double cold_iterations = MeasureIterations(cold);
+
+    std::vector<std::shared_ptr<ChBody>> warm_balls;
+    ChSystemParallelDVI* warm = CreatePile(type, true, warm_balls);
+    double warm_iterations = MeasureIterations(warm);
+
+    std::cout << "  iterations per step: cold " << cold_iterations << "  warm " << warm_iterations << std::endl;
+    if (!(warm_iterations < 0.8 * cold_iterations)) {
+        std::cout << "  FAILED: iteration count" << std::endl;
+        passed = false;
+    }
+
+    if (!CheckCarryOver(warm, warm_balls)) {
+        std::cout << "  FAILED: impulses not carried over" << std::endl;
+        passed = false;
+    }
+
+    delete cold;
+    delete warm;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= TestSolver(SolverType::APGD, "APGD");
+    passed &= TestSolver(SolverType::SPGQP, "SPGQP");
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,209 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the asynchronous binary output writer and reader.
+// A number of balls are dropped on the ground; body states and contact forces
+// are written at each step and compared, after reading them back, with the
+// values recorded during the simulation.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChSystemDEM.h"
+#include "chrono/utils/ChUtilsBinaryOutput.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// ====================================================================================
+
+double time_step = 1e-3;
+unsigned int num_steps = 200;
+unsigned int num_balls = 20;
+
+std::string output_file("binary_output_test.dat");
+
+// Forward declarations
+ChSystem* CreateSystem();
+bool test_roundtrip(ChBinaryOutputWriter::Compression compression);
+bool test_drop();
+
+// ====================================================================================
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_roundtrip(ChBinaryOutputWriter::Compression::NONE);
+    passed &= test_roundtrip(ChBinaryOutputWriter::Compression::SHUFFLE_RLE);
+    passed &= test_drop();
+
+    std::remove(output_file.c_str());
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
+
+// ====================================================================================
+
+ChSystem* CreateSystem() {
+    ChSystem* system = new ChSystemDEM();
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto material = std::make_shared<ChMaterialSurfaceDEM>();
+    material->SetYoungModulus(2e5f);
+    material->SetFriction(0.4f);
+
+    auto ground = std::shared_ptr<ChBody>(system->NewBody());
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->SetMaterialSurface(material);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), ChVector<>(5, 5, 0.1), ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+    system->AddBody(ground);
+
+    for (unsigned int i = 0; i < num_balls; i++) {
+        auto ball = std::shared_ptr<ChBody>(system->NewBody());
+        ball->SetIdentifier(i);
+        ball->SetMass(1);
+        ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+        ball->SetPos(ChVector<>(0.25 * (i % 5), 0.25 * (i / 5), 0.1 + 0.001 * i));
+        ball->SetPos_dt(ChVector<>(0.1 * i, 0, 0));
+        ball->SetCollide(true);
+        ball->SetMaterialSurface(material);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), 0.1);
+        ball->GetCollisionModel()->BuildModel();
+        system->AddBody(ball);
+    }
+
+    return system;
+}
+
+bool test_roundtrip(ChBinaryOutputWriter::Compression compression) {
+    std::cout << (compression == ChBinaryOutputWriter::Compression::NONE ? "No compression" : "Shuffle + RLE")
+              << std::endl;
+
+    ChSystem* system = CreateSystem();
+    auto& bodies = *system->Get_bodylist();
+
+    // Simulate and write all fields at each step, recording the expected values.
+    std::vector<double> times;
+    std::vector<std::vector<ChVector<>>> positions;
+    std::vector<std::vector<ChQuaternion<>>> rotations;
+    std::vector<std::vector<ChVector<>>> velocities;
+    std::vector<std::vector<ChVector<>>> forces;
+
+    {
+        ChBinaryOutputWriter writer(output_file, ChBinaryOutputWriter::ALL_FIELDS, compression);
+        for (unsigned int it = 0; it < num_steps; it++) {
+            system->DoStepDynamics(time_step);
+            writer.WriteFrame(system);
+
+            times.push_back(system->GetChTime());
+            positions.push_back(std::vector<ChVector<>>());
+            rotations.push_back(std::vector<ChQuaternion<>>());
+            velocities.push_back(std::vector<ChVector<>>());
+            forces.push_back(std::vector<ChVector<>>());
+            for (auto& body : bodies) {
+                positions.back().push_back(body->GetPos());
+                rotations.back().push_back(body->GetRot());
+                velocities.back().push_back(body->GetPos_dt());
+                forces.back().push_back(system->GetContactContainer()->GetContactableForce(body.get()));
+            }
+        }
+        writer.Flush();
+        if (writer.GetNumWritten() != num_steps || writer.GetNumDropped() != 0) {
+            std::cout << "  unexpected number of frames written" << std::endl;
+            delete system;
+            return false;
+        }
+    }
+
+    delete system;
+
+    // Read back and compare.
+    ChBinaryOutputReader reader(output_file);
+    if (!reader.IsOpen() || reader.GetFields() != ChBinaryOutputWriter::ALL_FIELDS) {
+        std::cout << "  cannot read output file" << std::endl;
+        return false;
+    }
+
+    bool passed = true;
+    size_t num_frames = 0;
+    while (reader.ReadFrame()) {
+        size_t it = num_frames++;
+        passed &= (reader.GetFrame() == it && reader.GetTime() == times[it]);
+        passed &= (reader.GetNumBodies() == num_balls + 1 && reader.GetIdentifiers()[1] == 0);
+        for (size_t i = 0; i < reader.GetNumBodies(); i++) {
+            passed &= (reader.GetVector(ChBinaryOutputWriter::POSITION, i) == positions[it][i]);
+            passed &= (reader.GetRotation(i) == rotations[it][i]);
+            passed &= (reader.GetVector(ChBinaryOutputWriter::LIN_VEL, i) == velocities[it][i]);
+            passed &= (reader.GetVector(ChBinaryOutputWriter::CONTACT_FORCE, i) == forces[it][i]);
+        }
+    }
+    passed &= (num_frames == num_steps);
+
+    std::cout << "  " << (passed ? "Passed" : "Failed") << std::endl;
+    return passed;
+}
+
+bool test_drop() {
+    std::cout << "Drop policy" << std::endl;
+
+    ChSystem* system = CreateSystem();
+
+    // Request frames much faster than they can be written.
+    unsigned int num_requests = 1000;
+    unsigned int num_written;
+    unsigned int num_dropped;
+    {
+        ChBinaryOutputWriter writer(output_file, ChBinaryOutputWriter::POSITION | ChBinaryOutputWriter::ROTATION,
+                                    ChBinaryOutputWriter::Compression::SHUFFLE_RLE,
+                                    ChBinaryOutputWriter::Backpressure::DROP);
+        unsigned int num_accepted = 0;
+        for (unsigned int i = 0; i < num_requests; i++) {
+            if (writer.WriteFrame(system))
+                num_accepted++;
+        }
+        writer.Flush();
+        num_written = writer.GetNumWritten();
+        num_dropped = writer.GetNumDropped();
+        if (num_accepted != num_written) {
+            std::cout << "  accepted frames not written" << std::endl;
+            delete system;
+            return false;
+        }
+    }
+
+    delete system;
+
+    // All written frames are read back, in increasing frame order.
+    ChBinaryOutputReader reader(output_file);
+    unsigned int num_frames = 0;
+    uint64_t last_frame = 0;
+    bool passed = true;
+    while (reader.ReadFrame()) {
+        passed &= (num_frames == 0 || reader.GetFrame() > last_frame);
+        last_frame = reader.GetFrame();
+        num_frames++;
+    }
+    passed &= (num_frames == num_written && num_written + num_dropped == num_requests);
+
+    std::cout << "  written: " << num_written << "  dropped: " << num_dropped << std::endl;
+    std::cout << "  " << (passed ? "Passed" : "Failed") << std::endl;
+    return passed;
+}
@@ -0,0 +1,185 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the binary checkpoint utilities.
+// A system with a pendulum chain and balls in contact with the ground is
+// simulated for a number of steps, checkpointed, and simulated further. The same
+// model is then rebuilt in a new system, restored from the checkpoint and
+// simulated for the same number of steps. The states of the two simulations
+// must be identical.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemDEM.h"
+#include "chrono/utils/ChUtilsCheckpoint.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+double time_step = 1e-3;
+int num_steps_before = 300;
+int num_steps_after = 100;
+
+std::string checkpoint_file("checkpoint_test.dat");
+
+// Forward declarations
+ChSystem* CreateSystem(ChMaterialSurfaceBase::ContactMethod method, bool original);
+bool test_checkpoint(ChMaterialSurfaceBase::ContactMethod method);
+
+// ====================================================================================
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_checkpoint(ChMaterialSurfaceBase::DVI);
+    passed &= test_checkpoint(ChMaterialSurfaceBase::DEM);
+
+    std::remove(checkpoint_file.c_str());
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
+
+// ====================================================================================
+
+// Create the test model: a fixed ground box, a chain of three pendulums connected
+// with revolute joints, and a few balls dropped on the ground. In the original
+// system, the last ball is moved and put to sleep.
+ChSystem* CreateSystem(ChMaterialSurfaceBase::ContactMethod method, bool original) {
+    ChSystem* system;
+    std::shared_ptr<ChMaterialSurfaceBase> material;
+
+    if (method == ChMaterialSurfaceBase::DEM) {
+        system = new ChSystemDEM();
+        auto mat = std::make_shared<ChMaterialSurfaceDEM>();
+        mat->SetYoungModulus(2e5f);
+        mat->SetFriction(0.4f);
+        mat->SetRestitution(0.1f);
+        material = mat;
+    } else {
+        system = new ChSystem();
+        auto mat = std::make_shared<ChMaterialSurface>();
+        mat->SetFriction(0.4f);
+        material = mat;
+    }
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto ground = std::shared_ptr<ChBody>(system->NewBody());
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->SetMaterialSurface(material);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), ChVector<>(5, 5, 0.1), ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+    system->AddBody(ground);
+
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < 3; i++) {
+        auto pend = std::shared_ptr<ChBody>(system->NewBody());
+        pend->SetMass(1);
+        pend->SetInertiaXX(ChVector<>(0.01, 0.1, 0.1));
+        pend->SetPos(ChVector<>(-3 + 0.5 * (i + 1), 0, 3));
+        system->AddBody(pend);
+
+        auto revolute = std::make_shared<ChLinkLockRevolute>();
+        revolute->Initialize(prev, pend, ChCoordsys<>(ChVector<>(-3 + 0.5 * i + 0.25, 0, 3), Q_from_AngX(CH_C_PI_2)));
+        system->AddLink(revolute);
+
+        prev = pend;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        auto ball = std::shared_ptr<ChBody>(system->NewBody());
+        ball->SetMass(1);
+        ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+        ball->SetPos(ChVector<>(0.3 * i, 0.1 * i, 0.1 + 0.02 * i));
+        ball->SetPos_dt(ChVector<>(0.5, 0, 0));
+        ball->SetCollide(true);
+        ball->SetMaterialSurface(material);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), 0.1);
+        ball->GetCollisionModel()->BuildModel();
+        system->AddBody(ball);
+
+        if (original && i == 3) {
+            ball->SetPos(ChVector<>(2, 2, 0.5));
+            ball->SetSleeping(true);
+        }
+    }
+
+    return system;
+}
+
+bool test_checkpoint(ChMaterialSurfaceBase::ContactMethod method) {
+    std::cout << (method == ChMaterialSurfaceBase::DEM ? "DEM" : "DVI") << " system" << std::endl;
+
+    // Original simulation
+    ChSystem* system = CreateSystem(method, true);
+    for (int i = 0; i < num_steps_before; i++)
+        system->DoStepDynamics(time_step);
+
+    if (!utils::WriteBinaryCheckpoint(system, checkpoint_file)) {
+        std::cout << "  cannot write checkpoint file" << std::endl;
+        delete system;
+        return false;
+    }
+
+    for (int i = 0; i < num_steps_after; i++)
+        system->DoStepDynamics(time_step);
+
+    // Restarted simulation
+    ChSystem* restart = CreateSystem(method, false);
+    if (!utils::ReadBinaryCheckpoint(restart, checkpoint_file)) {
+        std::cout << "  cannot read checkpoint file" << std::endl;
+        delete system;
+        delete restart;
+        return false;
+    }
+    for (int i = 0; i < num_steps_after; i++)
+        restart->DoStepDynamics(time_step);
+
+    // Compare final states
+    bool passed = (system->GetChTime() == restart->GetChTime());
+
+    auto& bodies = *system->Get_bodylist();
+    auto& restart_bodies = *restart->Get_bodylist();
+    for (size_t i = 0; i < bodies.size(); i++) {
+        bool match = bodies[i]->GetPos() == restart_bodies[i]->GetPos() &&
+                     bodies[i]->GetRot() == restart_bodies[i]->GetRot() &&
+                     bodies[i]->GetPos_dt() == restart_bodies[i]->GetPos_dt() &&
+                     bodies[i]->GetWvel_loc() == restart_bodies[i]->GetWvel_loc() &&
+                     bodies[i]->GetSleeping() == restart_bodies[i]->GetSleeping();
+        if (!match) {
+            std::cout << "  body " << i << " differs: |dpos| = "
+                      << (bodies[i]->GetPos() - restart_bodies[i]->GetPos()).Length() << std::endl;
+        }
+        passed &= match;
+    }
+
+    auto& links = *system->Get_linklist();
+    auto& restart_links = *restart->Get_linklist();
+    for (size_t i = 0; i < links.size(); i++)
+        passed &= (links[i]->Get_react_force() == restart_links[i]->Get_react_force());
+
+    std::cout << "  " << (passed ? "Passed" : "Failed") << std::endl;
+
+    delete system;
+    delete restart;
+
+    return passed;
+}
@@ -0,0 +1,152 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the bulk contact data query (ChContactContainerBase::GetContactData).
+// A pile of balls is settled on the ground, with both the DVI and DEM contact
+// containers; the contact arrays are compared with the data reported, one contact
+// at a time, through ReportAllContacts.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystemDEM.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+int num_balls = 128;
+int num_steps = 1000;
+
+// Contact data reported through the callback interface, in the same layout as ChContactArrays.
+class ContactCollector : public ChReportContactCallback {
+  public:
+    virtual bool ReportContactCallback(const ChVector<>& pA,
+                                       const ChVector<>& pB,
+                                       const ChMatrix33<>& plane_coord,
+                                       const double& distance,
+                                       const ChVector<>& react_forces,
+                                       const ChVector<>& react_torques,
+                                       ChContactable* contactobjA,
+                                       ChContactable* contactobjB) override {
+        data.objA.push_back(contactobjA);
+        data.objB.push_back(contactobjB);
+        data.idA.push_back(contactobjA->GetPhysicsItem()->GetIdentifier());
+        data.idB.push_back(contactobjB->GetPhysicsItem()->GetIdentifier());
+        data.pointA.push_back(pA);
+        data.pointB.push_back(pB);
+        data.normal.push_back(plane_coord.Get_A_Xaxis());
+        data.distance.push_back(distance);
+        data.force.push_back(plane_coord * react_forces);
+        data.torque.push_back(plane_coord * react_torques);
+        return true;
+    }
+
+    ChContactArrays data;
+};
+
+bool Equal(const ChVector<>& a, const ChVector<>& b) {
+    return (a - b).Length() <= 1e-10 * (1 + a.Length());
+}
+
+// ====================================================================================
+
+bool test_contact_data(ChSystem* system) {
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto ground = std::shared_ptr<ChBody>(system->NewBody());
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), ChVector<>(2, 2, 0.1), ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+    system->AddBody(ground);
+
+    for (int i = 0; i < num_balls; i++) {
+        auto ball = std::shared_ptr<ChBody>(system->NewBody());
+        ball->SetIdentifier(i);
+        ball->SetMass(1);
+        ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+        ball->SetPos(ChVector<>(0.21 * (i % 8) - 0.7, 0.21 * ((i / 8) % 8) - 0.7, 0.1 + 0.21 * (i / 64)));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), 0.1);
+        ball->GetCollisionModel()->BuildModel();
+        system->AddBody(ball);
+    }
+
+    for (int it = 0; it < num_steps; it++)
+        system->DoStepDynamics(1e-3);
+
+    auto container = system->GetContactContainer();
+
+    ChTimer<> timer_report;
+    ChTimer<> timer_bulk;
+
+    ContactCollector collector;
+    timer_report.start();
+    container->ReportAllContacts(&collector);
+    timer_report.stop();
+
+    ChContactArrays data;
+    timer_bulk.start();
+    container->GetContactData(data);
+    timer_bulk.stop();
+
+    const ChContactArrays& ref = collector.data;
+    size_t num_contacts = ref.GetNumContacts();
+    bool passed = (num_contacts > 0 && data.GetNumContacts() == num_contacts);
+
+    ChVector<> total_force(0);
+    for (size_t i = 0; passed && i < num_contacts; i++) {
+        passed &= (data.objA[i] == ref.objA[i] && data.objB[i] == ref.objB[i]);
+        passed &= (data.idA[i] == ref.idA[i] && data.idB[i] == ref.idB[i]);
+        passed &= (data.pointA[i] == ref.pointA[i] && data.pointB[i] == ref.pointB[i]);
+        passed &= (data.normal[i] == ref.normal[i] && data.distance[i] == ref.distance[i]);
+        passed &= Equal(data.force[i], ref.force[i]) && Equal(data.torque[i], ref.torque[i]);
+        if (data.idA[i] == -1)
+            total_force += data.force[i];
+        else if (data.idB[i] == -1)
+            total_force -= data.force[i];
+    }
+
+    // At rest, the ground supports the weight of all balls.
+    passed &= std::abs(total_force.z() - num_balls * 9.81) < 0.1 * num_balls * 9.81;
+
+    std::cout << "  contacts: " << num_contacts << "  ReportAllContacts: " << timer_report()
+              << " s  GetContactData: " << timer_bulk() << " s" << std::endl;
+    std::cout << "  " << (passed ? "Passed" : "Failed") << std::endl;
+    return passed;
+}
+
+// ====================================================================================
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    std::cout << "DVI contact container" << std::endl;
+    ChSystem system_dvi;
+    passed &= test_contact_data(&system_dvi);
+
+    std::cout << "DEM contact container" << std::endl;
+    ChSystemDEM system_dem;
+    passed &= test_contact_data(&system_dem);
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
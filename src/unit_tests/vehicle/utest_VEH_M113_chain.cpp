@@ -0,0 +1,190 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the reduced-order chain of single-pin track shoes.
+// The M113 is driven on rigid terrain with constant throttle, once with the
+// track shoes connected by joints and once with the reduced-order chain
+// (ChTrackAssemblySinglePin::EnableReducedChain). The test checks that the
+// chassis and track shoe positions (in the chassis frame) and the torque on the
+// sprocket gears are close in the two runs, and that the reduced chain is
+// rejected for a system with DVI contact.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChContactContainerBase.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/tracked_vehicle/track_assembly/ChTrackAssemblySinglePin.h"
+
+#include "chrono_models/vehicle/m113/M113_SimplePowertrain.h"
+#include "chrono_models/vehicle/m113/M113_Vehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::m113;
+
+double step_size = 1e-3;
+double settle_time = 0.5;  // time before the throttle is applied
+double end_time = 2.0;
+double avg_time = 0.5;    // final time interval over which the sprocket torque is averaged
+double throttle = 0.5;
+
+// Observed differences: chassis 0.011 m, shoes 0.042 m and 0.069 m, sprocket torque 0.7%
+double pos_tolerance = 0.02;     // chassis position [m]
+double shoe_tolerance = 0.08;    // shoe positions [m]
+double torque_tolerance = 0.02;  // sprocket torque, relative
+
+struct Results {
+    ChVector<> chassis_pos;
+    std::vector<ChVector<>> shoe_pos[2];  // shoe positions in the chassis frame
+    double sprocket_torque[2];            // sprocket torque, averaged over the final interval
+};
+
+Results Run(bool reduced_chain) {
+    M113_Vehicle vehicle(false, TrackShoeType::SINGLE_PIN, ChMaterialSurfaceBase::DEM);
+    if (reduced_chain) {
+        for (int side = 0; side < 2; side++) {
+            auto track = std::static_pointer_cast<ChTrackAssemblySinglePin>(
+                vehicle.GetTrackAssembly(static_cast<VehicleSide>(side)));
+            track->EnableReducedChain(1e8, 1e5, 1e5, 1e2);
+        }
+    }
+    vehicle.GetSystem()->SetMaxItersSolverSpeed(50);
+    vehicle.GetSystem()->SetMaxItersSolverStab(50);
+    vehicle.Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.1), QUNIT));
+
+    RigidTerrain terrain(vehicle.GetSystem());
+    terrain.SetContactFrictionCoefficient(0.9f);
+    terrain.SetContactRestitutionCoefficient(0.01f);
+    terrain.SetContactMaterialProperties(2e7f, 0.3f);
+    terrain.Initialize(0, 100, 100);
+
+    M113_SimplePowertrain powertrain;
+    powertrain.Initialize(vehicle.GetChassisBody(), vehicle.GetDriveshaft());
+
+    BodyStates shoe_states_left(vehicle.GetNumTrackShoes(LEFT));
+    BodyStates shoe_states_right(vehicle.GetNumTrackShoes(RIGHT));
+    TrackShoeForces shoe_forces_left(vehicle.GetNumTrackShoes(LEFT));
+    TrackShoeForces shoe_forces_right(vehicle.GetNumTrackShoes(RIGHT));
+
+    Results results;
+    results.sprocket_torque[0] = 0;
+    results.sprocket_torque[1] = 0;
+    int num_avg_steps = 0;
+
+    while (vehicle.GetChTime() < end_time) {
+        double time = vehicle.GetChTime();
+        double throttle_input = (time < settle_time) ? 0 : throttle;
+        double powertrain_torque = powertrain.GetOutputTorque();
+        double driveshaft_speed = vehicle.GetDriveshaftSpeed();
+        vehicle.GetTrackShoeStates(LEFT, shoe_states_left);
+        vehicle.GetTrackShoeStates(RIGHT, shoe_states_right);
+
+        terrain.Synchronize(time);
+        powertrain.Synchronize(time, throttle_input, driveshaft_speed);
+        vehicle.Synchronize(time, 0, 0, powertrain_torque, shoe_forces_left, shoe_forces_right);
+
+        terrain.Advance(step_size);
+        powertrain.Advance(step_size);
+        vehicle.Advance(step_size);
+
+        // Torque of the contact forces on the sprocket gears, about the gear axes
+        if (vehicle.GetChTime() > end_time - avg_time) {
+            auto contact_container = vehicle.GetSystem()->GetContactContainer();
+            for (int side = 0; side < 2; side++) {
+                auto gear = vehicle.GetTrackAssembly(static_cast<VehicleSide>(side))->GetSprocket()->GetGearBody();
+                ChVector<> torque = contact_container->GetContactableTorque(gear.get());
+                results.sprocket_torque[side] += Vdot(torque, gear->GetA().Get_A_Yaxis());
+            }
+            num_avg_steps++;
+        }
+    }
+
+    results.chassis_pos = vehicle.GetVehiclePos();
+    const ChFrameMoving<>& chassis = vehicle.GetChassisBody()->GetFrame_REF_to_abs();
+    for (int side = 0; side < 2; side++) {
+        auto track = vehicle.GetTrackAssembly(static_cast<VehicleSide>(side));
+        for (size_t i = 0; i < track->GetNumTrackShoes(); i++) {
+            ChVector<> pos = track->GetTrackShoe(i)->GetShoeBody()->GetPos();
+            results.shoe_pos[side].push_back(chassis.TransformPointParentToLocal(pos));
+        }
+        results.sprocket_torque[side] /= num_avg_steps;
+    }
+
+    return results;
+}
+
+int main(int argc, char* argv[]) {
+    Results joints = Run(false);
+    Results chain = Run(true);
+
+    bool passed = true;
+
+    double chassis_error = (chain.chassis_pos - joints.chassis_pos).Length();
+    std::cout << "chassis position: joints " << joints.chassis_pos.x() << " " << joints.chassis_pos.y() << " "
+              << joints.chassis_pos.z() << "  chain " << chain.chassis_pos.x() << " " << chain.chassis_pos.y() << " "
+              << chain.chassis_pos.z() << "  difference " << chassis_error << std::endl;
+    if (!(chassis_error <= pos_tolerance)) {
+        std::cout << "FAILED: chassis position" << std::endl;
+        passed = false;
+    }
+
+    for (int side = 0; side < 2; side++) {
+        // A NaN difference is kept and reported (std::max would drop it)
+        double shoe_error = 0;
+        for (size_t i = 0; i < joints.shoe_pos[side].size(); i++) {
+            double error = (chain.shoe_pos[side][i] - joints.shoe_pos[side][i]).Length();
+            if (std::isnan(error) || error > shoe_error)
+                shoe_error = error;
+        }
+        std::cout << "side " << side << ": max shoe position difference " << shoe_error << std::endl;
+        if (!(shoe_error <= shoe_tolerance)) {
+            std::cout << "FAILED: shoe positions" << std::endl;
+            passed = false;
+        }
+
+        double torque_joints = joints.sprocket_torque[side];
+        double torque_chain = chain.sprocket_torque[side];
+        std::cout << "side " << side << ": sprocket torque: joints " << torque_joints << "  chain " << torque_chain
+                  << std::endl;
+        if (!(std::abs(torque_chain - torque_joints) <= torque_tolerance * std::abs(torque_joints))) {
+            std::cout << "FAILED: sprocket torque" << std::endl;
+            passed = false;
+        }
+    }
+
+    // The reduced chain needs the contact forces of the current step (DEM only)
+    bool rejected = false;
+    try {
+        M113_Vehicle vehicle(false, TrackShoeType::SINGLE_PIN, ChMaterialSurfaceBase::DVI);
+        for (int side = 0; side < 2; side++) {
+            auto track = std::static_pointer_cast<ChTrackAssemblySinglePin>(
+                vehicle.GetTrackAssembly(static_cast<VehicleSide>(side)));
+            track->EnableReducedChain(1e8, 1e5, 1e5, 1e2);
+        }
+        vehicle.Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.1), QUNIT));
+    } catch (const ChException&) {
+        rejected = true;
+    }
+    std::cout << "reduced chain with DVI contact rejected: " << (rejected ? "yes" : "no") << std::endl;
+    if (!rejected) {
+        std::cout << "FAILED: DVI contact" << std::endl;
+        passed = false;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
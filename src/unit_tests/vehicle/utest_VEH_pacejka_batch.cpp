@@ -0,0 +1,111 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the batched Magic Formula evaluation of the Pacejka tire
+// (ChPacejkaTire::EvaluateReactions).
+// The HMMWV Pacejka tire is evaluated over a grid of longitudinal slips, slip
+// angles, camber angles and vertical loads, once sample by sample through
+// Synchronize/Advance (steady-state slips, vertical load override) and once in
+// a single batched call. The test checks that the combined slip reactions
+// (Fx, Fy, Mx, Mz) agree up to round-off.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChBody.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTire.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+std::string tire_file("hmmwv/tire/HMMWV_pacejka.tir");
+
+double kappa_grid[] = {-0.3, -0.1, -0.02, 0, 0.02, 0.1, 0.3};
+double alpha_grid[] = {-0.2, -0.05, 0, 0.05, 0.2};
+double gamma_grid[] = {-0.05, 0, 0.05};
+double Fz_grid[] = {1000, 4000, 8000, 15000};
+
+double speed = 10;       // forward speed of the wheel
+double step_size = 1e-3;
+
+double tolerance = 1e-9;  // relative to the largest force or moment of each kind
+                          // (the overturning moment coefficients of this tire are zero)
+
+int main(int argc, char* argv[]) {
+    ChPacejkaTire tire("tire", vehicle::GetDataFile(tire_file), Fz_grid[0], false);
+    auto wheel = std::make_shared<ChBody>();
+    tire.Initialize(wheel, LEFT);
+
+    // Terrain below the wheel center, so that the tire is in contact
+    FlatTerrain terrain(-0.4);
+
+    // Scalar evaluation. The kinematic slips seen by the tire are stored, since the
+    // longitudinal slip depends on the rolling radius updated in Advance().
+    std::vector<double> kappa, alpha, gamma, Fz;
+    std::vector<double> Fx_ref, Fy_ref, Mx_ref, Mz_ref;
+    for (double k : kappa_grid) {
+        for (double a : alpha_grid) {
+            for (double g : gamma_grid) {
+                for (double f : Fz_grid) {
+                    tire.set_Fz_override(f);
+                    tire.Synchronize(0, tire.getState_from_KAG(k, a, g, speed), terrain);
+                    tire.Advance(step_size);
+                    TireForce reactions = tire.GetTireForce_combinedSlip(true);
+
+                    kappa.push_back(tire.GetLongitudinalSlip());
+                    alpha.push_back(tire.GetSlipAngle());
+                    gamma.push_back(tire.GetCamberAngle());
+                    Fz.push_back(f);
+                    Fx_ref.push_back(reactions.force.x());
+                    Fy_ref.push_back(reactions.force.y());
+                    Mx_ref.push_back(reactions.moment.x());
+                    Mz_ref.push_back(reactions.moment.z());
+                }
+            }
+        }
+    }
+
+    // Batched evaluation
+    size_t num = Fz.size();
+    std::vector<double> Fx(num), Fy(num), Mx(num), Mz(num);
+    tire.EvaluateReactions(num, kappa.data(), alpha.data(), gamma.data(), Fz.data(), Fx.data(), Fy.data(), Mx.data(),
+                           Mz.data());
+
+    bool passed = true;
+
+    const char* names[] = {"Fx", "Fy", "Mx", "Mz"};
+    const std::vector<double>* batch[] = {&Fx, &Fy, &Mx, &Mz};
+    const std::vector<double>* scalar[] = {&Fx_ref, &Fy_ref, &Mx_ref, &Mz_ref};
+    for (int j = 0; j < 4; j++) {
+        double scale = 0;
+        double error = 0;
+        for (size_t i = 0; i < num; i++) {
+            scale = std::max(scale, std::abs((*scalar[j])[i]));
+            error = std::max(error, std::abs((*batch[j])[i] - (*scalar[j])[i]));
+        }
+        std::cout << names[j] << ": max value " << scale << "  max difference " << error << std::endl;
+        if (!(error <= tolerance * scale)) {
+            std::cout << "FAILED: " << names[j] << std::endl;
+            passed = false;
+        }
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
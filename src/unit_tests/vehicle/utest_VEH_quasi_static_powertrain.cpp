@@ -0,0 +1,245 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the quasi-static mode of the shafts powertrain and 4WD driveline.
+// The HMMWV (full suspension, rigid tires, rigid terrain) settles on the ground
+// and is then launched at full throttle, once with the ChShaft based powertrain
+// and driveline and once with both in quasi-static mode. The test checks that the
+// engine speed, the gear shifts and the wheel torques of the two runs agree within
+// the stated tolerances. It also checks that, in the shaft model, the driveshaft
+// speed is consistent with the wheel speeds through the driveline kinematics.
+//
+// The wheel torques are compared as the total torque averaged over intervals and
+// as the mean torque of each wheel over the run. The front wheels spin during the
+// launch; with the shaft model, the open front differential lets a single wheel
+// spin up, while the quasi-static model lumps the driveline inertia onto each
+// wheel, so that the instantaneous torques of individual wheels differ.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/driveline/ChShaftsDriveline4WD.h"
+
+#include "chrono_models/vehicle/hmmwv/HMMWV_Powertrain.h"
+#include "chrono_models/vehicle/hmmwv/HMMWV_RigidTire.h"
+#include "chrono_models/vehicle/hmmwv/HMMWV_VehicleFull.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::hmmwv;
+
+double step_size = 1e-3;
+double settle_time = 1.0;  // time before the throttle is applied (the vehicle is dropped on the terrain)
+double end_time = 4.0;
+double torque_interval = 0.5;  // interval over which the total wheel torque is averaged
+
+// HMMWV driveline: driveshaft speed = conical gear speed ratio * average wheel speed
+double driveshaft_to_wheels = 1 / -0.2;
+
+double speed_tolerance = 0.03;       // engine speed, relative to the maximum engine speed
+double torque_tolerance = 0.15;      // total wheel torque over an interval, relative to its maximum value
+double mean_torque_tolerance = 0.05; // mean torque of each wheel over the run, relative
+double shift_tolerance = 0.1;        // gear shift times [s]
+double kinematic_tolerance = 0.05;   // driveshaft speed vs wheel speeds (shaft model, iterative solver), relative
+
+struct Shift {
+    double time;
+    int gear;
+};
+
+struct Results {
+    std::vector<double> engine_speed;  // at each step after settling
+    std::vector<double> total_torque;  // total wheel torque, averaged over each interval
+    double mean_torque[4];             // torque of each wheel, averaged over the run
+    std::vector<Shift> shifts;
+    double kinematic_error;  // shaft model only
+};
+
+Results Run(bool quasi_static) {
+    HMMWV_VehicleFull vehicle(false, DrivelineType::AWD, ChMaterialSurfaceBase::DVI);
+    auto driveline = std::static_pointer_cast<ChShaftsDriveline4WD>(vehicle.GetDriveline());
+    driveline->SetQuasiStaticMode(quasi_static);
+    vehicle.Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.6), QUNIT));
+
+    HMMWV_Powertrain powertrain;
+    powertrain.SetQuasiStaticMode(quasi_static);
+    powertrain.Initialize(vehicle.GetChassisBody(), vehicle.GetDriveshaft());
+
+    std::vector<std::shared_ptr<HMMWV_RigidTire>> tires;
+    for (int i = 0; i < 4; i++) {
+        WheelID wheel(i);
+        tires.push_back(std::make_shared<HMMWV_RigidTire>("tire"));
+        tires[i]->Initialize(vehicle.GetWheelBody(wheel), wheel.side());
+    }
+
+    RigidTerrain terrain(vehicle.GetSystem());
+    terrain.SetContactFrictionCoefficient(0.9f);
+    terrain.SetContactRestitutionCoefficient(0.01f);
+    terrain.SetContactMaterialProperties(2e7f, 0.3f);
+    terrain.Initialize(0, 200, 200);
+
+    Results results;
+    results.kinematic_error = 0;
+    for (int i = 0; i < 4; i++)
+        results.mean_torque[i] = 0;
+    double next_sample = settle_time + torque_interval;
+    double total_torque = 0;
+    int num_steps = 0;
+    int num_run_steps = 0;
+    int gear = powertrain.GetCurrentTransmissionGear();
+    TireForces tire_forces(4);
+
+    while (vehicle.GetChTime() < end_time) {
+        double time = vehicle.GetChTime();
+        double throttle = (time < settle_time) ? 0 : 1;
+
+        for (int i = 0; i < 4; i++) {
+            tire_forces[i] = tires[i]->GetTireForce();
+            tires[i]->Synchronize(time, vehicle.GetWheelState(WheelID(i)), terrain);
+        }
+        double powertrain_torque = powertrain.GetOutputTorque();
+        double driveshaft_speed = vehicle.GetDriveshaftSpeed();
+        terrain.Synchronize(time);
+        powertrain.Synchronize(time, throttle, driveshaft_speed);
+        if (quasi_static)
+            driveline->SetInputInertia(powertrain.GetOutputInertia());
+        vehicle.Synchronize(time, 0, 0, powertrain_torque, tire_forces);
+
+        for (int i = 0; i < 4; i++)
+            tires[i]->Advance(step_size);
+        terrain.Advance(step_size);
+        powertrain.Advance(step_size);
+        vehicle.Advance(step_size);
+
+        if (vehicle.GetChTime() < settle_time)
+            continue;
+
+        if (!quasi_static) {
+            double wheel_speed = 0;
+            for (int i = 0; i < 4; i++)
+                wheel_speed += vehicle.GetWheelOmega(WheelID(i)) / 4;
+            double error = std::abs(vehicle.GetDriveshaftSpeed() - driveshaft_to_wheels * wheel_speed);
+            results.kinematic_error =
+                std::max(results.kinematic_error, error / std::max(std::abs(vehicle.GetDriveshaftSpeed()), 1.0));
+        }
+
+        if (powertrain.GetCurrentTransmissionGear() != gear) {
+            gear = powertrain.GetCurrentTransmissionGear();
+            results.shifts.push_back({vehicle.GetChTime(), gear});
+        }
+
+        results.engine_speed.push_back(powertrain.GetMotorSpeed());
+
+        for (int i = 0; i < 4; i++) {
+            double torque = vehicle.GetDriveline()->GetWheelTorque(WheelID(i));
+            total_torque += torque;
+            results.mean_torque[i] += torque;
+        }
+        num_steps++;
+        num_run_steps++;
+
+        if (vehicle.GetChTime() >= next_sample - step_size / 2) {
+            results.total_torque.push_back(total_torque / num_steps);
+            total_torque = 0;
+            num_steps = 0;
+            next_sample += torque_interval;
+        }
+    }
+
+    for (int i = 0; i < 4; i++)
+        results.mean_torque[i] /= num_run_steps;
+
+    return results;
+}
+
+int main(int argc, char* argv[]) {
+    Results shafts = Run(false);
+    Results quasi_static = Run(true);
+
+    bool passed = true;
+
+    std::cout << "shaft model: max relative driveshaft speed error " << shafts.kinematic_error << std::endl;
+    if (!(shafts.kinematic_error <= kinematic_tolerance)) {
+        std::cout << "FAILED: driveshaft speed" << std::endl;
+        passed = false;
+    }
+
+    // A NaN difference is kept and reported (std::max would drop it)
+    double max_speed = 0;
+    for (double speed : shafts.engine_speed)
+        max_speed = std::max(max_speed, std::abs(speed));
+    double speed_error = 0;
+    size_t num_steps = std::min(shafts.engine_speed.size(), quasi_static.engine_speed.size());
+    for (size_t k = 0; k < num_steps; k++) {
+        double error = std::abs(quasi_static.engine_speed[k] - shafts.engine_speed[k]) / max_speed;
+        if (std::isnan(error) || error > speed_error)
+            speed_error = error;
+    }
+    std::cout << "max relative engine speed difference " << speed_error << std::endl;
+    if (num_steps == 0 || !(speed_error <= speed_tolerance)) {
+        std::cout << "FAILED: engine speed" << std::endl;
+        passed = false;
+    }
+
+    double max_torque = 0;
+    for (double torque : shafts.total_torque)
+        max_torque = std::max(max_torque, std::abs(torque));
+    double torque_error = 0;
+    size_t num_samples = std::min(shafts.total_torque.size(), quasi_static.total_torque.size());
+    for (size_t k = 0; k < num_samples; k++) {
+        std::cout << "  total wheel torque " << shafts.total_torque[k] << " " << quasi_static.total_torque[k]
+                  << std::endl;
+        double error = std::abs(quasi_static.total_torque[k] - shafts.total_torque[k]) / max_torque;
+        if (std::isnan(error) || error > torque_error)
+            torque_error = error;
+    }
+    std::cout << "max relative total wheel torque difference " << torque_error << std::endl;
+    if (num_samples == 0 || !(torque_error <= torque_tolerance)) {
+        std::cout << "FAILED: total wheel torque" << std::endl;
+        passed = false;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        double torque_shafts = shafts.mean_torque[i];
+        double torque_quasi_static = quasi_static.mean_torque[i];
+        std::cout << "wheel " << i << ": mean torque " << torque_shafts << " " << torque_quasi_static << std::endl;
+        if (!(std::abs(torque_quasi_static - torque_shafts) <= mean_torque_tolerance * std::abs(torque_shafts))) {
+            std::cout << "FAILED: mean wheel torque" << std::endl;
+            passed = false;
+        }
+    }
+
+    bool shifts_match = shafts.shifts.size() == quasi_static.shifts.size();
+    for (size_t k = 0; k < shafts.shifts.size(); k++) {
+        const Shift& s = shafts.shifts[k];
+        std::cout << "  shift to gear " << s.gear << " at " << s.time;
+        if (k < quasi_static.shifts.size()) {
+            const Shift& q = quasi_static.shifts[k];
+            std::cout << " / gear " << q.gear << " at " << q.time;
+            if (q.gear != s.gear || std::abs(q.time - s.time) > shift_tolerance)
+                shifts_match = false;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "gear shifts: " << shafts.shifts.size() << " / " << quasi_static.shifts.size() << std::endl;
+    if (shafts.shifts.empty() || !shifts_match) {
+        std::cout << "FAILED: gear shifts" << std::endl;
+        passed = false;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
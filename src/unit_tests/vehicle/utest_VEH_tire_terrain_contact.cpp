@@ -0,0 +1,167 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the height-field contact path of deformable tires
+// (ChDeformableTire::EnableTerrainContact).
+// A grid of 400 free FEA nodes (a node cloud contact surface), loaded by their
+// weight, settles and slides on a flat rigid terrain, once with the node contacts
+// found by the collision system and once with the height-field terrain callback.
+// The test checks that the number of contacts and the node trajectories match,
+// and that the callback is unregistered from the system when the tire is deleted.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/physics/ChSystemDEM.h"
+
+#include "chrono_fea/ChContactSurfaceNodeCloud.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChDeformableTire.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+using namespace chrono::vehicle;
+
+double step_size = 1e-4;
+double end_time = 0.3;
+
+int num_side = 20;      // 20 x 20 nodes
+double spacing = 0.05;  // node spacing
+double node_radius = 0.01;
+double drop_height = node_radius + 0.002;  // initial node height
+double node_mass = 0.1;
+double gravity = 9.81;  // nodes without elements get no gravity load from the mesh
+
+double pos_tolerance = 1e-4;
+
+// Deformable "tire" made of a grid of unconnected nodes
+class NodeGridTire : public ChDeformableTire {
+  public:
+    NodeGridTire() : ChDeformableTire("grid") {
+        SetContactSurfaceType(NODE_CLOUD);
+        SetContactNodeRadius(node_radius);
+        SetContactMaterialProperties(2e6f, 0.3f);
+        EnablePressure(false);
+        EnableRimConnection(false);
+    }
+
+    virtual double GetRadius() const override { return 0; }
+    virtual double GetRimRadius() const override { return 0; }
+    virtual double GetWidth() const override { return 0; }
+
+    const std::vector<std::shared_ptr<ChNodeFEAxyz>>& GetNodes() const { return m_nodes; }
+
+  private:
+    virtual double GetDefaultPressure() const override { return 0; }
+    virtual std::vector<std::shared_ptr<ChNodeFEAbase>> GetConnectedNodes() const override {
+        return std::vector<std::shared_ptr<ChNodeFEAbase>>();
+    }
+    virtual void CreateMesh(const ChFrameMoving<>& wheel_frame, VehicleSide side) override {
+        for (int i = 0; i < num_side; i++) {
+            for (int j = 0; j < num_side; j++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * spacing, j * spacing, drop_height));
+                node->SetMass(node_mass);
+                node->SetForce(ChVector<>(0, 0, -node_mass * gravity));
+                node->SetPos_dt(ChVector<>(0.1, 0, 0));
+                m_mesh->AddNode(node);
+                m_nodes.push_back(node);
+            }
+        }
+    }
+    virtual void CreatePressureLoad() override {}
+    virtual void CreateContactSurface() override {
+        auto contact_surf = std::make_shared<ChContactSurfaceNodeCloud>();
+        m_mesh->AddContactSurface(contact_surf);
+        contact_surf->AddAllNodes(m_contact_node_radius);
+        contact_surf->SetMaterialSurface(m_contact_mat);
+    }
+    virtual void CreateRimConnections(std::shared_ptr<ChBody> wheel) override {}
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> m_nodes;
+};
+
+struct Results {
+    std::vector<int> num_contacts;  // number of contacts at each step
+    std::vector<ChVector<>> pos;    // final node positions
+};
+
+Results Run(bool terrain_contact) {
+    ChSystemDEM system;
+    system.Set_G_acc(ChVector<>(0, 0, -gravity));
+
+    RigidTerrain terrain(&system);
+    terrain.SetContactFrictionCoefficient(0.8f);
+    terrain.SetContactMaterialProperties(2e6f, 0.3f);
+    terrain.Initialize(0, 10, 10);
+
+    auto wheel = std::make_shared<ChBody>(ChMaterialSurfaceBase::DEM);
+    wheel->SetBodyFixed(true);
+    wheel->SetPos(ChVector<>(0, 0, 2));
+    system.AddBody(wheel);
+
+    NodeGridTire* tire = new NodeGridTire;
+    if (terrain_contact)
+        tire->EnableTerrainContact(&terrain, terrain.GetGroundBody());
+    tire->Initialize(wheel, LEFT);
+
+    Results results;
+    while (system.GetChTime() < end_time) {
+        system.DoStepDynamics(step_size);
+        results.num_contacts.push_back(system.GetNcontacts());
+    }
+    for (auto node : tire->GetNodes())
+        results.pos.push_back(node->GetPos());
+
+    // The nodes stay in the system; the tire callback must not be called anymore.
+    delete tire;
+    system.DoStepDynamics(step_size);
+
+    return results;
+}
+
+int main(int argc, char* argv[]) {
+    Results collision = Run(false);
+    Results callback = Run(true);
+
+    bool passed = true;
+
+    int max_contacts = 0;
+    int count_mismatches = 0;
+    for (size_t k = 0; k < collision.num_contacts.size(); k++) {
+        max_contacts = std::max(max_contacts, collision.num_contacts[k]);
+        if (callback.num_contacts[k] != collision.num_contacts[k])
+            count_mismatches++;
+    }
+    std::cout << "max number of contacts " << max_contacts << std::endl;
+    std::cout << "steps with different number of contacts " << count_mismatches << std::endl;
+    if (max_contacts != num_side * num_side || count_mismatches > 0) {
+        std::cout << "FAILED: number of contacts" << std::endl;
+        passed = false;
+    }
+
+    double pos_error = 0;
+    for (size_t i = 0; i < collision.pos.size(); i++)
+        pos_error = std::max(pos_error, (callback.pos[i] - collision.pos[i]).Length());
+    std::cout << "max node position difference " << pos_error << std::endl;
+    if (pos_error > pos_tolerance) {
+        std::cout << "FAILED: node positions" << std::endl;
+        passed = false;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}